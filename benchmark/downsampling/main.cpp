@@ -0,0 +1,199 @@
+// 降采样内核基准测试
+// 用法：DownsamplerBenchmark [点数]，默认 1000 万点
+#include "plot/QImM4Downsampler.h"
+#include "plot/QImMinMaxLTTBDownsampler.h"
+#include "plot/QImPlotMinMaxKernel.h"
+#include "plot/QImPlotParallel.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace QIM;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+// 运行 fn 至少 minSeconds 秒，返回单次平均耗时（秒）
+template< typename Fn >
+double measure(Fn&& fn, double minSeconds = 0.5)
+{
+    fn();  // 预热
+    int runs          = 0;
+    const auto start  = Clock::now();
+    double elapsed    = 0.0;
+    do {
+        fn();
+        ++runs;
+        elapsed = std::chrono::duration< double >(Clock::now() - start).count();
+    } while (elapsed < minSeconds);
+    return elapsed / runs;
+}
+
+void report(const char* name, const char* isa, qint64 points, double seconds)
+{
+    std::printf("%-34s %-10s %10.2f ms %12.1f Mpts/s\n", name, isa, seconds * 1e3, points / seconds / 1e6);
+}
+
+/**
+ * @brief 改为 SIMD 内核之前的 MinMaxLTTB 实现，作为基准
+ *
+ * 把整段数据拷贝为 double 数组，按 bucket_count / preselection_ratio 个子区间逐点求极值
+ */
+void legacyMinMaxLTTB(const QImAbstractXYDataSeries& src, int target, double ratio, std::vector< double >& outX, std::vector< double >& outY)
+{
+    const qint64 n = src.size();
+    std::vector< double > xs(n), ys(n);
+    for (qint64 i = 0; i < n; ++i) {
+        xs[ i ] = src.xValue(i);
+        ys[ i ] = src.yValue(i);
+    }
+    outX.clear();
+    outY.clear();
+    outX.push_back(xs[ 0 ]);
+    outY.push_back(ys[ 0 ]);
+    const qint64 buckets    = target - 2;
+    const qint64 bucketSize = n / buckets;
+    const qint64 remainder  = n % buckets;
+    qint64 current          = 1;
+    std::vector< qint64 > candidates;
+    for (qint64 b = 0; b < buckets; ++b) {
+        const qint64 bs = current;
+        const qint64 be = bs + bucketSize + (b < remainder ? 1 : 0);
+        if (be >= n || bs >= be) {
+            break;
+        }
+        const qint64 count = be - bs;
+        const qint64 subs  = std::max< qint64 >(1, static_cast< qint64 >(std::ceil(count / ratio)));
+        const qint64 per   = std::max< qint64 >(1, count / subs);
+        candidates.clear();
+        for (qint64 s = 0; s < subs; ++s) {
+            const qint64 ss = bs + s * per;
+            const qint64 se = (s == subs - 1) ? be : std::min(be, ss + per);
+            if (ss >= se) {
+                continue;
+            }
+            qint64 maxI = ss, minI = ss;
+            for (qint64 j = ss + 1; j < se; ++j) {
+                if (ys[ j ] > ys[ maxI ]) {
+                    maxI = j;
+                }
+                if (ys[ j ] < ys[ minI ]) {
+                    minI = j;
+                }
+            }
+            candidates.push_back(maxI);
+            if (maxI != minI) {
+                candidates.push_back(minI);
+            }
+        }
+        double ax = 0, ay = 0;
+        for (qint64 c : candidates) {
+            ax += xs[ c ];
+            ay += ys[ c ];
+        }
+        ax /= candidates.size();
+        ay /= candidates.size();
+        const double lx = outX.back(), ly = outY.back();
+        double best = -1;
+        qint64 bi   = candidates[ 0 ];
+        for (qint64 c : candidates) {
+            const double area = std::fabs((xs[ c ] - lx) * (ay - ly) - (ax - lx) * (ys[ c ] - ly));
+            if (area > best) {
+                best = area;
+                bi   = c;
+            }
+        }
+        outX.push_back(xs[ bi ]);
+        outY.push_back(ys[ bi ]);
+        current = be;
+    }
+    outX.push_back(xs[ n - 1 ]);
+    outY.push_back(ys[ n - 1 ]);
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const qint64 n = (argc > 1) ? std::max< qint64 >(1000, std::atoll(argv[ 1 ])) : 10000000;
+    std::printf("points: %lld, CPU supports: %s\n\n", static_cast< long long >(n), qimPlotSimdLevelName(qimPlotSupportedSimdLevel()));
+
+    // 带噪声的正弦信号
+    std::mt19937 rng(42);
+    std::normal_distribution< double > noise(0.0, 0.1);
+    std::vector< double > x(n), y(n);
+    std::vector< float > yf(n);
+    for (qint64 i = 0; i < n; ++i) {
+        x[ i ]  = static_cast< double >(i);
+        y[ i ]  = std::sin(i * 1e-4) + noise(rng);
+        yf[ i ] = static_cast< float >(y[ i ]);
+    }
+
+    std::vector< QImPlotSimdLevel > levels;
+    for (QImPlotSimdLevel l : { QImPlotSimdLevel::Scalar, QImPlotSimdLevel::AVX2, QImPlotSimdLevel::AVX512 }) {
+        if (l <= qimPlotSupportedSimdLevel()) {
+            levels.push_back(l);
+        }
+    }
+
+    // 1. 极值内核：按 MinMaxLTTB 的典型子区间长度分段调用
+    const qint64 chunk = 2500;
+    for (QImPlotSimdLevel l : levels) {
+        qimPlotSetSimdLevel(l);
+        volatile qint64 sink = 0;
+        const double t       = measure([ & ] {
+            for (qint64 i = 0; i < n; i += chunk) {
+                sink = sink + qimPlotMinMaxIndex(y.data() + i, std::min(chunk, n - i)).maxIdx;
+            }
+        });
+        report("min/max kernel (double)", qimPlotSimdLevelName(l), n, t);
+    }
+    for (QImPlotSimdLevel l : levels) {
+        qimPlotSetSimdLevel(l);
+        volatile qint64 sink = 0;
+        const double t       = measure([ & ] {
+            for (qint64 i = 0; i < n; i += chunk) {
+                sink = sink + qimPlotMinMaxIndex(yf.data() + i, std::min(chunk, n - i)).maxIdx;
+            }
+        });
+        report("min/max kernel (float)", qimPlotSimdLevelName(l), n, t);
+    }
+    std::printf("\n");
+
+    // 2. MinMaxLTTB 整体：旧实现与各指令集下的新实现
+    using Series = QImVectorXYDataSeries< std::vector< double >, std::vector< double > >;
+    Series series(x, y);
+    const int target = 2000;
+    std::vector< double > ox, oy;
+    report("MinMaxLTTB legacy (copy + scalar)", "Scalar", n, measure([ & ] { legacyMinMaxLTTB(series, target, 4.0, ox, oy); }));
+    for (QImPlotSimdLevel l : levels) {
+        qimPlotSetSimdLevel(l);
+        QImMinMaxLTTBDownsampler ds(&series, target);
+        report("MinMaxLTTB", qimPlotSimdLevelName(l), n, measure([ & ] { ds.downSampler(); }));
+    }
+    qimPlotSetSimdLevel(qimPlotSupportedSimdLevel());
+    std::printf("\n");
+
+    // 3. 并行预筛选：不同线程数（输出与单线程相同）
+    const int idealThreads = qimPlotThreadCount();
+    for (int threads = 1; threads <= std::max(idealThreads, 1); threads *= 2) {
+        qimPlotSetThreadCount(threads);
+        QImMinMaxLTTBDownsampler ds(&series, target);
+        const std::string label = std::to_string(threads) + " threads";
+        report("MinMaxLTTB parallel", label.c_str(), n, measure([ & ] { ds.downSampler(); }));
+    }
+    qimPlotSetThreadCount(0);
+    std::printf("\n");
+
+    // 4. M4：每列最多 4 个点，列数取 target / 4 使输出点数与 MinMaxLTTB 相当
+    {
+        QImM4Downsampler ds(&series, target / 4);
+        report("M4", qimPlotSimdLevelName(qimPlotSupportedSimdLevel()), n, measure([ & ] { ds.downSampler(); }));
+    }
+    return 0;
+}
@@ -0,0 +1,696 @@
+// 降采样质量与吞吐量基准测试
+// 对 QImWaveformGenerator 生成的合成信号运行各降采样算法，统计吞吐量、内存分配与像素保真度
+// 用法：DownsamplerQualityBenchmark [选项]
+//   --sizes 1e5,1e6,1e7        原始点数，最大可到 1e9（需要足够的内存，可配合 --float）
+//   --signals noise,spikes,square,chirp
+//   --targets 2000,20000       降采样目标点数（对应 QImPlotLineItemNode 的降采样阈值）
+//   --ratios 2,4,8             MinMaxLTTB 的预筛选比例
+//   --width 1000 --height 500  保真度对比的光栅尺寸
+//   --float                    以 float 存储原始数据
+//   --min-time 0.2             每项计时的最短时间（秒）
+//   --spike-threshold 2.5      告警阈值：|y| 达到该值的点视为必须显示的尖峰
+//   --json 文件                 输出机器可读的 JSON 结果
+// M4 行的列数等于 --width；M4 target/4 行使用 QImPlotLineItemNode 的列数（目标点数的 1/4）
+// GuaranteedExtrema 漏掉任何告警像素列时返回 2
+#include "plot/QImGuaranteedExtremaDownsampler.h"
+#include "plot/QImLTTBDownsampler.h"
+#include "plot/QImM4Downsampler.h"
+#include "plot/QImMinMaxLTTBDownsampler.h"
+#include "plot/QImPlotDataSeries.h"
+#include "plot/QImPlotMinMaxKernel.h"
+#include "plot/QImPlotParallel.h"
+#include "plot/QImWaveformGenerator.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace QIM;
+
+//===============================================================
+// 内存分配统计：替换全局 operator new/delete
+//===============================================================
+namespace
+{
+std::atomic< long long > g_allocCount { 0 };
+std::atomic< long long > g_allocBytes { 0 };
+std::atomic< long long > g_liveBytes { 0 };
+std::atomic< long long > g_peakBytes { 0 };
+// 每块内存前记录大小，保持 max_align_t 对齐
+constexpr std::size_t kAllocHeader = alignof(std::max_align_t);
+
+void* trackedAlloc(std::size_t size)
+{
+    void* block = std::malloc(size + kAllocHeader);
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    *static_cast< std::size_t* >(block) = size;
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocBytes.fetch_add(static_cast< long long >(size), std::memory_order_relaxed);
+    const long long live = g_liveBytes.fetch_add(static_cast< long long >(size), std::memory_order_relaxed) + size;
+    long long peak       = g_peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !g_peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+    return static_cast< char* >(block) + kAllocHeader;
+}
+
+void trackedFree(void* p) noexcept
+{
+    if (!p) {
+        return;
+    }
+    char* block = static_cast< char* >(p) - kAllocHeader;
+    g_liveBytes.fetch_sub(static_cast< long long >(*reinterpret_cast< std::size_t* >(block)), std::memory_order_relaxed);
+    std::free(block);
+}
+}  // namespace
+
+void* operator new(std::size_t size)
+{
+    return trackedAlloc(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return trackedAlloc(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    trackedFree(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    trackedFree(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    trackedFree(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    trackedFree(p);
+}
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+// 一段代码执行期间的分配次数、分配字节数与堆内存峰值（相对开始时）
+struct AllocationStats
+{
+    long long count { 0 };
+    long long bytes { 0 };
+    long long peak { 0 };
+};
+
+template< typename Fn >
+AllocationStats measureAllocations(Fn&& fn)
+{
+    const long long count = g_allocCount.load();
+    const long long bytes = g_allocBytes.load();
+    const long long live  = g_liveBytes.load();
+    g_peakBytes.store(live);
+    fn();
+    return { g_allocCount.load() - count, g_allocBytes.load() - bytes, g_peakBytes.load() - live };
+}
+
+// 运行 fn 至少 minSeconds 秒，返回单次平均耗时（秒）
+template< typename Fn >
+double measure(Fn&& fn, double minSeconds)
+{
+    fn();  // 预热
+    int runs         = 0;
+    const auto start = Clock::now();
+    double elapsed   = 0.0;
+    do {
+        fn();
+        ++runs;
+        elapsed = std::chrono::duration< double >(Clock::now() - start).count();
+    } while (elapsed < minSeconds);
+    return elapsed / runs;
+}
+
+//===============================================================
+// 合成信号
+//===============================================================
+// 正弦叠加白噪声
+struct NoisySine
+{
+    static double eval(double x, double noise)
+    {
+        return SineWave::eval(x, 1.0) + NoiseWave::eval(x, noise);
+    }
+};
+
+// 低幅噪声上的稀疏尖峰，检验窄峰是否被保留
+struct SpikyNoise
+{
+    static double eval(double x, double noise, double spike, double probability)
+    {
+        return NoiseWave::eval(x, noise) + SpikeTrain::eval(x, spike, probability);
+    }
+};
+
+template< typename T >
+std::vector< T > generateSignal(const std::string& name, std::size_t n, double& xEnd)
+{
+    if (name == "noise") {
+        xEnd = 20.0 * M_PI;
+        return make_waveform< NoisySine >(0.5).template generateY< T >(n, 0.0, xEnd);
+    }
+    if (name == "spikes") {
+        // 无论点数多少都约有 50 个尖峰
+        xEnd = 1000.0;
+        return make_waveform< SpikyNoise >(0.05, 5.0, 50.0 / static_cast< double >(n)).template generateY< T >(n, 0.0, xEnd);
+    }
+    if (name == "square") {
+        // 200 个周期
+        xEnd = 400.0 * M_PI;
+        return make_waveform< SquareWave >(1.0, 0.3).template generateY< T >(n, 0.0, xEnd);
+    }
+    if (name == "chirp") {
+        xEnd = 100.0 * M_PI;
+        return make_waveform< ChirpWave >(1.0, 1.0).template generateY< T >(n, 0.0, xEnd);
+    }
+    return {};
+}
+
+//===============================================================
+// 光栅化：折线覆盖的像素，用于对比降采样前后的显示结果
+//===============================================================
+class Raster
+{
+public:
+    Raster(int width, int height, const QImPlotDataBounds& bounds)
+        : m_width(width), m_height(height), m_pixels(static_cast< std::size_t >(width) * height, 0)
+    {
+        m_x0 = bounds.xMin;
+        m_y0 = bounds.yMin;
+        m_sx = (bounds.xMax > bounds.xMin) ? width / (bounds.xMax - bounds.xMin) : 0.0;
+        m_sy = (bounds.yMax > bounds.yMin) ? (height - 1) / (bounds.yMax - bounds.yMin) : 0.0;
+    }
+
+    // 绘制 n 个点的折线，point(i, x, y) 取第 i 个点；要求 X 单调递增，NaN 处断开
+    template< typename Fn >
+    void drawPolyline(qint64 n, Fn&& point)
+    {
+        bool open  = false;
+        qint64 col = 0;
+        double px = 0.0, py = 0.0, lo = 0.0, hi = 0.0;
+        for (qint64 i = 0; i < n; ++i) {
+            double x = 0.0, y = 0.0;
+            point(i, x, y);
+            if (std::isnan(x) || std::isnan(y)) {
+                if (open) {
+                    fill(col, lo, hi);
+                }
+                open = false;
+                continue;
+            }
+            const double nx = (x - m_x0) * m_sx;
+            const double ny = (y - m_y0) * m_sy;
+            if (!open) {
+                open = true;
+                col  = static_cast< qint64 >(std::floor(nx));
+                lo = hi = ny;
+            } else {
+                // 连续折线在一列内覆盖的是一段连续的像素，只需记录该列的最低与最高位置
+                const qint64 end = static_cast< qint64 >(std::floor(nx));
+                while (col < end) {
+                    const double t  = (nx > px) ? (col + 1 - px) / (nx - px) : 1.0;
+                    const double yb = py + (ny - py) * std::clamp(t, 0.0, 1.0);
+                    lo              = std::min(lo, yb);
+                    hi              = std::max(hi, yb);
+                    fill(col, lo, hi);
+                    ++col;
+                    lo = hi = yb;
+                }
+                lo = std::min(lo, ny);
+                hi = std::max(hi, ny);
+            }
+            px = nx;
+            py = ny;
+        }
+        if (open) {
+            fill(col, lo, hi);
+        }
+    }
+
+    long long pixelCount() const
+    {
+        return static_cast< long long >(std::count(m_pixels.begin(), m_pixels.end(), 1));
+    }
+
+    // 参考光栅中有而本光栅中没有的像素数，与本光栅中多出的像素数
+    void compare(const Raster& reference, long long& missing, long long& extra) const
+    {
+        missing = 0;
+        extra   = 0;
+        for (std::size_t i = 0; i < m_pixels.size(); ++i) {
+            missing += (reference.m_pixels[ i ] && !m_pixels[ i ]) ? 1 : 0;
+            extra += (!reference.m_pixels[ i ] && m_pixels[ i ]) ? 1 : 0;
+        }
+    }
+
+private:
+    void fill(qint64 col, double lo, double hi)
+    {
+        // 右边界上的点归入最后一列
+        col = (col == m_width) ? m_width - 1 : col;
+        if (col < 0 || col >= m_width) {
+            return;
+        }
+        const int r0 = std::max(0, static_cast< int >(std::floor(lo + 0.5)));
+        const int r1 = std::min(m_height - 1, static_cast< int >(std::floor(hi + 0.5)));
+        for (int r = r0; r <= r1; ++r) {
+            m_pixels[ static_cast< std::size_t >(r) * m_width + col ] = 1;
+        }
+    }
+
+private:
+    int m_width;
+    int m_height;
+    double m_x0 { 0.0 };
+    double m_y0 { 0.0 };
+    double m_sx { 0.0 };
+    double m_sy { 0.0 };
+    std::vector< unsigned char > m_pixels;
+};
+
+//===============================================================
+// 告警列：每个像素列中 |y| 达到阈值的最高与最低点
+//===============================================================
+class AlarmColumns
+{
+public:
+    // 列的划分与 QImGuaranteedExtremaDownsampler 相同：第 c 列从第一个 X >= x0 + step * c 的点开始
+    AlarmColumns(int width, double x0, double x1, double threshold)
+        : m_width(width)
+        , m_x0(x0)
+        , m_step((x1 - x0) / width)
+        , m_threshold(threshold)
+        , m_high(static_cast< std::size_t >(width), -HUGE_VAL)
+        , m_low(static_cast< std::size_t >(width), HUGE_VAL)
+    {
+    }
+
+    void add(double x, double y)
+    {
+        if (std::isnan(y) || !(m_step > 0.0)) {
+            return;
+        }
+        const std::size_t c = static_cast< std::size_t >(column(x));
+        m_high[ c ]         = std::max(m_high[ c ], y);
+        m_low[ c ]          = std::min(m_low[ c ], y);
+    }
+
+    // 本对象为原始数据时，输出 output 中未达到原始极值的告警列数；alarms 返回原始数据的告警列数
+    long long missed(const AlarmColumns& output, long long& alarms) const
+    {
+        long long count = 0;
+        alarms          = 0;
+        for (int c = 0; c < m_width; ++c) {
+            if (m_high[ c ] >= m_threshold) {
+                ++alarms;
+                count += (output.m_high[ c ] < m_high[ c ]) ? 1 : 0;
+            }
+            if (m_low[ c ] <= -m_threshold) {
+                ++alarms;
+                count += (output.m_low[ c ] > m_low[ c ]) ? 1 : 0;
+            }
+        }
+        return count;
+    }
+
+private:
+    int column(double x) const
+    {
+        int c = std::clamp(static_cast< int >(std::floor((x - m_x0) / m_step)), 0, m_width - 1);
+        // 与降采样器使用相同的边界运算，消除除法的舍入差异
+        while (c + 1 < m_width && x >= m_x0 + m_step * (c + 1)) {
+            ++c;
+        }
+        while (c > 0 && x < m_x0 + m_step * c) {
+            --c;
+        }
+        return c;
+    }
+
+private:
+    int m_width;
+    double m_x0;
+    double m_step;
+    double m_threshold;
+    std::vector< double > m_high;
+    std::vector< double > m_low;
+};
+
+//===============================================================
+// 参数与结果
+//===============================================================
+struct Options
+{
+    std::vector< double > sizes { 1e5, 1e6, 1e7 };
+    std::vector< std::string > signalNames { "noise", "spikes", "square", "chirp" };
+    std::vector< int > targets { 2000, 20000 };
+    std::vector< double > ratios { 2.0, 4.0, 8.0 };
+    int width { 1000 };
+    int height { 500 };
+    bool useFloat { false };
+    double minTime { 0.2 };
+    double spikeThreshold { 2.5 };
+    std::string jsonPath;
+};
+
+struct Result
+{
+    std::string signal;
+    long long points { 0 };
+    std::string strategy;
+    int target { 0 };
+    double ratio { 0.0 };
+    double seconds { 0.0 };
+    long long outputPoints { 0 };
+    AllocationStats allocations;
+    long long referencePixels { 0 };
+    long long missingPixels { 0 };
+    long long extraPixels { 0 };
+    long long alarmColumns { 0 };  ///< 原始数据中含告警点的像素列（上、下分别计数）
+    long long missedAlarms { 0 };  ///< 降采样后未显示原始极值的告警列
+    std::string skipped;  ///< 非空时表示该项未运行的原因
+};
+
+template< typename T >
+std::vector< T > parseList(const char* text, T (*convert)(const char*))
+{
+    std::vector< T > out;
+    std::string item;
+    for (const char* p = text;; ++p) {
+        if (*p == ',' || *p == '\0') {
+            if (!item.empty()) {
+                out.push_back(convert(item.c_str()));
+            }
+            item.clear();
+            if (*p == '\0') {
+                break;
+            }
+        } else {
+            item += *p;
+        }
+    }
+    return out;
+}
+
+double toDouble(const char* s)
+{
+    return std::strtod(s, nullptr);
+}
+
+int toInt(const char* s)
+{
+    return static_cast< int >(std::strtod(s, nullptr));
+}
+
+std::string toString(const char* s)
+{
+    return s;
+}
+
+bool parseOptions(int argc, char* argv[], Options& opt)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* arg   = argv[ i ];
+        const char* value = (i + 1 < argc) ? argv[ i + 1 ] : nullptr;
+        auto is           = [ & ](const char* name) { return std::strcmp(arg, name) == 0; };
+        if (is("--float")) {
+            opt.useFloat = true;
+            continue;
+        }
+        if (!value) {
+            std::fprintf(stderr, "missing value for %s\n", arg);
+            return false;
+        }
+        ++i;
+        if (is("--sizes")) {
+            opt.sizes = parseList< double >(value, toDouble);
+        } else if (is("--signals")) {
+            opt.signalNames = parseList< std::string >(value, toString);
+        } else if (is("--targets")) {
+            opt.targets = parseList< int >(value, toInt);
+        } else if (is("--ratios")) {
+            opt.ratios = parseList< double >(value, toDouble);
+        } else if (is("--width")) {
+            opt.width = std::max(16, toInt(value));
+        } else if (is("--height")) {
+            opt.height = std::max(16, toInt(value));
+        } else if (is("--min-time")) {
+            opt.minTime = std::max(0.0, toDouble(value));
+        } else if (is("--spike-threshold")) {
+            opt.spikeThreshold = std::max(0.0, toDouble(value));
+        } else if (is("--json")) {
+            opt.jsonPath = value;
+        } else {
+            std::fprintf(stderr, "unknown option %s\n", arg);
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string jsonEscape(const std::string& s)
+{
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out;
+}
+
+bool writeJson(const std::string& path, const Options& opt, const std::vector< Result >& results)
+{
+    std::FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) {
+        return false;
+    }
+    std::fprintf(f, "{\n  \"benchmark\": \"downsampling-quality\",\n");
+    std::fprintf(f, "  \"simd\": \"%s\",\n", qimPlotSimdLevelName(qimPlotSupportedSimdLevel()));
+    std::fprintf(f, "  \"threads\": %d,\n", qimPlotThreadCount());
+    std::fprintf(f, "  \"value_type\": \"%s\",\n", opt.useFloat ? "float" : "double");
+    std::fprintf(f, "  \"raster_width\": %d,\n  \"raster_height\": %d,\n", opt.width, opt.height);
+    std::fprintf(f, "  \"spike_threshold\": %g,\n", opt.spikeThreshold);
+    std::fprintf(f, "  \"results\": [");
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[ i ];
+        std::fprintf(f, "%s\n    {", i ? "," : "");
+        std::fprintf(f, "\"signal\": \"%s\", \"points\": %lld", jsonEscape(r.signal).c_str(), r.points);
+        if (!r.skipped.empty()) {
+            std::fprintf(f, ", \"skipped\": \"%s\"}", jsonEscape(r.skipped).c_str());
+            continue;
+        }
+        const double error = r.referencePixels ? double(r.missingPixels + r.extraPixels) / r.referencePixels : 0.0;
+        std::fprintf(f, ", \"strategy\": \"%s\", \"target\": %d", r.strategy.c_str(), r.target);
+        if (r.ratio > 0.0) {
+            std::fprintf(f, ", \"preselection_ratio\": %g", r.ratio);
+        }
+        std::fprintf(f,
+                     ", \"seconds\": %.9g, \"points_per_second\": %.6g, \"output_points\": %lld"
+                     ", \"allocations\": %lld, \"allocated_bytes\": %lld, \"peak_heap_bytes\": %lld"
+                     ", \"reference_pixels\": %lld, \"missing_pixels\": %lld, \"extra_pixels\": %lld"
+                     ", \"pixel_error\": %.6g, \"alarm_columns\": %lld, \"missed_alarms\": %lld}",
+                     r.seconds,
+                     r.seconds > 0.0 ? r.points / r.seconds : 0.0,
+                     r.outputPoints,
+                     r.allocations.count,
+                     r.allocations.bytes,
+                     r.allocations.peak,
+                     r.referencePixels,
+                     r.missingPixels,
+                     r.extraPixels,
+                     error,
+                     r.alarmColumns,
+                     r.missedAlarms);
+    }
+    std::fprintf(f, "\n  ]\n}\n");
+    std::fclose(f);
+    return true;
+}
+
+void printResult(const Result& r)
+{
+    if (!r.skipped.empty()) {
+        std::printf("%-7s %11lld  skipped: %s\n", r.signal.c_str(), r.points, r.skipped.c_str());
+        return;
+    }
+    const std::string name = r.ratio > 0.0 ? r.strategy + " r=" + std::to_string(static_cast< int >(r.ratio))
+                                           : r.strategy;
+    const double error = r.referencePixels ? 100.0 * (r.missingPixels + r.extraPixels) / r.referencePixels : 0.0;
+    std::printf("%-7s %11lld %-17s %6d %10.2f ms %10.1f Mpts/s %6lld allocs %10.1f KiB peak %8.3f %% px"
+                " %5lld/%lld missed\n",
+                r.signal.c_str(),
+                r.points,
+                name.c_str(),
+                r.target,
+                r.seconds * 1e3,
+                r.points / r.seconds / 1e6,
+                r.allocations.count,
+                r.allocations.peak / 1024.0,
+                error,
+                r.missedAlarms,
+                r.alarmColumns);
+}
+
+// 对一个信号运行所有算法与参数
+template< typename T >
+void runSignal(const Options& opt, const std::string& signal, std::size_t n, std::vector< Result >& results)
+{
+    double xEnd = 0.0;
+    std::vector< T > ys;
+    try {
+        ys = generateSignal< T >(signal, n, xEnd);
+    } catch (const std::bad_alloc&) {
+        Result r;
+        r.signal  = signal;
+        r.points  = static_cast< long long >(n);
+        r.skipped = "out of memory";
+        printResult(r);
+        results.push_back(r);
+        return;
+    }
+    if (ys.empty()) {
+        return;
+    }
+    const double dx = xEnd / static_cast< double >(n - 1);
+    using Series    = QImVectorXYDataSeries< std::vector< double >, std::vector< T > >;
+    Series series(std::vector< double >(), std::move(ys));
+    series.setYOnly(true, 0.0, dx);
+    const QImPlotDataBounds bounds = series.bounds();
+
+    // 全分辨率的参考光栅
+    Raster reference(opt.width, opt.height, bounds);
+    const T* y = static_cast< const T* >(series.yRawPointer());
+    reference.drawPolyline(static_cast< qint64 >(n), [ & ](qint64 i, double& px, double& py) {
+        px = i * dx;
+        py = static_cast< double >(y[ i ]);
+    });
+    const long long referencePixels = reference.pixelCount();
+    AlarmColumns alarms(opt.width, bounds.xMin, bounds.xMax, opt.spikeThreshold);
+    for (std::size_t i = 0; i < n; ++i) {
+        alarms.add(static_cast< double >(i) * dx, static_cast< double >(y[ i ]));
+    }
+
+    auto run = [ & ](const char* strategy, int target, double ratio, QImAbstractXYDataSeries& sampler, auto&& downsample) {
+        Result r;
+        r.signal   = signal;
+        r.points   = static_cast< long long >(n);
+        r.strategy = strategy;
+        r.target   = target;
+        r.ratio    = ratio;
+        r.seconds  = measure(downsample, opt.minTime);
+        // 预热后的一次调用：每帧重新降采样时的分配情况
+        r.allocations  = measureAllocations(downsample);
+        r.outputPoints = sampler.size();
+        Raster raster(opt.width, opt.height, bounds);
+        raster.drawPolyline(sampler.size(), [ & ](qint64 i, double& px, double& py) {
+            px = sampler.xValue(i);
+            py = sampler.yValue(i);
+        });
+        r.referencePixels = referencePixels;
+        raster.compare(reference, r.missingPixels, r.extraPixels);
+        AlarmColumns shown(opt.width, bounds.xMin, bounds.xMax, opt.spikeThreshold);
+        for (qint64 i = 0; i < sampler.size(); ++i) {
+            shown.add(sampler.xValue(i), sampler.yValue(i));
+        }
+        r.missedAlarms = alarms.missed(shown, r.alarmColumns);
+        printResult(r);
+        results.push_back(r);
+    };
+
+    for (int target : opt.targets) {
+        {
+            QImLTTBDownsampler ds(&series, target);
+            run("LTTB", target, 0.0, ds, [ & ] { ds.downSampler(); });
+        }
+        for (double ratio : opt.ratios) {
+            QImMinMaxLTTBDownsampler ds(&series, target, ratio);
+            run("MinMaxLTTB", target, ratio, ds, [ & ] { ds.downSampler(); });
+        }
+        {
+            // 列与光栅的像素列一致，像素误差只反映 M4 本身
+            QImM4Downsampler ds(&series, opt.width);
+            run("M4", target, 0.0, ds, [ & ] { ds.downSampler(); });
+        }
+        {
+            // 与 QImPlotLineItemNode 相同：每列最多 4 个点，列数取目标点数的 1/4；
+            // 列数与 --width 不同时误差包含列错位，不能直接与上一行比较
+            QImM4Downsampler ds(&series, target / 4);
+            run("M4 target/4", target, 0.0, ds, [ & ] { ds.downSampler(); });
+        }
+        {
+            // 列与光栅的像素列一致，漏掉的告警列必须为 0
+            QImGuaranteedExtremaDownsampler ds(&series, target, opt.spikeThreshold);
+            ds.setPixelWidth(opt.width);
+            run("GuaranteedExtrema", target, 0.0, ds, [ & ] { ds.downSampler(); });
+        }
+    }
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    Options opt;
+    if (!parseOptions(argc, argv, opt)) {
+        return 1;
+    }
+    std::printf("CPU supports: %s, threads: %d, raster %dx%d, %s samples\n\n",
+                qimPlotSimdLevelName(qimPlotSupportedSimdLevel()),
+                qimPlotThreadCount(),
+                opt.width,
+                opt.height,
+                opt.useFloat ? "float" : "double");
+
+    std::vector< Result > results;
+    for (double size : opt.sizes) {
+        const std::size_t n = static_cast< std::size_t >(std::max(size, 1000.0));
+        for (const std::string& signal : opt.signalNames) {
+            if (opt.useFloat) {
+                runSignal< float >(opt, signal, n, results);
+            } else {
+                runSignal< double >(opt, signal, n, results);
+            }
+        }
+        std::printf("\n");
+    }
+    if (!opt.jsonPath.empty() && !writeJson(opt.jsonPath, opt, results)) {
+        std::fprintf(stderr, "cannot write %s\n", opt.jsonPath.c_str());
+        return 1;
+    }
+    for (const Result& r : results) {
+        if (r.strategy == "GuaranteedExtrema" && r.missedAlarms > 0) {
+            std::fprintf(stderr,
+                         "guarantee violated: %s, %lld points, target %d missed %lld alarm columns\n",
+                         r.signal.c_str(),
+                         r.points,
+                         r.target,
+                         r.missedAlarms);
+            return 2;
+        }
+    }
+    return 0;
+}
@@ -11,6 +11,7 @@
 #include "plot/QImPlotNode.h"
 #include "plot/QImSubplotsNode.h"
 #include "plot/QImPlotLineItemNode.h"
+#include "plot/QImPlotDataSeries.h"
 // 可选库的条件编译
 #if defined(HAVE_QWT)
 #include "QwtPlot.h"
@@ -176,6 +177,9 @@ void PerformanceTestController::runTests(const TestConfig& config)
 #if defined(HAVE_QTCHARTS)
     ++totalTests;
 #endif
+    if (config.compareSampleTypes) {
+        totalTests += 2;
+    }
 
     int testCounter = 0;
     MemoryMonitor::setGlobalBaseline();
@@ -206,21 +210,58 @@ void PerformanceTestController::runTests(const TestConfig& config)
         allResults.append(testQImPlot(pointCount));
         emit progressChanged(allResults.size(), totalTests);
         cleanupMemory();
+        if (config.compareSampleTypes) {
+            // float32：X/Y 均为 float，走 ImPlot::PlotLine<float>，内存为 double 的一半
+            emit testStarted("QIm (float32)", pointCount);
+            allResults.append(testQImPlot(pointCount, "QIm (float32)", [ this ](int startIdx, int count) {
+                using Series = QIM::QImVectorXYDataSeries< QVector< float >, QVector< float > >;
+                return new Series(
+                    QVector< float >(m_testDataXf.constData() + startIdx, m_testDataXf.constData() + startIdx + count),
+                    QVector< float >(m_testDataYf.constData() + startIdx, m_testDataYf.constData() + startIdx + count)
+                );
+            }));
+            emit progressChanged(allResults.size(), totalTests);
+            cleanupMemory();
+            // int16：Y-only 模式，每个点只占2字节，走 ImPlot::PlotLine<ImS16>
+            emit testStarted("QIm (int16)", pointCount);
+            allResults.append(testQImPlot(pointCount, "QIm (int16)", [ this ](int startIdx, int count) {
+                using Series = QIM::QImVectorXYDataSeries< QVector< float >, QVector< qint16 > >;
+                auto* series = new Series(
+                    QVector< float >(),
+                    QVector< qint16 >(m_testDataYi16.constData() + startIdx, m_testDataYi16.constData() + startIdx + count)
+                );
+                series->setYOnly(true, m_testDataX[ startIdx ], m_testDataX[ 1 ] - m_testDataX[ 0 ]);
+                return series;
+            }));
+            emit progressChanged(allResults.size(), totalTests);
+            cleanupMemory();
+        }
     }
 
     emit allTestsCompleted(allResults);
 }
 
 TestResult PerformanceTestController::testQImPlot(int pointCount)
+{
+    return testQImPlot(pointCount, "QIm", [ this ](int startIdx, int count) {
+        using Series = QIM::QImVectorXYDataSeries< QVector< double >, QVector< double > >;
+        return new Series(
+            QVector< double >(m_testDataX.constData() + startIdx, m_testDataX.constData() + startIdx + count),
+            QVector< double >(m_testDataY.constData() + startIdx, m_testDataY.constData() + startIdx + count)
+        );
+    });
+}
+
+TestResult PerformanceTestController::testQImPlot(int pointCount, const QString& libraryName, const SeriesFactory& makeSeries)
 {
     TestResult result;
-    result.libraryName      = "QIm";
+    result.libraryName      = libraryName;
     result.pointCount       = pointCount;
     result.usedDownsampling = m_config.useDownsampling;
     result.usedOpenGL       = true;
     // 记录基准内存（测试开始前）
     MemoryMonitor mem;
-    qDebug().noquote() << "\nBegin Test QIm Baseline memory:" << mem.recordedMemory() << "MB";
+    qDebug().noquote() << "\nBegin Test" << libraryName << "Baseline memory:" << mem.recordedMemory() << "MB";
 
     auto* figure = new QIM::QImFigureWidget();
     figure->setRenderMode(QIM::QImWidget::RenderOnDemand);
@@ -239,11 +280,10 @@ TestResult PerformanceTestController::testQImPlot(int pointCount)
     timer.start();
     auto* plotNode = figure->createPlotNode();
     plotNode->setTitle("Performance Test");
-    auto* lineNode = plotNode->addLine(
-        QVector< double >(m_testDataX.constData(), m_testDataX.constData() + pointCount),
-        QVector< double >(m_testDataY.constData(), m_testDataY.constData() + pointCount),
-        "Test Curve"
-    );
+    auto* lineNode = new QIM::QImPlotLineItemNode();
+    lineNode->setLabel("Test Curve");
+    lineNode->setData(makeSeries(0, pointCount));
+    plotNode->addLine(lineNode);
     lineNode->setAdaptivesSampling(result.usedDownsampling);
     result.setupTime = timer.elapsed();
 
@@ -251,10 +291,7 @@ TestResult PerformanceTestController::testQImPlot(int pointCount)
     for (int i = 0; i < m_config.warmupFrames; ++i) {
         int startIdx = i * step;
         startIdx     = qMin(startIdx, m_totalDataSize - pointCount);
-        lineNode->setData(
-            QVector< double >(m_testDataX.constData() + startIdx, m_testDataX.constData() + startIdx + pointCount - 1),
-            QVector< double >(m_testDataY.constData() + startIdx, m_testDataY.constData() + startIdx + pointCount - 1)
-        );
+        lineNode->setData(makeSeries(startIdx, pointCount - 1));
         plotNode->rescaleAxes();
         figure->requestRender();
         QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
@@ -266,10 +303,7 @@ TestResult PerformanceTestController::testQImPlot(int pointCount)
     for (int i = 0; i < m_config.testFrames; ++i) {
         int startIdx = i * step;
         startIdx     = qMin(startIdx, m_totalDataSize - pointCount);
-        lineNode->setData(
-            QVector< double >(m_testDataX.constData() + startIdx, m_testDataX.constData() + startIdx + pointCount - 1),
-            QVector< double >(m_testDataY.constData() + startIdx, m_testDataY.constData() + startIdx + pointCount - 1)
-        );
+        lineNode->setData(makeSeries(startIdx, pointCount - 1));
         QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
         plotNode->rescaleAxes();
         figure->requestRender();
@@ -518,6 +552,20 @@ void PerformanceTestController::generateTestData(int totalPoints)
         m_testDataX[ i ] = x;
         m_testDataY[ i ] = std::sin(x) + 0.2 * std::sin(10 * x) + 0.05 * std::sin(50 * x) + noise(rng);
     }
+
+    m_testDataXf.clear();
+    m_testDataYf.clear();
+    m_testDataYi16.clear();
+    if (m_config.compareSampleTypes) {
+        m_testDataXf.resize(totalPoints);
+        m_testDataYf.resize(totalPoints);
+        m_testDataYi16.resize(totalPoints);
+        for (int i = 0; i < totalPoints; ++i) {
+            m_testDataXf[ i ]   = static_cast< float >(m_testDataX[ i ]);
+            m_testDataYf[ i ]   = static_cast< float >(m_testDataY[ i ]);
+            m_testDataYi16[ i ] = static_cast< qint16 >(std::lround(m_testDataY[ i ] * 10000.0));  // |y| < 1.5
+        }
+    }
 }
 
 // 跨平台内存清理：触发GC/内存页回收
@@ -6,6 +6,12 @@
 #include <QVector>
 #include <QElapsedTimer>
 #include <QString>
+#include <functional>
+
+namespace QIM
+{
+class QImAbstractXYDataSeries;
+}
 
 struct TestResult
 {
@@ -31,6 +37,7 @@ public:
         int testFrames       = 100;
         bool useDownsampling = false;
         bool useOpenGL       = false;  // 是否启用了OpenGL
+        bool compareSampleTypes = false;  ///< QIm 额外使用 float32 / int16 存储测试，对比内存与帧耗时
     };
 
     explicit PerformanceTestController(QObject* parent = nullptr);
@@ -45,7 +52,10 @@ signals:
     void allTestsCompleted(const QVector< TestResult >& allResults);
 
 private:
+    // 根据测试数据的 [startIdx, startIdx + count) 区间创建数据系列
+    using SeriesFactory = std::function< QIM::QImAbstractXYDataSeries*(int startIdx, int count) >;
     TestResult testQImPlot(int pointCount);
+    TestResult testQImPlot(int pointCount, const QString& libraryName, const SeriesFactory& makeSeries);
 #if defined(HAVE_QWT)
     TestResult testQwt(int pointCount);
 #endif
@@ -64,6 +74,10 @@ private:
     TestConfig m_config;
     QVector< double > m_testDataX;
     QVector< double > m_testDataY;
+    // compareSampleTypes 时使用的窄类型测试数据（一次性转换，不计入测试耗时）
+    QVector< float > m_testDataXf;
+    QVector< float > m_testDataYf;
+    QVector< qint16 > m_testDataYi16;
     int m_totalDataSize = 0;  // 实际生成的数据总点数（totalPoints * 1.3）
 };
 Q_DECLARE_METATYPE(PerformanceTestController::TestConfig)
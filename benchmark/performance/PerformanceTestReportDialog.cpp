@@ -469,6 +469,8 @@ QPixmap PerformanceTestReportDialog::generateFpsChart(const QVector< TestResult
     style[ "Qwt" ]         = { QColor(231, 76, 60), QCPScatterStyle::ssSquare };     // 红色
     style[ "QCustomPlot" ] = { QColor(46, 204, 113), QCPScatterStyle::ssTriangle };  // 绿色
     style[ "Qt Charts" ]   = { QColor(155, 89, 182), QCPScatterStyle::ssDisc };      // 紫色
+    style[ "QIm (float32)" ] = { QColor(41, 128, 185), QCPScatterStyle::ssDiamond };  // 深蓝
+    style[ "QIm (int16)" ]   = { QColor(26, 188, 156), QCPScatterStyle::ssCross };    // 青色
 
     int graphIndex = 0;
     for (auto it = dataMap.begin(); it != dataMap.end(); ++it) {
@@ -555,6 +557,8 @@ QPixmap PerformanceTestReportDialog::generateCostChart(const QVector< TestResult
     style[ "Qwt" ]         = { QColor(231, 76, 60), QCPScatterStyle::ssSquare };     // 红色
     style[ "QCustomPlot" ] = { QColor(46, 204, 113), QCPScatterStyle::ssTriangle };  // 绿色
     style[ "Qt Charts" ]   = { QColor(155, 89, 182), QCPScatterStyle::ssDisc };      // 紫色
+    style[ "QIm (float32)" ] = { QColor(41, 128, 185), QCPScatterStyle::ssDiamond };  // 深蓝
+    style[ "QIm (int16)" ]   = { QColor(26, 188, 156), QCPScatterStyle::ssCross };    // 青色
 
     int graphIndex = 0;
     for (auto it = dataMap.begin(); it != dataMap.end(); ++it) {
@@ -640,6 +644,8 @@ QPixmap PerformanceTestReportDialog::generateMemoryChart(const QVector< TestResu
     style[ "Qwt" ]         = { QColor(231, 76, 60), QCPScatterStyle::ssSquare };     // 红色
     style[ "QCustomPlot" ] = { QColor(46, 204, 113), QCPScatterStyle::ssTriangle };  // 绿色
     style[ "Qt Charts" ]   = { QColor(155, 89, 182), QCPScatterStyle::ssDisc };      // 紫色
+    style[ "QIm (float32)" ] = { QColor(41, 128, 185), QCPScatterStyle::ssDiamond };  // 深蓝
+    style[ "QIm (int16)" ]   = { QColor(26, 188, 156), QCPScatterStyle::ssCross };    // 青色
 
     int graphIndex = 0;
     for (auto it = dataMap.begin(); it != dataMap.end(); ++it) {
@@ -886,7 +892,7 @@ void PerformanceTestReportDialog::onPushButtonCopy_clicked()
         // 按库名排序（QImPlot -> Qwt -> QCustomPlot -> Qt Charts）
         QVector< TestResult > sortedResults = results;
         std::sort(sortedResults.begin(), sortedResults.end(), [](const TestResult& a, const TestResult& b) {
-            static const QStringList order = { "QIm", "Qwt", "QCustomPlot", "Qt Charts" };
+            static const QStringList order = { "QIm", "QIm (float32)", "QIm (int16)", "Qwt", "QCustomPlot", "Qt Charts" };
             int idxA                       = order.indexOf(a.libraryName);
             int idxB                       = order.indexOf(b.libraryName);
             if (idxA == -1)
@@ -92,6 +92,7 @@ void PerformanceTestWidget::onStartButtonClicked()
     config.warmupFrames    = 10;  // 固定预热帧数
     config.useDownsampling = ui->checkBoxDownsampling->isChecked();
     config.useOpenGL       = ui->checkBoxUseOpenGL->isChecked();
+    config.compareSampleTypes = ui->checkBoxSampleTypes->isChecked();
     // 验证输入
     if (config.pointCounts.isEmpty()) {
         QMessageBox::warning(this, "Input Error", "Please enter valid point counts (comma separated numbers)");
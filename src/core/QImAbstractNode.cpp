@@ -246,6 +246,28 @@ void QImAbstractNode::render()
     }
 }
 
+/**
+ * \if ENGLISH
+ * @brief Asks the owning widget to render a new frame
+ * @details Emits renderRequested() on this node and every ancestor. QImWidget listens on its root node,
+ *          so nodes that change outside of the render loop (e.g. when background work finishes) are
+ *          shown without waiting for the next timer frame, which can be up to a second in adaptive mode.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 请求所属窗口渲染新的一帧
+ * @details 在本节点及所有祖先节点上发出 renderRequested()。QImWidget 连接根节点的该信号，
+ *          在渲染循环之外发生变化的节点（例如后台计算完成）无需等待下一次定时器帧即可显示，
+ *          自适应模式下定时器间隔可达 1 秒。
+ * \endif
+ */
+void QImAbstractNode::requestRender()
+{
+    for (QImAbstractNode* node = this; node; node = node->parentNode()) {
+        emit node->renderRequested();
+    }
+}
+
 void QImAbstractNode::setRenderOptionFlags(RenderOptionFlags f)
 {
     m_renderFlags = f;
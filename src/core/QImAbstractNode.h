@@ -97,6 +97,8 @@ public:
     QList< T > findChildrenNodes() const;
     // 核心渲染入口 - 由QImWidget调用
     void render();
+    // 请求重新渲染（例如后台计算完成），沿父节点向上传递到 QImWidget
+    void requestRender();
     // 设置渲染属性
     void setRenderOptionFlags(RenderOptionFlags f);
     RenderOptionFlags renderOptionFlags() const;
@@ -113,6 +115,8 @@ Q_SIGNALS:
      */
     void childNodeRemoved(QIM::QImAbstractNode* c);
     void childNodeAdded(QIM::QImAbstractNode* c);
+    // 节点或其子节点请求重新渲染，QImWidget 连接根节点的此信号
+    void renderRequested();
 
 protected:
     /**
@@ -0,0 +1,445 @@
+#include "QImGuaranteedExtremaDownsampler.h"
+#include "QImPlotDataSeriesView.h"
+#include "QImPlotMinMaxKernel.h"
+#include "QImPlotParallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cassert>
+
+namespace QIM
+{
+
+namespace
+{
+// 每个任务至少处理的原始点数，太小的任务调度开销超过计算量
+constexpr qint64 kParallelGrainSamples = 1 << 16;
+// 每列最多保留的点数：X 有序时为最小、最大，X 无序时为首、最小、最大、尾
+constexpr int kSlotsPerColumn = 4;
+
+// [lo, hi) 中第一个 X >= value 的位置（要求 X 单调递增）
+template< typename View >
+qint64 lowerBoundX(const View& view, qint64 lo, qint64 hi, double value)
+{
+    while (lo < hi) {
+        const qint64 mid = lo + (hi - lo) / 2;
+        if (view.x(mid) < value) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+}  // namespace
+
+QImGuaranteedExtremaDownsampler::QImGuaranteedExtremaDownsampler(QImAbstractXYDataSeries* source,
+                                                                 int target_points,
+                                                                 double threshold,
+                                                                 double reference)
+    : m_source(source), m_base(source, target_points), m_threshold(std::max(threshold, 0.0)), m_reference(reference)
+{
+    assert(source && "Source must not be null");
+    rebuildGlobal();
+}
+
+qint64 QImGuaranteedExtremaDownsampler::size() const
+{
+    return m_cached_valid ? static_cast< qint64 >(m_cached_x.size()) : (m_source ? m_source->size() : 0);
+}
+
+bool QImGuaranteedExtremaDownsampler::isContiguous() const
+{
+    return m_cached_valid || (m_source && m_source->isContiguous());
+}
+
+int QImGuaranteedExtremaDownsampler::stride() const
+{
+    if (m_cached_valid || !m_source) {
+        return sizeof(double);
+    }
+    return m_source->stride();
+}
+
+int QImGuaranteedExtremaDownsampler::xStride() const
+{
+    if (m_cached_valid || !m_source) {
+        return sizeof(double);
+    }
+    return m_source->xStride();
+}
+
+const double* QImGuaranteedExtremaDownsampler::xRawData() const
+{
+    if (m_cached_valid) {
+        return m_cached_x.data();
+    }
+    return m_source ? m_source->xRawData() : nullptr;
+}
+
+const double* QImGuaranteedExtremaDownsampler::yRawData() const
+{
+    if (m_cached_valid) {
+        return m_cached_y.data();
+    }
+    return m_source ? m_source->yRawData() : nullptr;
+}
+
+QImPlotValueType QImGuaranteedExtremaDownsampler::xValueType() const
+{
+    return (m_cached_valid || !m_source) ? QImPlotValueType::Double : m_source->xValueType();
+}
+
+QImPlotValueType QImGuaranteedExtremaDownsampler::yValueType() const
+{
+    return (m_cached_valid || !m_source) ? QImPlotValueType::Double : m_source->yValueType();
+}
+
+const void* QImGuaranteedExtremaDownsampler::xRawPointer() const
+{
+    if (m_cached_valid) {
+        return m_cached_x.data();
+    }
+    return m_source ? m_source->xRawPointer() : nullptr;
+}
+
+const void* QImGuaranteedExtremaDownsampler::yRawPointer() const
+{
+    if (m_cached_valid) {
+        return m_cached_y.data();
+    }
+    return m_source ? m_source->yRawPointer() : nullptr;
+}
+
+bool QImGuaranteedExtremaDownsampler::chunkLayout(QImPlotChunkLayout& layout) const
+{
+    return !m_cached_valid && m_source && m_source->chunkLayout(layout);
+}
+
+QImPlotDataBounds QImGuaranteedExtremaDownsampler::bounds() const
+{
+    // 视图模式下只包含可见范围，坐标轴自适应仍使用原始数据的范围
+    return m_source ? m_source->bounds() : QImPlotDataBounds();
+}
+
+double QImGuaranteedExtremaDownsampler::xScale() const
+{
+    return m_source->xScale();
+}
+
+double QImGuaranteedExtremaDownsampler::xStart() const
+{
+    return m_source->xStart();
+}
+
+qint64 QImGuaranteedExtremaDownsampler::offset() const
+{
+    return m_cached_valid ? 0 : m_source->offset();
+}
+
+double QImGuaranteedExtremaDownsampler::xValue(qint64 index) const
+{
+    if (!m_cached_valid) {
+        return m_source ? m_source->xValue(index) : std::numeric_limits< double >::quiet_NaN();
+    }
+    return m_cached_x[ index ];
+}
+
+double QImGuaranteedExtremaDownsampler::yValue(qint64 index) const
+{
+    if (!m_cached_valid) {
+        return m_source ? m_source->yValue(index) : std::numeric_limits< double >::quiet_NaN();
+    }
+    return m_cached_y[ index ];
+}
+
+void QImGuaranteedExtremaDownsampler::setThreshold(double threshold)
+{
+    const double new_threshold = std::max(threshold, 0.0);
+    if (new_threshold != m_threshold) {
+        m_threshold = new_threshold;
+        downSampler();
+    }
+}
+
+double QImGuaranteedExtremaDownsampler::threshold() const
+{
+    return m_threshold;
+}
+
+void QImGuaranteedExtremaDownsampler::setReference(double reference)
+{
+    if (reference != m_reference) {
+        m_reference = reference;
+        downSampler();
+    }
+}
+
+double QImGuaranteedExtremaDownsampler::reference() const
+{
+    return m_reference;
+}
+
+void QImGuaranteedExtremaDownsampler::setTargetPoints(int points)
+{
+    if (std::max(points, 100) != m_base.targetPoints()) {
+        // MinMaxLTTB 在目标点数变化时已重新降采样
+        m_base.setTargetPoints(points);
+        rebuildGlobal();
+    }
+}
+
+int QImGuaranteedExtremaDownsampler::targetPoints() const
+{
+    return m_base.targetPoints();
+}
+
+void QImGuaranteedExtremaDownsampler::setPixelWidth(int width)
+{
+    const int new_width = std::max(width, 16);
+    if (new_width != m_pixel_width) {
+        m_pixel_width = new_width;
+        downSampler();
+    }
+}
+
+int QImGuaranteedExtremaDownsampler::pixelWidth() const
+{
+    return m_pixel_width;
+}
+
+void QImGuaranteedExtremaDownsampler::downSampler()
+{
+    m_base.downSampler();
+    rebuildGlobal();
+}
+
+/**
+ * \if ENGLISH
+ * @brief Downsamples [x_min, x_max] with one guard column per pixel
+ * @param x_min Left limit of the visible X range
+ * @param x_max Right limit of the visible X range
+ * @param pixel_width Width of the plot area in pixels
+ * @return true if the cache was rebuilt, false if the cached result was reused or the view cannot be used
+ * @details The inner MinMaxLTTB downsamples the view first, then the extrema of every pixel column
+ *          that lie outside the threshold band are merged in. Requires monotonically increasing X,
+ *          otherwise the global result is kept and false is returned.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 对 [x_min, x_max] 降采样，每个像素一列检查超限点
+ * @param x_min 可见 X 范围的左边界
+ * @param x_max 可见 X 范围的右边界
+ * @param pixel_width 绘图区的像素宽度
+ * @return 重新计算了缓存返回 true；使用已有缓存或无法按视图采样时返回 false
+ * @details 先由内部的 MinMaxLTTB 对视图降采样，再合并每个像素列中位于阈值带外的极值点。
+ *          要求 X 单调递增，否则保持全量结果并返回 false。
+ * \endif
+ */
+bool QImGuaranteedExtremaDownsampler::setViewRange(double x_min, double x_max, int pixel_width)
+{
+    if (!m_source || !m_base.isSourceSorted() || pixel_width <= 0 || !(x_min < x_max)) {
+        return false;
+    }
+    const qint64 source_size = m_source->size();
+    if (m_view_active && m_view_x_min == x_min && m_view_x_max == x_max && m_view_pixel_width == pixel_width
+        && m_view_source_size == source_size) {
+        return false;
+    }
+    m_base.setViewRange(x_min, x_max, pixel_width);
+
+    qint64 start_idx = 0;
+    qint64 end_idx   = 0;
+    qimPlotVisitXYSeries(*m_source, [ & ](const auto& view) {
+        start_idx = lowerBoundX(view, 0, source_size, x_min);
+        end_idx   = lowerBoundX(view, start_idx, source_size, x_max);
+        start_idx = std::max< qint64 >(0, start_idx - 1);
+        end_idx   = std::min(source_size, end_idx + 1);
+    });
+    rebuild(start_idx, end_idx, x_min, x_max, pixel_width);
+
+    m_cached_valid     = true;
+    m_view_active      = true;
+    m_view_x_min       = x_min;
+    m_view_x_max       = x_max;
+    m_view_pixel_width = pixel_width;
+    m_view_source_size = source_size;
+    return true;
+}
+
+void QImGuaranteedExtremaDownsampler::clearViewRange()
+{
+    if (m_view_active) {
+        downSampler();
+    }
+}
+
+void QImGuaranteedExtremaDownsampler::sourceAppended()
+{
+    if (!m_source) {
+        return;
+    }
+    m_base.sourceAppended();
+    if (m_view_active && m_base.isViewRangeActive()) {
+        // 清除缓存键使下一次 setViewRange() 重新采样
+        m_view_pixel_width = 0;
+        return;
+    }
+    rebuildGlobal();
+}
+
+bool QImGuaranteedExtremaDownsampler::isViewRangeActive() const
+{
+    return m_view_active;
+}
+
+qint64 QImGuaranteedExtremaDownsampler::guardedCount() const
+{
+    return m_guarded;
+}
+
+const QImMinMaxLTTBDownsampler* QImGuaranteedExtremaDownsampler::base() const
+{
+    return &m_base;
+}
+
+void QImGuaranteedExtremaDownsampler::rebuildGlobal()
+{
+    m_cached_x.clear();
+    m_cached_y.clear();
+    m_cached_valid = false;
+    m_view_active  = false;
+    m_guarded      = 0;
+
+    const qint64 source_size = m_source ? m_source->size() : 0;
+    // 不超过目标点数时 MinMaxLTTB 透传原始数据，所有点都会被绘制
+    if (source_size <= m_base.targetPoints()) {
+        return;
+    }
+    double x_min = 0.0;
+    double x_max = 0.0;
+    if (m_base.isSourceSorted()) {
+        qimPlotVisitXYSeries(*m_source, [ & ](const auto& view) {
+            x_min = view.x(0);
+            x_max = view.x(source_size - 1);
+        });
+    }
+    rebuild(0, source_size, x_min, x_max, m_pixel_width);
+    m_cached_valid = true;
+}
+
+// ===== 按列收集超限点并与 MinMaxLTTB 的结果合并（O(n)，各列独立）=====
+void QImGuaranteedExtremaDownsampler::rebuild(qint64 start_idx, qint64 end_idx, double x_min, double x_max, int columns)
+{
+    m_cached_x.clear();
+    m_cached_y.clear();
+    m_guarded      = 0;
+    const qint64 n = end_idx - start_idx;
+    if (n <= 0 || columns <= 0) {
+        return;
+    }
+    const bool by_x   = m_base.isSourceSorted() && x_min < x_max;
+    const double step = by_x ? (x_max - x_min) / columns : 0.0;
+    const double low  = m_reference - m_threshold;
+    const double high = m_reference + m_threshold;
+
+    // 每列固定槽位，各列并行写入自己的槽位，-1 表示空槽位
+    std::vector< qint64 > slots(static_cast< std::size_t >(columns) * kSlotsPerColumn, -1);
+    const qint64 grain = std::max< qint64 >(1, columns * kParallelGrainSamples / n);
+    std::vector< double > guard_x;
+    std::vector< double > guard_y;
+
+    qimPlotVisitXYSeries(*m_source, [ & ](const auto& view) {
+        auto columnStart = [ & ](qint64 c) -> qint64 {
+            if (c <= 0) {
+                return start_idx;
+            }
+            if (c >= columns) {
+                return end_idx;
+            }
+            if (by_x) {
+                return lowerBoundX(view, start_idx, end_idx, x_min + step * c);
+            }
+            return start_idx + n * c / columns;
+        };
+        qimPlotParallelFor(columns, grain, [ & ](qint64 begin, qint64 end) {
+            qint64 first = columnStart(begin);
+            for (qint64 c = begin; c < end; ++c) {
+                const qint64 last = columnStart(c + 1);
+                if (last > first) {
+                    const QImPlotMinMaxIndex mm = qimPlotViewMinMax(view, first, last);
+                    // X 有序时只保留带外的极值；X 无序时 MinMaxLTTB 的结果不可按 X 合并，输出 M4 的四个点
+                    qint64 idx[ kSlotsPerColumn ] = { -1, -1, -1, -1 };
+                    if (by_x) {
+                        if (mm.minIdx >= 0 && mm.minValue <= low) {
+                            idx[ 0 ] = mm.minIdx;
+                        }
+                        if (mm.maxIdx >= 0 && mm.maxValue >= high) {
+                            idx[ 1 ] = mm.maxIdx;
+                        }
+                    } else {
+                        idx[ 0 ] = first;
+                        idx[ 1 ] = mm.minIdx;
+                        idx[ 2 ] = mm.maxIdx;
+                        idx[ 3 ] = last - 1;
+                    }
+                    std::sort(idx, idx + kSlotsPerColumn);
+                    qint64* out = &slots[ static_cast< std::size_t >(c) * kSlotsPerColumn ];
+                    int k       = 0;
+                    for (qint64 i : idx) {
+                        if (i >= 0 && (k == 0 || out[ k - 1 ] != i)) {
+                            out[ k++ ] = i;
+                        }
+                    }
+                }
+                first = last;
+            }
+        });
+
+        // 按列顺序串行压缩，结果与线程数无关
+        const auto kept = static_cast< std::size_t >(std::count_if(slots.begin(), slots.end(), [](qint64 i) {
+            return i >= 0;
+        }));
+        guard_x.reserve(kept);
+        guard_y.reserve(kept);
+        for (qint64 i : slots) {
+            if (i >= 0) {
+                guard_x.push_back(view.x(i));
+                guard_y.push_back(view.y(i));
+            }
+        }
+    });
+
+    if (!by_x) {
+        m_cached_x.swap(guard_x);
+        m_cached_y.swap(guard_y);
+        m_guarded = static_cast< qint64 >(m_cached_x.size());
+        return;
+    }
+
+    // 与 MinMaxLTTB 的结果按 X 归并，已被选中的点不重复加入
+    const qint64 base_size   = m_base.size();
+    const std::size_t guards = guard_x.size();
+    m_cached_x.reserve(static_cast< std::size_t >(base_size) + guards);
+    m_cached_y.reserve(static_cast< std::size_t >(base_size) + guards);
+    qint64 i      = 0;
+    std::size_t j = 0;
+    while (i < base_size || j < guards) {
+        if (j < guards && (i >= base_size || guard_x[ j ] < m_base.xValue(i))) {
+            m_cached_x.push_back(guard_x[ j ]);
+            m_cached_y.push_back(guard_y[ j ]);
+            ++m_guarded;
+            ++j;
+            continue;
+        }
+        const double bx = m_base.xValue(i);
+        const double by = m_base.yValue(i);
+        if (j < guards && guard_x[ j ] == bx && guard_y[ j ] == by) {
+            ++j;
+        }
+        m_cached_x.push_back(bx);
+        m_cached_y.push_back(by);
+        ++i;
+    }
+}
+
+}  // namespace QIM
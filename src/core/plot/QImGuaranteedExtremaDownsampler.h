@@ -0,0 +1,161 @@
+#ifndef QIMGUARANTEEDEXTREMADOWNSAMPLER_H
+#define QIMGUARANTEEDEXTREMADOWNSAMPLER_H
+
+#include "QImMinMaxLTTBDownsampler.h"
+#include <vector>
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief MinMaxLTTB downsampling with a hard guarantee that samples beyond a threshold survive
+ *
+ * @class QImGuaranteedExtremaDownsampler
+ *
+ * @details LTTB may drop a single-sample spike and the MinMaxLTTB preselection only keeps extrema of
+ *          its sub-buckets, so neither guarantees that a transient is drawn. This proxy runs MinMaxLTTB
+ *          for the shape of the curve and then, for every pixel column of the range, adds the column's
+ *          maximum and minimum sample when they lie outside the band reference() ± threshold().
+ *
+ *          Guarantee: for every sample with |y - reference()| >= threshold(), the output contains a
+ *          sample of the same pixel column that is at least as far from the reference on the same side.
+ *          Several spikes in one column collapse to the most extreme one, so at most 2 samples are added per
+ *          pixel column: the global result never exceeds targetPoints() + 2 * pixelWidth(), a view result
+ *          never exceeds 6 samples per pixel column (at most 4 from the MinMaxLTTB view result). A threshold
+ *          of 0 guards the minimum and maximum of every column. The added samples are real samples, merged
+ *          in X order.
+ *
+ *          Columns follow the view (setViewRange()) or, for the global result, pixelWidth() columns over
+ *          the whole X range. X must increase monotonically; with unsorted X the output is the first,
+ *          minimum, maximum and last sample of equal-count columns, which keeps the guarantee.
+ *          The column scan uses the SIMD min/max kernel and runs in parallel.
+ *
+ *          The source is not owned and must outlive the downsampler.
+ * @see QImMinMaxLTTBDownsampler, QImPlotLineItemNode::DownsampleGuaranteedExtrema
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 带硬性保证的 MinMaxLTTB 降采样：超过阈值的点一定保留
+ *
+ * @class QImGuaranteedExtremaDownsampler
+ *
+ * @details LTTB 可能丢掉单点尖峰，MinMaxLTTB 的预筛选只保留子区间的极值，二者都不能保证瞬态一定被绘制。
+ *          该代理先用 MinMaxLTTB 得到曲线的形状，再对范围内的每个像素列，在列内最大、最小点位于
+ *          reference() ± threshold() 的带外时把它们加入结果。
+ *
+ *          保证：对每个 |y - reference()| >= threshold() 的点，输出中同一像素列内一定有一个在同一侧、
+ *          离参考值至少同样远的点。同一列内的多个尖峰合并为最极端的一个，每列最多加入 2 个点：
+ *          全量结果不超过 targetPoints() + 2 * pixelWidth() 个点，视图结果每个像素列不超过 6 个点
+ *          （MinMaxLTTB 的视图结果最多 4 个）。阈值为 0 时保留每列的最小、最大点。加入的都是真实的数据点，
+ *          按 X 顺序合并。
+ *
+ *          列随视图划分（setViewRange()），全量结果则把整个 X 范围划分为 pixelWidth() 列。
+ *          要求 X 单调递增；X 无序时输出点数相等的各列的首、最小、最大、尾点，保证仍然成立。
+ *          列扫描使用 SIMD 极值内核并行执行。
+ *
+ *          不持有原始数据，原始数据的生命周期必须长于代理。
+ * @see QImMinMaxLTTBDownsampler, QImPlotLineItemNode::DownsampleGuaranteedExtrema
+ * \endif
+ */
+class QIM_CORE_API QImGuaranteedExtremaDownsampler : public QImAbstractXYDataSeries
+{
+public:
+    /**
+     * @brief 构造代理（不拥有原始数据所有权）
+     * @param source 原始数据系列（必须保证生命周期长于代理）
+     * @param target_points MinMaxLTTB 的目标点数
+     * @param threshold 与参考值的距离达到该值的点一定保留
+     * @param reference 参考值（基线）
+     */
+    explicit QImGuaranteedExtremaDownsampler(QImAbstractXYDataSeries* source,
+                                             int target_points = 2000,
+                                             double threshold  = 0.0,
+                                             double reference  = 0.0);
+    ~QImGuaranteedExtremaDownsampler() override = default;
+
+    // ===== QImAbstractXYDataSeries 接口重写 =====
+    int type() const override
+    {
+        return XYData;
+    }  // 代理后总是 XY 模式
+
+    qint64 size() const override;
+    bool isContiguous() const override;
+    int stride() const override;
+    int xStride() const override;
+    const double* xRawData() const override;
+    const double* yRawData() const override;
+    QImPlotValueType xValueType() const override;
+    QImPlotValueType yValueType() const override;
+    const void* xRawPointer() const override;
+    const void* yRawPointer() const override;
+    bool chunkLayout(QImPlotChunkLayout& layout) const override;
+    QImPlotDataBounds bounds() const override;
+    double xScale() const override;
+    double xStart() const override;
+    qint64 offset() const override;
+    double xValue(qint64 index) const override;
+    double yValue(qint64 index) const override;
+
+    // ===== 配置接口 =====
+    // 与参考值的距离达到 threshold 的点一定保留，默认 0 表示保留每列的最小、最大点
+    void setThreshold(double threshold);
+    double threshold() const;
+    // 参考值（基线），默认 0
+    void setReference(double reference);
+    double reference() const;
+    // MinMaxLTTB 的目标点数
+    void setTargetPoints(int points);
+    int targetPoints() const;
+    // 全量结果的列数（尚未知道绘图宽度时的估计值），最小 16
+    void setPixelWidth(int width);
+    int pixelWidth() const;
+
+    // 对全量数据重新降采样（原始数据被修改时调用）
+    void downSampler();
+
+    // ===== 视图相关下采样 =====
+    // 对 [x_min, x_max] 按像素宽度降采样，范围与像素宽度不变时直接使用缓存，返回是否重新计算
+    bool setViewRange(double x_min, double x_max, int pixel_width);
+    // 回到全量数据的下采样
+    void clearViewRange();
+    // 原始数据追加了点后调用
+    void sourceAppended();
+    bool isViewRangeActive() const;
+
+    // ===== 结果 =====
+    // 当前结果中因超出阈值带而加入的点数（不含 MinMaxLTTB 已选中的点）
+    qint64 guardedCount() const;
+    // 内部的 MinMaxLTTB 降采样器
+    const QImMinMaxLTTBDownsampler* base() const;
+
+private:
+    // 在 MinMaxLTTB 的全量结果上重新收集全部数据的保留点
+    void rebuildGlobal();
+    // 把 [start_idx, end_idx) 划分为 columns 列，收集需要保留的点并与 MinMaxLTTB 的结果合并
+    void rebuild(qint64 start_idx, qint64 end_idx, double x_min, double x_max, int columns);
+
+private:
+    QImAbstractXYDataSeries* m_source { nullptr };
+    QImMinMaxLTTBDownsampler m_base;
+    double m_threshold { 0.0 };
+    double m_reference { 0.0 };
+    int m_pixel_width { 1000 };
+
+    std::vector< double > m_cached_x;
+    std::vector< double > m_cached_y;
+    bool m_cached_valid { false };
+    qint64 m_guarded { 0 };
+
+    // 视图范围下采样的缓存键
+    bool m_view_active { false };
+    double m_view_x_min { 0.0 };
+    double m_view_x_max { 0.0 };
+    int m_view_pixel_width { 0 };
+    qint64 m_view_source_size { 0 };
+};
+
+}  // namespace QIM
+
+#endif  // QIMGUARANTEEDEXTREMADOWNSAMPLER_H
@@ -0,0 +1,307 @@
+#include "QImHeatmapPyramid.h"
+#include "QImPlotMinMaxKernel.h"
+#include "QImPlotParallel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace QIM
+{
+
+namespace
+{
+// 每个任务至少归约的单元格数
+constexpr qint64 kParallelGrainCells = 1 << 16;
+
+// 以 get(row, col) 的形式访问原始矩阵，连续存储时按存储类型直接读取
+template< typename Fn >
+void visitSource(const QImAbstractHeatmapDataSeries& source, Fn&& fn)
+{
+    const void* raw = source.valuesRawPointer();
+    if (!raw || !source.isContiguous()) {
+        fn([ &source ](qint64 r, qint64 c) { return source.value(static_cast< int >(r), static_cast< int >(c)); });
+        return;
+    }
+    const qint64 rows = source.rows();
+    const qint64 cols = source.cols();
+    qimPlotDispatchValueType(source.valueType(), [ & ](auto tag) {
+        using T         = typename decltype(tag)::type;
+        const T* values = static_cast< const T* >(raw);
+        if (source.isColMajor()) {
+            fn([ values, rows ](qint64 r, qint64 c) { return static_cast< double >(values[ c * rows + r ]); });
+        } else {
+            fn([ values, cols ](qint64 r, qint64 c) { return static_cast< double >(values[ r * cols + c ]); });
+        }
+    });
+}
+
+// 非 NaN 值的范围，没有有效值时返回 false
+template< typename T >
+bool rawRange(const T* values, qint64 count, double& lo, double& hi)
+{
+    if constexpr (std::is_same_v< T, double > || std::is_same_v< T, float >) {
+        const QImPlotMinMaxIndex mm = qimPlotMinMaxIndex(values, count);
+        if (mm.minIdx < 0) {
+            return false;
+        }
+        lo = mm.minValue;
+        hi = mm.maxValue;
+    } else {
+        const auto [ mn, mx ] = std::minmax_element(values, values + count);
+        lo                    = static_cast< double >(*mn);
+        hi                    = static_cast< double >(*mx);
+    }
+    return true;
+}
+
+// 输入层往上第 step 层单元格 (r, c) 的归约值，dims[ s ] 为往上第 s 层的行数、列数。
+// 每一层都与逐层构建一样先舍入为 float，跳过中间层的结果与逐层构建相同
+template< typename Get >
+double reduceCell(const Get& get, const qint64 (*dims)[ 2 ], int step, qint64 r, qint64 c, bool useMax)
+{
+    if (step == 0) {
+        return get(r, c);
+    }
+    const qint64 rEnd = std::min(r * 2 + 2, dims[ step - 1 ][ 0 ]);
+    const qint64 cEnd = std::min(c * 2 + 2, dims[ step - 1 ][ 1 ]);
+    double acc        = useMax ? -std::numeric_limits< double >::infinity() : 0.0;
+    int n             = 0;
+    for (qint64 rr = r * 2; rr < rEnd; ++rr) {
+        for (qint64 cc = c * 2; cc < cEnd; ++cc) {
+            const double v = reduceCell(get, dims, step - 1, rr, cc, useMax);
+            if (std::isnan(v)) {
+                continue;
+            }
+            acc = useMax ? std::max(acc, v) : acc + v;
+            ++n;
+        }
+    }
+    if (n == 0) {
+        return std::numeric_limits< float >::quiet_NaN();
+    }
+    return static_cast< float >(useMax ? acc : acc / n);
+}
+}  // namespace
+
+QImHeatmapPyramid::QImHeatmapPyramid(const QImAbstractHeatmapDataSeries* source, Reduction reduction)
+    : m_source(source), m_reduction(reduction)
+{
+}
+
+void QImHeatmapPyramid::setSource(const QImAbstractHeatmapDataSeries* source)
+{
+    m_source = source;
+    invalidate();
+}
+
+const QImAbstractHeatmapDataSeries* QImHeatmapPyramid::source() const
+{
+    return m_source;
+}
+
+void QImHeatmapPyramid::setReduction(Reduction reduction)
+{
+    if (m_reduction != reduction) {
+        m_reduction = reduction;
+        m_levels.clear();
+    }
+}
+
+QImHeatmapPyramid::Reduction QImHeatmapPyramid::reduction() const
+{
+    return m_reduction;
+}
+
+void QImHeatmapPyramid::invalidate()
+{
+    m_levels.clear();
+    m_range_valid = false;
+}
+
+int QImHeatmapPyramid::rows(int level) const
+{
+    if (!m_source) {
+        return 0;
+    }
+    qint64 n = m_source->rows();
+    for (int l = 0; l < level; ++l) {
+        n = (n + 1) / 2;
+    }
+    return static_cast< int >(n);
+}
+
+int QImHeatmapPyramid::cols(int level) const
+{
+    if (!m_source) {
+        return 0;
+    }
+    qint64 n = m_source->cols();
+    for (int l = 0; l < level; ++l) {
+        n = (n + 1) / 2;
+    }
+    return static_cast< int >(n);
+}
+
+int QImHeatmapPyramid::levelFor(int size) const
+{
+    int level = 0;
+    size      = std::max(size, 1);
+    while (rows(level) > size || cols(level) > size) {
+        ++level;
+    }
+    return level;
+}
+
+template< typename Get >
+QImHeatmapPyramid::Level QImHeatmapPyramid::reduce(int rows, int cols, int steps, const Get& get) const
+{
+    // 输入层往上各层的行数、列数；行数、列数为 int，不会超过 32 层
+    qint64 dims[ 33 ][ 2 ];
+    dims[ 0 ][ 0 ] = rows;
+    dims[ 0 ][ 1 ] = cols;
+    for (int s = 1; s <= steps; ++s) {
+        dims[ s ][ 0 ] = (dims[ s - 1 ][ 0 ] + 1) / 2;
+        dims[ s ][ 1 ] = (dims[ s - 1 ][ 1 ] + 1) / 2;
+    }
+    Level out;
+    out.rows = static_cast< int >(dims[ steps ][ 0 ]);
+    out.cols = static_cast< int >(dims[ steps ][ 1 ]);
+    out.values.resize(static_cast< std::size_t >(out.rows) * out.cols);
+    const bool useMax       = m_reduction == ReduceMax;
+    // 每个输出行读取 2^steps 个输入行
+    const qint64 grain = std::max< qint64 >(1, kParallelGrainCells / (static_cast< qint64 >(cols) << steps));
+    qimPlotParallelFor(out.rows, grain, [ & ](qint64 begin, qint64 end) {
+        for (qint64 r = begin; r < end; ++r) {
+            float* dst = &out.values[ static_cast< std::size_t >(r * out.cols) ];
+            for (qint64 c = 0; c < out.cols; ++c) {
+                dst[ c ] = static_cast< float >(reduceCell(get, dims, steps, r, c, useMax));
+            }
+        }
+    });
+    return out;
+}
+
+void QImHeatmapPyramid::ensureLevel(int level)
+{
+    if (!m_source || m_source->rows() <= 0 || m_source->cols() <= 0) {
+        return;
+    }
+    // 超过单个单元格的层没有意义
+    level = std::min(level, levelFor(1));
+    if (level <= 0 || isLevelBuilt(level)) {
+        return;
+    }
+    if (static_cast< int >(m_levels.size()) < level) {
+        m_levels.resize(static_cast< std::size_t >(level));
+    }
+    // 从下方最近的已构建层归约，不构建中间层
+    int from = level - 1;
+    while (from > 0 && !isLevelBuilt(from)) {
+        --from;
+    }
+    Level& target = m_levels[ static_cast< std::size_t >(level - 1) ];
+    if (from == 0) {
+        visitSource(*m_source, [ & ](const auto& get) {
+            target = reduce(m_source->rows(), m_source->cols(), level, get);
+        });
+    } else {
+        const Level& below = m_levels[ static_cast< std::size_t >(from - 1) ];
+        const float* src   = below.values.data();
+        const qint64 cols  = below.cols;
+        target             = reduce(below.rows, below.cols, level - from, [ src, cols ](qint64 r, qint64 c) {
+            return static_cast< double >(src[ r * cols + c ]);
+        });
+    }
+}
+
+bool QImHeatmapPyramid::isLevelBuilt(int level) const
+{
+    if (!m_source || level < 0) {
+        return false;
+    }
+    return level == 0
+           || (level <= static_cast< int >(m_levels.size()) && m_levels[ static_cast< std::size_t >(level - 1) ].rows > 0);
+}
+
+int QImHeatmapPyramid::builtLevelCount() const
+{
+    if (!m_source) {
+        return 0;
+    }
+    int count = 1;
+    for (const auto& level : m_levels) {
+        count += level.rows > 0 ? 1 : 0;
+    }
+    return count;
+}
+
+void QImHeatmapPyramid::read(int level, int row, int col, int height, int width, double* out) const
+{
+    if (!isLevelBuilt(level)) {
+        return;
+    }
+    if (level == 0) {
+        visitSource(*m_source, [ & ](const auto& get) {
+            for (int r = 0; r < height; ++r) {
+                double* dst = out + static_cast< std::size_t >(r) * width;
+                for (int c = 0; c < width; ++c) {
+                    dst[ c ] = get(row + r, col + c);
+                }
+            }
+        });
+        return;
+    }
+    const Level& lv = m_levels[ static_cast< std::size_t >(level - 1) ];
+    for (int r = 0; r < height; ++r) {
+        const float* src = &lv.values[ static_cast< std::size_t >(row + r) * lv.cols + col ];
+        std::copy(src, src + width, out + static_cast< std::size_t >(r) * width);
+    }
+}
+
+bool QImHeatmapPyramid::valueRange(double& lo, double& hi)
+{
+    if (!m_source) {
+        return false;
+    }
+    if (!m_range_valid) {
+        m_range_found     = false;
+        const void* raw   = m_source->valuesRawPointer();
+        const qint64 size = static_cast< qint64 >(m_source->rows()) * m_source->cols();
+        if (raw && m_source->isContiguous()) {
+            qimPlotDispatchValueType(m_source->valueType(), [ & ](auto tag) {
+                using T       = typename decltype(tag)::type;
+                m_range_found = rawRange(static_cast< const T* >(raw), size, m_range_lo, m_range_hi);
+            });
+        } else {
+            for (int r = 0; r < m_source->rows(); ++r) {
+                for (int c = 0; c < m_source->cols(); ++c) {
+                    const double v = m_source->value(r, c);
+                    if (std::isnan(v)) {
+                        continue;
+                    }
+                    m_range_lo    = m_range_found ? std::min(m_range_lo, v) : v;
+                    m_range_hi    = m_range_found ? std::max(m_range_hi, v) : v;
+                    m_range_found = true;
+                }
+            }
+        }
+        m_range_valid = true;
+    }
+    if (m_range_found) {
+        lo = m_range_lo;
+        hi = m_range_hi;
+    }
+    return m_range_found;
+}
+
+qint64 QImHeatmapPyramid::memoryUsage() const
+{
+    qint64 bytes = 0;
+    for (const auto& level : m_levels) {
+        bytes += static_cast< qint64 >(level.values.capacity() * sizeof(float));
+    }
+    return bytes;
+}
+
+}  // namespace QIM
@@ -0,0 +1,114 @@
+#ifndef QIMHEATMAPPYRAMID_H
+#define QIMHEATMAPPYRAMID_H
+
+#include "QImPlotHeatmapDataSeries.h"
+#include <vector>
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief Mip pyramid of a heatmap matrix, used to draw very large heatmaps tile by tile
+ *
+ * @class QImHeatmapPyramid
+ *
+ * @details Level 0 is the source matrix itself and is never copied. Every higher level halves the
+ *          number of rows and columns (rounded up): a cell of level k is the reduction of the 2x2 cells
+ *          of level k - 1 below it, so it covers 2^k x 2^k source cells (fewer on the last row and
+ *          column). ReduceMax keeps peaks visible at any zoom level, ReduceMean keeps the average
+ *          intensity. NaN cells are skipped; a cell whose inputs are all NaN is NaN.
+ *
+ *          Levels are stored row-major as float, row 0 on top like the source, and are built on demand
+ *          by ensureLevel(), in parallel. Only the requested level is stored: it is reduced directly from
+ *          the nearest built level below it (or the source), with the same result as building every level
+ *          in between. The whole pyramid takes at most a third of the cell count of the source in floats.
+ *          invalidate() drops the built levels after the source changed.
+ *          The source is not owned and must outlive the pyramid.
+ * @see QImPlotTiledHeatmapItemNode
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 热力图矩阵的 mip 金字塔，用于按瓦片绘制超大热力图
+ *
+ * @class QImHeatmapPyramid
+ *
+ * @details 第 0 层就是原始矩阵，不做拷贝。每往上一层行数、列数减半（向上取整）：第 k 层的一个单元格
+ *          是第 k - 1 层对应 2x2 个单元格的归约结果，覆盖 2^k x 2^k 个原始单元格（最后一行、一列更少）。
+ *          ReduceMax 在任意缩放级别都保留峰值，ReduceMean 保留平均强度。NaN 被跳过，输入全为 NaN 时结果为 NaN。
+ *
+ *          各层以 float 按行主序存储，与原始数据一样第 0 行在上方，由 ensureLevel() 按需并行构建。只保存请求的层：
+ *          直接从其下方最近的已构建层（或原始数据）归约，结果与逐层构建相同。整个金字塔最多占原始单元格数
+ *          三分之一的 float。原始数据修改后调用 invalidate() 丢弃已构建的层。
+ *          不持有原始数据，原始数据的生命周期必须长于金字塔。
+ * @see QImPlotTiledHeatmapItemNode
+ * \endif
+ */
+class QIM_CORE_API QImHeatmapPyramid
+{
+public:
+    // 2x2 单元格的归约方式
+    enum Reduction
+    {
+        ReduceMax = 0,  ///< 取最大值，保留峰值
+        ReduceMean      ///< 取平均值，保留平均强度
+    };
+
+    explicit QImHeatmapPyramid(const QImAbstractHeatmapDataSeries* source = nullptr,
+                               Reduction reduction                        = ReduceMax);
+    ~QImHeatmapPyramid() = default;
+
+    // 更换原始数据，丢弃已构建的层
+    void setSource(const QImAbstractHeatmapDataSeries* source);
+    const QImAbstractHeatmapDataSeries* source() const;
+    // 更换归约方式，丢弃已构建的层
+    void setReduction(Reduction reduction);
+    Reduction reduction() const;
+    // 丢弃已构建的层与缓存的数据范围（原始数据被原地修改时调用）
+    void invalidate();
+
+    // 第 level 层的行数、列数（不需要该层已构建）
+    int rows(int level) const;
+    int cols(int level) const;
+    // 行数、列数都不超过 size 的最低层，即只需一个 size x size 瓦片的层
+    int levelFor(int size) const;
+    // 构建第 level 层，不构建中间层；已构建的层不会重复计算
+    void ensureLevel(int level);
+    // 第 level 层是否已构建，有原始数据时第 0 层总是已构建
+    bool isLevelBuilt(int level) const;
+    // 已构建的层数（含第 0 层），没有原始数据时为 0
+    int builtLevelCount() const;
+
+    // 把第 level 层 [row, row + height) x [col, col + width) 的单元格按行主序写入 out（width * height 个），
+    // 该层必须已构建
+    void read(int level, int row, int col, int height, int width, double* out) const;
+    // 原始数据中非 NaN 值的范围，结果缓存到 invalidate()；没有有效值时返回 false
+    bool valueRange(double& lo, double& hi);
+    // 已构建的层占用的字节数
+    qint64 memoryUsage() const;
+
+private:
+    struct Level
+    {
+        int rows { 0 };
+        int cols { 0 };
+        std::vector< float > values;
+    };
+
+    // 把读取函数为 get 的 rows x cols 的一层归约为往上 steps 层
+    template< typename Get >
+    Level reduce(int rows, int cols, int steps, const Get& get) const;
+
+private:
+    const QImAbstractHeatmapDataSeries* m_source { nullptr };
+    Reduction m_reduction { ReduceMax };
+    std::vector< Level > m_levels;  ///< 第 1 层起，未构建的层 rows 为 0
+    bool m_range_valid { false };
+    bool m_range_found { false };
+    double m_range_lo { 0.0 };
+    double m_range_hi { 0.0 };
+};
+
+}  // namespace QIM
+
+#endif  // QIMHEATMAPPYRAMID_H
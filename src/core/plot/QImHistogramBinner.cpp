@@ -0,0 +1,358 @@
+#include "QImHistogramBinner.h"
+#include "QImPlotDataSeriesView.h"
+#include "QImPlotMinMaxKernel.h"
+#include "QImPlotParallel.h"
+#include "implot.h"
+#include <algorithm>
+#include <cmath>
+
+namespace QIM
+{
+
+namespace
+{
+// 每个分片至少的样本数，分片数与线程数无关
+constexpr qint64 kParallelGrainSamples = 1 << 20;
+constexpr qint64 kMaxSlices            = 64;
+// 各分片局部计数的槽位总数上限（32 MiB），箱数很多时减少分片
+constexpr qint64 kMaxLocalSlots = 1 << 22;
+
+qint64 sliceCount(qint64 n, qint64 slotsPerSlice)
+{
+    const qint64 slices = std::clamp< qint64 >(n / kParallelGrainSamples, 1, kMaxSlices);
+    return std::max< qint64 >(1, std::min(slices, kMaxLocalSlots / slotsPerSlice));
+}
+
+// 分片并行的最小/最大值，按分片顺序合并，相等时保留索引较小者
+template< typename View >
+QImPlotMinMaxIndex parallelMinMax(const View& view, qint64 first, qint64 last)
+{
+    const qint64 n      = last - first;
+    const qint64 slices = sliceCount(n, 1);
+    std::vector< QImPlotMinMaxIndex > parts(static_cast< std::size_t >(slices));
+    qimPlotParallelFor(slices, 1, [ & ](qint64 begin, qint64 end) {
+        for (qint64 s = begin; s < end; ++s) {
+            parts[ s ] = qimPlotViewMinMax(view, first + n * s / slices, first + n * (s + 1) / slices);
+        }
+    });
+    QImPlotMinMaxIndex r;
+    for (const QImPlotMinMaxIndex& part : parts) {
+        detail::mergeMinMax(r, part, 0);
+    }
+    return r;
+}
+
+// 忽略 NaN 的样本标准差（n - 1），与 ImStdDev 一致
+template< typename View >
+double sampleStdDev(const View& view, qint64 first, qint64 last)
+{
+    double sum = 0.0;
+    qint64 n   = 0;
+    for (qint64 i = first; i < last; ++i) {
+        const double v = view.y(i);
+        if (!std::isnan(v)) {
+            sum += v;
+            ++n;
+        }
+    }
+    if (n < 2) {
+        return 0.0;
+    }
+    const double mean = sum / n;
+    double sq         = 0.0;
+    for (qint64 i = first; i < last; ++i) {
+        const double v = view.y(i);
+        if (!std::isnan(v)) {
+            sq += (v - mean) * (v - mean);
+        }
+    }
+    return std::sqrt(sq / (n - 1.0));
+}
+
+// ImPlotBin 自动方法的箱数，与 ImPlot::CalculateBins 一致
+template< typename View >
+int autoBinCount(const View& view, qint64 first, qint64 last, int method, double rangeSize)
+{
+    const double n = static_cast< double >(last - first);
+    double bins    = 1.0;
+    switch (method) {
+    case ImPlotBin_Sqrt:
+        bins = std::ceil(std::sqrt(n));
+        break;
+    case ImPlotBin_Sturges:
+        bins = std::ceil(1.0 + std::log2(n));
+        break;
+    case ImPlotBin_Rice:
+        bins = std::ceil(2.0 * std::cbrt(n));
+        break;
+    case ImPlotBin_Scott: {
+        const double width = 3.49 * sampleStdDev(view, first, last) / std::cbrt(n);
+        if (width > 0) {
+            bins = std::round(rangeSize / width);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    // 数据全部相等时 Scott 方法的箱宽为 0
+    if (!(bins >= 1.0)) {
+        return 1;
+    }
+    return static_cast< int >(std::min(bins, 1.0e6));
+}
+}  // namespace
+
+bool QImHistogramBinner::Settings::operator==(const Settings& other) const
+{
+    return bins == other.bins && rangeMin == other.rangeMin && rangeMax == other.rangeMax
+           && cumulative == other.cumulative && density == other.density && outliers == other.outliers;
+}
+
+bool QImHistogramBinner::Settings::operator!=(const Settings& other) const
+{
+    return !(*this == other);
+}
+
+void QImHistogramBinner::compute(const QImAbstractXYDataSeries& series, const Settings& settings)
+{
+    clear();
+    m_settings = settings;
+    append(series, 0);
+}
+
+void QImHistogramBinner::append(const QImAbstractXYDataSeries& series, qint64 first)
+{
+    const qint64 count = series.size();
+    first              = std::max< qint64 >(first, 0);
+    if (count <= first) {
+        return;
+    }
+    if (m_total > 0 && m_settings.bins < 0) {
+        // 自动方法的箱数取决于样本数，追加后沿用原箱数
+        m_exact = false;
+    }
+    qimPlotVisitXYSeries(series, [ & ](const auto& view) {
+        const QImPlotMinMaxIndex mm = parallelMinMax(view, first, count);
+        if (mm.minIdx >= 0) {
+            m_seenMin = m_hasSeen ? std::min(m_seenMin, mm.minValue) : mm.minValue;
+            m_seenMax = m_hasSeen ? std::max(m_seenMax, mm.maxValue) : mm.maxValue;
+            m_hasSeen = true;
+        }
+        if (m_bins == 0) {
+            if (!initGrid(view, first, count)) {
+                return;
+            }
+        } else if (m_settings.rangeMin == 0 && m_settings.rangeMax == 0) {
+            widenToSeen();
+        }
+        binValues(view, first, count);
+    });
+    m_total += count - first;
+    finish();
+}
+
+void QImHistogramBinner::clear()
+{
+    m_bins    = 0;
+    m_lower   = 0.0;
+    m_upper   = 0.0;
+    m_width   = 0.0;
+    m_below   = 0;
+    m_counted = 0;
+    m_total   = 0;
+    m_hasSeen = false;
+    m_seenMin = 0.0;
+    m_seenMax = 0.0;
+    m_exact   = true;
+    m_raw.clear();
+    m_centers.clear();
+    m_counts.clear();
+    m_maxCount = 0.0;
+}
+
+template< typename View >
+bool QImHistogramBinner::initGrid(const View& view, qint64 first, qint64 last)
+{
+    if (m_settings.bins == 0) {
+        return false;
+    }
+    double lower = m_settings.rangeMin;
+    double upper = m_settings.rangeMax;
+    if (lower == 0 && upper == 0) {
+        if (!m_hasSeen) {
+            // 至今全部为 NaN
+            return false;
+        }
+        lower = m_seenMin;
+        upper = m_seenMax;
+    }
+    const int bins =
+        (m_settings.bins > 0) ? m_settings.bins : autoBinCount(view, first, last, m_settings.bins, upper - lower);
+    setGrid(lower, upper, bins);
+    return true;
+}
+
+void QImHistogramBinner::widenToSeen()
+{
+    if (m_seenMin >= m_lower && m_seenMax <= m_upper) {
+        return;
+    }
+    if (m_width == 0) {
+        // 已计数的值全部等于 m_lower，在覆盖已见范围的新网格中重新定位，结果仍然精确
+        const qint64 counted = m_raw[ 0 ];
+        const double value   = m_lower;
+        setGrid(m_seenMin, m_seenMax, m_bins);
+        m_raw[ qimPlotUniformBinSlot(grid(), value) ] = counted;
+        return;
+    }
+    m_exact = false;
+    std::vector< qint64 > merged(m_raw.size());
+    // 每次加倍箱宽，旧箱恰好两两落入新箱；次数有上限，避免无穷大的值导致死循环
+    for (int k = 0; k < 64 && (m_seenMin < m_lower || m_seenMax > m_upper); ++k) {
+        std::fill(merged.begin(), merged.end(), 0);
+        m_width *= 2.0;
+        if (m_seenMax > m_upper) {
+            // 保持下边界，向上扩展
+            for (int b = 0; b < m_bins; ++b) {
+                merged[ b / 2 ] += m_raw[ b ];
+            }
+            m_upper = m_lower + m_width * m_bins;
+        } else {
+            // 保持上边界，向下扩展
+            for (int b = 0; b < m_bins; ++b) {
+                merged[ (m_bins + b) / 2 ] += m_raw[ b ];
+            }
+            m_lower = m_upper - m_width * m_bins;
+        }
+        m_raw.swap(merged);
+    }
+}
+
+template< typename View >
+void QImHistogramBinner::binValues(const View& view, qint64 first, qint64 last)
+{
+    const QImPlotUniformBins bins = grid();
+    const qint64 slots            = m_bins + 2;
+    const qint64 n                = last - first;
+    const qint64 slices           = sliceCount(n, slots);
+    // 每个分片计入自己的局部计数，全部完成后合并
+    std::vector< qint64 > local(static_cast< std::size_t >(slices * slots), 0);
+    qimPlotParallelFor(slices, 1, [ & ](qint64 begin, qint64 end) {
+        for (qint64 s = begin; s < end; ++s) {
+            qimPlotViewBinUniform(
+                view, first + n * s / slices, first + n * (s + 1) / slices, bins, local.data() + s * slots);
+        }
+    });
+    for (qint64 s = 0; s < slices; ++s) {
+        const qint64* part = local.data() + s * slots;
+        for (int b = 0; b < m_bins; ++b) {
+            m_raw[ b ] += part[ b ];
+            m_counted += part[ b ];
+        }
+        m_below += part[ m_bins ];
+    }
+}
+
+void QImHistogramBinner::setGrid(double lower, double upper, int bins)
+{
+    m_bins  = bins;
+    m_lower = lower;
+    m_upper = upper;
+    m_width = (upper - lower) / bins;
+    m_raw.assign(static_cast< std::size_t >(bins), 0);
+}
+
+QImPlotUniformBins QImHistogramBinner::grid() const
+{
+    QImPlotUniformBins bins;
+    bins.lower = m_lower;
+    bins.upper = m_upper;
+    bins.width = m_width;
+    bins.count = m_bins;
+    return bins;
+}
+
+void QImHistogramBinner::finish()
+{
+    m_centers.resize(static_cast< std::size_t >(m_bins));
+    m_counts.resize(static_cast< std::size_t >(m_bins));
+    m_maxCount = 0.0;
+    if (m_bins == 0) {
+        return;
+    }
+    for (int b = 0; b < m_bins; ++b) {
+        m_centers[ b ] = m_lower + b * m_width + m_width * 0.5;
+        m_counts[ b ]  = static_cast< double >(m_raw[ b ]);
+        m_maxCount     = std::max(m_maxCount, m_counts[ b ]);
+    }
+    const double samples = static_cast< double >(m_settings.outliers ? m_total : m_counted);
+    if (m_settings.cumulative) {
+        if (m_settings.outliers) {
+            m_counts[ 0 ] += static_cast< double >(m_below);
+        }
+        for (int b = 1; b < m_bins; ++b) {
+            m_counts[ b ] += m_counts[ b - 1 ];
+        }
+        if (m_settings.density) {
+            const double scale = 1.0 / samples;
+            for (double& c : m_counts) {
+                c *= scale;
+            }
+        }
+        m_maxCount = m_counts.back();
+    } else if (m_settings.density) {
+        const double scale = 1.0 / (samples * m_width);
+        for (double& c : m_counts) {
+            c *= scale;
+        }
+        m_maxCount *= scale;
+    }
+}
+
+const QImHistogramBinner::Settings& QImHistogramBinner::settings() const
+{
+    return m_settings;
+}
+
+int QImHistogramBinner::binCount() const
+{
+    return m_bins;
+}
+
+double QImHistogramBinner::binWidth() const
+{
+    return m_width;
+}
+
+double QImHistogramBinner::lowerBound() const
+{
+    return m_lower;
+}
+
+double QImHistogramBinner::maxCount() const
+{
+    return m_maxCount;
+}
+
+const std::vector< double >& QImHistogramBinner::binCenters() const
+{
+    return m_centers;
+}
+
+const std::vector< double >& QImHistogramBinner::binCounts() const
+{
+    return m_counts;
+}
+
+qint64 QImHistogramBinner::sampleCount() const
+{
+    return m_total;
+}
+
+bool QImHistogramBinner::isExact() const
+{
+    return m_exact;
+}
+
+}  // namespace QIM
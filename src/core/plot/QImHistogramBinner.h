@@ -0,0 +1,143 @@
+#ifndef QIMHISTOGRAMBINNER_H
+#define QIMHISTOGRAMBINNER_H
+
+#include "QImPlotDataSeries.h"
+#include "QImPlotHistogramKernel.h"
+#include <vector>
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief Bin edges and counts of the Y values of a series, cached between frames
+ *
+ * @class QImHistogramBinner
+ *
+ * @details Computes the same histogram as ImPlot::PlotHistogram(): automatic range from the data when
+ *          the range is 0/0, bin count or ImPlotBin method (Sqrt, Sturges, Rice, Scott), values outside
+ *          the range skipped, optional cumulative and density normalization, the outliers flag. The
+ *          result is kept until compute() is called again, so an item can draw the bars every frame at
+ *          O(bins) and only rebin when the data or the settings change.
+ *
+ *          Unlike PlotHistogram() the sample count is not limited to INT_MAX, NaN values are ignored by
+ *          the automatic range and the Scott method, and any series layout (chunked, strided, ring
+ *          buffer) is read in place without gathering the values.
+ *
+ *          Binning is split into slices of the samples that are counted in parallel
+ *          (qimPlotParallelFor()) into local bins and merged at the end; packed double/float values
+ *          compute their bin indices with SIMD (qimPlotViewBinUniform()).
+ *
+ *          append() bins only the values added to a growing series since the last call. A running
+ *          minimum/maximum of all values seen is kept: with the automatic range, values beyond the
+ *          current bins widen the range by doubling the bin width and merging neighbouring bins, so the
+ *          history is never read again. The bin count of an ImPlotBin method is kept from the first
+ *          binning. In these two cases the result is an approximation of compute() over all values,
+ *          reported by isExact(); with a fixed range and bin count append() is exact.
+ * @see QImPlotHistogramItemNode
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 数据系列 Y 值的分箱边界与计数，跨帧缓存
+ *
+ * @class QImHistogramBinner
+ *
+ * @details 计算结果与 ImPlot::PlotHistogram() 相同：范围为 0/0 时取数据范围，箱数或 ImPlotBin 自动方法
+ *          （Sqrt、Sturges、Rice、Scott），跳过范围外的值，可选累积与密度归一化，以及异常值标志。
+ *          结果保留到下一次 compute()，绘图项每帧以 O(bins) 绘制柱条，只在数据或设置变化时重新分箱。
+ *
+ *          与 PlotHistogram() 不同，样本数不受 INT_MAX 限制，自动范围与 Scott 方法忽略 NaN，
+ *          任意存储布局（分块、带步长、环形缓冲）的数据都原地读取，无需收集到连续缓冲。
+ *
+ *          样本被划分为若干分片，并行（qimPlotParallelFor()）计入各自的局部计数后再合并；
+ *          紧凑存储的 double/float 数据以 SIMD 计算箱索引（qimPlotViewBinUniform()）。
+ *
+ *          append() 只对增长的数据系列中上次之后新增的值分箱。内部维护全部已见值的运行最小/最大值：
+ *          自动范围下超出当前箱范围的值使箱宽加倍、相邻箱合并，从而扩大范围，无需重新读取历史数据。
+ *          ImPlotBin 自动方法的箱数保持第一次分箱的结果。这两种情况下的结果是对全部值调用 compute()
+ *          的近似，由 isExact() 报告；范围与箱数固定时 append() 的结果是精确的。
+ * @see QImPlotHistogramItemNode
+ * \endif
+ */
+class QIM_CORE_API QImHistogramBinner
+{
+public:
+    // 分箱设置，与 ImPlot::PlotHistogram 的参数对应
+    struct Settings
+    {
+        int bins { -2 };          ///< 正数为箱数，负数为 ImPlotBin 自动方法，默认 Sturges
+        double rangeMin { 0.0 };  ///< 与 rangeMax 均为 0 时使用数据范围
+        double rangeMax { 0.0 };
+        bool cumulative { false };
+        bool density { false };
+        bool outliers { true };  ///< 密度与累积计数是否计入范围外的样本
+
+        bool operator==(const Settings& other) const;
+        bool operator!=(const Settings& other) const;
+    };
+
+    QImHistogramBinner()  = default;
+    ~QImHistogramBinner() = default;
+
+    // 按 settings 对 series 的 Y 值重新分箱
+    void compute(const QImAbstractXYDataSeries& series, const Settings& settings);
+    // 把 series 中 [first, size()) 的值计入已有结果，first 之前的值不再读取
+    void append(const QImAbstractXYDataSeries& series, qint64 first);
+    // 丢弃结果
+    void clear();
+
+    // 上一次 compute() 使用的设置
+    const Settings& settings() const;
+    // 箱数，没有结果时为 0
+    int binCount() const;
+    // 箱宽
+    double binWidth() const;
+    // 分箱范围的下边界
+    double lowerBound() const;
+    // 最大的箱值（累积时为最后一个箱）
+    double maxCount() const;
+    // 箱中心与箱值（按设置做了累积/密度归一化），各 binCount() 个
+    const std::vector< double >& binCenters() const;
+    const std::vector< double >& binCounts() const;
+    // 参与分箱的样本总数（含范围外与 NaN）
+    qint64 sampleCount() const;
+    // 结果是否与对全部样本调用 compute() 相同，append() 扩大自动范围或沿用自动箱数后为 false
+    bool isExact() const;
+
+private:
+    // 由全部已见值的范围建立分箱网格，无法建立时返回 false
+    template< typename View >
+    bool initGrid(const View& view, qint64 first, qint64 last);
+    // 自动范围下加倍箱宽直到覆盖全部已见值
+    void widenToSeen();
+    // 并行地把 [first, last) 计入原始计数
+    template< typename View >
+    void binValues(const View& view, qint64 first, qint64 last);
+    void setGrid(double lower, double upper, int bins);
+    QImPlotUniformBins grid() const;
+    // 由原始计数按累积/密度设置得到 binCounts()
+    void finish();
+
+private:
+    Settings m_settings;
+    int m_bins { 0 };
+    double m_lower { 0.0 };
+    double m_upper { 0.0 };
+    double m_width { 0.0 };
+    std::vector< qint64 > m_raw;  ///< 每个箱的原始计数
+    qint64 m_below { 0 };         ///< 低于范围的样本数
+    qint64 m_counted { 0 };       ///< 落在范围内的样本数
+    qint64 m_total { 0 };
+    // 全部已见值（不含 NaN）的运行最小/最大值
+    bool m_hasSeen { false };
+    double m_seenMin { 0.0 };
+    double m_seenMax { 0.0 };
+    bool m_exact { true };
+    std::vector< double > m_centers;
+    std::vector< double > m_counts;
+    double m_maxCount { 0.0 };
+};
+
+}  // namespace QIM
+
+#endif  // QIMHISTOGRAMBINNER_H
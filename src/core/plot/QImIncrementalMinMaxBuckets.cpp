@@ -0,0 +1,139 @@
+#include "QImIncrementalMinMaxBuckets.h"
+#include <algorithm>
+
+namespace QIM
+{
+
+namespace
+{
+// 合并两个桶的极值，相等时保留索引较小的点
+void mergeInto(QImIncrementalMinMaxBuckets::Bucket& a, const QImIncrementalMinMaxBuckets::Bucket& b)
+{
+    if (b.minIdx < 0) {
+        return;
+    }
+    if (a.minIdx < 0) {
+        a = b;
+        return;
+    }
+    if (b.minY < a.minY) {
+        a.minY   = b.minY;
+        a.minIdx = b.minIdx;
+    }
+    if (b.maxY > a.maxY) {
+        a.maxY   = b.maxY;
+        a.maxIdx = b.maxIdx;
+    }
+}
+}  // namespace
+
+QImIncrementalMinMaxBuckets::QImIncrementalMinMaxBuckets(int maxBuckets)
+{
+    setMaxBuckets(maxBuckets);
+}
+
+void QImIncrementalMinMaxBuckets::reset()
+{
+    m_width = 1;
+    m_count = 0;
+    m_buckets.clear();
+    m_tail = Bucket();
+}
+
+void QImIncrementalMinMaxBuckets::setMaxBuckets(int count)
+{
+    // 合并要求完整桶的数量为偶数
+    m_maxBuckets = std::max(2, count & ~1);
+    m_buckets.reserve(m_maxBuckets);
+}
+
+int QImIncrementalMinMaxBuckets::maxBuckets() const
+{
+    return m_maxBuckets;
+}
+
+qint64 QImIncrementalMinMaxBuckets::count() const
+{
+    return m_count;
+}
+
+qint64 QImIncrementalMinMaxBuckets::bucketWidth() const
+{
+    return m_width;
+}
+
+const std::vector< QImIncrementalMinMaxBuckets::Bucket >& QImIncrementalMinMaxBuckets::buckets() const
+{
+    return m_buckets;
+}
+
+/**
+ * @brief 把 [m_count, last) 的极值并入尾桶，尾桶填满后成为完整的桶
+ */
+void QImIncrementalMinMaxBuckets::addRange(const QImPlotMinMaxIndex& mm, qint64 last)
+{
+    if (mm.minIdx >= 0) {
+        Bucket part;
+        part.minIdx = mm.minIdx;
+        part.maxIdx = mm.maxIdx;
+        part.minY   = mm.minValue;
+        part.maxY   = mm.maxValue;
+        mergeInto(m_tail, part);
+    }
+    m_count = last;
+    if (m_count == static_cast< qint64 >(m_buckets.size() + 1) * m_width) {
+        m_buckets.push_back(m_tail);
+        m_tail = Bucket();
+        if (static_cast< int >(m_buckets.size()) >= m_maxBuckets) {
+            mergeBuckets();
+        }
+    }
+}
+
+/**
+ * @brief 桶宽加倍，相邻的两个桶原地合并（完整桶的数量为偶数，合并后尾桶的起点仍然对齐）
+ */
+void QImIncrementalMinMaxBuckets::mergeBuckets()
+{
+    const std::size_t half = m_buckets.size() / 2;
+    for (std::size_t i = 0; i < half; ++i) {
+        Bucket merged = m_buckets[ 2 * i ];
+        mergeInto(merged, m_buckets[ 2 * i + 1 ]);
+        m_buckets[ i ] = merged;
+    }
+    m_buckets.resize(half);
+    m_width *= 2;
+}
+
+void QImIncrementalMinMaxBuckets::retainedIndices(std::vector< qint64 >& out) const
+{
+    out.clear();
+    if (m_count <= 0) {
+        return;
+    }
+    out.reserve(m_buckets.size() * 2 + 4);
+    out.push_back(0);
+    auto addBucket = [ &out ](const Bucket& b) {
+        if (b.minIdx < 0) {
+            return;  // 整个桶都是NaN
+        }
+        // 桶内按索引顺序输出最小值与最大值
+        const qint64 first = std::min(b.minIdx, b.maxIdx);
+        const qint64 last  = std::max(b.minIdx, b.maxIdx);
+        if (first != out.back()) {
+            out.push_back(first);
+        }
+        if (last != out.back()) {
+            out.push_back(last);
+        }
+    };
+    for (const Bucket& b : m_buckets) {
+        addBucket(b);
+    }
+    addBucket(m_tail);
+    if (m_count - 1 != out.back()) {
+        out.push_back(m_count - 1);
+    }
+}
+
+}  // namespace QIM
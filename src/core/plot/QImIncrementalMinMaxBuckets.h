@@ -0,0 +1,100 @@
+#ifndef QIMINCREMENTALMINMAXBUCKETS_H
+#define QIMINCREMENTALMINMAXBUCKETS_H
+
+#include "QImAPI.h"
+#include "QImPlotMinMaxKernel.h"
+#include <vector>
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief Min/max buckets of an append-only sample stream, updated in time proportional to the new samples
+ *
+ * @class QImIncrementalMinMaxBuckets
+ *
+ * @details Samples are grouped into buckets of bucketWidth() consecutive indices. Each bucket keeps the
+ *          minimum and maximum Y and their indices; the last, partially filled bucket is updated as
+ *          samples arrive. When maxBuckets() buckets are complete the width doubles and adjacent
+ *          buckets merge in place, which is exact for min/max, so a stream of any length retains
+ *          at most 2 * maxBuckets() + 2 points.
+ *
+ *          The container stores indices only; append() reads new samples through a typed view and
+ *          the caller maps the indices from retainedIndices() back to X/Y values. A source whose
+ *          old samples move (ring buffer eviction) must be reset().
+ * @see QImMinMaxLTTBDownsampler::setIncrementalMode(), QImMultiChannelMinMaxDownsampler::sourceAppended()
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 只追加数据流的最大/最小值分桶，更新代价与新增点数成正比
+ *
+ * @class QImIncrementalMinMaxBuckets
+ *
+ * @details 每 bucketWidth() 个连续索引为一个桶，记录桶内 Y 的最小值、最大值及其索引；
+ *          最后一个未满的桶随新数据更新。完整的桶达到 maxBuckets() 个时桶宽加倍，相邻的桶原地合并
+ *          （对最大/最小值是精确的），因此任意长度的数据流最多保留 2 * maxBuckets() + 2 个点。
+ *
+ *          只保存索引：append() 通过类型化视图读取新增的点，调用者把 retainedIndices()
+ *          返回的索引映射回 X/Y 值。旧数据会移动的数据源（环形缓冲淘汰）需要 reset()。
+ * @see QImMinMaxLTTBDownsampler::setIncrementalMode(), QImMultiChannelMinMaxDownsampler::sourceAppended()
+ * \endif
+ */
+class QIM_CORE_API QImIncrementalMinMaxBuckets
+{
+public:
+    // 一个桶的极值，索引为 -1 表示桶内全部为 NaN
+    struct Bucket
+    {
+        qint64 minIdx { -1 };
+        qint64 maxIdx { -1 };
+        double minY { 0.0 };
+        double maxY { 0.0 };
+    };
+
+    explicit QImIncrementalMinMaxBuckets(int maxBuckets = 1000);
+
+    // 丢弃全部桶，从索引 0 重新开始
+    void reset();
+    // 完整桶的数量上限（取偶数，最小 2），修改后需要 reset()
+    void setMaxBuckets(int count);
+    int maxBuckets() const;
+
+    // 已处理的点数
+    qint64 count() const;
+    qint64 bucketWidth() const;
+    const std::vector< Bucket >& buckets() const;
+
+    // 处理视图中 [count(), end) 的新增点，视图的逻辑索引必须与之前处理的点一致
+    template< typename View >
+    void append(const View& view, qint64 end);
+
+    // 保留的点的索引（首点、各桶的最小/最大值、尾点），按索引递增、去重，替换 out 的内容
+    void retainedIndices(std::vector< qint64 >& out) const;
+
+private:
+    void addRange(const QImPlotMinMaxIndex& mm, qint64 last);
+    void mergeBuckets();
+
+private:
+    int m_maxBuckets { 1000 };
+    qint64 m_width { 1 };
+    qint64 m_count { 0 };
+    std::vector< Bucket > m_buckets;
+    Bucket m_tail;  ///< 未满的最后一个桶
+};
+
+template< typename View >
+inline void QImIncrementalMinMaxBuckets::append(const View& view, qint64 end)
+{
+    while (m_count < end) {
+        // 每次最多填满当前的尾桶，区间内的极值由 SIMD 内核计算
+        const qint64 tailStart = static_cast< qint64 >(m_buckets.size()) * m_width;
+        const qint64 last      = std::min(end, tailStart + m_width);
+        addRange(qimPlotViewMinMax(view, m_count, last), last);
+    }
+}
+
+}  // namespace QIM
+
+#endif  // QIMINCREMENTALMINMAXBUCKETS_H
@@ -1,4 +1,5 @@
 ﻿#include "QImLTTBDownsampler.h"
+#include "QImPlotDataSeriesView.h"
 #include <algorithm>
 #include <cmath>
 #include <cassert>
@@ -14,10 +15,10 @@ QImLTTBDownsampler::QImLTTBDownsampler(QImAbstractXYDataSeries* source, int targ
 }
 
 
-int QImLTTBDownsampler::size() const
+qint64 QImLTTBDownsampler::size() const
 {
     // 优先返回下采样数据大小，若未下采样则返回原始数据大小
-    return m_cached_valid ? static_cast< int >(m_cached_x.size()) : (m_source ? m_source->size() : 0);
+    return m_cached_valid ? static_cast< qint64 >(m_cached_x.size()) : (m_source ? m_source->size() : 0);
 }
 
 bool QImLTTBDownsampler::isContiguous() const
@@ -27,8 +28,19 @@ bool QImLTTBDownsampler::isContiguous() const
 
 int QImLTTBDownsampler::stride() const
 {
-    // 连续内存步幅固定为double大小
-    return sizeof(double);
+    // 下采样缓存步幅固定为double大小，透传时使用原始数据的步幅
+    if (m_cached_valid || !m_source) {
+        return sizeof(double);
+    }
+    return m_source->stride();
+}
+
+int QImLTTBDownsampler::xStride() const
+{
+    if (m_cached_valid || !m_source) {
+        return sizeof(double);
+    }
+    return m_source->xStride();
 }
 
 const double* QImLTTBDownsampler::xRawData() const
@@ -48,6 +60,44 @@ const double* QImLTTBDownsampler::yRawData() const
     return m_source ? m_source->yRawData() : nullptr;
 }
 
+QImPlotValueType QImLTTBDownsampler::xValueType() const
+{
+    return (m_cached_valid || !m_source) ? QImPlotValueType::Double : m_source->xValueType();
+}
+
+QImPlotValueType QImLTTBDownsampler::yValueType() const
+{
+    return (m_cached_valid || !m_source) ? QImPlotValueType::Double : m_source->yValueType();
+}
+
+const void* QImLTTBDownsampler::xRawPointer() const
+{
+    if (m_cached_valid) {
+        return m_cached_x.data();
+    }
+    return m_source ? m_source->xRawPointer() : nullptr;
+}
+
+const void* QImLTTBDownsampler::yRawPointer() const
+{
+    if (m_cached_valid) {
+        return m_cached_y.data();
+    }
+    return m_source ? m_source->yRawPointer() : nullptr;
+}
+
+bool QImLTTBDownsampler::chunkLayout(QImPlotChunkLayout& layout) const
+{
+    // 透传分块数据的布局，缓存总是连续的
+    return !m_cached_valid && m_source && m_source->chunkLayout(layout);
+}
+
+QImPlotDataBounds QImLTTBDownsampler::bounds() const
+{
+    // 降采样结果可能丢掉极值点，坐标轴自适应使用原始数据的范围
+    return m_source ? m_source->bounds() : QImPlotDataBounds();
+}
+
 double QImLTTBDownsampler::xScale() const
 {
     return m_source->xScale();
@@ -58,9 +108,10 @@ double QImLTTBDownsampler::xStart() const
     return m_source->xStart();
 }
 
-int QImLTTBDownsampler::offset() const
+qint64 QImLTTBDownsampler::offset() const
 {
-    return m_source->offset();
+    // 下采样缓存按逻辑顺序存储，不再需要偏移
+    return m_cached_valid ? 0 : m_source->offset();
 }
 
 void QImLTTBDownsampler::setTargetPoints(int points)
@@ -79,7 +130,7 @@ int QImLTTBDownsampler::targetPoints() const
     return m_target_points;
 }
 
-double QImLTTBDownsampler::xValue(int index) const
+double QImLTTBDownsampler::xValue(qint64 index) const
 {
     if (!m_cached_valid) {
         return m_source ? m_source->xValue(index) : std::numeric_limits< double >::quiet_NaN();
@@ -87,7 +138,7 @@ double QImLTTBDownsampler::xValue(int index) const
     return m_cached_x[ index ];
 }
 
-double QImLTTBDownsampler::yValue(int index) const
+double QImLTTBDownsampler::yValue(qint64 index) const
 {
     if (!m_cached_valid) {
         return m_source ? m_source->yValue(index) : std::numeric_limits< double >::quiet_NaN();
@@ -106,7 +157,7 @@ void QImLTTBDownsampler::downSampler()
         return;
     }
 
-    const int source_size = m_source->size();
+    const qint64 source_size = m_source->size();
     // 原始数据量 ≤ 目标点数 → 直接透传，不下采样
     if (source_size <= m_target_points || source_size < 3) {
         m_cached_valid = false;
@@ -114,28 +165,46 @@ void QImLTTBDownsampler::downSampler()
     }
 
     // 对全量数据执行LTTB下采样
-    lttb(m_source->xRawData(), m_source->yRawData(), 0, source_size, m_target_points);
+    lttb(0, source_size, m_target_points);
     m_cached_valid = true;
 }
 
 
 // ===== 辅助：查找可见范围（二分查找优化）=====
-std::pair< int, int > QImLTTBDownsampler::findVisibleRange(double x_min, double x_max) const
+std::pair< qint64, qint64 > QImLTTBDownsampler::findVisibleRange(double x_min, double x_max) const
 {
-    const int total_size = m_source->size();
+    const qint64 total_size = m_source->size();
     if (total_size == 0)
         return { 0, 0 };
 
     // 处理Y-only模式：X坐标可计算
-    if (const double* x_ptr = m_source->xRawData()) {
-        // XY模式：二分查找
-        auto x_begin = x_ptr;
-        auto x_end   = x_ptr + total_size;
-
-        int start_idx = std::lower_bound(x_begin, x_end, x_min) - x_begin;
-        int end_idx   = std::upper_bound(x_begin, x_end, x_max) - x_begin;
+    if (m_source->xRawPointer()) {
+        // XY模式：二分查找（按逻辑索引访问，兼容任意存储类型）
+        qint64 start_idx = 0, end_idx = total_size;
+        {
+            qint64 lo = 0, hi = total_size;
+            while (lo < hi) {
+                const qint64 mid = lo + (hi - lo) / 2;
+                if (m_source->xValue(mid) < x_min) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            start_idx = lo;
+            hi        = total_size;
+            while (lo < hi) {
+                const qint64 mid = lo + (hi - lo) / 2;
+                if (m_source->xValue(mid) <= x_max) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            end_idx = lo;
+        }
 
-        return { std::max(0, start_idx), std::min(total_size, end_idx) };
+        return { start_idx, std::min(total_size, end_idx) };
     } else {
         // Y-only模式：直接计算索引范围
         const double x_start = m_source->xStart();
@@ -144,54 +213,40 @@ std::pair< int, int > QImLTTBDownsampler::findVisibleRange(double x_min, double
         if (x_scale == 0)
             return { 0, total_size };  // 退化情况
 
-        int start_idx = static_cast< int >(std::floor((x_min - x_start) / x_scale));
-        int end_idx   = static_cast< int >(std::ceil((x_max - x_start) / x_scale)) + 1;
+        // 先在 double 中截断，避免超出 qint64 范围
+        const double last   = static_cast< double >(total_size);
+        const double first  = std::clamp(std::floor((x_min - x_start) / x_scale), 0.0, last);
+        const double beyond = std::clamp(std::ceil((x_max - x_start) / x_scale) + 1, 0.0, last);
 
-        return { std::max(0, start_idx), std::min(total_size, end_idx) };
+        return { static_cast< qint64 >(first), static_cast< qint64 >(beyond) };
     }
 }
 
 
 // ===== LTTB核心算法（O(n)）=====
-void QImLTTBDownsampler::lttb(const double* x_data, const double* y_data, int start_idx, int end_idx, int target_points)
+namespace
 {
-    // 前置校验：输入参数合法性
-    if (!m_source || !y_data)
-        return;
-    const int n = end_idx - start_idx;
-    if (n <= 0 || target_points < 3 || start_idx < 0 || end_idx > m_source->size()) {
-        m_cached_x.clear();
-        m_cached_y.clear();
-        return;
-    }
-
+template< typename View >
+void lttbKernel(const View& view,
+                qint64 start_idx,
+                qint64 end_idx,
+                int target_points,
+                std::vector< double >& out_x,
+                std::vector< double >& out_y)
+{
+    const qint64 n = end_idx - start_idx;
     // 预分配缓存
-    m_cached_x.reserve(target_points);
-    m_cached_y.reserve(target_points);
+    out_x.reserve(target_points);
+    out_y.reserve(target_points);
 
-    // 辅助lambda：安全获取X坐标（兼容Y-only模式）
-    auto getX = [ this, x_data, start_idx ](int local_idx) -> double {
-        if (local_idx < 0 || local_idx >= (m_source->size() - start_idx)) {
-            return std::numeric_limits< double >::quiet_NaN();
-        }
-        // XY模式：直接取X数组
-        if (x_data) {
-            return x_data[ start_idx + local_idx ];
-        }
-        // Y-only模式：计算X坐标（防护除0）
-        const double x_scale = m_source->xScale();
-        if (std::fabs(x_scale) < 1e-12) {
-            return m_source->xStart();
-        }
-        return m_source->xStart() + (start_idx + local_idx) * x_scale;
-    };
-
-    // 辅助lambda：安全获取Y坐标
-    auto getY = [ y_data, start_idx ](int local_idx) -> double { return y_data[ start_idx + local_idx ]; };
+    // 辅助lambda：获取X坐标（兼容Y-only模式，视图内部处理offset与存储类型）
+    auto getX = [ &view, start_idx ](qint64 local_idx) -> double { return view.x(start_idx + local_idx); };
+    // 辅助lambda：获取Y坐标
+    auto getY = [ &view, start_idx ](qint64 local_idx) -> double { return view.y(start_idx + local_idx); };
 
     // 1. 保留第一个点
-    m_cached_x.push_back(getX(0));
-    m_cached_y.push_back(getY(0));
+    out_x.push_back(getX(0));
+    out_y.push_back(getY(0));
 
     // 2. 中间点：LTTB核心（最大三角形面积采样）
     const double avg_bucket_size = static_cast< double >(n - 2) / (target_points - 2);
@@ -202,9 +257,9 @@ void QImLTTBDownsampler::lttb(const double* x_data, const double* y_data, int st
         double bucket_right =
             (i == target_points - 2) ? (n - 1) : std::min(bucket_left + avg_bucket_size, static_cast< double >(n - 1));
 
-        const int bucket_start = static_cast< int >(std::floor(bucket_left));
-        const int bucket_end   = static_cast< int >(std::ceil(bucket_right)) + 1;
-        const int bucket_size  = bucket_end - bucket_start;
+        const qint64 bucket_start = static_cast< qint64 >(std::floor(bucket_left));
+        const qint64 bucket_end   = static_cast< qint64 >(std::ceil(bucket_right)) + 1;
+        const qint64 bucket_size  = bucket_end - bucket_start;
 
         if (bucket_size <= 0 || bucket_start >= n) {
             continue;  // 空桶跳过，避免崩溃
@@ -213,7 +268,7 @@ void QImLTTBDownsampler::lttb(const double* x_data, const double* y_data, int st
         // 计算桶内平均点（三角形第三点）
         double avg_x = 0.0, avg_y = 0.0;
         int valid_count = 0;
-        for (int j = bucket_start; j < bucket_end && j < n; ++j) {
+        for (qint64 j = bucket_start; j < bucket_end && j < n; ++j) {
             double x = getX(j);
             double y = getY(j);
             if (std::isnan(x) || std::isnan(y))
@@ -232,11 +287,11 @@ void QImLTTBDownsampler::lttb(const double* x_data, const double* y_data, int st
 
         // 寻找桶内最大三角形面积的点
         double max_area     = -1.0;
-        int max_idx         = bucket_start;
-        const double last_x = m_cached_x.back();
-        const double last_y = m_cached_y.back();
+        qint64 max_idx      = bucket_start;
+        const double last_x = out_x.back();
+        const double last_y = out_y.back();
 
-        for (int j = bucket_start; j < bucket_end && j < n; ++j) {
+        for (qint64 j = bucket_start; j < bucket_end && j < n; ++j) {
             const double curr_x = getX(j);
             const double curr_y = getY(j);
             if (std::isnan(curr_x) || std::isnan(curr_y))
@@ -252,14 +307,33 @@ void QImLTTBDownsampler::lttb(const double* x_data, const double* y_data, int st
         }
 
         // 添加最大面积点到缓存
-        m_cached_x.push_back(getX(max_idx));
-        m_cached_y.push_back(getY(max_idx));
+        out_x.push_back(getX(max_idx));
+        out_y.push_back(getY(max_idx));
         bucket_left = bucket_right + 1;
     }
 
     // 3. 保留最后一个点
-    m_cached_x.push_back(getX(n - 1));
-    m_cached_y.push_back(getY(n - 1));
+    out_x.push_back(getX(n - 1));
+    out_y.push_back(getY(n - 1));
+}
+}  // namespace
+
+void QImLTTBDownsampler::lttb(qint64 start_idx, qint64 end_idx, int target_points)
+{
+    // 前置校验：输入参数合法性
+    if (!m_source)
+        return;
+    const qint64 n = end_idx - start_idx;
+    if (n <= 0 || target_points < 3 || start_idx < 0 || end_idx > m_source->size()) {
+        m_cached_x.clear();
+        m_cached_y.clear();
+        return;
+    }
+
+    // 按存储类型分派一次，内层循环没有虚函数调用
+    qimPlotVisitXYSeries(*m_source, [ & ](const auto& view) {
+        lttbKernel(view, start_idx, end_idx, target_points, m_cached_x, m_cached_y);
+    });
 }
 
 }  // namespace QIM
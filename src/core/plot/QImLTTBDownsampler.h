@@ -36,35 +36,44 @@ public:
         return XYData;
     }  // 代理后总是XY模式
 
-    int size() const override;
+    qint64 size() const override;
 
     bool isContiguous() const override;  // 缓存数据总是连续
 
     int stride() const override;
+    int xStride() const override;
 
     const double* xRawData() const override;
 
     const double* yRawData() const override;
 
+    // 未下采样时透传原始数据的存储类型，下采样缓存总是double
+    QImPlotValueType xValueType() const override;
+    QImPlotValueType yValueType() const override;
+    const void* xRawPointer() const override;
+    const void* yRawPointer() const override;
+    bool chunkLayout(QImPlotChunkLayout& layout) const override;
+    QImPlotDataBounds bounds() const override;
+
     // 代理后不再支持Y-only模式（下采样破坏等间隔假设），返回默认值
     double xScale() const override;
     double xStart() const override;
-    int offset() const override;
+    qint64 offset() const override;
 
     // ===== 配置接口 =====
     void setTargetPoints(int points);
 
     int targetPoints() const;
 
-    virtual double xValue(int index) const override;
-    virtual double yValue(int index) const override;
+    virtual double xValue(qint64 index) const override;
+    virtual double yValue(qint64 index) const override;
     // 根据目标点数更新数据，这个函数在目标点数变化,或原数据发生变化是调用，用于更新
     void downSampler();
 
 private:
     // ===== 内部状态 =====
     QImAbstractXYDataSeries* m_source;  // 原始数据指针
-    int m_target_points;
+    int m_target_points { 0 };  // 由构造函数通过 setTargetPoints() 设置
     // 缓存状态
     mutable std::vector< double > m_cached_x;
     mutable std::vector< double > m_cached_y;
@@ -72,10 +81,10 @@ private:
 
 
     // 查找视图范围内的数据索引 [start_idx, end_idx)
-    std::pair< int, int > findVisibleRange(double x_min, double x_max) const;
+    std::pair< qint64, qint64 > findVisibleRange(double x_min, double x_max) const;
 
-    // LTTB核心算法（裁剪后数据段）
-    void lttb(const double* x_data, const double* y_data, int start_idx, int end_idx, int target_points);
+    // LTTB核心算法（裁剪后数据段），按原始数据的存储类型分派
+    void lttb(qint64 start_idx, qint64 end_idx, int target_points);
 };
 
 }  // namespace QIM
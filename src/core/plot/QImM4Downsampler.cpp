@@ -0,0 +1,381 @@
+#include "QImM4Downsampler.h"
+#include "QImPlotDataSeriesView.h"
+#include "QImPlotMinMaxKernel.h"
+#include "QImPlotParallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cassert>
+
+namespace QIM
+{
+
+namespace
+{
+// 每个任务至少处理的原始点数，太小的任务调度开销超过计算量
+constexpr qint64 kParallelGrainSamples = 1 << 16;
+// 每列最多输出的点数：首、最小、最大、尾
+constexpr int kSlotsPerColumn = 4;
+
+// [lo, hi) 中第一个 X >= value 的位置（要求 X 单调递增）
+template< typename View >
+qint64 lowerBoundX(const View& view, qint64 lo, qint64 hi, double value)
+{
+    while (lo < hi) {
+        const qint64 mid = lo + (hi - lo) / 2;
+        if (view.x(mid) < value) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+}  // namespace
+
+QImM4Downsampler::QImM4Downsampler(QImAbstractXYDataSeries* source, int pixel_width) : m_source(source)
+{
+    assert(source && "Source must not be null");
+    setPixelWidth(pixel_width);
+}
+
+qint64 QImM4Downsampler::size() const
+{
+    return m_cached_valid ? static_cast< qint64 >(m_cached_x.size()) : (m_source ? m_source->size() : 0);
+}
+
+bool QImM4Downsampler::isContiguous() const
+{
+    return m_cached_valid || (m_source && m_source->isContiguous());
+}
+
+int QImM4Downsampler::stride() const
+{
+    if (m_cached_valid || !m_source) {
+        return sizeof(double);
+    }
+    return m_source->stride();
+}
+
+int QImM4Downsampler::xStride() const
+{
+    if (m_cached_valid || !m_source) {
+        return sizeof(double);
+    }
+    return m_source->xStride();
+}
+
+const double* QImM4Downsampler::xRawData() const
+{
+    if (m_cached_valid) {
+        return m_cached_x.data();
+    }
+    return m_source ? m_source->xRawData() : nullptr;
+}
+
+const double* QImM4Downsampler::yRawData() const
+{
+    if (m_cached_valid) {
+        return m_cached_y.data();
+    }
+    return m_source ? m_source->yRawData() : nullptr;
+}
+
+QImPlotValueType QImM4Downsampler::xValueType() const
+{
+    return (m_cached_valid || !m_source) ? QImPlotValueType::Double : m_source->xValueType();
+}
+
+QImPlotValueType QImM4Downsampler::yValueType() const
+{
+    return (m_cached_valid || !m_source) ? QImPlotValueType::Double : m_source->yValueType();
+}
+
+const void* QImM4Downsampler::xRawPointer() const
+{
+    if (m_cached_valid) {
+        return m_cached_x.data();
+    }
+    return m_source ? m_source->xRawPointer() : nullptr;
+}
+
+const void* QImM4Downsampler::yRawPointer() const
+{
+    if (m_cached_valid) {
+        return m_cached_y.data();
+    }
+    return m_source ? m_source->yRawPointer() : nullptr;
+}
+
+bool QImM4Downsampler::chunkLayout(QImPlotChunkLayout& layout) const
+{
+    return !m_cached_valid && m_source && m_source->chunkLayout(layout);
+}
+
+QImPlotDataBounds QImM4Downsampler::bounds() const
+{
+    // M4 保留了每列的极值，但视图模式下只包含可见范围，坐标轴自适应仍使用原始数据的范围
+    return m_source ? m_source->bounds() : QImPlotDataBounds();
+}
+
+double QImM4Downsampler::xScale() const
+{
+    return m_source->xScale();
+}
+
+double QImM4Downsampler::xStart() const
+{
+    return m_source->xStart();
+}
+
+qint64 QImM4Downsampler::offset() const
+{
+    return m_cached_valid ? 0 : m_source->offset();
+}
+
+double QImM4Downsampler::xValue(qint64 index) const
+{
+    if (!m_cached_valid) {
+        return m_source ? m_source->xValue(index) : std::numeric_limits< double >::quiet_NaN();
+    }
+    return m_cached_x[ index ];
+}
+
+double QImM4Downsampler::yValue(qint64 index) const
+{
+    if (!m_cached_valid) {
+        return m_source ? m_source->yValue(index) : std::numeric_limits< double >::quiet_NaN();
+    }
+    return m_cached_y[ index ];
+}
+
+void QImM4Downsampler::setPixelWidth(int width)
+{
+    const int new_width = std::max(width, 16);
+    if (new_width != m_pixel_width) {
+        m_pixel_width = new_width;
+        downSampler();
+    }
+}
+
+int QImM4Downsampler::pixelWidth() const
+{
+    return m_pixel_width;
+}
+
+void QImM4Downsampler::downSampler()
+{
+    m_cached_x.clear();
+    m_cached_y.clear();
+    m_cached_valid  = false;
+    m_view_active   = false;
+    m_source_sorted = false;
+    m_sorted_count  = 0;
+
+    if (!m_source || m_source->size() <= 0) {
+        return;
+    }
+    const qint64 source_size = m_source->size();
+    m_source_sorted          = checkSourceSorted(0);
+    m_sorted_count           = source_size;
+    // 每列最多输出 4 个点，点数不超过时直接透传
+    if (source_size <= static_cast< qint64 >(m_pixel_width) * kSlotsPerColumn) {
+        return;
+    }
+    double x_min = 0.0;
+    double x_max = 0.0;
+    if (m_source_sorted) {
+        qimPlotVisitXYSeries(*m_source, [ & ](const auto& view) {
+            x_min = view.x(0);
+            x_max = view.x(source_size - 1);
+        });
+    }
+    m4(0, source_size, x_min, x_max, m_pixel_width);
+    m_cached_valid = true;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Splits [x_min, x_max] into pixel_width columns and keeps the M4 points of each
+ * @param x_min Left limit of the visible X range
+ * @param x_max Right limit of the visible X range
+ * @param pixel_width Width of the plot area in pixels
+ * @return true if the cache was rebuilt, false if the cached result was reused or the view cannot be used
+ * @details Cached by range, pixel width and source size. One sample on each side of the range is kept
+ *          so the curve reaches the plot edges; when no more than 4 * pixel_width samples are visible
+ *          they are copied as they are. Requires monotonically increasing X, otherwise the global
+ *          result is kept and false is returned.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 把 [x_min, x_max] 划分为 pixel_width 列，每列保留 M4 的四个点
+ * @param x_min 可见 X 范围的左边界
+ * @param x_max 可见 X 范围的右边界
+ * @param pixel_width 绘图区的像素宽度
+ * @return 重新计算了缓存返回 true；使用已有缓存或无法按视图采样时返回 false
+ * @details 结果按（范围, 像素宽度, 原始数据点数）缓存。范围两侧各多保留一个点，使曲线延伸到绘图区边缘；
+ *          可见点数不超过 4 * pixel_width 时原样拷贝。要求 X 单调递增，否则保持全量结果并返回 false。
+ * \endif
+ */
+bool QImM4Downsampler::setViewRange(double x_min, double x_max, int pixel_width)
+{
+    if (!m_source || !m_source_sorted || pixel_width <= 0 || !(x_min < x_max)) {
+        return false;
+    }
+    const qint64 source_size = m_source->size();
+    if (m_view_active && m_view_x_min == x_min && m_view_x_max == x_max && m_view_pixel_width == pixel_width
+        && m_view_source_size == source_size) {
+        return false;
+    }
+
+    qint64 start_idx = 0;
+    qint64 end_idx   = 0;
+    qimPlotVisitXYSeries(*m_source, [ & ](const auto& view) {
+        start_idx = lowerBoundX(view, 0, source_size, x_min);
+        end_idx   = lowerBoundX(view, start_idx, source_size, x_max);
+        // lowerBound 得到第一个 >= x_max 的点，正好是右侧多保留的一个点
+        start_idx = std::max< qint64 >(0, start_idx - 1);
+        end_idx   = std::min(source_size, end_idx + 1);
+    });
+
+    if (end_idx - start_idx > static_cast< qint64 >(pixel_width) * kSlotsPerColumn) {
+        m4(start_idx, end_idx, x_min, x_max, pixel_width);
+    } else {
+        m_cached_x.clear();
+        m_cached_y.clear();
+        qimPlotVisitXYSeries(*m_source, [ & ](const auto& view) {
+            for (qint64 i = start_idx; i < end_idx; ++i) {
+                m_cached_x.push_back(view.x(i));
+                m_cached_y.push_back(view.y(i));
+            }
+        });
+    }
+    m_cached_valid     = true;
+    m_view_active      = true;
+    m_view_x_min       = x_min;
+    m_view_x_max       = x_max;
+    m_view_pixel_width = pixel_width;
+    m_view_source_size = source_size;
+    return true;
+}
+
+void QImM4Downsampler::clearViewRange()
+{
+    if (m_view_active) {
+        downSampler();
+    }
+}
+
+void QImM4Downsampler::sourceAppended()
+{
+    if (!m_source) {
+        return;
+    }
+    const bool shifted = m_source->offset() != 0 || m_source->size() < m_sorted_count;
+    if (m_view_active) {
+        m_source_sorted = checkSourceSorted(shifted ? 0 : m_sorted_count);
+        m_sorted_count  = m_source->size();
+        if (m_source_sorted) {
+            // 清除缓存键使下一次 setViewRange() 重新采样
+            m_view_pixel_width = 0;
+            return;
+        }
+    }
+    downSampler();
+}
+
+bool QImM4Downsampler::isViewRangeActive() const
+{
+    return m_view_active;
+}
+
+bool QImM4Downsampler::isSourceSorted() const
+{
+    return m_source_sorted;
+}
+
+bool QImM4Downsampler::checkSourceSorted(qint64 from) const
+{
+    return qimPlotVisitXYSeries(*m_source, [ this, from ](const auto& view) {
+        if (view.isYOnly()) {
+            return m_source->xScale() > 0;
+        }
+        if (view.count <= 0) {
+            return true;
+        }
+        const qint64 first = std::clamp< qint64 >(from - 1, 0, view.count - 1);
+        double last        = view.x(first);
+        for (qint64 i = first + 1; i < view.count; ++i) {
+            const double x = view.x(i);
+            if (!(x >= last)) {
+                return false;
+            }
+            last = x;
+        }
+        return !std::isnan(last);
+    });
+}
+
+// ===== M4 核心算法（O(n)，各列独立）=====
+void QImM4Downsampler::m4(qint64 start_idx, qint64 end_idx, double x_min, double x_max, int columns)
+{
+    m_cached_x.clear();
+    m_cached_y.clear();
+    const qint64 n = end_idx - start_idx;
+    if (n <= 0 || columns <= 0) {
+        return;
+    }
+    // X 有序时按 X 等分列，否则按点数等分
+    const bool by_x   = m_source_sorted && x_min < x_max;
+    const double step = (x_max - x_min) / columns;
+
+    // 每列固定 4 个槽位，各列并行写入自己的槽位，-1 表示空槽位
+    std::vector< qint64 > slots(static_cast< std::size_t >(columns) * kSlotsPerColumn, -1);
+    const qint64 grain = std::max< qint64 >(1, columns * kParallelGrainSamples / n);
+
+    qimPlotVisitXYSeries(*m_source, [ & ](const auto& view) {
+        auto columnStart = [ & ](qint64 c) -> qint64 {
+            if (c <= 0) {
+                return start_idx;
+            }
+            if (c >= columns) {
+                return end_idx;
+            }
+            if (by_x) {
+                return lowerBoundX(view, start_idx, end_idx, x_min + step * c);
+            }
+            return start_idx + n * c / columns;
+        };
+        qimPlotParallelFor(columns, grain, [ & ](qint64 begin, qint64 end) {
+            qint64 first = columnStart(begin);
+            for (qint64 c = begin; c < end; ++c) {
+                const qint64 last = columnStart(c + 1);
+                if (last > first) {
+                    const QImPlotMinMaxIndex mm = qimPlotViewMinMax(view, first, last);
+                    qint64 idx[ kSlotsPerColumn ] = { first, mm.minIdx, mm.maxIdx, last - 1 };
+                    // 整列为 NaN 时只保留首尾（折线在 NaN 处断开）
+                    std::sort(idx, idx + kSlotsPerColumn);
+                    qint64* out = &slots[ static_cast< std::size_t >(c) * kSlotsPerColumn ];
+                    int k       = 0;
+                    for (qint64 i : idx) {
+                        if (i >= 0 && (k == 0 || out[ k - 1 ] != i)) {
+                            out[ k++ ] = i;
+                        }
+                    }
+                }
+                first = last;
+            }
+        });
+
+        // 按列顺序串行压缩，结果与线程数无关
+        m_cached_x.reserve(slots.size());
+        m_cached_y.reserve(slots.size());
+        for (qint64 i : slots) {
+            if (i >= 0) {
+                m_cached_x.push_back(view.x(i));
+                m_cached_y.push_back(view.y(i));
+            }
+        }
+    });
+}
+
+}  // namespace QIM
@@ -0,0 +1,133 @@
+#ifndef QIMM4DOWNSAMPLER_H
+#define QIMM4DOWNSAMPLER_H
+
+#include "QImPlotDataSeries.h"
+#include <vector>
+#include <utility>
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief M4 downsampling proxy: first, last, minimum and maximum sample of every pixel column
+ *
+ * @class QImM4Downsampler
+ *
+ * @details M4 (Jugel et al., VLDB 2014) splits the X range into as many columns as the plot area has
+ *          pixels and keeps, per column, the first and last sample and the samples with the minimum and
+ *          maximum Y, in index order. A polyline through these at most 4 * width points rasterizes to
+ *          the same pixels as the polyline through all samples, as long as the columns match the
+ *          plot's pixel columns, so the proxy is driven by the plot's actual pixel width and visible
+ *          range (setViewRange()). It needs no area or average computations and is cheaper than
+ *          MinMaxLTTB; the per-column min/max uses the SIMD kernel and columns are processed in parallel.
+ *
+ *          Columns are built in X space and require monotonically increasing X (checked once per data
+ *          change). Unsorted X falls back to columns of equal sample count, which keeps extrema but is
+ *          no longer pixel exact. Logarithmic X axes are not pixel exact either.
+ *
+ *          Like the other proxies the source is not owned and must outlive the downsampler; series not
+ *          larger than four points per column are passed through unchanged.
+ * @see QImMinMaxLTTBDownsampler, QImLTTBDownsampler, QImPlotLineItemNode::setDownsampleStrategy()
+ * \endif
+ *
+ * \if CHINESE
+ * @brief M4 下采样代理：每个像素列保留首、尾、最小、最大四个点
+ *
+ * @class QImM4Downsampler
+ *
+ * @details M4（Jugel 等，VLDB 2014）把 X 范围划分为与绘图区像素数相同的列，每列按索引顺序保留
+ *          首点、尾点以及 Y 最小、最大的点。只要列与绘图的像素列一致，经过这最多 4 * 宽度个点的折线
+ *          与经过全部数据点的折线光栅化结果完全相同，因此该代理由绘图的实际像素宽度与可见范围驱动
+ *          （setViewRange()）。不需要面积或平均值计算，比 MinMaxLTTB 更快；每列的最大/最小值使用
+ *          SIMD 内核，各列并行处理。
+ *
+ *          列按 X 划分，要求 X 单调递增（每次数据变化检查一次）。X 无序时退化为点数相等的列，
+ *          仍保留极值但不再与像素完全一致。对数坐标的 X 轴同样不是像素精确的。
+ *
+ *          与其它代理相同，不持有原始数据，原始数据的生命周期必须长于代理；
+ *          数据点数不超过每列四个点时直接透传原始数据。
+ * @see QImMinMaxLTTBDownsampler, QImLTTBDownsampler, QImPlotLineItemNode::setDownsampleStrategy()
+ * \endif
+ */
+class QIM_CORE_API QImM4Downsampler : public QImAbstractXYDataSeries
+{
+public:
+    /**
+     * @brief 构造代理（不拥有原始数据所有权）
+     * @param source 原始数据系列（必须保证生命周期长于代理）
+     * @param pixel_width 全量结果使用的列数（尚未知道绘图宽度时的估计值）
+     */
+    explicit QImM4Downsampler(QImAbstractXYDataSeries* source, int pixel_width = 1000);
+    ~QImM4Downsampler() override = default;
+
+    // ===== QImAbstractXYDataSeries 接口重写 =====
+    int type() const override
+    {
+        return XYData;
+    }  // 代理后总是 XY 模式
+
+    qint64 size() const override;
+    bool isContiguous() const override;
+    int stride() const override;
+    int xStride() const override;
+    const double* xRawData() const override;
+    const double* yRawData() const override;
+    QImPlotValueType xValueType() const override;
+    QImPlotValueType yValueType() const override;
+    const void* xRawPointer() const override;
+    const void* yRawPointer() const override;
+    bool chunkLayout(QImPlotChunkLayout& layout) const override;
+    QImPlotDataBounds bounds() const override;
+    double xScale() const override;
+    double xStart() const override;
+    qint64 offset() const override;
+    double xValue(qint64 index) const override;
+    double yValue(qint64 index) const override;
+
+    // ===== 配置接口 =====
+    // 全量结果的列数，最小 16
+    void setPixelWidth(int width);
+    int pixelWidth() const;
+
+    // 对全量数据重新降采样（原始数据被修改时调用）
+    void downSampler();
+
+    // ===== 视图相关下采样 =====
+    // 把 [x_min, x_max] 划分为 pixel_width 列，范围与像素宽度不变时直接使用缓存，返回是否重新计算
+    bool setViewRange(double x_min, double x_max, int pixel_width);
+    // 回到全量数据的下采样
+    void clearViewRange();
+    // 原始数据追加了点后调用：视图模式下只检查新增点的单调性，否则重新计算全量结果
+    void sourceAppended();
+    bool isViewRangeActive() const;
+    // X 是否单调递增，只有单调数据才能按 X 划分列
+    bool isSourceSorted() const;
+
+private:
+    // 原始数据从 from 开始的 X 是否单调递增（O(n - from)）
+    bool checkSourceSorted(qint64 from) const;
+    // 把 [start_idx, end_idx) 按 [x_min, x_max] 划分为 columns 列并输出每列的 M4 点
+    void m4(qint64 start_idx, qint64 end_idx, double x_min, double x_max, int columns);
+
+private:
+    QImAbstractXYDataSeries* m_source { nullptr };
+    int m_pixel_width { 0 };  // 由构造函数通过 setPixelWidth() 设置
+
+    std::vector< double > m_cached_x;
+    std::vector< double > m_cached_y;
+    bool m_cached_valid { false };
+
+    // 视图范围下采样的缓存键
+    bool m_view_active { false };
+    double m_view_x_min { 0.0 };
+    double m_view_x_max { 0.0 };
+    int m_view_pixel_width { 0 };
+    qint64 m_view_source_size { 0 };
+    bool m_source_sorted { false };
+    qint64 m_sorted_count { 0 };  ///< 已检查单调性的点数
+};
+
+}  // namespace QIM
+
+#endif  // QIMM4DOWNSAMPLER_H
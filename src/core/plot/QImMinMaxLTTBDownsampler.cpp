@@ -1,4 +1,7 @@
 ﻿#include "QImMinMaxLTTBDownsampler.h"
+#include "QImPlotDataSeriesView.h"
+#include "QImPlotMinMaxKernel.h"
+#include "QImPlotParallel.h"
 #include <algorithm>
 #include <cmath>
 #include <cassert>
@@ -16,10 +19,10 @@ QImMinMaxLTTBDownsampler::QImMinMaxLTTBDownsampler(QImAbstractXYDataSeries* sour
 }
 
 
-int QImMinMaxLTTBDownsampler::size() const
+qint64 QImMinMaxLTTBDownsampler::size() const
 {
     // 优先返回下采样数据大小，若未下采样则返回原始数据大小
-    return m_cached_valid ? static_cast< int >(m_cached_x.size()) : (m_source ? m_source->size() : 0);
+    return m_cached_valid ? static_cast< qint64 >(m_cached_x.size()) : (m_source ? m_source->size() : 0);
 }
 
 bool QImMinMaxLTTBDownsampler::isContiguous() const
@@ -29,8 +32,19 @@ bool QImMinMaxLTTBDownsampler::isContiguous() const
 
 int QImMinMaxLTTBDownsampler::stride() const
 {
-    // 连续内存步幅固定为 double 大小
-    return sizeof(double);
+    // 下采样缓存步幅固定为 double 大小，透传时使用原始数据的步幅
+    if (m_cached_valid || !m_source) {
+        return sizeof(double);
+    }
+    return m_source->stride();
+}
+
+int QImMinMaxLTTBDownsampler::xStride() const
+{
+    if (m_cached_valid || !m_source) {
+        return sizeof(double);
+    }
+    return m_source->xStride();
 }
 
 const double* QImMinMaxLTTBDownsampler::xRawData() const
@@ -50,6 +64,44 @@ const double* QImMinMaxLTTBDownsampler::yRawData() const
     return m_source ? m_source->yRawData() : nullptr;
 }
 
+QImPlotValueType QImMinMaxLTTBDownsampler::xValueType() const
+{
+    return (m_cached_valid || !m_source) ? QImPlotValueType::Double : m_source->xValueType();
+}
+
+QImPlotValueType QImMinMaxLTTBDownsampler::yValueType() const
+{
+    return (m_cached_valid || !m_source) ? QImPlotValueType::Double : m_source->yValueType();
+}
+
+const void* QImMinMaxLTTBDownsampler::xRawPointer() const
+{
+    if (m_cached_valid) {
+        return m_cached_x.data();
+    }
+    return m_source ? m_source->xRawPointer() : nullptr;
+}
+
+const void* QImMinMaxLTTBDownsampler::yRawPointer() const
+{
+    if (m_cached_valid) {
+        return m_cached_y.data();
+    }
+    return m_source ? m_source->yRawPointer() : nullptr;
+}
+
+bool QImMinMaxLTTBDownsampler::chunkLayout(QImPlotChunkLayout& layout) const
+{
+    // 透传分块数据的布局，缓存总是连续的
+    return !m_cached_valid && m_source && m_source->chunkLayout(layout);
+}
+
+QImPlotDataBounds QImMinMaxLTTBDownsampler::bounds() const
+{
+    // 降采样结果可能丢掉极值点，坐标轴自适应使用原始数据的范围
+    return m_source ? m_source->bounds() : QImPlotDataBounds();
+}
+
 double QImMinMaxLTTBDownsampler::xScale() const
 {
     return m_source->xScale();
@@ -60,9 +112,10 @@ double QImMinMaxLTTBDownsampler::xStart() const
     return m_source->xStart();
 }
 
-int QImMinMaxLTTBDownsampler::offset() const
+qint64 QImMinMaxLTTBDownsampler::offset() const
 {
-    return m_source->offset();
+    // 下采样缓存按逻辑顺序存储，不再需要偏移
+    return m_cached_valid ? 0 : m_source->offset();
 }
 
 void QImMinMaxLTTBDownsampler::setTargetPoints(int points)
@@ -96,7 +149,7 @@ double QImMinMaxLTTBDownsampler::preselectionRatio() const
     return m_preselection_ratio;
 }
 
-double QImMinMaxLTTBDownsampler::xValue(int index) const
+double QImMinMaxLTTBDownsampler::xValue(qint64 index) const
 {
     if (!m_cached_valid) {
         return m_source ? m_source->xValue(index) : std::numeric_limits< double >::quiet_NaN();
@@ -104,7 +157,7 @@ double QImMinMaxLTTBDownsampler::xValue(int index) const
     return m_cached_x[ index ];
 }
 
-double QImMinMaxLTTBDownsampler::yValue(int index) const
+double QImMinMaxLTTBDownsampler::yValue(qint64 index) const
 {
     if (!m_cached_valid) {
         return m_source ? m_source->yValue(index) : std::numeric_limits< double >::quiet_NaN();
@@ -117,13 +170,28 @@ void QImMinMaxLTTBDownsampler::downSampler()
     // 清空旧缓存
     m_cached_x.clear();
     m_cached_y.clear();
-    m_cached_valid = false;
+    m_cached_valid  = false;
+    m_view_active   = false;
+    m_source_sorted = false;
+    m_sorted_count  = 0;
+    // 原始数据可能被整体修改，金字塔在下一次按视图采样时重建
+    m_pyramid.reset();
+    // 每个桶保留最小、最大两个点，再加首尾两个点
+    m_buckets.setMaxBuckets((m_target_points - 2) / 2);
+    m_buckets.reset();
 
     if (!m_source || m_source->size() <= 0) {
         return;
     }
 
-    const int source_size = m_source->size();
+    const qint64 source_size = m_source->size();
+    if (m_incremental) {
+        // 数据量不足目标点数时也要建立分桶，之后追加的点才能增量处理
+        m_source_sorted = checkSourceSorted(0);
+        m_sorted_count  = source_size;
+        appendIncremental(true);
+        return;
+    }
     // 原始数据量 ≤ 目标点数 → 直接透传，不下采样
     if (source_size <= m_target_points || source_size < 3) {
         m_cached_valid = false;
@@ -131,203 +199,446 @@ void QImMinMaxLTTBDownsampler::downSampler()
     }
 
     // 对全量数据执行 MinMaxLTTB 下采样
-    minMaxLTTB(m_source->xRawData(), m_source->yRawData(), 0, source_size, m_target_points);
-    m_cached_valid = true;
+    minMaxLTTB(0, source_size, m_target_points);
+    m_cached_valid  = true;
+    m_source_sorted = checkSourceSorted(0);
+    m_sorted_count  = source_size;
 }
 
-
-// ===== 辅助：查找可见范围（二分查找优化）=====
-std::pair< int, int > QImMinMaxLTTBDownsampler::findVisibleRange(double x_min, double x_max) const
+/**
+ * \if ENGLISH
+ * @brief Downsamples only the samples inside [x_min, x_max] to a target tied to the pixel width
+ * @param x_min Left limit of the visible X range
+ * @param x_max Right limit of the visible X range
+ * @param pixel_width Width of the plot area in pixels
+ * @return true if the cache was rebuilt, false if the cached result was reused or the view cannot be used
+ * @details The result is keyed by range, pixel width and source size, so a static frame costs nothing.
+ *          One sample on each side of the range is kept so the curve reaches the plot edges. When fewer
+ *          samples than the target are visible they are copied as they are, so deep zooms show full
+ *          resolution. Requires monotonically increasing X (checked in downSampler()); otherwise the
+ *          global downsampling is kept and false is returned.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 只对 [x_min, x_max] 内的数据按像素宽度下采样
+ * @param x_min 可见 X 范围的左边界
+ * @param x_max 可见 X 范围的右边界
+ * @param pixel_width 绘图区的像素宽度
+ * @return 重新计算了缓存返回 true；使用已有缓存或无法按视图采样时返回 false
+ * @details 结果按（范围, 像素宽度, 原始数据点数）缓存，静止的帧没有开销。
+ *          范围两侧各多保留一个点，使曲线延伸到绘图区边缘。可见点数不超过目标点数时原样拷贝，
+ *          深度缩放时显示全分辨率数据。要求 X 单调递增（在 downSampler() 中检查），
+ *          否则保持全量下采样并返回 false。
+ * \endif
+ */
+bool QImMinMaxLTTBDownsampler::setViewRange(double x_min, double x_max, int pixel_width)
 {
-    const int total_size = m_source->size();
-    if (total_size == 0)
-        return { 0, 0 };
-
-    // 处理 Y-only 模式：X 坐标可计算
-    if (const double* x_ptr = m_source->xRawData()) {
-        // XY 模式：二分查找
-        auto x_begin = x_ptr;
-        auto x_end   = x_ptr + total_size;
+    if (!m_source || !m_source_sorted || pixel_width <= 0 || !(x_min < x_max)) {
+        return false;
+    }
+    const qint64 source_size = m_source->size();
+    if (m_view_active && m_view_x_min == x_min && m_view_x_max == x_max && m_view_pixel_width == pixel_width
+        && m_view_source_size == source_size) {
+        return false;
+    }
+    // 每个像素列保留约两个点（最小、最大），与 MinMax 预筛选的粒度一致
+    const int target_points = std::max(pixel_width * 2, 3);
 
-        int start_idx = std::lower_bound(x_begin, x_end, x_min) - x_begin;
-        int end_idx   = std::upper_bound(x_begin, x_end, x_max) - x_begin;
+    auto [ start_idx, end_idx ] = findVisibleRange(x_min, x_max);
+    start_idx                   = std::max< qint64 >(0, start_idx - 1);
+    end_idx                     = std::min(source_size, end_idx + 1);
 
-        return { std::max(0, start_idx), std::min(total_size, end_idx) };
+    if (end_idx - start_idx > target_points && m_pyramid_enabled) {
+        // 从金字塔读取，代价与像素宽度成正比而不是可见点数
+        if (!m_pyramid) {
+            m_pyramid.reset(new QImMinMaxPyramid(m_source));
+        } else {
+            m_pyramid->update();
+        }
+        m_cached_x.clear();
+        m_cached_y.clear();
+        m_pyramid->decimate(start_idx, end_idx, pixel_width, m_cached_x, m_cached_y);
+    } else if (end_idx - start_idx > target_points) {
+        minMaxLTTB(start_idx, end_idx, target_points);
     } else {
-        // Y-only 模式：直接计算索引范围
-        const double x_start = m_source->xStart();
-        const double x_scale = m_source->xScale();
-
-        if (x_scale == 0)
-            return { 0, total_size };  // 退化情况
-
-        int start_idx = static_cast< int >(std::floor((x_min - x_start) / x_scale));
-        int end_idx   = static_cast< int >(std::ceil((x_max - x_start) / x_scale)) + 1;
-
-        return { std::max(0, start_idx), std::min(total_size, end_idx) };
+        m_cached_x.clear();
+        m_cached_y.clear();
+        qimPlotVisitXYSeries(*m_source, [ & ](const auto& view) {
+            for (qint64 i = start_idx; i < end_idx; ++i) {
+                m_cached_x.push_back(view.x(i));
+                m_cached_y.push_back(view.y(i));
+            }
+        });
     }
+    m_cached_valid     = true;
+    m_view_active      = true;
+    m_view_x_min       = x_min;
+    m_view_x_max       = x_max;
+    m_view_pixel_width = pixel_width;
+    m_view_source_size = source_size;
+    return true;
 }
 
+void QImMinMaxLTTBDownsampler::clearViewRange()
+{
+    if (m_view_active) {
+        downSampler();
+    }
+}
 
-// ===== MinMaxLTTB 核心算法（O(n)，带 MinMax 预筛选）=====
-void QImMinMaxLTTBDownsampler::minMaxLTTB(const double* x_data, const double* y_data, int start_idx, int end_idx, int target_points)
+/**
+ * \if ENGLISH
+ * @brief Call after samples were appended to the source
+ * @details In view mode only the monotonicity of the new samples is checked; the next
+ *          setViewRange() sees the new size, updates the pyramid incrementally and re-decimates the
+ *          view. In incremental mode the new samples are merged into the min/max buckets of the
+ *          global result. Otherwise the global result is recomputed. Ring buffers that started to
+ *          evict old samples move every logical index and are always recomputed.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 原始数据追加了点后调用
+ * @details 视图模式下只检查新增点的单调性，下一次 setViewRange() 发现点数变化后增量更新金字塔
+ *          并重新采样可见范围；增量模式下新增的点并入全量结果的最大/最小值分桶；
+ *          否则重新计算全量下采样结果。开始淘汰旧数据的环形缓冲所有逻辑索引都会移动，总是重新计算。
+ * \endif
+ */
+void QImMinMaxLTTBDownsampler::sourceAppended()
 {
-    // 前置校验
-    if (!m_source || target_points < 3) {
-        m_cached_x.clear();
-        m_cached_y.clear();
+    if (!m_source) {
         return;
     }
-
-    const int n = end_idx - start_idx;
-    if (n <= 0 || start_idx < 0 || end_idx > m_source->size()) {
-        m_cached_x.clear();
-        m_cached_y.clear();
+    // 环形缓冲写满后逻辑索引整体移动，已处理的点不再对应原来的位置
+    const bool shifted = m_source->offset() != 0 || m_source->size() < m_sorted_count;
+    if (m_view_active) {
+        m_source_sorted = checkSourceSorted(shifted ? 0 : m_sorted_count);
+        m_sorted_count  = m_source->size();
+        if (m_incremental && !shifted) {
+            // 分桶保持最新，clearViewRange() 之后不需要重新扫描全部数据
+            appendIncremental(false);
+        }
+        if (m_source_sorted) {
+            // 环形缓冲写满后点数不变，清除缓存键使下一次 setViewRange() 重新采样
+            m_view_pixel_width = 0;
+            return;
+        }
+    } else if (m_incremental && !shifted) {
+        m_source_sorted = m_source_sorted && checkSourceSorted(m_sorted_count);
+        m_sorted_count  = m_source->size();
+    }
+    if (m_incremental && !shifted) {
+        m_view_active = false;
+        appendIncremental(true);
         return;
     }
+    downSampler();
+}
 
+/**
+ * \if ENGLISH
+ * @brief Switches the global result to incrementally maintained min/max buckets
+ * @param on true for append-only streams
+ * @details The global result (outside of view mode) keeps the first and last sample and the minimum
+ *          and maximum of fixed-width index buckets instead of running MinMaxLTTB. sourceAppended()
+ *          then only reads the new samples: the last bucket is extended, and when the number of
+ *          buckets exceeds half of targetPoints() the width doubles and adjacent buckets merge in
+ *          place. Per-append cost is proportional to the new samples plus targetPoints().
+ * @see QImIncrementalMinMaxBuckets
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 全量结果改为增量维护的最大/最小值分桶
+ * @param on 只追加的数据流设为 true
+ * @details 全量结果（非视图模式）不再执行 MinMaxLTTB，而是保留首尾点与固定宽度索引桶内的最小、最大值。
+ *          sourceAppended() 只读取新增的点：扩展最后一个桶，桶数超过 targetPoints() 的一半时桶宽加倍，
+ *          相邻的桶原地合并。每次追加的代价与新增点数加 targetPoints() 成正比。
+ * @see QImIncrementalMinMaxBuckets
+ * \endif
+ */
+void QImMinMaxLTTBDownsampler::setIncrementalMode(bool on)
+{
+    if (m_incremental != on) {
+        m_incremental = on;
+        downSampler();
+    }
+}
 
-    // 预分配缓存
+bool QImMinMaxLTTBDownsampler::isIncrementalMode() const
+{
+    return m_incremental;
+}
+
+void QImMinMaxLTTBDownsampler::appendIncremental(bool publish)
+{
+    const qint64 n = m_source->size();
+    qimPlotVisitXYSeries(*m_source, [ & ](const auto& view) { m_buckets.append(view, n); });
+    if (!publish) {
+        return;
+    }
     m_cached_x.clear();
     m_cached_y.clear();
-    m_cached_x.reserve(target_points);
-    m_cached_y.reserve(target_points);
+    if (n <= m_target_points || n < 3) {
+        // 数据量不足目标点数，透传原始数据
+        m_cached_valid = false;
+        return;
+    }
+    m_buckets.retainedIndices(m_retained);
+    m_cached_x.reserve(m_retained.size());
+    m_cached_y.reserve(m_retained.size());
+    qimPlotVisitXYSeries(*m_source, [ & ](const auto& view) {
+        for (qint64 i : m_retained) {
+            m_cached_x.push_back(view.x(i));
+            m_cached_y.push_back(view.y(i));
+        }
+    });
+    m_cached_valid = true;
+}
 
-    // 预先获取所有X和Y值，避免重复计算和边界检查
-    std::vector< double > x_values(n);
-    std::vector< double > y_values(n);
+void QImMinMaxLTTBDownsampler::setPyramidEnabled(bool on)
+{
+    if (m_pyramid_enabled != on) {
+        m_pyramid_enabled = on;
+        m_view_active     = false;
+        if (!on) {
+            m_pyramid.reset();
+        }
+    }
+}
 
-    // Y-only模式处理
-    const bool is_y_only = (x_data == nullptr);
-    const double x_start = is_y_only ? m_source->xStart() : 0.0;
-    const double x_scale = is_y_only ? m_source->xScale() : 1.0;
+bool QImMinMaxLTTBDownsampler::isPyramidEnabled() const
+{
+    return m_pyramid_enabled;
+}
 
-    // 一次性获取所有数据
-    for (int i = 0; i < n; ++i) {
-        const int global_idx = start_idx + i;
-        y_values[ i ]        = y_data[ global_idx ];
+const QImMinMaxPyramid* QImMinMaxLTTBDownsampler::pyramid() const
+{
+    return m_pyramid.get();
+}
 
-        if (is_y_only) {
-            x_values[ i ] = x_start + global_idx * x_scale;
-        } else {
-            x_values[ i ] = x_data[ global_idx ];
-        }
-    }
+bool QImMinMaxLTTBDownsampler::isViewRangeActive() const
+{
+    return m_view_active;
+}
 
-    // 1. 保留第一个点
-    m_cached_x.push_back(x_values[ 0 ]);
-    m_cached_y.push_back(y_values[ 0 ]);
+bool QImMinMaxLTTBDownsampler::isSourceSorted() const
+{
+    return m_source_sorted;
+}
 
-    // 2. 预计算每个桶的边界 - 整数计算替代浮点
-    const int num_buckets = target_points - 2;
-    const int bucket_size = n / num_buckets;
-    const int remainder   = n % num_buckets;
+bool QImMinMaxLTTBDownsampler::checkSourceSorted(qint64 from) const
+{
+    return qimPlotVisitXYSeries(*m_source, [ this, from ](const auto& view) {
+        if (view.isYOnly()) {
+            // Y-only 模式 X 等间隔
+            return m_source->xScale() > 0;
+        }
+        if (view.count <= 0) {
+            return true;
+        }
+        // 与已检查部分的最后一个点比较
+        const qint64 first = std::clamp< qint64 >(from - 1, 0, view.count - 1);
+        double last        = view.x(first);
+        for (qint64 i = first + 1; i < view.count; ++i) {
+            const double x = view.x(i);
+            // NaN 同样无法二分查找
+            if (!(x >= last)) {
+                return false;
+            }
+            last = x;
+        }
+        return !std::isnan(last);
+    });
+}
 
-    // 3. 中间点：优化MinMaxLTTB
-    int current_idx                     = 1;
-    const double preselection_factor    = std::max(2.0, m_preselection_ratio);
-    const int max_candidates_per_bucket = static_cast< int >(std::ceil(preselection_factor * 2));
 
-    // 预分配候选点数组
-    std::vector< int > candidate_indices;
-    candidate_indices.reserve(max_candidates_per_bucket);
+// ===== 辅助：查找可见范围（二分查找优化）=====
+std::pair< qint64, qint64 > QImMinMaxLTTBDownsampler::findVisibleRange(double x_min, double x_max) const
+{
+    const qint64 total_size = m_source->size();
+    if (total_size == 0)
+        return { 0, 0 };
 
-    const int last_cached_index = 0;
+    // 处理 Y-only 模式：X 坐标可计算；分块存储的 xRawPointer() 为空，因此按视图判断
+    const bool y_only = qimPlotVisitXYSeries(*m_source, [](const auto& view) { return view.isYOnly(); });
+    if (!y_only) {
+        // XY 模式：二分查找（通过类型化视图访问，兼容任意存储类型）
+        return qimPlotVisitXYSeries(*m_source, [ & ](const auto& view) -> std::pair< qint64, qint64 > {
+            qint64 lo = 0, hi = total_size;
+            while (lo < hi) {
+                const qint64 mid = lo + (hi - lo) / 2;
+                if (view.x(mid) < x_min) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            const qint64 start_idx = lo;
+            hi                     = total_size;
+            while (lo < hi) {
+                const qint64 mid = lo + (hi - lo) / 2;
+                if (view.x(mid) <= x_max) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            return { start_idx, std::min(total_size, lo) };
+        });
+    } else {
+        // Y-only 模式：直接计算索引范围
+        const double x_start = m_source->xStart();
+        const double x_scale = m_source->xScale();
 
-    for (int bucket = 0; bucket < num_buckets; ++bucket) {
-        // 计算桶边界 - 整数算法
-        const int bucket_start = current_idx;
-        const int extra        = (bucket < remainder) ? 1 : 0;
-        const int bucket_end   = bucket_start + bucket_size + extra;
+        if (x_scale == 0)
+            return { 0, total_size };  // 退化情况
 
-        if (bucket_end >= n || bucket_start >= bucket_end) {
-            break;
-        }
+        // 先在 double 中截断，避免超出 qint64 范围
+        const double last   = static_cast< double >(total_size);
+        const double first  = std::clamp(std::floor((x_min - x_start) / x_scale), 0.0, last);
+        const double beyond = std::clamp(std::ceil((x_max - x_start) / x_scale) + 1, 0.0, last);
 
-        // 计算桶大小
-        const int bucket_count = bucket_end - bucket_start;
+        return { static_cast< qint64 >(first), static_cast< qint64 >(beyond) };
+    }
+}
 
-        // 预筛选候选点数量
-        const int num_sub_intervals = std::max(1, static_cast< int >(std::ceil(bucket_count / preselection_factor)));
-        const int points_per_subinterval = std::max(1, bucket_count / num_sub_intervals);
 
-        // 重置候选点
-        candidate_indices.clear();
+// ===== MinMaxLTTB 核心算法（O(n)，带 MinMax 预筛选）=====
+namespace
+{
+// 每个任务至少处理的原始点数，太小的任务调度开销超过计算量
+constexpr qint64 kParallelGrainSamples = 1 << 16;
 
-        // 高效寻找极值点 - 无需去重检查
-        for (int sub = 0; sub < num_sub_intervals; ++sub) {
-            const int sub_start = bucket_start + sub * points_per_subinterval;
-            const int sub_end =
-                (sub == num_sub_intervals - 1) ? bucket_end : std::min(bucket_end, sub_start + points_per_subinterval);
+// 一个桶的预筛选结果：候选点（局部索引）及其平均点
+struct BucketCandidates
+{
+    int count { 0 };
+    double avgX { 0.0 };
+    double avgY { 0.0 };
+};
+
+// 直接从视图读取数据，不再把整段数据拷贝为 double 数组：
+// 超过 2^31 个点的数据系列也只需要 O(target_points) 的额外内存。
+// 第一阶段（预筛选）各桶互相独立，按桶并行；第二阶段（LTTB 选点）依赖上一个选中的点，
+// 串行执行但只访问候选点。两个阶段的计算与线程数无关，输出与串行执行完全相同
+template< typename View >
+void minMaxLttbKernel(const View& view,
+                      qint64 start_idx,
+                      qint64 end_idx,
+                      int target_points,
+                      double preselection_ratio,
+                      std::vector< double >& out_x,
+                      std::vector< double >& out_y)
+{
+    const qint64 n = end_idx - start_idx;
+    // 辅助lambda：按局部索引获取X/Y（视图内部处理Y-only、offset与存储类型）
+    auto getX = [ &view, start_idx ](qint64 local_idx) -> double { return view.x(start_idx + local_idx); };
+    auto getY = [ &view, start_idx ](qint64 local_idx) -> double { return view.y(start_idx + local_idx); };
 
-            if (sub_start >= sub_end)
-                continue;
+    // 1. 保留第一个点
+    out_x.push_back(getX(0));
+    out_y.push_back(getY(0));
 
-            int max_idx    = sub_start;
-            int min_idx    = sub_start;
-            double max_val = y_values[ sub_start ];
-            double min_val = max_val;
+    // 2. 预计算每个桶的边界 - 整数计算替代浮点
+    const qint64 num_buckets = target_points - 2;
+    const qint64 bucket_size = n / num_buckets;
+    const qint64 remainder   = n % num_buckets;
+    // 桶 b 覆盖 [1 + b * bucket_size + min(b, remainder), 下一个桶的起点)，前 remainder 个桶多一个点
+    auto bucketStart = [ = ](qint64 bucket) { return 1 + bucket * bucket_size + std::min(bucket, remainder); };
+    // 只处理完整落在 [1, n-1) 内的非空桶，最后一个点单独保留
+    qint64 used_buckets = 0;
+    while (used_buckets < num_buckets) {
+        const qint64 bucket_end = bucketStart(used_buckets + 1);
+        if (bucket_end >= n || bucketStart(used_buckets) >= bucket_end) {
+            break;
+        }
+        ++used_buckets;
+    }
 
-            // 寻找子区间内的极值
-            for (int j = sub_start + 1; j < sub_end; ++j) {
-                const double y = y_values[ j ];
-                if (std::isnan(y))
+    // 预筛选：每个桶划分为 ceil(桶内点数 / preselection_ratio) 个子区间，每个子区间贡献最大、最小两个候选点
+    const double preselection_factor = std::max(2.0, preselection_ratio);
+    auto subIntervals                = [ = ](qint64 bucket_count) {
+        return std::max< qint64 >(1, static_cast< qint64 >(std::ceil(bucket_count / preselection_factor)));
+    };
+    // 各桶点数最多相差 1，按最大的桶分配候选点槽位
+    const qint64 slots_per_bucket = subIntervals(bucket_size + (remainder > 0 ? 1 : 0)) * 2;
+    std::vector< qint64 > candidate_indices(static_cast< std::size_t >(used_buckets * slots_per_bucket));
+    std::vector< BucketCandidates > buckets(static_cast< std::size_t >(used_buckets));
+
+    auto preselect = [ & ](qint64 first_bucket, qint64 last_bucket) {
+        for (qint64 bucket = first_bucket; bucket < last_bucket; ++bucket) {
+            const qint64 bucket_start = bucketStart(bucket);
+            const qint64 bucket_end   = bucketStart(bucket + 1);
+            const qint64 bucket_count = bucket_end - bucket_start;
+
+            const qint64 num_sub_intervals      = subIntervals(bucket_count);
+            const qint64 points_per_subinterval = std::max< qint64 >(1, bucket_count / num_sub_intervals);
+
+            qint64* candidates = candidate_indices.data() + bucket * slots_per_bucket;
+            int count          = 0;
+            // 高效寻找极值点 - 无需去重检查
+            for (qint64 sub = 0; sub < num_sub_intervals; ++sub) {
+                const qint64 sub_start = bucket_start + sub * points_per_subinterval;
+                const qint64 sub_end   = (sub == num_sub_intervals - 1)
+                                             ? bucket_end
+                                             : std::min(bucket_end, sub_start + points_per_subinterval);
+                if (sub_start >= sub_end)
                     continue;
 
-                if (y > max_val) {
-                    max_val = y;
-                    max_idx = j;
-                }
-                if (y < min_val) {
-                    min_val = y;
-                    min_idx = j;
+                // 寻找子区间内的极值：紧凑的 double/float 数据走运行时选择的 SIMD 内核
+                const QImPlotMinMaxIndex mm = qimPlotViewMinMax(view, start_idx + sub_start, start_idx + sub_end);
+                // 子区间全部为 NaN 时保留第一个点
+                const qint64 max_idx = (mm.maxIdx < 0) ? sub_start : mm.maxIdx - start_idx;
+                const qint64 min_idx = (mm.minIdx < 0) ? sub_start : mm.minIdx - start_idx;
+
+                candidates[ count++ ] = max_idx;
+                if (max_idx != min_idx) {
+                    candidates[ count++ ] = min_idx;
                 }
             }
-
-            candidate_indices.push_back(max_idx);
-            if (max_idx != min_idx) {
-                candidate_indices.push_back(min_idx);
+            // 确保至少有一个候选点
+            if (count == 0) {
+                candidates[ count++ ] = bucket_start;
             }
-        }
-
-        // 确保至少有一个候选点
-        if (candidate_indices.empty()) {
-            candidate_indices.push_back(bucket_start);
-        }
 
-        // 优化：只使用候选点计算平均点
-        double avg_x    = 0.0;
-        double avg_y    = 0.0;
-        int valid_count = 0;
-
-        for (int idx : candidate_indices) {
-            const double x = x_values[ idx ];
-            const double y = y_values[ idx ];
-            if (!std::isnan(x) && !std::isnan(y)) {
-                avg_x += x;
-                avg_y += y;
-                valid_count++;
+            // 优化：只使用候选点计算平均点
+            double avg_x    = 0.0;
+            double avg_y    = 0.0;
+            int valid_count = 0;
+            for (int c = 0; c < count; ++c) {
+                const double x = getX(candidates[ c ]);
+                const double y = getY(candidates[ c ]);
+                if (!std::isnan(x) && !std::isnan(y)) {
+                    avg_x += x;
+                    avg_y += y;
+                    valid_count++;
+                }
             }
+            if (valid_count > 0) {
+                avg_x /= valid_count;
+                avg_y /= valid_count;
+            } else {
+                // 回退到桶内第一个有效点
+                avg_x = getX(bucket_start);
+                avg_y = getY(bucket_start);
+            }
+            buckets[ bucket ] = { count, avg_x, avg_y };
         }
-
-        if (valid_count > 0) {
-            avg_x /= valid_count;
-            avg_y /= valid_count;
-        } else {
-            // 回退到桶内第一个有效点
-            avg_x = x_values[ bucket_start - start_idx ];
-            avg_y = y_values[ bucket_start - start_idx ];
-        }
-
-        // 寻找最大三角形面积的候选点
-        const double last_x = m_cached_x.back();
-        const double last_y = m_cached_y.back();
-        double max_area     = -1.0;
-        int best_idx        = candidate_indices[ 0 ];
-
-        for (int idx : candidate_indices) {
-            const double curr_x = x_values[ idx - start_idx ];
-            const double curr_y = y_values[ idx - start_idx ];
+    };
+    qimPlotParallelFor(used_buckets, std::max< qint64 >(1, kParallelGrainSamples / std::max< qint64 >(1, bucket_size)), preselect);
+
+    // 3. 中间点：在候选点中寻找与上一个选中点、本桶平均点构成最大三角形的点
+    for (qint64 bucket = 0; bucket < used_buckets; ++bucket) {
+        const BucketCandidates& info = buckets[ bucket ];
+        const qint64* candidates     = candidate_indices.data() + bucket * slots_per_bucket;
+        const double last_x          = out_x.back();
+        const double last_y          = out_y.back();
+        double max_area              = -1.0;
+        qint64 best_idx              = candidates[ 0 ];
+
+        for (int c = 0; c < info.count; ++c) {
+            const qint64 idx    = candidates[ c ];
+            const double curr_x = getX(idx);
+            const double curr_y = getY(idx);
 
             if (std::isnan(curr_x) || std::isnan(curr_y))
                 continue;
@@ -335,8 +646,8 @@ void QImMinMaxLTTBDownsampler::minMaxLTTB(const double* x_data, const double* y_
             // 三角形面积计算（简化版，避免绝对值和除法）
             const double dx1  = curr_x - last_x;
             const double dy1  = curr_y - last_y;
-            const double dx2  = avg_x - last_x;
-            const double dy2  = avg_y - last_y;
+            const double dx2  = info.avgX - last_x;
+            const double dy2  = info.avgY - last_y;
             const double area = std::fabs(dx1 * dy2 - dx2 * dy1);
 
             if (area > max_area) {
@@ -346,17 +657,39 @@ void QImMinMaxLTTBDownsampler::minMaxLTTB(const double* x_data, const double* y_
         }
 
         // 添加最佳点
-        m_cached_x.push_back(x_values[ best_idx - start_idx ]);
-        m_cached_y.push_back(y_values[ best_idx - start_idx ]);
+        out_x.push_back(getX(best_idx));
+        out_y.push_back(getY(best_idx));
+    }
 
-        current_idx = bucket_end;
+    // 4. 保留最后一个点
+    if (out_x.size() < static_cast< size_t >(target_points)) {
+        out_x.push_back(getX(n - 1));
+        out_y.push_back(getY(n - 1));
     }
+}
+}  // namespace
 
-    // 3. 保留最后一个点
-    if (m_cached_x.size() < static_cast< size_t >(target_points)) {
-        m_cached_x.push_back(x_values[ n - 1 ]);
-        m_cached_y.push_back(y_values[ n - 1 ]);
+void QImMinMaxLTTBDownsampler::minMaxLTTB(qint64 start_idx, qint64 end_idx, int target_points)
+{
+    // 预分配缓存
+    m_cached_x.clear();
+    m_cached_y.clear();
+
+    // 前置校验
+    if (!m_source || target_points < 3) {
+        return;
+    }
+    const qint64 n = end_idx - start_idx;
+    if (n <= 0 || start_idx < 0 || end_idx > m_source->size()) {
+        return;
     }
+    m_cached_x.reserve(target_points);
+    m_cached_y.reserve(target_points);
+
+    // 按存储类型分派一次，内层循环没有虚函数调用
+    qimPlotVisitXYSeries(*m_source, [ & ](const auto& view) {
+        minMaxLttbKernel(view, start_idx, end_idx, target_points, m_preselection_ratio, m_cached_x, m_cached_y);
+    });
 }
 
 }  // namespace QIM
@@ -2,6 +2,8 @@
 #define QIMMINMAXLTTBDOWNSAMPLER_H
 
 #include "QImPlotDataSeries.h"
+#include "QImMinMaxPyramid.h"
+#include "QImIncrementalMinMaxBuckets.h"
 #include <vector>
 #include <memory>
 #include <optional>
@@ -70,7 +72,9 @@ namespace QIM
  *
  * 1. **完全符合 QImAbstractXYDataSeries 接口** - 可无缝替换原始数据
  * 2. **内部维护下采样缓存** - xRawData()/yRawData() 返回下采样后数据指针
- * 3. **全局一次性下采样** - 初始化时对全量数据下采样，视图变化不重新采样
+ * 3. **视图相关下采样** - 初始化时对全量数据下采样；setViewRange() 只对可见 X 范围按像素宽度重新采样，
+ *    结果按（范围, 像素宽度）缓存，静止的帧不重复计算，深度缩放时显示全分辨率数据；
+ *    可见点数远多于像素时读取 QImMinMaxPyramid 的对应层，每帧代价只与像素宽度有关
  * 4. **自动处理 Y-only 模式** - 下采样后转为显式 XY 模式
  * 5. **零拷贝优先** - 小数据集时直接透传原始数据
  * 6. **性能优化** - 采用 MinMax 预筛选策略，比标准 LTTB 快 10-30 倍
@@ -196,20 +200,29 @@ public:
         return XYData;
     }  // 代理后总是 XY 模式
 
-    int size() const override;
+    qint64 size() const override;
 
     bool isContiguous() const override;  // 缓存数据总是连续
 
     int stride() const override;
+    int xStride() const override;
 
     const double* xRawData() const override;
 
     const double* yRawData() const override;
 
+    // 未下采样时透传原始数据的存储类型，下采样缓存总是 double
+    QImPlotValueType xValueType() const override;
+    QImPlotValueType yValueType() const override;
+    const void* xRawPointer() const override;
+    const void* yRawPointer() const override;
+    bool chunkLayout(QImPlotChunkLayout& layout) const override;
+    QImPlotDataBounds bounds() const override;
+
     // 代理后不再支持 Y-only 模式（下采样破坏等间隔假设），返回默认值
     double xScale() const override;
     double xStart() const override;
-    int offset() const override;
+    qint64 offset() const override;
 
     // ===== 配置接口 =====
     void setTargetPoints(int points);
@@ -220,16 +233,38 @@ public:
 
     double preselectionRatio() const;
 
-    virtual double xValue(int index) const override;
-    virtual double yValue(int index) const override;
+    virtual double xValue(qint64 index) const override;
+    virtual double yValue(qint64 index) const override;
 
     // 根据目标点数更新数据，这个函数在目标点数变化，或原数据发生变化时调用，用于更新
     void downSampler();
 
+    // ===== 视图相关下采样 =====
+    // 只对 [x_min, x_max] 内的数据按像素宽度下采样，范围与像素宽度不变时直接使用缓存，返回是否重新计算
+    bool setViewRange(double x_min, double x_max, int pixel_width);
+    // 回到全量数据的下采样
+    void clearViewRange();
+    // 原始数据追加了点后调用：视图模式下金字塔增量更新，否则重新全量下采样
+    void sourceAppended();
+    // 是否用最大/最小值金字塔生成视图范围的下采样结果（默认开启）
+    void setPyramidEnabled(bool on);
+    bool isPyramidEnabled() const;
+    // 金字塔索引，尚未按视图采样或未开启时为 nullptr
+    const QImMinMaxPyramid* pyramid() const;
+    // 是否正在使用视图范围的下采样结果
+    bool isViewRangeActive() const;
+    // X 是否单调递增，只有单调数据才能按视图范围二分查找
+    bool isSourceSorted() const;
+
+    // ===== 增量模式（只追加的数据流）=====
+    // 全量结果改为固定宽度的最大/最小值桶，sourceAppended() 只处理新增的点（默认关闭）
+    void setIncrementalMode(bool on);
+    bool isIncrementalMode() const;
+
 private:
     // ===== 内部状态 =====
     QImAbstractXYDataSeries* m_source;  // 原始数据指针
-    int m_target_points;
+    int m_target_points { 0 };  // 由构造函数通过 setTargetPoints() 设置
     double m_preselection_ratio;  // MinMax 预筛选比例
 
     // 缓存状态
@@ -237,12 +272,31 @@ private:
     mutable std::vector< double > m_cached_y;
     mutable bool m_cached_valid = false;
 
+    // 视图范围下采样的缓存键
+    bool m_view_active        = false;
+    double m_view_x_min       = 0.0;
+    double m_view_x_max       = 0.0;
+    int m_view_pixel_width    = 0;
+    qint64 m_view_source_size = 0;
+    bool m_source_sorted      = false;  ///< 在 downSampler() 中检查
+    qint64 m_sorted_count     = 0;      ///< 已检查单调性的点数
+    bool m_pyramid_enabled    = true;
+    std::unique_ptr< QImMinMaxPyramid > m_pyramid;  ///< 首次按视图采样时构建
+    bool m_incremental = false;
+    QImIncrementalMinMaxBuckets m_buckets;  ///< 增量模式下全量数据的分桶
+    std::vector< qint64 > m_retained;       ///< 分桶保留的点的索引（复用内存）
 
     // 查找视图范围内的数据索引 [start_idx, end_idx)
-    std::pair< int, int > findVisibleRange(double x_min, double x_max) const;
+    std::pair< qint64, qint64 > findVisibleRange(double x_min, double x_max) const;
+
+    // 原始数据从 from 开始的 X 是否单调递增（O(n - from)）
+    bool checkSourceSorted(qint64 from) const;
 
     // MinMaxLTTB 核心算法（O(n)，带 MinMax 预筛选）
-    void minMaxLTTB(const double* x_data, const double* y_data, int start_idx, int end_idx, int target_points);
+    void minMaxLTTB(qint64 start_idx, qint64 end_idx, int target_points);
+
+    // 增量模式：把新增的点并入分桶，publish 为 true 时用分桶结果替换缓存
+    void appendIncremental(bool publish);
 };
 
 }  // namespace QIM
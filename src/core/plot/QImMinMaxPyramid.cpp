@@ -0,0 +1,254 @@
+#include "QImMinMaxPyramid.h"
+#include "QImPlotDataSeriesView.h"
+#include "QImPlotMinMaxKernel.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace QIM
+{
+
+namespace
+{
+// 合并两个块的极值，相等时保留索引较小的点
+void mergeNode(QImMinMaxPyramid::Node& a, const QImMinMaxPyramid::Node& b)
+{
+    if (b.minIdx < 0) {
+        return;
+    }
+    if (a.minIdx < 0) {
+        a = b;
+        return;
+    }
+    if (b.minY < a.minY) {
+        a.minY   = b.minY;
+        a.minIdx = b.minIdx;
+    }
+    if (b.maxY > a.maxY) {
+        a.maxY   = b.maxY;
+        a.maxIdx = b.maxIdx;
+    }
+}
+
+// 扫描 [first, last) 并合并到 node，NaN 被跳过
+template< typename View >
+void scanRaw(const View& view, qint64 first, qint64 last, QImMinMaxPyramid::Node& node)
+{
+    if (first >= last) {
+        return;
+    }
+    const QImPlotMinMaxIndex mm = qimPlotViewMinMax(view, first, last);
+    QImMinMaxPyramid::Node part;
+    part.minY   = mm.minValue;
+    part.maxY   = mm.maxValue;
+    part.minIdx = mm.minIdx;
+    part.maxIdx = mm.maxIdx;
+    mergeNode(node, part);
+}
+
+/**
+ * @brief 用第 level 层及以下的块覆盖 [first, last)，不足一个块的部分直接扫描原始数据
+ */
+template< typename View >
+void accumulate(const View& view,
+                const std::vector< std::vector< QImMinMaxPyramid::Node > >& levels,
+                qint64 baseBlock,
+                qint64 first,
+                qint64 last,
+                int level,
+                QImMinMaxPyramid::Node& node)
+{
+    if (first >= last) {
+        return;
+    }
+    if (level < 0) {
+        scanRaw(view, first, last, node);
+        return;
+    }
+    qint64 bs = baseBlock;
+    for (int l = 0; l < level; ++l) {
+        bs *= 4;
+    }
+    const auto& blocks    = levels[ level ];
+    const qint64 firstBlk = (first + bs - 1) / bs;
+    const qint64 lastBlk  = std::min< qint64 >(last / bs, static_cast< qint64 >(blocks.size()));
+    if (firstBlk >= lastBlk) {
+        accumulate(view, levels, baseBlock, first, last, level - 1, node);
+        return;
+    }
+    accumulate(view, levels, baseBlock, first, firstBlk * bs, level - 1, node);
+    for (qint64 b = firstBlk; b < lastBlk; ++b) {
+        mergeNode(node, blocks[ b ]);
+    }
+    accumulate(view, levels, baseBlock, lastBlk * bs, last, level - 1, node);
+}
+
+template< typename View >
+void appendIndex(const View& view, qint64 i, std::vector< double >& outX, std::vector< double >& outY)
+{
+    outX.push_back(view.x(i));
+    outY.push_back(view.y(i));
+}
+}  // namespace
+
+QImMinMaxPyramid::QImMinMaxPyramid(const QImAbstractXYDataSeries* source, int baseBlockSize)
+    : m_source(source), m_baseBlockSize(std::max(baseBlockSize, 4))
+{
+    assert(source && "Source must not be null");
+    rebuild();
+}
+
+void QImMinMaxPyramid::rebuild()
+{
+    m_levels.clear();
+    m_indexedCount = 0;
+    buildLevels(0);
+}
+
+void QImMinMaxPyramid::update()
+{
+    // 环形缓冲写满后逻辑索引整体移动，已有的块不再对应原来的点
+    if (!m_source || m_source->offset() != 0 || m_source->size() < m_indexedCount) {
+        rebuild();
+        return;
+    }
+    buildLevels(m_indexedCount);
+}
+
+qint64 QImMinMaxPyramid::indexedCount() const
+{
+    return m_indexedCount;
+}
+
+int QImMinMaxPyramid::baseBlockSize() const
+{
+    return m_baseBlockSize;
+}
+
+int QImMinMaxPyramid::levelCount() const
+{
+    return static_cast< int >(m_levels.size());
+}
+
+qint64 QImMinMaxPyramid::blockSize(int level) const
+{
+    qint64 bs = m_baseBlockSize;
+    for (int l = 0; l < level; ++l) {
+        bs *= 4;
+    }
+    return bs;
+}
+
+qint64 QImMinMaxPyramid::memoryUsage() const
+{
+    qint64 bytes = 0;
+    for (const auto& level : m_levels) {
+        bytes += static_cast< qint64 >(level.capacity() * sizeof(Node));
+    }
+    return bytes;
+}
+
+void QImMinMaxPyramid::buildLevels(qint64 from_count)
+{
+    if (!m_source) {
+        return;
+    }
+    const qint64 n        = m_source->size();
+    const qint64 oldBlock = from_count / m_baseBlockSize;
+    const qint64 newBlock = n / m_baseBlockSize;
+    if (newBlock <= oldBlock) {
+        return;
+    }
+    if (m_levels.empty()) {
+        m_levels.emplace_back();
+    }
+    // 第 0 层：只为完整的块建立索引，不足一块的尾部在查询时逐点扫描
+    auto& level0 = m_levels[ 0 ];
+    level0.resize(static_cast< std::size_t >(newBlock));
+    qimPlotVisitXYSeries(*m_source, [ & ](const auto& view) {
+        for (qint64 b = oldBlock; b < newBlock; ++b) {
+            Node node;
+            scanRaw(view, b * m_baseBlockSize, (b + 1) * m_baseBlockSize, node);
+            level0[ b ] = node;
+        }
+    });
+    m_indexedCount = newBlock * m_baseBlockSize;
+
+    // 上层：每 4 个子块合并为一个，只合并新增的完整父块
+    for (std::size_t l = 1;; ++l) {
+        const qint64 parents = static_cast< qint64 >(m_levels[ l - 1 ].size()) / 4;
+        if (parents == 0) {
+            break;
+        }
+        if (m_levels.size() <= l) {
+            m_levels.emplace_back();
+        }
+        auto& parent         = m_levels[ l ];
+        const auto& children = m_levels[ l - 1 ];
+        const qint64 old     = static_cast< qint64 >(parent.size());
+        parent.resize(static_cast< std::size_t >(parents));
+        for (qint64 p = old; p < parents; ++p) {
+            Node node;
+            for (qint64 c = p * 4; c < p * 4 + 4; ++c) {
+                mergeNode(node, children[ c ]);
+            }
+            parent[ p ] = node;
+        }
+    }
+}
+
+void QImMinMaxPyramid::decimate(qint64 start_idx,
+                                qint64 end_idx,
+                                int columns,
+                                std::vector< double >& out_x,
+                                std::vector< double >& out_y) const
+{
+    if (!m_source || columns <= 0) {
+        return;
+    }
+    start_idx = std::max< qint64 >(0, start_idx);
+    end_idx   = std::min(end_idx, m_source->size());
+    if (end_idx <= start_idx) {
+        return;
+    }
+    const double perColumn = static_cast< double >(end_idx - start_idx) / columns;
+    // 选择块宽不超过半列的最高层，每列只需合并少量块
+    int level = -1;
+    for (int l = 0; l < levelCount(); ++l) {
+        if (blockSize(l) * 2 <= perColumn) {
+            level = l;
+        }
+    }
+    const qint64 snap = (level >= 0) ? blockSize(level) : 1;
+
+    qimPlotVisitXYSeries(*m_source, [ & ](const auto& view) {
+        qint64 first = start_idx;
+        for (int c = 0; c < columns && first < end_idx; ++c) {
+            qint64 last = end_idx;
+            if (c != columns - 1) {
+                last = start_idx + static_cast< qint64 >((c + 1) * perColumn);
+                // 列边界对齐到块边界，列内部全部由整块覆盖
+                last = (last + snap / 2) / snap * snap;
+                last = std::clamp(last, first, end_idx);
+            }
+            if (last <= first) {
+                continue;
+            }
+            Node node;
+            accumulate(view, m_levels, m_baseBlockSize, first, last, level, node);
+            // 首、最小、最大、尾按索引顺序输出，去掉重复的点
+            qint64 idx[ 4 ] = { first, node.minIdx, node.maxIdx, last - 1 };
+            std::sort(idx, idx + 4);
+            qint64 prev = -1;
+            for (qint64 i : idx) {
+                if (i >= 0 && i != prev) {
+                    appendIndex(view, i, out_x, out_y);
+                    prev = i;
+                }
+            }
+            first = last;
+        }
+    });
+}
+
+}  // namespace QIM
@@ -0,0 +1,98 @@
+#ifndef QIMMINMAXPYRAMID_H
+#define QIMMINMAXPYRAMID_H
+
+#include "QImPlotDataSeries.h"
+#include <vector>
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief Multi-resolution min/max index (LOD pyramid) over the Y values of an XY series
+ *
+ * @class QImMinMaxPyramid
+ *
+ * @details Level 0 stores, for every block of baseBlockSize() consecutive samples, the minimum and
+ *          maximum Y and their indices. Every higher level merges 4 blocks of the level below, so
+ *          level k covers baseBlockSize() * 4^k samples per block. First and last samples of a
+ *          block are implied by its index range. NaN samples are skipped.
+ *
+ *          decimate() reduces any index range to at most 4 points (first, min, max, last) per
+ *          pixel column by reading the level whose block is at most half a column wide, so the
+ *          per-frame cost depends on the pixel width and not on the sample count.
+ *          Column boundaries snap to block boundaries, the error stays below half a pixel.
+ *
+ *          update() indexes samples appended since the last call and only merges the new blocks
+ *          at each level. Sources with a ring-buffer offset, or that shrank, are rebuilt.
+ *          The source is not owned and must outlive the pyramid.
+ * @see QImMinMaxLTTBDownsampler::setViewRange()
+ * \endif
+ *
+ * \if CHINESE
+ * @brief XY 数据系列 Y 值的多分辨率最大/最小值索引（LOD 金字塔）
+ *
+ * @class QImMinMaxPyramid
+ *
+ * @details 第 0 层对每 baseBlockSize() 个连续点记录一个块：Y 的最小值、最大值及其索引。
+ *          每一层把下一层的 4 个块合并为一个，第 k 层每块覆盖 baseBlockSize() * 4^k 个点。
+ *          块的首尾点由其索引范围隐含给出。NaN 被跳过。
+ *
+ *          decimate() 把任意索引区间降为每个像素列最多 4 个点（首、最小、最大、尾），
+ *          读取块宽不超过半列的那一层，每帧的代价取决于像素宽度而不是数据点数。
+ *          列边界对齐到块边界，误差小于半个像素。
+ *
+ *          update() 只为上次调用后追加的点建立索引，每层只合并新增的块。
+ *          带环形缓冲 offset 或点数减少的数据会被重建。
+ *          不持有原始数据，原始数据的生命周期必须长于金字塔。
+ * @see QImMinMaxLTTBDownsampler::setViewRange()
+ * \endif
+ */
+class QIM_CORE_API QImMinMaxPyramid
+{
+public:
+    // 一个块的极值，索引为 -1 表示块内全部为 NaN
+    struct Node
+    {
+        double minY { 0.0 };
+        double maxY { 0.0 };
+        qint64 minIdx { -1 };
+        qint64 maxIdx { -1 };
+    };
+
+    explicit QImMinMaxPyramid(const QImAbstractXYDataSeries* source, int baseBlockSize = 64);
+    ~QImMinMaxPyramid() = default;
+
+    // 丢弃全部索引并重新构建（原始数据被修改而不只是追加时调用）
+    void rebuild();
+    // 为追加的点建立索引，每次调用的代价与新增点数成正比
+    void update();
+
+    // 已建立索引的点数（完整块覆盖的点）
+    qint64 indexedCount() const;
+    int baseBlockSize() const;
+    int levelCount() const;
+    qint64 blockSize(int level) const;
+    // 索引占用的字节数
+    qint64 memoryUsage() const;
+
+    // 把 [start_idx, end_idx) 降为每个像素列最多 4 个点，追加到 out_x/out_y，按索引顺序输出
+    void decimate(qint64 start_idx,
+                  qint64 end_idx,
+                  int columns,
+                  std::vector< double >& out_x,
+                  std::vector< double >& out_y) const;
+
+private:
+    void buildLevels(qint64 from_count);
+
+private:
+    const QImAbstractXYDataSeries* m_source { nullptr };
+    int m_baseBlockSize { 64 };
+    qint64 m_indexedCount { 0 };
+    std::vector< std::vector< Node > > m_levels;
+};
+
+}  // namespace QIM
+
+#endif  // QIMMINMAXPYRAMID_H
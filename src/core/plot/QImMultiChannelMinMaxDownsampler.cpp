@@ -0,0 +1,300 @@
+#include "QImMultiChannelMinMaxDownsampler.h"
+#include "QImPlotDataSeriesView.h"
+#include "QImPlotParallel.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace QIM
+{
+
+namespace
+{
+// 单个通道在当前桶内的极值
+struct BucketExtrema
+{
+    qint64 minIdx { -1 };
+    qint64 maxIdx { -1 };
+    double minV { 0.0 };
+    double maxV { 0.0 };
+
+    void reset()
+    {
+        minIdx = maxIdx = -1;
+    }
+
+    void add(qint64 i, double v)
+    {
+        if (std::isnan(v)) {
+            return;
+        }
+        if (minIdx < 0) {
+            minIdx = maxIdx = i;
+            minV = maxV = v;
+            return;
+        }
+        if (v < minV) {
+            minV   = v;
+            minIdx = i;
+        } else if (v > maxV) {
+            maxV   = v;
+            maxIdx = i;
+        }
+    }
+};
+
+template< typename View >
+void appendPoint(const View& x, const View& ch, qint64 i, std::vector< double >& outX, std::vector< double >& outY)
+{
+    outX.push_back(x.x(i));
+    outY.push_back(ch.y(i));
+}
+
+// 每个任务至少处理的行数（所有通道一起读取）
+constexpr qint64 kParallelGrainRows = 1 << 15;
+
+/**
+ * @brief 处理 [firstBucket, lastBucket) 内的桶，每个通道的结果追加到 outX/outY
+ */
+template< typename View >
+void multiChannelMinMaxBuckets(const std::vector< View >& views,
+                               bool rowMajor,
+                               qint64 buckets,
+                               qint64 firstBucket,
+                               qint64 lastBucket,
+                               std::vector< std::vector< double > >& outX,
+                               std::vector< std::vector< double > >& outY)
+{
+    const int channels = static_cast< int >(views.size());
+    const qint64 n     = views.front().count;
+    const View& xs     = views.front();
+    std::vector< BucketExtrema > ext(channels);
+
+    // 桶边界对所有通道相同，覆盖 [1, n-1)，首尾点单独保留
+    const qint64 inner = n - 2;
+    for (qint64 b = firstBucket; b < lastBucket; ++b) {
+        const qint64 lo = 1 + b * inner / buckets;
+        const qint64 hi = 1 + (b + 1) * inner / buckets;
+        if (lo >= hi) {
+            continue;
+        }
+        for (BucketExtrema& e : ext) {
+            e.reset();
+        }
+        if (rowMajor) {
+            // 同一行的各通道相邻，按行读取
+            for (qint64 i = lo; i < hi; ++i) {
+                for (int c = 0; c < channels; ++c) {
+                    ext[ c ].add(i, views[ c ].y(i));
+                }
+            }
+        } else {
+            for (int c = 0; c < channels; ++c) {
+                for (qint64 i = lo; i < hi; ++i) {
+                    ext[ c ].add(i, views[ c ].y(i));
+                }
+            }
+        }
+        for (int c = 0; c < channels; ++c) {
+            const BucketExtrema& e = ext[ c ];
+            if (e.minIdx < 0) {
+                continue;  // 整个桶都是NaN
+            }
+            const qint64 first = std::min(e.minIdx, e.maxIdx);
+            const qint64 last  = std::max(e.minIdx, e.maxIdx);
+            appendPoint(xs, views[ c ], first, outX[ c ], outY[ c ]);
+            if (last != first) {
+                appendPoint(xs, views[ c ], last, outX[ c ], outY[ c ]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 多通道最大/最小值降采样内核
+ * @param views 每个通道的视图（X 相同，Y 为各自通道），类型在调用前已分派
+ * @details 桶按固定大小分组并行处理，每组写入自己的缓冲，最后按组的顺序拼接，
+ *          结果与串行执行相同
+ */
+template< typename View >
+void multiChannelMinMaxKernel(const std::vector< View >& views,
+                              bool rowMajor,
+                              int targetPoints,
+                              std::vector< std::vector< double > >& outX,
+                              std::vector< std::vector< double > >& outY)
+{
+    const int channels   = static_cast< int >(views.size());
+    const qint64 n       = views.front().count;
+    const View& xs       = views.front();
+    const qint64 buckets = std::max< qint64 >(1, (targetPoints - 2) / 2);
+
+    for (int c = 0; c < channels; ++c) {
+        outX[ c ].reserve(static_cast< std::size_t >(buckets * 2 + 2));
+        outY[ c ].reserve(static_cast< std::size_t >(buckets * 2 + 2));
+        appendPoint(xs, views[ c ], 0, outX[ c ], outY[ c ]);
+    }
+    const qint64 rowsPerBucket = std::max< qint64 >(1, (n - 2) / buckets);
+    const qint64 grain         = std::max< qint64 >(1, kParallelGrainRows / rowsPerBucket);
+    const qint64 groups        = (buckets + grain - 1) / grain;
+    if (groups <= 1 || qimPlotThreadCount() <= 1) {
+        multiChannelMinMaxBuckets(views, rowMajor, buckets, 0, buckets, outX, outY);
+    } else {
+        std::vector< std::vector< std::vector< double > > > groupX(groups), groupY(groups);
+        qimPlotParallelFor(buckets, grain, [ & ](qint64 first, qint64 last) {
+            const qint64 g = first / grain;
+            groupX[ g ].resize(channels);
+            groupY[ g ].resize(channels);
+            multiChannelMinMaxBuckets(views, rowMajor, buckets, first, last, groupX[ g ], groupY[ g ]);
+        });
+        for (qint64 g = 0; g < groups; ++g) {
+            for (int c = 0; c < channels; ++c) {
+                outX[ c ].insert(outX[ c ].end(), groupX[ g ][ c ].begin(), groupX[ g ][ c ].end());
+                outY[ c ].insert(outY[ c ].end(), groupY[ g ][ c ].begin(), groupY[ g ][ c ].end());
+            }
+        }
+    }
+    for (int c = 0; c < channels; ++c) {
+        appendPoint(xs, views[ c ], n - 1, outX[ c ], outY[ c ]);
+    }
+}
+}  // namespace
+
+QImMultiChannelMinMaxDownsampler::QImMultiChannelMinMaxDownsampler(const QImAbstractMultiChannelDataSeries* source,
+                                                                   int targetPoints)
+    : m_source(source)
+{
+    assert(source && "Source must not be null");
+    m_targetPoints = std::max(targetPoints, 100);
+    downSampler();
+}
+
+void QImMultiChannelMinMaxDownsampler::setTargetPoints(int points)
+{
+    const int newPoints = std::max(points, 100);
+    if (newPoints != m_targetPoints) {
+        m_targetPoints = newPoints;
+        downSampler();
+    }
+}
+
+int QImMultiChannelMinMaxDownsampler::targetPoints() const
+{
+    return m_targetPoints;
+}
+
+void QImMultiChannelMinMaxDownsampler::downSampler()
+{
+    m_cachedValid = false;
+    m_cachedX.clear();
+    m_cachedY.clear();
+    m_channelBuckets.clear();
+    if (!m_source) {
+        return;
+    }
+    const qint64 n     = m_source->size();
+    const int channels = m_source->channelCount();
+    if (n <= m_targetPoints || n < 3 || channels <= 0) {
+        // 数据量不足，直接绘制原始数据
+        return;
+    }
+    m_cachedX.resize(channels);
+    m_cachedY.resize(channels);
+    const bool rowMajor = (m_source->layout() == QImAbstractMultiChannelDataSeries::RowMajor);
+    // 所有通道的存储类型相同，只分派一次
+    qimPlotVisitChannel(*m_source, 0, [ & ](const auto& first) {
+        using View = std::decay_t< decltype(first) >;
+        std::vector< View > views(channels, first);
+        for (int c = 1; c < channels; ++c) {
+            views[ c ].ys = static_cast< const char* >(m_source->channelRawPointer(c));
+        }
+        multiChannelMinMaxKernel(views, rowMajor, m_targetPoints, m_cachedX, m_cachedY);
+    });
+    m_cachedValid = true;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Call after rows were appended to the source
+ * @details The first call builds one QImIncrementalMinMaxBuckets per channel over all rows; later calls
+ *          only read the new rows, so a growing recording costs time proportional to the appended rows
+ *          plus targetPoints() per update instead of the full history. Buckets have a fixed width that
+ *          doubles as the stream grows, so the result keeps between about targetPoints() / 2 and
+ *          targetPoints() points per channel. A source that shrank is downsampled from scratch.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 原始数据追加了行后调用
+ * @details 第一次调用为每个通道对全部行建立 QImIncrementalMinMaxBuckets，之后只读取新增的行，
+ *          持续增长的记录每次更新的代价与新增行数加 targetPoints() 成正比，而不是全部历史数据。
+ *          桶宽固定并随数据增长加倍，每个通道保留约 targetPoints() / 2 到 targetPoints() 个点。
+ *          行数减少时重新降采样。
+ * \endif
+ */
+void QImMultiChannelMinMaxDownsampler::sourceAppended()
+{
+    if (!m_source) {
+        return;
+    }
+    const qint64 n     = m_source->size();
+    const int channels = m_source->channelCount();
+    if (static_cast< int >(m_channelBuckets.size()) != channels
+        || (!m_channelBuckets.empty() && m_channelBuckets.front().count() > n)) {
+        m_channelBuckets.assign(channels, QImIncrementalMinMaxBuckets((m_targetPoints - 2) / 2));
+    }
+    for (int c = 0; c < channels; ++c) {
+        qimPlotVisitChannel(*m_source, c, [ & ](const auto& view) { m_channelBuckets[ c ].append(view, n); });
+    }
+    m_cachedValid = false;
+    if (n <= m_targetPoints || n < 3 || channels <= 0) {
+        // 数据量不足，直接绘制原始数据
+        m_cachedX.clear();
+        m_cachedY.clear();
+        return;
+    }
+    m_cachedX.resize(channels);
+    m_cachedY.resize(channels);
+    std::vector< qint64 > retained;
+    for (int c = 0; c < channels; ++c) {
+        m_channelBuckets[ c ].retainedIndices(retained);
+        std::vector< double >& xs = m_cachedX[ c ];
+        std::vector< double >& ys = m_cachedY[ c ];
+        xs.clear();
+        ys.clear();
+        xs.reserve(retained.size());
+        ys.reserve(retained.size());
+        qimPlotVisitChannel(*m_source, c, [ & ](const auto& view) {
+            for (qint64 i : retained) {
+                xs.push_back(view.x(i));
+                ys.push_back(view.y(i));
+            }
+        });
+    }
+    m_cachedValid = true;
+}
+
+bool QImMultiChannelMinMaxDownsampler::isValid() const
+{
+    return m_cachedValid;
+}
+
+int QImMultiChannelMinMaxDownsampler::channelCount() const
+{
+    return static_cast< int >(m_cachedY.size());
+}
+
+int QImMultiChannelMinMaxDownsampler::size(int channel) const
+{
+    return (channel >= 0 && channel < channelCount()) ? static_cast< int >(m_cachedY[ channel ].size()) : 0;
+}
+
+const double* QImMultiChannelMinMaxDownsampler::xData(int channel) const
+{
+    return (channel >= 0 && channel < channelCount()) ? m_cachedX[ channel ].data() : nullptr;
+}
+
+const double* QImMultiChannelMinMaxDownsampler::yData(int channel) const
+{
+    return (channel >= 0 && channel < channelCount()) ? m_cachedY[ channel ].data() : nullptr;
+}
+
+}  // namespace QIM
@@ -0,0 +1,77 @@
+#ifndef QIMMULTICHANNELMINMAXDOWNSAMPLER_H
+#define QIMMULTICHANNELMINMAXDOWNSAMPLER_H
+
+#include "QImPlotMultiChannelDataSeries.h"
+#include "QImIncrementalMinMaxBuckets.h"
+#include <vector>
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief Min/max downsampler for all channels of a multi-channel series in one pass
+ *
+ * @class QImMultiChannelMinMaxDownsampler
+ *
+ * @details The sample range is split into (targetPoints - 2) / 2 index buckets shared by all channels.
+ *          Every bucket is read once for all channels: row by row for row-major matrices (the
+ *          channels of one row are adjacent in memory), channel by channel for column-major ones.
+ *          For each channel the bucket's minimum and maximum are kept in index order, the first
+ *          and last samples are always kept, NaN samples are skipped.
+ *
+ *          The per-channel result is plain double arrays (xData()/yData()) that can be passed
+ *          directly to ImPlot::PlotLine(). The source is not owned and must outlive the downsampler.
+ * @see QImPlotMultiLineItemNode
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 在一次遍历中对多通道数据的所有通道做最大/最小值降采样
+ *
+ * @class QImMultiChannelMinMaxDownsampler
+ *
+ * @details 把数据按索引划分为 (targetPoints - 2) / 2 个所有通道共享的桶。
+ *          每个桶对所有通道只读取一次：行主序矩阵按行读取（同一行的各通道在内存中相邻），
+ *          列主序矩阵逐通道读取。每个通道按索引顺序保留桶内的最小值与最大值，
+ *          始终保留首尾两个点，跳过 NaN。
+ *
+ *          每个通道的结果为 double 数组（xData()/yData()），可直接传给 ImPlot::PlotLine()。
+ *          不持有原始数据，原始数据的生命周期必须长于降采样器。
+ * @see QImPlotMultiLineItemNode
+ * \endif
+ */
+class QIM_CORE_API QImMultiChannelMinMaxDownsampler
+{
+public:
+    explicit QImMultiChannelMinMaxDownsampler(const QImAbstractMultiChannelDataSeries* source, int targetPoints = 2000);
+    ~QImMultiChannelMinMaxDownsampler() = default;
+
+    // 目标点数（每个通道），最小100
+    void setTargetPoints(int points);
+    int targetPoints() const;
+
+    // 对全量数据重新降采样，数据量不超过目标点数时不生成缓存
+    void downSampler();
+    // 原始数据追加了行后调用：每个通道的最大/最小值分桶只处理新增的行，行数减少时重新降采样
+    void sourceAppended();
+    // 缓存是否有效（无效时应直接绘制原始数据）
+    bool isValid() const;
+
+    int channelCount() const;
+    // 通道 channel 降采样后的点数
+    int size(int channel) const;
+    const double* xData(int channel) const;
+    const double* yData(int channel) const;
+
+private:
+    const QImAbstractMultiChannelDataSeries* m_source { nullptr };
+    int m_targetPoints { 2000 };
+    bool m_cachedValid { false };
+    std::vector< std::vector< double > > m_cachedX;
+    std::vector< std::vector< double > > m_cachedY;
+    std::vector< QImIncrementalMinMaxBuckets > m_channelBuckets;  ///< 第一次追加时建立，之后增量更新
+};
+
+}  // namespace QIM
+
+#endif  // QIMMULTICHANNELMINMAXDOWNSAMPLER_H
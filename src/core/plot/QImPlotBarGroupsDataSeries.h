@@ -275,7 +275,7 @@ public:
     virtual ~QImVectorBarGroupsDataSeries() = default;
 
     // QImAbstractPlotDataSeries interface
-    int size() const override
+    qint64 size() const override
     {
         return m_itemCount * m_groupCount;
     }
@@ -15,7 +15,7 @@ class QImPlotBarsItemNode::PrivateData
 public:
     PrivateData(QImPlotBarsItemNode* p);
 
-    std::unique_ptr< QImAbstractXYDataSeries > data;
+    std::shared_ptr< QImAbstractXYDataSeries > data;
     ImPlotBarsFlags flags { ImPlotBarsFlags_None };
     double barWidth { 0.67 };  ///< Bar width in plot units
     // Style tracking values
@@ -66,9 +66,25 @@ QImPlotBarsItemNode::~QImPlotBarsItemNode()
  * \endif
  */
 void QImPlotBarsItemNode::setData(QImAbstractXYDataSeries* series)
+{
+    setSharedData(std::shared_ptr< QImAbstractXYDataSeries >(series));
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set a data series that may be shared with other items or inspection tools
+ * @param series Shared series, the item keeps a reference until the next setData()/setSharedData()
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置可与其它绘图项或检查工具共享的数据系列
+ * @param series 共享的数据系列，绘图项持有其引用直到下一次 setData()/setSharedData()
+ * \endif
+ */
+void QImPlotBarsItemNode::setSharedData(std::shared_ptr< QImAbstractXYDataSeries > series)
 {
     QIM_D(d);
-    d->data.reset(series);
+    d->data = std::move(series);
     emit dataChanged();
 }
 
@@ -88,6 +104,11 @@ QImAbstractXYDataSeries* QImPlotBarsItemNode::data() const
     return d_ptr->data.get();
 }
 
+std::shared_ptr< QImAbstractXYDataSeries > QImPlotBarsItemNode::sharedData() const
+{
+    return d_ptr->data;
+}
+
 /**
  * \if ENGLISH
  * @brief Get bar width in plot units
@@ -289,11 +310,13 @@ bool QImPlotBarsItemNode::beginDraw()
     }
 
     // Call ImPlot API
-    if (d->data->isContiguous()) {
+    // One bar per sample, ImPlot takes an int count: draw at most INT_MAX samples
+    const int count = static_cast< int >(std::min(d->data->size(), qimPlotMaxDrawCount()));
+    if (d->data->isPackedDoubleData()) {
         // Continuous memory mode: use zero-copy fast path
         const double* xData = d->data->xRawData();
         const double* yData = d->data->yRawData();
-        int size            = d->data->size();
+        const int size      = count;
 
         if (xData) {
             // XY mode
@@ -320,7 +343,7 @@ bool QImPlotBarsItemNode::beginDraw()
                 return ImPlotPoint(series->xValue(idx), series->yValue(idx));
             },
             d->data.get(),
-            d->data->size(),
+            count,
             d->barWidth,
             d->flags);
     }
@@ -3,6 +3,7 @@
 #include <QColor>
 #include "QImPlotItemNode.h"
 #include "QImPlotDataSeries.h"
+#include <memory>
 
 namespace QIM
 {
@@ -149,6 +150,8 @@ public:
 
     // Sets the data series for the bar chart
     void setData(QImAbstractXYDataSeries* series);
+    // Sets a series shared with other items, kept alive while this item uses it
+    void setSharedData(std::shared_ptr< QImAbstractXYDataSeries > series);
 
     // Sets bar chart data from X and Y containers
     template< typename ContainerX, typename ContainerY >
@@ -160,6 +163,8 @@ public:
 
     // Gets the current data series
     QImAbstractXYDataSeries* data() const;
+    // Gets the current data series as a shared reference
+    std::shared_ptr< QImAbstractXYDataSeries > sharedData() const;
 
     //----------------------------------------------------
     // Style property accessors
@@ -0,0 +1,340 @@
+#ifndef QIMPLOTCHUNKEDDATASERIES_H
+#define QIMPLOTCHUNKEDDATASERIES_H
+
+#include "QImPlotDataSeries.h"
+#include <QtGlobal>
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief XY data series stored in fixed-size chunks (non-contiguous)
+ *
+ * @class QImChunkedXYDataSeries
+ * @ingroup plot_data
+ *
+ * @details Keeps long histories as a deque of blocks of 2^chunkShift samples (64K by default).
+ *          Appending never moves existing samples, and removeFirst() evicts old data by
+ *          releasing whole blocks, so neither operation is O(size()).
+ *
+ *          isContiguous() is false; chunkLayout() describes the blocks so items render them
+ *          through ImPlot getters specialized at compile time for TX/TY and the block layout,
+ *          and the downsamplers read them without a virtual call per point.
+ *
+ * @tparam TX X element type (double, float or integer)
+ * @tparam TY Y element type, defaults to TX
+ * @note After appending or evicting, call notifyDataAppended() on line/scatter items.
+ * @see QImAbstractXYDataSeries, QImPlotChunkLayout
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 以定长分块存储（非连续）的 XY 数据系列
+ *
+ * @class QImChunkedXYDataSeries
+ * @ingroup plot_data
+ *
+ * @details 以双端队列保存长历史数据，每块 2^chunkShift 个点（默认 64K）。
+ *          追加数据不会移动已有数据，removeFirst() 以整块释放的方式淘汰旧数据，两者都不是 O(size())。
+ *
+ *          isContiguous() 为 false；chunkLayout() 描述分块布局，绘图项据此使用针对 TX/TY 与块布局
+ *          编译期特化的 ImPlot getter 绘制，降采样器读取时也没有逐点的虚函数调用。
+ *
+ * @tparam TX X 元素类型（double、float 或整数）
+ * @tparam TY Y 元素类型，默认与 TX 相同
+ * @note 追加或淘汰数据后，需调用线/散点绘图项的 notifyDataAppended()。
+ * @see QImAbstractXYDataSeries, QImPlotChunkLayout
+ * \endif
+ */
+template< typename TX = double, typename TY = TX >
+class QImChunkedXYDataSeries : public QImAbstractXYDataSeries
+{
+public:
+    static_assert(std::is_arithmetic_v< TX > && !std::is_same_v< TX, bool >, "TX must be numeric");
+    static_assert(std::is_arithmetic_v< TY > && !std::is_same_v< TY, bool >, "TY must be numeric");
+
+    // XY 模式，chunkShift 为每块点数的以2为底的对数
+    explicit QImChunkedXYDataSeries(int chunkShift = 16) : QImAbstractXYDataSeries(), m_shift(qBound(4, chunkShift, 24))
+    {
+        setBoundsXMonotonic(true);
+    }
+
+    // Y-only 模式，x = xStart + index * xScale，淘汰旧数据时 xStart 随之前移
+    QImChunkedXYDataSeries(double xStart, double xScale, int chunkShift = 16)
+        : QImAbstractXYDataSeries(), m_shift(qBound(4, chunkShift, 24)), m_yOnly(true), m_xStart(xStart), m_xScale(xScale)
+    {
+    }
+
+    ~QImChunkedXYDataSeries() override = default;
+
+    qint64 size() const override
+    {
+        return m_size;
+    }
+
+    bool isContiguous() const override
+    {
+        return false;
+    }
+
+    const double* yRawData() const override
+    {
+        return nullptr;
+    }
+
+    const void* yRawPointer() const override
+    {
+        return nullptr;
+    }
+
+    QImPlotValueType xValueType() const override
+    {
+        return qimPlotValueType< TX >();
+    }
+
+    QImPlotValueType yValueType() const override
+    {
+        return qimPlotValueType< TY >();
+    }
+
+    double xScale() const override
+    {
+        return m_xScale;
+    }
+
+    double xStart() const override
+    {
+        return m_xStart + static_cast< double >(m_removed) * m_xScale;
+    }
+
+    double xValue(qint64 index) const override
+    {
+        if (index < 0 || index >= m_size) {
+            return std::numeric_limits< double >::quiet_NaN();
+        }
+        if (m_yOnly) {
+            return xStart() + m_xScale * index;
+        }
+        const qint64 j = index + m_first;
+        return static_cast< double >(m_xChunks[ j >> m_shift ][ j & mask() ]);
+    }
+
+    double yValue(qint64 index) const override
+    {
+        if (index < 0 || index >= m_size) {
+            return std::numeric_limits< double >::quiet_NaN();
+        }
+        const qint64 j = index + m_first;
+        return static_cast< double >(m_yChunks[ j >> m_shift ][ j & mask() ]);
+    }
+
+    bool chunkLayout(QImPlotChunkLayout& layout) const override
+    {
+        if (m_size <= 0) {
+            return false;
+        }
+        layout.xChunks    = m_yOnly ? nullptr : m_xPtrs.data();
+        layout.yChunks    = m_yPtrs.data();
+        layout.chunkCount = static_cast< int >(m_yPtrs.size());
+        layout.chunkShift = m_shift;
+        layout.first      = m_first;
+        return true;
+    }
+
+    // 追加一个 XY 点
+    void append(TX x, TY y)
+    {
+        if (!m_yOnly) {
+            trackXOrder(&x, 1);
+        }
+        const qint64 j = reserveOne();
+        if (!m_yOnly) {
+            m_xChunks[ j >> m_shift ][ j & mask() ] = x;
+        }
+        m_yChunks[ j >> m_shift ][ j & mask() ] = y;
+    }
+
+    // 追加一个 Y 点，仅用于 Y-only 模式（XY 模式下断言失败并忽略）
+    void append(TY y)
+    {
+        Q_ASSERT(m_yOnly);
+        if (!m_yOnly) {
+            return;
+        }
+        append(TX(), y);
+    }
+
+    // 批量追加，xs 在 Y-only 模式下忽略（可为 nullptr），XY 模式下必须提供；按块整段拷贝
+    void appendBatch(const TX* xs, const TY* ys, int count)
+    {
+        if (!ys || count <= 0) {
+            return;
+        }
+        // XY 模式下缺少 X 会留下未初始化的 X 值
+        Q_ASSERT(m_yOnly || xs);
+        if (!m_yOnly && !xs) {
+            return;
+        }
+        if (!m_yOnly) {
+            trackXOrder(xs, count);
+        }
+        int done = 0;
+        while (done < count) {
+            const qint64 j = m_first + m_size;
+            if ((j >> m_shift) >= static_cast< qint64 >(m_yChunks.size())) {
+                addChunk();
+            }
+            const int within = static_cast< int >(j & mask());
+            const int n      = std::min(count - done, chunkSize() - within);
+            std::memcpy(m_yChunks[ j >> m_shift ].get() + within, ys + done, sizeof(TY) * n);
+            if (!m_yOnly) {
+                std::memcpy(m_xChunks[ j >> m_shift ].get() + within, xs + done, sizeof(TX) * n);
+            }
+            m_size += n;
+            done += n;
+        }
+    }
+
+    // 批量追加 Y，仅用于 Y-only 模式（XY 模式下断言失败并忽略）
+    void appendBatch(const TY* ys, int count)
+    {
+        appendBatch(nullptr, ys, count);
+    }
+
+    // 淘汰最旧的 count 个点，整块不再使用时立即释放
+    void removeFirst(qint64 count)
+    {
+        count = qBound< qint64 >(0, count, m_size);
+        // 被淘汰的点位于范围边界上时缓存失效，否则缓存的范围仍然准确；X 单调时 X 范围由首尾点给出，只检查 Y
+        const bool checkX = !m_yOnly && !m_xSorted;
+        for (qint64 j = m_first; j < m_first + count && isBoundsCached(); ++j) {
+            const double x = checkX ? static_cast< double >(m_xChunks[ j >> m_shift ][ j & mask() ])
+                                    : std::numeric_limits< double >::quiet_NaN();
+            evictBounds(x, static_cast< double >(m_yChunks[ j >> m_shift ][ j & mask() ]));
+        }
+        dropBoundsFront(count);
+        const qint64 first = m_first + count;
+        const qint64 drop  = std::min< qint64 >(first >> m_shift, static_cast< qint64 >(m_yChunks.size()));
+        for (qint64 k = 0; k < drop; ++k) {
+            m_yChunks.pop_front();
+            if (!m_yOnly) {
+                m_xChunks.pop_front();
+            }
+        }
+        m_first = static_cast< int >(first - (drop << m_shift));
+        m_size -= count;
+        m_removed += count;
+        rebuildPointers();
+    }
+
+    // 清空所有数据并释放全部块
+    void clear()
+    {
+        m_xChunks.clear();
+        m_yChunks.clear();
+        m_first   = 0;
+        m_size    = 0;
+        m_removed = 0;
+        m_xSorted = true;
+        setBoundsXMonotonic(!m_yOnly);
+        rebuildPointers();
+        invalidateBounds();
+    }
+
+    // 每块点数
+    int chunkSize() const
+    {
+        return 1 << m_shift;
+    }
+
+    // 当前块数
+    int chunkCount() const
+    {
+        return static_cast< int >(m_yChunks.size());
+    }
+
+    bool isYOnly() const
+    {
+        return m_yOnly;
+    }
+
+private:
+    int mask() const
+    {
+        return chunkSize() - 1;
+    }
+
+    // 追加前调用：X 一旦出现非有限值或递减即不再视为单调（直到 clear()）
+    void trackXOrder(const TX* xs, int count)
+    {
+        if (!m_xSorted) {
+            return;
+        }
+        double last = (m_size > 0) ? xValue(m_size - 1) : -std::numeric_limits< double >::infinity();
+        for (int i = 0; i < count; ++i) {
+            const double x = static_cast< double >(xs[ i ]);
+            if (!(std::isfinite(x) && x >= last)) {
+                m_xSorted = false;
+                setBoundsXMonotonic(false);
+                return;
+            }
+            last = x;
+        }
+    }
+
+    qint64 reserveOne()
+    {
+        const qint64 j = m_first + m_size;
+        if ((j >> m_shift) >= static_cast< qint64 >(m_yChunks.size())) {
+            addChunk();
+        }
+        ++m_size;
+        return j;
+    }
+
+    void addChunk()
+    {
+        m_yChunks.emplace_back(new TY[ chunkSize() ]);
+        if (!m_yOnly) {
+            m_xChunks.emplace_back(new TX[ chunkSize() ]);
+        }
+        rebuildPointers();
+    }
+
+    // 块指针数组只在增删块时重建（每 chunkSize() 个点一次）
+    void rebuildPointers()
+    {
+        m_yPtrs.resize(m_yChunks.size());
+        std::transform(m_yChunks.begin(), m_yChunks.end(), m_yPtrs.begin(), [](const auto& c) {
+            return static_cast< const void* >(c.get());
+        });
+        m_xPtrs.resize(m_xChunks.size());
+        std::transform(m_xChunks.begin(), m_xChunks.end(), m_xPtrs.begin(), [](const auto& c) {
+            return static_cast< const void* >(c.get());
+        });
+    }
+
+private:
+    std::deque< std::unique_ptr< TX[] > > m_xChunks;
+    std::deque< std::unique_ptr< TY[] > > m_yChunks;
+    std::vector< const void* > m_xPtrs;
+    std::vector< const void* > m_yPtrs;
+    int m_shift { 16 };
+    int m_first { 0 };  ///< 第一个有效点在首块中的位置
+    qint64 m_size { 0 };
+    qint64 m_removed { 0 };  ///< 已淘汰的点数，用于 Y-only 模式下推算 xStart
+    bool m_yOnly { false };
+    bool m_xSorted { true };  ///< XY 模式下 X 是否有限且单调递增
+    double m_xStart { 0.0 };
+    double m_xScale { 1.0 };
+};
+
+}  // namespace QIM
+
+#endif  // QIMPLOTCHUNKEDDATASERIES_H
@@ -0,0 +1,311 @@
+#ifndef QIMPLOTCOLUMNDATASERIES_H
+#define QIMPLOTCOLUMNDATASERIES_H
+
+#include "QImPlotDataSeries.h"
+#include <QtGlobal>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief Reference-counted column of samples that several series can share
+ *
+ * @class QImDataColumn
+ * @ingroup plot_data
+ *
+ * @details Always handled through std::shared_ptr (see create()). A multi-channel recording keeps
+ *          one timestamp column and hands it to the QImColumnXYDataSeries of every channel, so
+ *          64 channels hold one copy of X instead of 64. Appending through the owner's non-const
+ *          pointer is seen by every series using the column; call notifyDataAppended() on the items.
+ *          clear() bumps revision(), the series using the column then rescan their bounds.
+ *
+ * @tparam T Element type (double, float or integer)
+ * @see QImColumnXYDataSeries
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 可被多个数据系列共享的引用计数数据列
+ *
+ * @class QImDataColumn
+ * @ingroup plot_data
+ *
+ * @details 总是通过 std::shared_ptr 使用（见 create()）。多通道记录只保留一个时间戳列，
+ *          并交给每个通道的 QImColumnXYDataSeries，64 个通道只保存一份 X 而不是 64 份。
+ *          通过持有者的非 const 指针追加数据后，所有使用该列的数据系列都能看到；需调用绘图项的 notifyDataAppended()。
+ *          clear() 使 revision() 加一，使用该列的数据系列随后重新扫描数据范围。
+ *
+ * @tparam T 元素类型（double、float 或整数）
+ * @see QImColumnXYDataSeries
+ * \endif
+ */
+template< typename T >
+class QImDataColumn
+{
+public:
+    static_assert(std::is_arithmetic_v< T > && !std::is_same_v< T, bool >, "T must be numeric");
+    using ValueType = T;
+
+    QImDataColumn() = default;
+    explicit QImDataColumn(std::vector< T > values) : m_values(std::move(values))
+    {
+    }
+
+    // 创建共享的数据列
+    static std::shared_ptr< QImDataColumn< T > > create(std::vector< T > values = std::vector< T >())
+    {
+        return std::make_shared< QImDataColumn< T > >(std::move(values));
+    }
+
+    qint64 size() const
+    {
+        return static_cast< qint64 >(m_values.size());
+    }
+
+    bool isEmpty() const
+    {
+        return m_values.empty();
+    }
+
+    const T* constData() const
+    {
+        return m_values.data();
+    }
+
+    T at(qint64 index) const
+    {
+        return m_values[ static_cast< std::size_t >(index) ];
+    }
+
+    const std::vector< T >& values() const
+    {
+        return m_values;
+    }
+
+    // 追加一个值
+    void append(T value)
+    {
+        m_values.push_back(value);
+    }
+
+    // 批量追加
+    void append(const T* values, qint64 count)
+    {
+        if (values && count > 0) {
+            m_values.insert(m_values.end(), values, values + count);
+        }
+    }
+
+    // 预留容量，避免流式追加时反复扩容
+    void reserve(qint64 capacity)
+    {
+        m_values.reserve(static_cast< std::size_t >(capacity));
+    }
+
+    // 清空数据，使用该列的数据系列的范围缓存随之失效
+    void clear()
+    {
+        m_values.clear();
+        ++m_revision;
+    }
+
+    // 每次 clear() 加一，追加不改变
+    quint64 revision() const
+    {
+        return m_revision;
+    }
+
+private:
+    std::vector< T > m_values;
+    quint64 m_revision { 0 };
+};
+
+/**
+ * \if ENGLISH
+ * @brief XY data series over shared QImDataColumn instances
+ *
+ * @class QImColumnXYDataSeries
+ * @ingroup plot_data
+ *
+ * @details Holds const references to its X and Y columns, so the columns live as long as any series
+ *          (and through QImPlotLineItemNode::setSharedData() any item) still uses them.
+ *          size() is the shorter of both columns, which keeps channels that are appended one
+ *          after the other consistent. Raw pointers are the columns' own storage, items call
+ *          the typed ImPlot API without copying.
+ *
+ * @tparam TX X element type
+ * @tparam TY Y element type, defaults to TX
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 基于共享 QImDataColumn 的 XY 数据系列
+ *
+ * @class QImColumnXYDataSeries
+ * @ingroup plot_data
+ *
+ * @details 以 const 引用持有 X、Y 数据列，只要还有数据系列（以及通过 QImPlotLineItemNode::setSharedData()
+ *          持有它的绘图项）在使用，数据列就不会被释放。size() 取两列中较短者，
+ *          各通道先后追加时也保持一致。原始指针即数据列自身的存储，绘图项直接调用类型化的 ImPlot 接口，不拷贝。
+ *
+ * @tparam TX X 元素类型
+ * @tparam TY Y 元素类型，默认与 TX 相同
+ * \endif
+ */
+template< typename TX = double, typename TY = TX >
+class QImColumnXYDataSeries : public QImAbstractXYDataSeries
+{
+public:
+    using XColumn = QImDataColumn< TX >;
+    using YColumn = QImDataColumn< TY >;
+
+    // XY 模式，X、Y 均为共享的数据列
+    QImColumnXYDataSeries(std::shared_ptr< const XColumn > x, std::shared_ptr< const YColumn > y)
+        : QImAbstractXYDataSeries()
+        , m_x(std::move(x))
+        , m_y(std::move(y))
+        , m_xRevision(m_x ? m_x->revision() : 0)
+        , m_yRevision(m_y ? m_y->revision() : 0)
+    {
+    }
+
+    // Y-only 模式，x = xStart + index * xScale
+    QImColumnXYDataSeries(std::shared_ptr< const YColumn > y, double xStart, double xScale)
+        : QImAbstractXYDataSeries()
+        , m_y(std::move(y))
+        , m_xStart(xStart)
+        , m_xScale(xScale)
+        , m_yRevision(m_y ? m_y->revision() : 0)
+    {
+    }
+
+    ~QImColumnXYDataSeries() override = default;
+
+    // 数据列被清空过时丢弃范围缓存，清空后重新填充到原有长度也不会沿用旧范围
+    QImPlotDataBounds bounds() const override
+    {
+        const quint64 xRevision = m_x ? m_x->revision() : 0;
+        const quint64 yRevision = m_y ? m_y->revision() : 0;
+        if (xRevision != m_xRevision || yRevision != m_yRevision) {
+            m_xRevision = xRevision;
+            m_yRevision = yRevision;
+            invalidateBounds();
+        }
+        return QImAbstractXYDataSeries::bounds();
+    }
+
+    qint64 size() const override
+    {
+        if (!m_y) {
+            return 0;
+        }
+        return m_x ? std::min(m_x->size(), m_y->size()) : m_y->size();
+    }
+
+    bool isContiguous() const override
+    {
+        return true;
+    }
+
+    int stride() const override
+    {
+        return sizeof(TY);
+    }
+
+    int xStride() const override
+    {
+        return sizeof(TX);
+    }
+
+    const double* xRawData() const override
+    {
+        if constexpr (std::is_same_v< TX, double >) {
+            return m_x ? m_x->constData() : nullptr;
+        } else {
+            return nullptr;
+        }
+    }
+
+    const double* yRawData() const override
+    {
+        if constexpr (std::is_same_v< TY, double >) {
+            return m_y ? m_y->constData() : nullptr;
+        } else {
+            return nullptr;
+        }
+    }
+
+    QImPlotValueType xValueType() const override
+    {
+        return qimPlotValueType< TX >();
+    }
+
+    QImPlotValueType yValueType() const override
+    {
+        return qimPlotValueType< TY >();
+    }
+
+    const void* xRawPointer() const override
+    {
+        return m_x ? m_x->constData() : nullptr;
+    }
+
+    const void* yRawPointer() const override
+    {
+        return m_y ? m_y->constData() : nullptr;
+    }
+
+    double xScale() const override
+    {
+        return m_xScale;
+    }
+
+    double xStart() const override
+    {
+        return m_xStart;
+    }
+
+    double xValue(qint64 index) const override
+    {
+        if (index < 0 || index >= size()) {
+            return std::numeric_limits< double >::quiet_NaN();
+        }
+        if (!m_x) {
+            return m_xStart + m_xScale * index;
+        }
+        return static_cast< double >(m_x->at(index));
+    }
+
+    double yValue(qint64 index) const override
+    {
+        if (index < 0 || index >= size()) {
+            return std::numeric_limits< double >::quiet_NaN();
+        }
+        return static_cast< double >(m_y->at(index));
+    }
+
+    // X 数据列，Y-only 模式为 nullptr
+    std::shared_ptr< const XColumn > xColumn() const
+    {
+        return m_x;
+    }
+
+    std::shared_ptr< const YColumn > yColumn() const
+    {
+        return m_y;
+    }
+
+private:
+    std::shared_ptr< const XColumn > m_x;
+    std::shared_ptr< const YColumn > m_y;
+    double m_xStart { 0.0 };
+    double m_xScale { 1.0 };
+    mutable quint64 m_xRevision { 0 };  ///< 范围缓存对应的数据列版本
+    mutable quint64 m_yRevision { 0 };
+};
+
+}  // namespace QIM
+
+#endif  // QIMPLOTCOLUMNDATASERIES_H
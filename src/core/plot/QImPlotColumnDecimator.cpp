@@ -0,0 +1,408 @@
+#include "QImPlotColumnDecimator.h"
+#include "QImPlotDataSeries.h"
+#include "QImPlotDataSeriesView.h"
+#include "QImPlotErrorDataSeries.h"
+#include "QImPlotMinMaxKernel.h"
+#include "QImPlotParallel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace QIM
+{
+
+namespace
+{
+// 每个任务至少处理的原始点数，太小的任务调度开销超过计算量
+constexpr qint64 kParallelGrainSamples = 1 << 16;
+// 每列最多保留的原始点索引数
+constexpr int kMaxSlotsPerColumn = 4;
+
+// [lo, hi) 中第一个 X >= value 的位置（要求 X 单调递增）
+template< typename View >
+qint64 lowerBoundX(const View& view, qint64 lo, qint64 hi, double value)
+{
+    while (lo < hi) {
+        const qint64 mid = lo + (hi - lo) / 2;
+        if (view.x(mid) < value) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// [first, count) 内的 X 是否单调递增
+template< typename View >
+bool isSortedX(const View& view, qint64 first)
+{
+    double last = -std::numeric_limits< double >::infinity();
+    for (qint64 i = first; i < view.count; ++i) {
+        const double x = view.x(i);
+        if (!(x >= last)) {
+            return false;
+        }
+        last = x;
+    }
+    return true;
+}
+
+int slotsPerColumn(QImPlotColumnDecimator::Reducer reducer)
+{
+    switch (reducer) {
+    case QImPlotColumnDecimator::ReduceM4:
+        return 4;
+    case QImPlotColumnDecimator::ReduceErrorBars:
+        return 1;
+    default:
+        return 2;
+    }
+}
+
+// 单列的归约结果：保留的原始点索引（-1 为空），以及包络或误差的上下界
+struct ColumnResult
+{
+    qint64 idx[ kMaxSlotsPerColumn ] = { -1, -1, -1, -1 };
+    double low { 0.0 };
+    double high { 0.0 };
+};
+
+// 把索引排序去重后写入列结果
+void storeSortedUnique(ColumnResult& out, qint64* idx, int n)
+{
+    std::sort(idx, idx + n);
+    int k = 0;
+    for (int j = 0; j < n; ++j) {
+        if (idx[ j ] >= 0 && (k == 0 || out.idx[ k - 1 ] != idx[ j ])) {
+            out.idx[ k++ ] = idx[ j ];
+        }
+    }
+}
+}  // namespace
+
+QImPlotColumnDecimator::QImPlotColumnDecimator(Reducer reducer) : m_reducer(reducer)
+{
+}
+
+QImPlotColumnDecimator::Reducer QImPlotColumnDecimator::reducer() const
+{
+    return m_reducer;
+}
+
+void QImPlotColumnDecimator::setThreshold(qint64 points)
+{
+    if (points != m_threshold) {
+        m_threshold = points;
+        m_dirty     = true;
+    }
+}
+
+qint64 QImPlotColumnDecimator::threshold() const
+{
+    return m_threshold;
+}
+
+void QImPlotColumnDecimator::setEnvelopeReference(const QImAbstractXYDataSeries* series2, double reference)
+{
+    if (series2 != m_series2 || reference != m_reference) {
+        m_series2   = series2;
+        m_reference = reference;
+        m_dirty     = true;
+    }
+}
+
+void QImPlotColumnDecimator::invalidate()
+{
+    m_dirty = true;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Decimates the visible part of @p series into one group of values per pixel column
+ * @param series Data drawn by the item
+ * @param x_min Left limit of the visible X range
+ * @param x_max Right limit of the visible X range
+ * @param pixel_width Width of the plot area in pixels, <= 0 when no view is available this frame
+ * @return true if the result (xs(), ys(), ...) should be drawn instead of @p series
+ * @details The result is recomputed only when the range, the pixel width, the series or its size
+ *          changed, or after invalidate(). One sample on each side of the range is kept so the item
+ *          reaches the plot edges.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 把 @p series 的可见部分按像素列降采样
+ * @param series 绘图项绘制的数据
+ * @param x_min 可见 X 范围的左边界
+ * @param x_max 可见 X 范围的右边界
+ * @param pixel_width 绘图区的像素宽度，本帧没有视图时 <= 0
+ * @return 返回 true 时应绘制降采样结果（xs()、ys() 等）代替 @p series
+ * @details 只有范围、像素宽度、数据系列或其点数变化，或调用了 invalidate() 后才重新计算。
+ *          范围两侧各多保留一个点，使图元延伸到绘图区边缘。
+ * \endif
+ */
+bool QImPlotColumnDecimator::update(const QImAbstractXYDataSeries& series, double x_min, double x_max, int pixel_width)
+{
+    if (!prepare(series, x_min, x_max, pixel_width)) {
+        return m_valid;
+    }
+    decimate(series, nullptr);
+    return m_valid;
+}
+
+bool QImPlotColumnDecimator::update(const QImAbstractErrorDataSeries& series, double x_min, double x_max, int pixel_width)
+{
+    if (!prepare(series, x_min, x_max, pixel_width)) {
+        return m_valid;
+    }
+    decimate(series, &series);
+    return m_valid;
+}
+
+int QImPlotColumnDecimator::count() const
+{
+    return static_cast< int >(m_x.size());
+}
+
+const double* QImPlotColumnDecimator::xs() const
+{
+    return m_x.data();
+}
+
+const double* QImPlotColumnDecimator::ys() const
+{
+    return m_y.data();
+}
+
+const double* QImPlotColumnDecimator::lowerYs() const
+{
+    return m_low.data();
+}
+
+const double* QImPlotColumnDecimator::upperYs() const
+{
+    return m_high.data();
+}
+
+const double* QImPlotColumnDecimator::negErrors() const
+{
+    return m_low.data();
+}
+
+const double* QImPlotColumnDecimator::posErrors() const
+{
+    return m_high.data();
+}
+
+// 检查缓存并确定本次计算的索引范围与列数，返回 false 表示沿用当前结果
+bool QImPlotColumnDecimator::prepare(const QImAbstractXYDataSeries& series, double x_min, double x_max, int pixel_width)
+{
+    const qint64 size = series.size();
+    const bool view   = pixel_width > 0 && x_min < x_max;
+    if (!view) {
+        // 自适应帧：按全部数据与上一次的像素宽度计算，范围记为 NaN 以区别于视图模式
+        x_min       = std::numeric_limits< double >::quiet_NaN();
+        x_max       = x_min;
+        pixel_width = m_last_pixel_width;
+    }
+    const bool same_key = m_key_series == &series && m_key_size == size && m_key_pixel_width == pixel_width
+                          && (view ? (m_key_x_min == x_min && m_key_x_max == x_max) : std::isnan(m_key_x_min));
+    if (!m_dirty && same_key) {
+        return false;
+    }
+    // X 的有序性只在数据变化时检查；同一数据系列只是变长时，只检查新数据及其前一个点
+    const bool grown = !m_dirty && m_key_series == &series && m_key_size > 0 && size > m_key_size;
+    if (grown) {
+        if (m_sorted) {
+            m_sorted = qimPlotVisitXYSeries(series, [ &series, this ](const auto& s) {
+                return s.isYOnly() ? series.xScale() > 0 : isSortedX(s, m_key_size - 1);
+            });
+        }
+    } else if (m_dirty || m_key_series != &series || m_key_size != size) {
+        m_sorted = qimPlotVisitXYSeries(series, [ &series ](const auto& s) {
+            return s.isYOnly() ? series.xScale() > 0 : isSortedX(s, 0);
+        });
+    }
+    m_dirty            = false;
+    m_key_series       = &series;
+    m_key_size         = size;
+    m_key_x_min        = x_min;
+    m_key_x_max        = x_max;
+    m_key_pixel_width  = pixel_width;
+    m_last_pixel_width = pixel_width;
+
+    m_valid = false;
+    if (size <= m_threshold || (m_series2 && m_series2->size() < size)) {
+        return false;
+    }
+    m_start   = 0;
+    m_end     = size;
+    m_columns = pixel_width;
+    if (m_sorted) {
+        qimPlotVisitXYSeries(series, [ & ](const auto& s) {
+            if (view) {
+                // lowerBound 得到第一个 >= x_max 的点，正好是右侧多保留的一个点
+                m_start = std::max< qint64 >(0, lowerBoundX(s, 0, size, x_min) - 1);
+                m_end   = std::min(size, lowerBoundX(s, m_start, size, x_max) + 1);
+            } else {
+                x_min = s.x(0);
+                x_max = s.x(size - 1);
+            }
+        });
+    }
+    // 列的划分范围（自适应帧为全部数据的 X 范围）
+    m_x_min = x_min;
+    m_x_max = x_max;
+    return true;
+}
+
+// 各列并行归约，再按列顺序串行压缩，结果与线程数无关
+void QImPlotColumnDecimator::decimate(const QImAbstractXYDataSeries& series, const QImAbstractErrorDataSeries* errors)
+{
+    const double x_min = m_x_min;
+    const double x_max = m_x_max;
+    m_x.clear();
+    m_y.clear();
+    m_low.clear();
+    m_high.clear();
+
+    const qint64 n    = m_end - m_start;
+    const int columns = m_columns;
+    const int slots   = slotsPerColumn(m_reducer);
+    if (n <= 0 || columns <= 0) {
+        return;
+    }
+    const bool by_x   = m_sorted && x_min < x_max;
+    const double step = by_x ? (x_max - x_min) / columns : 0.0;
+    std::vector< ColumnResult > results(static_cast< std::size_t >(columns));
+    const qint64 grain = std::max< qint64 >(1, columns * kParallelGrainSamples / n);
+
+    qimPlotVisitXYSeries(series, [ & ](const auto& view) {
+        auto columnStart = [ & ](qint64 c) -> qint64 {
+            if (c <= 0) {
+                return m_start;
+            }
+            if (c >= columns) {
+                return m_end;
+            }
+            if (by_x) {
+                return lowerBoundX(view, m_start, m_end, x_min + step * c);
+            }
+            return m_start + n * c / columns;
+        };
+        auto reduceColumn = [ & ](ColumnResult& out, qint64 first, qint64 last) {
+            switch (m_reducer) {
+            case ReduceM4: {
+                const QImPlotMinMaxIndex mm = qimPlotViewMinMax(view, first, last);
+                qint64 idx[ 4 ]             = { first, mm.minIdx, mm.maxIdx, last - 1 };
+                storeSortedUnique(out, idx, 4);
+                break;
+            }
+            case ReduceMinMax: {
+                const QImPlotMinMaxIndex mm = qimPlotViewMinMax(view, first, last);
+                qint64 idx[ 2 ]             = { mm.minIdx, mm.maxIdx };
+                storeSortedUnique(out, idx, 2);
+                break;
+            }
+            case ReduceEnvelope: {
+                double low  = std::numeric_limits< double >::infinity();
+                double high = -low;
+                if (m_series2) {
+                    for (qint64 i = first; i < last; ++i) {
+                        const double y1 = view.y(i);
+                        const double y2 = m_series2->yValue(i);
+                        // NaN 不参与比较
+                        if (y1 < low) {
+                            low = y1;
+                        }
+                        if (y1 > high) {
+                            high = y1;
+                        }
+                        if (y2 < low) {
+                            low = y2;
+                        }
+                        if (y2 > high) {
+                            high = y2;
+                        }
+                    }
+                } else {
+                    const QImPlotMinMaxIndex mm = qimPlotViewMinMax(view, first, last);
+                    if (mm.minIdx >= 0) {
+                        low  = std::min(mm.minValue, m_reference);
+                        high = std::max(mm.maxValue, m_reference);
+                    }
+                }
+                if (low <= high) {
+                    qint64 idx[ 2 ] = { first, last - 1 };
+                    storeSortedUnique(out, idx, 2);
+                    out.low  = low;
+                    out.high = high;
+                }
+                break;
+            }
+            case ReduceErrorBars: {
+                double low     = std::numeric_limits< double >::infinity();
+                double high    = -low;
+                double largest = -1.0;
+                for (qint64 i = first; i < last; ++i) {
+                    const double y   = view.y(i);
+                    const double neg = errors->negError(i);
+                    const double pos = errors->posError(i);
+                    if (std::isnan(y) || std::isnan(neg) || std::isnan(pos)) {
+                        continue;
+                    }
+                    low  = std::min(low, y - neg);
+                    high = std::max(high, y + pos);
+                    if (neg + pos > largest) {
+                        largest     = neg + pos;
+                        out.idx[ 0 ] = i;
+                    }
+                }
+                out.low  = low;
+                out.high = high;
+                break;
+            }
+            }
+        };
+
+        qimPlotParallelFor(columns, grain, [ & ](qint64 begin, qint64 end) {
+            qint64 first = columnStart(begin);
+            for (qint64 c = begin; c < end; ++c) {
+                const qint64 last = columnStart(c + 1);
+                if (last > first) {
+                    reduceColumn(results[ static_cast< std::size_t >(c) ], first, last);
+                }
+                first = last;
+            }
+        });
+
+        const std::size_t capacity = static_cast< std::size_t >(columns) * slots;
+        m_x.reserve(capacity);
+        m_y.reserve(capacity);
+        for (const ColumnResult& r : results) {
+            for (int k = 0; k < slots && r.idx[ k ] >= 0; ++k) {
+                const qint64 i = r.idx[ k ];
+                m_x.push_back(view.x(i));
+                switch (m_reducer) {
+                case ReduceEnvelope:
+                    m_low.push_back(r.low);
+                    m_high.push_back(r.high);
+                    break;
+                case ReduceErrorBars: {
+                    const double y = view.y(i);
+                    m_y.push_back(y);
+                    m_low.push_back(y - r.low);
+                    m_high.push_back(r.high - y);
+                    break;
+                }
+                default:
+                    m_y.push_back(view.y(i));
+                    break;
+                }
+            }
+        }
+    });
+    m_valid = true;
+}
+
+}  // namespace QIM
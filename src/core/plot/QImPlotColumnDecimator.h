@@ -0,0 +1,134 @@
+#ifndef QIMPLOTCOLUMNDECIMATOR_H
+#define QIMPLOTCOLUMNDECIMATOR_H
+
+#include "QImAPI.h"
+#include <QtGlobal>
+#include <vector>
+
+namespace QIM
+{
+class QImAbstractXYDataSeries;
+class QImAbstractErrorDataSeries;
+
+/**
+ * \if ENGLISH
+ * @brief Per-pixel-column decimation shared by the items that draw one primitive per sample
+ *
+ * @class QImPlotColumnDecimator
+ *
+ * @details The visible X range is split into one column per pixel of the plot area and every column
+ *          is reduced to a few values that draw the same pixels as all of its samples. The reducer
+ *          depends on what the item draws:
+ *          - ReduceM4: first, minimum, maximum and last sample in index order. Stairs and digital
+ *            signals keep every transition level and the state a column ends in.
+ *          - ReduceMinMax: minimum and maximum sample. Stems from a baseline cover the same span.
+ *          - ReduceEnvelope: lower and upper bound of the filled area (between the series and the
+ *            reference value, or between two series), at the first and last X of the column.
+ *          - ReduceErrorBars: one bar spanning the lowest and highest error bound of the column,
+ *            placed at the sample with the largest error.
+ *
+ *          The item keeps a decimator per series and calls update() every frame: the result is cached
+ *          by visible range, pixel width and series size and recomputed only when one of them changes
+ *          or after invalidate(). Series up to threshold() samples are not decimated and update()
+ *          returns false, the item then draws the series itself. Columns require monotonically
+ *          increasing X (checked once per data change, only the new samples when the same series
+ *          grew without invalidate()); otherwise the whole series is split into columns of equal
+ *          sample count.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 按像素列降采样，供每个数据点绘制一个图元的绘图项共用
+ *
+ * @class QImPlotColumnDecimator
+ *
+ * @details 可见 X 范围按绘图区的像素划分为列，每列归约为少量的值，绘制出的像素与该列全部数据点相同。
+ *          归约方式取决于绘图项绘制的图元：
+ *          - ReduceM4：按索引顺序保留首点、最小值、最大值与尾点。阶梯图与数字信号保留每个跳变电平与列末的状态
+ *          - ReduceMinMax：保留最小值与最大值，从基线出发的茎叶覆盖相同的范围
+ *          - ReduceEnvelope：填充区域（数据与参考值之间，或两条数据之间）的下界与上界，位于列内首、尾点的 X
+ *          - ReduceErrorBars：每列一根误差棒，覆盖列内最低与最高的误差边界，位于误差最大的点
+ *
+ *          绘图项为每个数据系列持有一个降采样器并在每帧调用 update()：结果按（可见范围, 像素宽度,
+ *          数据点数）缓存，只在其中之一变化或 invalidate() 之后重新计算。不超过 threshold() 个点的数据不降采样，
+ *          update() 返回 false，由绘图项直接绘制原始数据。按 X 划分列要求 X 单调递增（每次数据变化检查一次，
+ *          同一数据系列变长且未调用 invalidate() 时只检查新数据），否则整个数据系列按点数等分为列。
+ * \endif
+ */
+class QIM_CORE_API QImPlotColumnDecimator
+{
+public:
+    enum Reducer
+    {
+        ReduceM4,        ///< 首、最小、最大、尾
+        ReduceMinMax,    ///< 最小、最大
+        ReduceEnvelope,  ///< 填充区域的上下界
+        ReduceErrorBars  ///< 误差范围的并集
+    };
+
+    explicit QImPlotColumnDecimator(Reducer reducer = ReduceM4);
+
+    Reducer reducer() const;
+    // 超过该点数才降采样，默认 20000
+    void setThreshold(qint64 points);
+    qint64 threshold() const;
+    // ReduceEnvelope 的填充边界：另一条数据系列（与主数据按索引对齐），为空时使用参考值
+    void setEnvelopeReference(const QImAbstractXYDataSeries* series2, double reference);
+
+    // 数据被替换或修改后调用，下一次 update() 重新计算
+    void invalidate();
+
+    // 按可见范围 [x_min, x_max] 与像素宽度降采样；pixel_width <= 0 表示本帧没有视图（自适应帧），
+    // 使用全部数据与上一次的像素宽度。返回 false 表示不需要降采样，应绘制原始数据
+    bool update(const QImAbstractXYDataSeries& series, double x_min, double x_max, int pixel_width);
+    // ReduceErrorBars 使用的重载
+    bool update(const QImAbstractErrorDataSeries& series, double x_min, double x_max, int pixel_width);
+
+    // ===== 结果（update() 返回 true 时有效）=====
+    int count() const;
+    const double* xs() const;
+    // ReduceM4/ReduceMinMax 的 Y，ReduceErrorBars 的误差棒中心
+    const double* ys() const;
+    // ReduceEnvelope 的下界与上界
+    const double* lowerYs() const;
+    const double* upperYs() const;
+    // ReduceErrorBars 的负向与正向误差
+    const double* negErrors() const;
+    const double* posErrors() const;
+
+private:
+    bool prepare(const QImAbstractXYDataSeries& series, double x_min, double x_max, int pixel_width);
+    void decimate(const QImAbstractXYDataSeries& series, const QImAbstractErrorDataSeries* errors);
+
+private:
+    Reducer m_reducer;
+    qint64 m_threshold { 20000 };
+    const QImAbstractXYDataSeries* m_series2 { nullptr };
+    double m_reference { 0.0 };
+
+    std::vector< double > m_x;
+    std::vector< double > m_y;
+    std::vector< double > m_low;   ///< 下界或负向误差
+    std::vector< double > m_high;  ///< 上界或正向误差
+    bool m_valid { false };
+
+    // 本次计算的范围
+    qint64 m_start { 0 };
+    qint64 m_end { 0 };
+    double m_x_min { 0.0 };  ///< 列划分的 X 范围
+    double m_x_max { 0.0 };
+    int m_columns { 0 };
+
+    // 缓存键
+    bool m_dirty { true };
+    const void* m_key_series { nullptr };
+    qint64 m_key_size { -1 };
+    double m_key_x_min { 0.0 };
+    double m_key_x_max { 0.0 };
+    int m_key_pixel_width { 0 };
+    int m_last_pixel_width { 1000 };  ///< 没有视图时沿用的像素宽度
+    bool m_sorted { false };
+};
+
+}  // namespace QIM
+
+#endif  // QIMPLOTCOLUMNDECIMATOR_H
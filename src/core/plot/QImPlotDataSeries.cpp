@@ -0,0 +1,56 @@
+#include "QImPlotDataSeries.h"
+#include "QImPlotDataSeriesView.h"
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief Finite X/Y extent of the series, used to fit the axes in O(1) per item
+ * @return Bounds of all samples; NaN and Inf are skipped per coordinate like ImPlot's own fit
+ * @details The result is cached. When size() has grown since the last call only the new samples
+ *          [cached count, size()) are scanned, so append-only series never rescan their history;
+ *          when size() has shrunk everything is scanned again. Series that overwrite or evict
+ *          samples keep the cache exact through extendBounds()/evictBounds(), other modifications
+ *          must call invalidateBounds(). The X extent of Y-only series, and of series that declared
+ *          finite monotonic X through setBoundsXMonotonic(), is always derived from the first and last
+ *          index, so it follows evictions without rescanning.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 数据系列中有限值的 X/Y 范围，用于以每个绘图项 O(1) 的代价自适应坐标轴
+ * @return 所有点的范围；与 ImPlot 自身的自适应一致，X、Y 分别跳过 NaN 与 Inf
+ * @details 结果会被缓存。自上次调用后 size() 增加时只扫描新增的 [缓存点数, size()) 部分，
+ *          只追加的数据系列不会重复扫描历史数据；size() 减小时重新完整扫描。
+ *          会覆盖或淘汰数据的系列通过 extendBounds()/evictBounds() 保持缓存准确，
+ *          其它修改需调用 invalidateBounds()。Y-only 数据以及通过 setBoundsXMonotonic() 声明 X 有限且单调的数据，
+ *          X 范围总是由首尾索引计算，淘汰数据后无需重新扫描。
+ * \endif
+ */
+QImPlotDataBounds QImAbstractXYDataSeries::bounds() const
+{
+    const qint64 n = size();
+    if (m_boundsCount < 0 || m_boundsCount > n) {
+        m_bounds      = QImPlotDataBounds();
+        m_boundsCount = 0;
+    }
+    if (m_boundsCount < n) {
+        // 环形偏移下逻辑区间无法切片，重新扫描全部（只在缓冲写满前后发生）
+        const qint64 first = (offset() == 0) ? m_boundsCount : 0;
+        // 按存储类型分派一次，扫描过程没有逐点的虚函数调用
+        m_bounds.extend(qimPlotVisitXYSeries(
+            *this, [ first, n ](const auto& view) { return qimPlotScanBounds(view.slice(first, n - first)); }));
+        m_boundsCount = n;
+    }
+    const bool yOnly = qimPlotVisitXYSeries(*this, [](const auto& view) { return view.isYOnly(); });
+    if ((!yOnly && !m_boundsXMonotonic) || n <= 0) {
+        return m_bounds;
+    }
+    // Y-only 或 X 单调的数据淘汰旧点时 X 范围整体移动，不使用缓存
+    QImPlotDataBounds b = m_bounds;
+    b.xMin              = std::min(xValue(0), xValue(n - 1));
+    b.xMax              = std::max(xValue(0), xValue(n - 1));
+    return b;
+}
+
+}  // namespace QIM
@@ -5,9 +5,173 @@
 #include <QtGlobal>
 
 #include <cmath>
+#include <limits>
+#include <type_traits>
 
 namespace QIM
 {
+/**
+ * @brief 采样数据的存储类型
+ *
+ * 与 ImPlot 模板函数实例化的类型一一对应（ImS8…ImU64、float、double），
+ * 绘图项可据此直接调用 ImPlot::PlotLine<T> 等类型化接口，无需转换为 double。
+ */
+enum class QImPlotValueType
+{
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Int64,
+    UInt64,
+    Float,
+    Double
+};
+
+/**
+ * @brief 获取 C++ 数值类型对应的 QImPlotValueType
+ *
+ * 按符号和字节数映射，因此 long/long long、int64_t/qint64 等同宽类型映射到同一个枚举值
+ */
+template< typename T >
+constexpr QImPlotValueType qimPlotValueType()
+{
+    static_assert(std::is_arithmetic_v< T > && !std::is_same_v< T, bool >, "sample type must be numeric");
+    if constexpr (std::is_floating_point_v< T >) {
+        static_assert(sizeof(T) == sizeof(float) || sizeof(T) == sizeof(double), "long double is not supported");
+        return sizeof(T) == sizeof(float) ? QImPlotValueType::Float : QImPlotValueType::Double;
+    } else if constexpr (sizeof(T) == 1) {
+        return std::is_signed_v< T > ? QImPlotValueType::Int8 : QImPlotValueType::UInt8;
+    } else if constexpr (sizeof(T) == 2) {
+        return std::is_signed_v< T > ? QImPlotValueType::Int16 : QImPlotValueType::UInt16;
+    } else if constexpr (sizeof(T) == 4) {
+        return std::is_signed_v< T > ? QImPlotValueType::Int32 : QImPlotValueType::UInt32;
+    } else {
+        return std::is_signed_v< T > ? QImPlotValueType::Int64 : QImPlotValueType::UInt64;
+    }
+}
+
+// 类型标签，用于 qimPlotDispatchValueType 把运行时类型转换为编译期类型
+template< typename T >
+struct QImPlotValueTag
+{
+    using type = T;
+};
+
+/**
+ * @brief 按运行时的 QImPlotValueType 调用 fn(QImPlotValueTag<T>{})
+ *
+ * T 为 ImPlot 实例化过的类型（qint8…quint64、float、double），可直接用于 ImPlot 模板函数
+ */
+template< typename Fn >
+decltype(auto) qimPlotDispatchValueType(QImPlotValueType t, Fn&& fn)
+{
+    switch (t) {
+    case QImPlotValueType::Int8:
+        return fn(QImPlotValueTag< qint8 > {});
+    case QImPlotValueType::UInt8:
+        return fn(QImPlotValueTag< quint8 > {});
+    case QImPlotValueType::Int16:
+        return fn(QImPlotValueTag< qint16 > {});
+    case QImPlotValueType::UInt16:
+        return fn(QImPlotValueTag< quint16 > {});
+    case QImPlotValueType::Int32:
+        return fn(QImPlotValueTag< qint32 > {});
+    case QImPlotValueType::UInt32:
+        return fn(QImPlotValueTag< quint32 > {});
+    case QImPlotValueType::Int64:
+        return fn(QImPlotValueTag< qint64 > {});
+    case QImPlotValueType::UInt64:
+        return fn(QImPlotValueTag< quint64 > {});
+    case QImPlotValueType::Float:
+        return fn(QImPlotValueTag< float > {});
+    default:
+        break;
+    }
+    return fn(QImPlotValueTag< double > {});
+}
+
+// 存储类型的字节数
+inline int qimPlotValueTypeSize(QImPlotValueType t)
+{
+    return qimPlotDispatchValueType(t, [](auto tag) { return static_cast< int >(sizeof(typename decltype(tag)::type)); });
+}
+
+/**
+ * @brief 单次 ImPlot 绘图调用的最大点数
+ *
+ * ImPlot 的计数与索引为 int，数据系列为 64 位，超过此值时绘图项通过 qimPlotForEachRange() 分段调用
+ */
+constexpr qint64 qimPlotMaxDrawCount()
+{
+    return std::numeric_limits< int >::max();
+}
+
+/**
+ * @brief 分块（非连续）存储的布局描述
+ *
+ * 每块包含 2^chunkShift 个同类型元素，逻辑索引 i 位于
+ * 第 (i + first) >> chunkShift 块的 (i + first) & (2^chunkShift - 1) 位置。
+ * 绘图项据此生成编译期特化的 ImPlot getter，无需逐点调用虚函数 xValue()/yValue()。
+ */
+struct QImPlotChunkLayout
+{
+    const void* const* xChunks { nullptr };  ///< X 数据块指针数组，nullptr 表示 Y-only
+    const void* const* yChunks { nullptr };  ///< Y 数据块指针数组
+    int chunkCount { 0 };
+    int chunkShift { 16 };
+    int first { 0 };  ///< 第一个有效元素在首块中的位置
+};
+
+/**
+ * @brief 数据范围
+ *
+ * X、Y 分别统计有限值，NaN/Inf 被跳过，与 ImPlot 自适应坐标轴的规则一致；
+ * 没有任何有限值的方向 min > max（保持初始的 +inf/-inf）
+ */
+struct QImPlotDataBounds
+{
+    double xMin { std::numeric_limits< double >::infinity() };
+    double xMax { -std::numeric_limits< double >::infinity() };
+    double yMin { std::numeric_limits< double >::infinity() };
+    double yMax { -std::numeric_limits< double >::infinity() };
+
+    bool isXValid() const
+    {
+        return xMin <= xMax;
+    }
+    bool isYValid() const
+    {
+        return yMin <= yMax;
+    }
+    bool isValid() const
+    {
+        return isXValid() && isYValid();
+    }
+    // 扩展一个点，非有限值被忽略
+    void extend(double x, double y)
+    {
+        if (std::isfinite(x)) {
+            xMin = std::min(xMin, x);
+            xMax = std::max(xMax, x);
+        }
+        if (std::isfinite(y)) {
+            yMin = std::min(yMin, y);
+            yMax = std::max(yMax, y);
+        }
+    }
+    // 合并另一个范围
+    void extend(const QImPlotDataBounds& other)
+    {
+        xMin = std::min(xMin, other.xMin);
+        xMax = std::max(xMax, other.xMax);
+        yMin = std::min(yMin, other.yMin);
+        yMax = std::max(yMax, other.yMax);
+    }
+};
+
 // 通用数据访问接口类
 class QIM_CORE_API QImAbstractPlotDataSeries
 {
@@ -17,7 +181,8 @@ public:
      */
     enum DataType
     {
-        XYData
+        XYData,
+        MultiChannelData
     };
 
 public:
@@ -33,9 +198,12 @@ public:
 
     /**
      * @brief 数据尺寸
+     *
+     * 使用 64 位计数，单个数据系列可以超过 2^31 个点；
+     * ImPlot 的绘图接口计数为 int，超过时由绘图项分段调用（见 qimPlotForEachSlice()）
      * @return
      */
-    virtual int size() const = 0;
+    virtual qint64 size() const = 0;
 };
 
 /**
@@ -57,22 +225,87 @@ public:
     // 是否使用连续内存（可走 PlotLine 快速路径）
     virtual bool isContiguous() const = 0;
 
-    // 步幅（stride），连续内存模式下有效
+    // 步幅（stride，字节），连续内存模式下有效，对应Y数据
     virtual int stride() const
     {
         return sizeof(double);
     }
 
+    // X数据的步幅（字节），默认与 stride() 相同
+    virtual int xStride() const
+    {
+        return stride();
+    }
+
     // X数据指针：如果不是Y-only模式，返回nullptr表示使用索引计算
     // 如果返回非nullptr，ImPlot直接使用该指针（零拷贝）
+    // 存储类型不是double时返回nullptr，此时使用 xRawPointer()
     virtual const double* xRawData() const
     {
         return nullptr;
     }
 
     // Y数据指针：必须有效（Y-only模式也返回此指针）
+    // 存储类型不是double时返回nullptr，此时使用 yRawPointer()
     virtual const double* yRawData() const = 0;
 
+    // X/Y数据的存储类型，默认double
+    virtual QImPlotValueType xValueType() const
+    {
+        return QImPlotValueType::Double;
+    }
+    virtual QImPlotValueType yValueType() const
+    {
+        return QImPlotValueType::Double;
+    }
+
+    // 类型无关的X数据指针，实际类型由 xValueType() 给出；返回nullptr表示Y-only模式
+    virtual const void* xRawPointer() const
+    {
+        return xRawData();
+    }
+
+    // 类型无关的Y数据指针，实际类型由 yValueType() 给出
+    virtual const void* yRawPointer() const
+    {
+        return yRawData();
+    }
+
+    // 按指定类型获取X数据指针，类型不匹配返回nullptr
+    template< typename T >
+    const T* xRawDataAs() const
+    {
+        return xValueType() == qimPlotValueType< T >() ? static_cast< const T* >(xRawPointer()) : nullptr;
+    }
+
+    // 按指定类型获取Y数据指针，类型不匹配返回nullptr
+    template< typename T >
+    const T* yRawDataAs() const
+    {
+        return yValueType() == qimPlotValueType< T >() ? static_cast< const T* >(yRawPointer()) : nullptr;
+    }
+
+    // 分块存储的数据（isContiguous()为false）通过此函数提供块布局，不支持时返回false
+    virtual bool chunkLayout(QImPlotChunkLayout& layout) const
+    {
+        Q_UNUSED(layout);
+        return false;
+    }
+
+    // X/Y是否都以double存储（xRawData()/yRawData() 可用）
+    bool isDoubleData() const
+    {
+        return xValueType() == QImPlotValueType::Double && yValueType() == QImPlotValueType::Double;
+    }
+
+    // 是否为紧凑的double数组（连续、步幅为sizeof(double)、无offset），可按 xRawData()[i] 直接访问
+    // 交错记录、环形缓冲等数据返回false，需按 stride()/offset() 或 xValue()/yValue() 访问
+    bool isPackedDoubleData() const
+    {
+        return isContiguous() && isDoubleData() && offset() == 0 && stride() == static_cast< int >(sizeof(double))
+               && (!xRawPointer() || xStride() == static_cast< int >(sizeof(double)));
+    }
+
     // Y-only模式参数（当xRawData返回nullptr时使用）
     virtual double xScale() const
     {
@@ -82,19 +315,20 @@ public:
     {
         return 0.0;
     }
-    virtual int offset() const
+    // 环形缓冲起始位置（逻辑索引0对应的物理索引）
+    virtual qint64 offset() const
     {
         return 0;
     }
 
-    virtual double xValue(int index) const = 0;
-    virtual double yValue(int index) const = 0;
+    virtual double xValue(qint64 index) const = 0;
+    virtual double yValue(qint64 index) const = 0;
     /**
      * @brief 二分查找：给定X值，返回最接近的Y值
      *
      * 智能处理两种模式：
-     * - 完整XY模式 (xRawData() != nullptr)：在X数组中二分查找
-     * - Y-only模式 (xRawData() == nullptr)：通过公式计算索引
+     * - 完整XY模式 (xRawPointer() != nullptr)：在X数组中二分查找
+     * - Y-only模式 (xRawPointer() == nullptr)：通过公式计算索引
      *
      * @param x 目标X值
      * @param[out] index 可选：返回匹配的索引位置
@@ -104,9 +338,9 @@ public:
      * @note 要求X数据单调递增（时间序列/数值序列均满足）
      * @note 内部自动处理边界情况（x超出范围时返回首/尾点）
      */
-    virtual double yValueAtX(double x, int* index = nullptr, bool* exact = nullptr) const
+    virtual double yValueAtX(double x, qint64* index = nullptr, bool* exact = nullptr) const
     {
-        const int n = size();
+        const qint64 n = size();
         if (n <= 0) {
             if (index)
                 *index = -1;
@@ -114,50 +348,51 @@ public:
                 *exact = false;
             return std::numeric_limits< double >::quiet_NaN();
         }
+        // 通过 xValue()/yValue() 访问，与存储类型及 offset 无关
 
         // Y-only 模式：通过公式计算索引
-        if (!xRawData()) {
-            double idx = offset() + (x - xStart()) / xScale();
-            int i      = static_cast< int >(std::round(idx));
-            i          = qBound(0, i, n - 1);
+        if (!xRawPointer()) {
+            double idx = (x - xStart()) / xScale();
+            qint64 i   = static_cast< qint64 >(std::round(idx));
+            i          = qBound< qint64 >(0, i, n - 1);
             if (index)
                 *index = i;
             if (exact)
                 *exact = (std::abs(idx - i) < 1e-6);
-            return yRawData()[ i ];
+            return yValue(i);
         }
 
         // 完整XY模式：二分查找
-        const double* xs = xRawData();
-        int lo = 0, hi = n - 1;
+        qint64 lo = 0, hi = n - 1;
 
         // 边界快速处理
-        if (x <= xs[ 0 ]) {
+        if (x <= xValue(0)) {
             if (index)
                 *index = 0;
             if (exact)
-                *exact = (x == xs[ 0 ]);
-            return yRawData()[ 0 ];
+                *exact = (x == xValue(0));
+            return yValue(0);
         }
-        if (x >= xs[ n - 1 ]) {
+        if (x >= xValue(n - 1)) {
             if (index)
                 *index = n - 1;
             if (exact)
-                *exact = (x == xs[ n - 1 ]);
-            return yRawData()[ n - 1 ];
+                *exact = (x == xValue(n - 1));
+            return yValue(n - 1);
         }
 
         // 标准二分查找
         while (lo <= hi) {
-            int mid = (lo + hi) / 2;
-            if (std::abs(xs[ mid ] - x) < 1e-10) {  // 精确匹配
+            qint64 mid = lo + (hi - lo) / 2;
+            const double xm = xValue(mid);
+            if (std::abs(xm - x) < 1e-10) {  // 精确匹配
                 if (index)
                     *index = mid;
                 if (exact)
                     *exact = true;
-                return yRawData()[ mid ];
+                return yValue(mid);
             }
-            if (xs[ mid ] < x) {
+            if (xm < x) {
                 lo = mid + 1;
             } else {
                 hi = mid - 1;
@@ -165,28 +400,99 @@ public:
         }
 
         // 未精确匹配：返回最近邻
-        int closest = (std::abs(xs[ lo ] - x) < std::abs(xs[ hi ] - x)) ? lo : hi;
+        qint64 closest = (std::abs(xValue(lo) - x) < std::abs(xValue(hi) - x)) ? lo : hi;
         if (index)
             *index = closest;
         if (exact)
             *exact = false;
-        return yRawData()[ closest ];
+        return yValue(closest);
+    }
+
+    // 有限值的 X/Y 范围，结果被缓存，size() 增加时只扫描新增的点
+    virtual QImPlotDataBounds bounds() const;
+    // 数据被修改（而不只是追加）后调用，下次 bounds() 重新完整扫描
+    void invalidateBounds() const
+    {
+        m_boundsCount = -1;
+    }
+    // 以在其它线程扫描得到的前 count 个点的范围填充缓存，只能在使用 bounds() 的线程调用；缓存已覆盖这些点时忽略
+    void seedBounds(const QImPlotDataBounds& bounds, qint64 count)
+    {
+        if (count > m_boundsCount && count <= size()) {
+            m_bounds      = bounds;
+            m_boundsCount = count;
+        }
+    }
+
+protected:
+    // 是否已有缓存的数据范围
+    bool isBoundsCached() const
+    {
+        return m_boundsCount >= 0;
+    }
+    // 追加点后调用，size() 不变的追加（如环形缓冲写满后覆盖）无法被 bounds() 自动发现
+    void extendBounds(double x, double y)
+    {
+        if (isBoundsCached()) {
+            m_bounds.extend(x, y);
+        }
+    }
+    // 覆盖或淘汰一个点前调用，该点位于范围边界上时缓存失效；NaN 表示不检查该方向
+    void evictBounds(double x, double y)
+    {
+        if (!isBoundsCached()) {
+            return;
+        }
+        if ((std::isfinite(x) && (x <= m_bounds.xMin || x >= m_bounds.xMax))
+            || (std::isfinite(y) && (y <= m_bounds.yMin || y >= m_bounds.yMax))) {
+            invalidateBounds();
+        }
     }
+    // 从头部淘汰 count 个点后调用（先对这些点调用 evictBounds()）：其余点的索引前移，缓存覆盖的点数随之减少
+    void dropBoundsFront(qint64 count)
+    {
+        if (!isBoundsCached() || count <= 0) {
+            return;
+        }
+        if (count >= m_boundsCount) {
+            // 缓存覆盖的点全部被淘汰
+            m_bounds      = QImPlotDataBounds();
+            m_boundsCount = 0;
+        } else {
+            m_boundsCount -= count;
+        }
+    }
+    // X 单调递增且全部为有限值时设为 true：bounds() 与 Y-only 数据一样由首尾点得到 X 范围，
+    // 淘汰数据时只需对 Y 调用 evictBounds()
+    void setBoundsXMonotonic(bool on)
+    {
+        m_boundsXMonotonic = on;
+    }
+
+private:
+    mutable QImPlotDataBounds m_bounds;  ///< 前 m_boundsCount 个点的范围
+    mutable qint64 m_boundsCount { -1 };  ///< -1 表示缓存无效
+    bool m_boundsXMonotonic { false };  ///< X 范围由首尾点给出
 };
 
 /**
- * @brief 标准连续 double 容器封装
+ * @brief 标准连续容器封装
  *
- * 支持：std::vector<double>, QVector<double>, std::deque<double>（只要内存连续）
+ * 支持：std::vector<T>, QVector<T>（只要内存连续）
  *
+ * 元素类型可以是 double、float 以及 8/16/32/64 位有符号/无符号整数，X 与 Y 的类型可以不同。
+ * 非 double 数据不做转换，绘图项通过 xRawPointer()/yRawPointer() 调用对应的 ImPlot 模板实例，
+ * 例如 10M 点的 float 数据只占用 double 的一半内存。
  */
 template< typename ContainerX, typename ContainerY >
 class QImVectorXYDataSeries : public QImAbstractXYDataSeries
 {
 public:
-    // 静态检查：确保容器存储的是 double（或可以按 double 解释的类型）
-    static_assert(std::is_same_v< typename ContainerX::value_type, double >, "ContainerX must store double");
-    static_assert(std::is_same_v< typename ContainerY::value_type, double >, "ContainerY must store double");
+    using XValue = typename ContainerX::value_type;
+    using YValue = typename ContainerY::value_type;
+    // 静态检查：确保容器存储的是 ImPlot 支持的数值类型
+    static_assert(std::is_arithmetic_v< XValue > && !std::is_same_v< XValue, bool >, "ContainerX must store numbers");
+    static_assert(std::is_arithmetic_v< YValue > && !std::is_same_v< YValue, bool >, "ContainerY must store numbers");
     explicit QImVectorXYDataSeries(ContainerX&& xs, ContainerY&& ys)
         : QImAbstractXYDataSeries(), m_xs(std::move(xs)), m_ys(std::move(ys)), m_yOnly(false)
     {
@@ -196,9 +502,10 @@ public:
     {
     }
     virtual ~QImVectorXYDataSeries() = default;
-    int size() const override
+    qint64 size() const override
     {
-        return std::min(m_xs.size(), m_ys.size());
+        // Y-only 模式不使用X容器，X容器可以为空
+        return static_cast< qint64 >(m_yOnly ? m_ys.size() : std::min(m_xs.size(), m_ys.size()));
     }
 
     bool isContiguous() const override
@@ -206,19 +513,51 @@ public:
         return true;
     }
 
-    // 标准连续内存，步幅就是 sizeof(double)
+    // 标准连续内存，步幅就是元素大小
     int stride() const override
     {
-        return sizeof(double);
+        return sizeof(YValue);
+    }
+
+    int xStride() const override
+    {
+        return sizeof(XValue);
     }
 
     const double* xRawData() const override
     {
-        // XY模式：交替存储 x,y,x,y...
-        return (m_yOnly ? nullptr : m_xs.data());
+        if constexpr (std::is_same_v< XValue, double >) {
+            return (m_yOnly ? nullptr : m_xs.data());
+        } else {
+            return nullptr;
+        }
     }
 
     const double* yRawData() const override
+    {
+        if constexpr (std::is_same_v< YValue, double >) {
+            return m_ys.data();
+        } else {
+            return nullptr;
+        }
+    }
+
+    QImPlotValueType xValueType() const override
+    {
+        return qimPlotValueType< XValue >();
+    }
+
+    QImPlotValueType yValueType() const override
+    {
+        return qimPlotValueType< YValue >();
+    }
+
+    const void* xRawPointer() const override
+    {
+        return (m_yOnly ? nullptr : m_xs.data());
+    }
+
+    const void* yRawPointer() const override
     {
         return m_ys.data();
     }
@@ -231,24 +570,24 @@ public:
     {
         return m_xStart;
     }
-    double xValue(int index) const override
+    double xValue(qint64 index) const override
     {
-        const int valid_size = size();
+        const qint64 valid_size = size();
         if (index < 0 || index >= valid_size) {
             return std::numeric_limits<double>::quiet_NaN();
         }
         if (m_yOnly) {
             return m_xStart + (m_xScale * index);
         }
-        return m_xs[ index ];
+        return static_cast< double >(m_xs[ index ]);
     }
-    double yValue(int index) const override
+    double yValue(qint64 index) const override
     {
-        const int valid_size = size();
+        const qint64 valid_size = size();
         if (index < 0 || index >= valid_size) {
             return std::numeric_limits<double>::quiet_NaN();
         }
-        return m_ys[ index ];
+        return static_cast< double >(m_ys[ index ]);
     }
     void setYOnly(bool on, double xStart = 0.0, double xScale = 1.0)
     {
@@ -261,26 +600,37 @@ public:
             m_xStart = 0.0;
             m_xScale = 1.0;
         }
+        invalidateBounds();
     }
     bool empty() const
     {
         return m_ys.empty();
     }
-    typename ContainerX::value_type xmin() const
+    // 有限值的最小/最大值（缓存），没有有限值时 min 为 +inf、max 为 -inf
+    double xmin() const
+    {
+        return bounds().xMin;
+    }
+    double xmax() const
+    {
+        return bounds().xMax;
+    }
+    double ymin() const
     {
-        return xValue(0);
+        return bounds().yMin;
     }
-    typename ContainerX::value_type xman() const
+    double ymax() const
     {
-        return xValue(size() - 1);
+        return bounds().yMax;
     }
-    typename ContainerX::value_type ymin() const
+    // 旧的拼写，保留兼容
+    double xman() const
     {
-        return yValue(0);
+        return xmax();
     }
-    typename ContainerX::value_type yman() const
+    double yman() const
     {
-        return yValue(size() - 1);
+        return ymax();
     }
 
 protected:
@@ -0,0 +1,503 @@
+#ifndef QIMPLOTDATASERIESVIEW_H
+#define QIMPLOTDATASERIESVIEW_H
+#include "QImPlotDataSeries.h"
+#include "QImPlotMultiChannelDataSeries.h"
+#include "implot.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief Splits [0, count) into ranges ImPlot can draw in one call
+ * @param count Number of samples, may exceed INT_MAX
+ * @param fn Called as fn(qint64 first, int n) for each range
+ * @details Consecutive ranges share one sample so line segments stay connected across calls.
+ *          Items issue every call with the same label id, so ImPlot keeps a single item and legend entry.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 把 [0, count) 拆分为 ImPlot 单次调用可绘制的区间
+ * @param count 数据点数，可以超过 INT_MAX
+ * @param fn 对每个区间调用 fn(qint64 first, int n)
+ * @details 相邻区间共享一个点，保证折线在两次调用之间连续。
+ *          各次调用使用同一个 label id，ImPlot 只保留一个绘图项与一个图例条目。
+ * \endif
+ */
+template< typename Fn >
+void qimPlotForEachRange(qint64 count, Fn&& fn)
+{
+    if (count <= qimPlotMaxDrawCount()) {
+        fn(qint64(0), static_cast< int >(count));
+        return;
+    }
+    for (qint64 first = 0; first < count - 1; first += qimPlotMaxDrawCount() - 1) {
+        fn(first, static_cast< int >(std::min(qimPlotMaxDrawCount(), count - first)));
+    }
+}
+
+/**
+ * \if ENGLISH
+ * @brief Typed, non-virtual view over the contiguous storage of a QImAbstractXYDataSeries
+ *
+ * @details Captures raw pointers, byte strides, offset and Y-only parameters once, so that
+ *          per-sample access in hot loops (downsampling, ImPlot getters) is an inlined load
+ *          and conversion instead of a virtual xValue()/yValue() call.
+ *          Index arguments are logical, the ring-buffer offset is applied internally.
+ *
+ *          Use qimPlotVisitXYSeries() to obtain a view with the series' real element types.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief QImAbstractXYDataSeries 连续存储的类型化、非虚访问视图
+ *
+ * @details 一次性获取原始指针、字节步幅、offset 以及 Y-only 参数，热循环（降采样、ImPlot getter）
+ *          中逐点访问只是内联的读取与类型转换，而不是虚函数 xValue()/yValue() 调用。
+ *          索引参数为逻辑索引，内部处理环形缓冲的 offset。
+ *
+ *          通过 qimPlotVisitXYSeries() 获取与数据实际元素类型一致的视图。
+ * \endif
+ */
+template< typename TX, typename TY >
+struct QImPlotXYView
+{
+    using XValue = TX;
+    using YValue = TY;
+
+    const char* xs { nullptr };  ///< nullptr 表示 Y-only
+    const char* ys { nullptr };
+    qint64 count { 0 };
+    qint64 offset { 0 };
+    int xStride { sizeof(TX) };
+    int yStride { sizeof(TY) };
+    double xStart { 0.0 };
+    double xScale { 1.0 };
+
+    bool isYOnly() const
+    {
+        return xs == nullptr;
+    }
+
+    // 逻辑索引转物理索引
+    qint64 rawIndex(qint64 i) const
+    {
+        return (offset == 0) ? i : (i + offset) % count;
+    }
+
+    double x(qint64 i) const
+    {
+        if (!xs) {
+            return xStart + xScale * i;
+        }
+        return load< TX >(xs + rawIndex(i) * xStride);
+    }
+
+    double y(qint64 i) const
+    {
+        return load< TY >(ys + rawIndex(i) * yStride);
+    }
+
+    // 子区间 [first, first + n) 的视图，要求 offset 为 0（环形缓冲容量为 int，不会需要分段）
+    QImPlotXYView slice(qint64 first, qint64 n) const
+    {
+        Q_ASSERT(offset == 0 || (first == 0 && n == count));
+        QImPlotXYView v = *this;
+        if (xs) {
+            v.xs += first * xStride;
+        } else {
+            v.xStart += xScale * first;
+        }
+        v.ys += first * yStride;
+        v.count = n;
+        return v;
+    }
+
+    // 交错记录中的字段不一定对齐，使用 memcpy 读取（编译器会优化为普通的加载指令）
+    template< typename T >
+    static double load(const char* p)
+    {
+        T v;
+        std::memcpy(&v, p, sizeof(T));
+        return static_cast< double >(v);
+    }
+};
+
+/**
+ * \if ENGLISH
+ * @brief Typed view over chunked (non-contiguous) storage described by QImPlotChunkLayout
+ * @details Element access is two shifts/masks and an array load, inlined into the caller,
+ *          so an ImPlot getter built on it has no virtual call per point.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 基于 QImPlotChunkLayout 的分块（非连续）存储类型化视图
+ * @details 访问一个元素只需移位、掩码与一次数组读取，并内联到调用处，
+ *          基于它的 ImPlot getter 不会逐点调用虚函数。
+ * \endif
+ */
+template< typename TX, typename TY >
+struct QImPlotChunkedXYView
+{
+    using XValue = TX;
+    using YValue = TY;
+
+    const void* const* xChunks { nullptr };  ///< nullptr 表示 Y-only
+    const void* const* yChunks { nullptr };
+    qint64 count { 0 };
+    qint64 first { 0 };
+    int shift { 16 };
+    int mask { 0xFFFF };
+    double xStart { 0.0 };
+    double xScale { 1.0 };
+
+    bool isYOnly() const
+    {
+        return xChunks == nullptr;
+    }
+
+    double x(qint64 i) const
+    {
+        if (!xChunks) {
+            return xStart + xScale * i;
+        }
+        const qint64 j = i + first;
+        return static_cast< double >(static_cast< const TX* >(xChunks[ j >> shift ])[ j & mask ]);
+    }
+
+    double y(qint64 i) const
+    {
+        const qint64 j = i + first;
+        return static_cast< double >(static_cast< const TY* >(yChunks[ j >> shift ])[ j & mask ]);
+    }
+
+    // 子区间 [first, first + n) 的视图
+    QImPlotChunkedXYView slice(qint64 from, qint64 n) const
+    {
+        QImPlotChunkedXYView v = *this;
+        if (!xChunks) {
+            v.xStart += xScale * from;
+        }
+        v.first += from;
+        v.count = n;
+        return v;
+    }
+};
+
+/**
+ * \if ENGLISH
+ * @brief Fallback view for series that expose neither raw pointers nor a chunk layout
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 既没有原始指针也没有块布局的数据系列使用的兜底视图（逐点虚函数调用）
+ * \endif
+ */
+struct QImPlotVirtualXYView
+{
+    using XValue = double;
+    using YValue = double;
+
+    const QImAbstractXYDataSeries* series { nullptr };
+    qint64 first { 0 };
+    qint64 count { 0 };
+
+    bool isYOnly() const
+    {
+        return false;
+    }
+
+    double x(qint64 i) const
+    {
+        return series->xValue(first + i);
+    }
+
+    double y(qint64 i) const
+    {
+        return series->yValue(first + i);
+    }
+
+    QImPlotVirtualXYView slice(qint64 from, qint64 n) const
+    {
+        return QImPlotVirtualXYView { series, first + from, n };
+    }
+};
+
+/**
+ * \if ENGLISH
+ * @brief ImPlotGetter over any view above, pass a pointer to the view as user_data
+ * @details ImPlot indices are int, use View::slice() to draw views of more than INT_MAX samples.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 适用于上述任意视图的 ImPlotGetter，user_data 传入视图指针
+ * @details ImPlot 的索引为 int，超过 INT_MAX 个点的视图需通过 View::slice() 分段绘制。
+ * \endif
+ */
+template< typename View >
+ImPlotPoint qimPlotViewGetter(int idx, void* data)
+{
+    const View* v = static_cast< const View* >(data);
+    return ImPlotPoint(v->x(idx), v->y(idx));
+}
+
+/**
+ * \if ENGLISH
+ * @brief Calls fn(view) with a QImPlotXYView typed after the series' X/Y element types
+ * @param series Any XY series
+ * @param fn Generic callable taking the view by const reference
+ * @return Whatever fn returns
+ * @details Contiguous series yield QImPlotXYView, chunked series (chunkLayout()) yield
+ *          QImPlotChunkedXYView, anything else QImPlotVirtualXYView.
+ *          Y-only series are dispatched on the Y type only (X is reported as double).
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 按数据系列的存储方式与 X/Y 元素类型构造视图并调用 fn(view)
+ * @param series 任意 XY 数据系列
+ * @param fn 以 const 引用接收视图的泛型可调用对象
+ * @return fn 的返回值
+ * @details 连续内存得到 QImPlotXYView，分块存储（chunkLayout()）得到 QImPlotChunkedXYView，
+ *          其它情况得到 QImPlotVirtualXYView。Y-only 数据只按 Y 类型分派（X 视为 double）。
+ * \endif
+ */
+template< typename Fn >
+decltype(auto) qimPlotVisitXYSeries(const QImAbstractXYDataSeries& series, Fn&& fn)
+{
+    if (!series.isContiguous()) {
+        QImPlotChunkLayout layout;
+        if (!series.chunkLayout(layout) || !layout.yChunks) {
+            return fn(QImPlotVirtualXYView { &series, 0, series.size() });
+        }
+        return qimPlotDispatchValueType(series.yValueType(), [ & ](auto ytag) -> decltype(auto) {
+            using TY      = typename decltype(ytag)::type;
+            auto makeView = [ & ](auto xtag) {
+                using TX = typename decltype(xtag)::type;
+                QImPlotChunkedXYView< TX, TY > v;
+                v.xChunks = layout.xChunks;
+                v.yChunks = layout.yChunks;
+                v.count   = series.size();
+                v.first   = layout.first;
+                v.shift   = layout.chunkShift;
+                v.mask    = (1 << layout.chunkShift) - 1;
+                v.xStart  = series.xStart();
+                v.xScale  = series.xScale();
+                return v;
+            };
+            if (!layout.xChunks) {
+                return fn(makeView(QImPlotValueTag< double > {}));
+            }
+            return qimPlotDispatchValueType(series.xValueType(), [ & ](auto xtag) -> decltype(auto) {
+                return fn(makeView(xtag));
+            });
+        });
+    }
+    const void* xp = series.xRawPointer();
+    return qimPlotDispatchValueType(series.yValueType(), [ & ](auto ytag) -> decltype(auto) {
+        using TY = typename decltype(ytag)::type;
+        auto makeView = [ & ](auto xtag) {
+            using TX = typename decltype(xtag)::type;
+            QImPlotXYView< TX, TY > v;
+            v.xs      = static_cast< const char* >(xp);
+            v.ys      = static_cast< const char* >(series.yRawPointer());
+            v.count   = series.size();
+            v.offset  = series.offset();
+            v.xStride = series.xStride();
+            v.yStride = series.stride();
+            v.xStart  = series.xStart();
+            v.xScale  = series.xScale();
+            return v;
+        };
+        if (!xp) {
+            return fn(makeView(QImPlotValueTag< double > {}));
+        }
+        return qimPlotDispatchValueType(series.xValueType(), [ & ](auto xtag) -> decltype(auto) {
+            return fn(makeView(xtag));
+        });
+    });
+}
+
+/**
+ * \if ENGLISH
+ * @brief Calls fn(view) with a QImPlotXYView over one channel of a multi-channel series
+ * @param series Multi-channel series
+ * @param channel Channel index in [0, channelCount())
+ * @param fn Generic callable taking the view by const reference
+ * @return Whatever fn returns
+ * @details The view's X is the shared X column (or Y-only parameters), its Y is the channel with
+ *          channelStride() as byte stride, so every algorithm written for XY views works per channel.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 以多通道数据中某一通道的 QImPlotXYView 调用 fn(view)
+ * @param series 多通道数据系列
+ * @param channel 通道索引，范围 [0, channelCount())
+ * @param fn 以 const 引用接收视图的泛型可调用对象
+ * @return fn 的返回值
+ * @details 视图的 X 为共享的 X 列（或 Y-only 参数），Y 为该通道、字节步幅为 channelStride()，
+ *          因此所有针对 XY 视图编写的算法都可按通道使用。
+ * \endif
+ */
+template< typename Fn >
+decltype(auto) qimPlotVisitChannel(const QImAbstractMultiChannelDataSeries& series, int channel, Fn&& fn)
+{
+    const void* xp = series.xRawPointer();
+    return qimPlotDispatchValueType(series.valueType(), [ & ](auto ytag) -> decltype(auto) {
+        using TY      = typename decltype(ytag)::type;
+        auto makeView = [ & ](auto xtag) {
+            using TX = typename decltype(xtag)::type;
+            QImPlotXYView< TX, TY > v;
+            v.xs      = static_cast< const char* >(xp);
+            v.ys      = static_cast< const char* >(series.channelRawPointer(channel));
+            v.count   = v.ys ? series.size() : 0;
+            v.xStride = series.xStride();
+            v.yStride = series.channelStride();
+            v.xStart  = series.xStart();
+            v.xScale  = series.xScale();
+            return v;
+        };
+        if (!xp) {
+            return fn(makeView(QImPlotValueTag< double > {}));
+        }
+        return qimPlotDispatchValueType(series.xValueType(), [ & ](auto xtag) -> decltype(auto) {
+            return fn(makeView(xtag));
+        });
+    });
+}
+
+/**
+ * \if ENGLISH
+ * @brief Finite X/Y extent of a view, NaN and Inf are skipped
+ * @details Y-only views take X from the first and last index instead of scanning.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 视图中有限值的 X/Y 范围，跳过 NaN 与 Inf
+ * @details Y-only 视图的 X 范围直接由首尾索引计算，不逐点扫描。
+ * \endif
+ */
+template< typename View >
+QImPlotDataBounds qimPlotScanBounds(const View& view)
+{
+    QImPlotDataBounds b;
+    if (view.count <= 0) {
+        return b;
+    }
+    if (view.isYOnly()) {
+        b.extend(view.x(0), std::numeric_limits< double >::quiet_NaN());
+        b.extend(view.x(view.count - 1), std::numeric_limits< double >::quiet_NaN());
+        for (qint64 i = 0; i < view.count; ++i) {
+            const double y = view.y(i);
+            if (std::isfinite(y)) {
+                b.yMin = std::min(b.yMin, y);
+                b.yMax = std::max(b.yMax, y);
+            }
+        }
+        return b;
+    }
+    for (qint64 i = 0; i < view.count; ++i) {
+        b.extend(view.x(i), view.y(i));
+    }
+    return b;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Calls fn(slice) for slices of view that ImPlot can draw in one call
+ * @details See qimPlotForEachRange(); a view of at most INT_MAX samples is passed unchanged.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 把视图拆分为 ImPlot 单次调用可绘制的子视图并依次调用 fn(slice)
+ * @details 见 qimPlotForEachRange()；不超过 INT_MAX 个点的视图原样传入。
+ * \endif
+ */
+template< typename View, typename Fn >
+void qimPlotForEachSlice(const View& view, Fn&& fn)
+{
+    if (view.count <= qimPlotMaxDrawCount()) {
+        fn(view);
+        return;
+    }
+    qimPlotForEachRange(view.count, [ & ](qint64 first, int n) { fn(view.slice(first, n)); });
+}
+
+/**
+ * \if ENGLISH
+ * @brief Routes a series to the cheapest typed ImPlot call, split into int-sized calls
+ * @param series Any XY series
+ * @param yOnly Called as yOnly(const TY* ys, int count, int offset, double xStart) for contiguous Y-only data
+ * @param xy Called as xy(const T* xs, const T* ys, int count, int offset) for contiguous data whose X and Y
+ *        share element type and stride
+ * @param generic Called with a view from qimPlotVisitXYSeries() otherwise (mixed types, chunked storage...),
+ *        typically to feed an ImPlot getter; view.count fits in int
+ * @details Lets items call ImPlot::PlotLine<T>/PlotScatter<T>... on the stored type without converting to double.
+ *          Series of more than INT_MAX samples are passed in several consecutive ranges (see qimPlotForEachRange()),
+ *          with pointers and xStart already advanced to the range.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 把数据系列分派给开销最小的类型化 ImPlot 调用，并按 int 范围分段
+ * @param series 任意 XY 数据系列
+ * @param yOnly 连续内存的 Y-only 数据调用 yOnly(const TY* ys, int count, int offset, double xStart)
+ * @param xy 连续内存且 X、Y 元素类型与步幅相同时调用 xy(const T* xs, const T* ys, int count, int offset)
+ * @param generic 其它情况（类型不同、分块存储等）以 qimPlotVisitXYSeries() 的视图调用，通常用于 ImPlot getter，
+ *        view.count 不超过 int 范围
+ * @details 绘图项可直接按存储类型调用 ImPlot::PlotLine<T>/PlotScatter<T> 等接口，无需转换为 double。
+ *          超过 INT_MAX 个点的数据分多个连续区间回调（见 qimPlotForEachRange()），指针与 xStart 已移动到区间起点。
+ * \endif
+ */
+template< typename FnYOnly, typename FnXY, typename FnGeneric >
+void qimPlotDispatchXYSeries(const QImAbstractXYDataSeries& series, FnYOnly&& yOnly, FnXY&& xy, FnGeneric&& generic)
+{
+    auto visitGeneric = [ & ] {
+        qimPlotVisitXYSeries(series, [ & ](const auto& view) { qimPlotForEachSlice(view, generic); });
+    };
+    if (!series.isContiguous()) {
+        visitGeneric();
+        return;
+    }
+    const char* xp = static_cast< const char* >(series.xRawPointer());
+    const char* yp = static_cast< const char* >(series.yRawPointer());
+    if (!yp) {
+        return;
+    }
+    const qint64 count  = series.size();
+    const qint64 offset = series.offset();
+    if (offset != 0 && count > qimPlotMaxDrawCount()) {
+        // 环形偏移无法与分段同时使用，走视图
+        visitGeneric();
+        return;
+    }
+    const qint64 xStride = series.xStride();
+    const qint64 yStride = series.stride();
+    if (!xp) {
+        const double xStart = series.xStart();
+        const double xScale = series.xScale();
+        qimPlotDispatchValueType(series.yValueType(), [ & ](auto tag) {
+            using T = typename decltype(tag)::type;
+            qimPlotForEachRange(count, [ & ](qint64 first, int n) {
+                yOnly(reinterpret_cast< const T* >(yp + first * yStride), n, static_cast< int >(offset), xStart + xScale * first);
+            });
+        });
+        return;
+    }
+    if (series.xValueType() == series.yValueType() && xStride == yStride) {
+        qimPlotDispatchValueType(series.yValueType(), [ & ](auto tag) {
+            using T = typename decltype(tag)::type;
+            qimPlotForEachRange(count, [ & ](qint64 first, int n) {
+                xy(reinterpret_cast< const T* >(xp + first * xStride),
+                   reinterpret_cast< const T* >(yp + first * yStride),
+                   n,
+                   static_cast< int >(offset));
+            });
+        });
+        return;
+    }
+    visitGeneric();
+}
+
+}  // namespace QIM
+#endif  // QIMPLOTDATASERIESVIEW_H
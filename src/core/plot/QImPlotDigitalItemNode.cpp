@@ -1,4 +1,5 @@
 #include "QImPlotDigitalItemNode.h"
+#include "QImPlotColumnDecimator.h"
 #include <optional>
 #include "implot.h"
 #include "implot_internal.h"
@@ -14,8 +15,10 @@ class QImPlotDigitalItemNode::PrivateData
 public:
     PrivateData(QImPlotDigitalItemNode* p);
 
-    std::unique_ptr<QImAbstractXYDataSeries> data;  ///< Data series (X, Y values)
+    std::shared_ptr<QImAbstractXYDataSeries> data;  ///< Data series (X, Y values)
     ImPlotDigitalFlags flags { ImPlotDigitalFlags_None };
+    bool isAdaptiveSampling { true };
+    QImPlotColumnDecimator decimator { QImPlotColumnDecimator::ReduceM4 };
     // Style tracking values
     std::optional<QImTrackedValue<ImVec4, QIM::ImVecComparator<ImVec4>>> color;
 };
@@ -65,9 +68,26 @@ QImPlotDigitalItemNode::~QImPlotDigitalItemNode()
  * \endif
  */
 void QImPlotDigitalItemNode::setData(QImAbstractXYDataSeries* series)
+{
+    setSharedData(std::shared_ptr< QImAbstractXYDataSeries >(series));
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set a data series that may be shared with other items or inspection tools
+ * @param series Shared series, the item keeps a reference until the next setData()/setSharedData()
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置可与其它绘图项或检查工具共享的数据系列
+ * @param series 共享的数据系列，绘图项持有其引用直到下一次 setData()/setSharedData()
+ * \endif
+ */
+void QImPlotDigitalItemNode::setSharedData(std::shared_ptr< QImAbstractXYDataSeries > series)
 {
     QIM_D(d);
-    d->data.reset(series);
+    d->data = std::move(series);
+    d->decimator.invalidate();
     emit dataChanged();
 }
 
@@ -87,6 +107,11 @@ QImAbstractXYDataSeries* QImPlotDigitalItemNode::data() const
     return d_ptr->data.get();
 }
 
+std::shared_ptr< QImAbstractXYDataSeries > QImPlotDigitalItemNode::sharedData() const
+{
+    return d_ptr->data;
+}
+
 /**
  * \if ENGLISH
  * @brief Get digital signal color
@@ -157,6 +182,55 @@ void QImPlotDigitalItemNode::setDigitalFlags(int flags)
     }
 }
 
+/**
+ * \if ENGLISH
+ * @brief Enable or disable per-pixel-column decimation
+ * @param on true to decimate series larger than 20000 samples (default)
+ * @details Each column keeps its first, lowest, highest and last sample, so every transition is still
+ *          drawn and the signal leaves each column in the right state.
+ *          The result is cached by visible range and recomputed when the view or the data changes.
+ * @see QImPlotColumnDecimator
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 启用或禁用按像素列降采样
+ * @param on 为 true 时对超过 20000 个点的数据降采样（默认）
+ * @details 每列保留首点、最低点、最高点与尾点，每个跳变仍会绘制，信号离开每列时的状态也正确。
+ *          结果按可见范围缓存，视图或数据变化时重新计算。
+ * @see QImPlotColumnDecimator
+ * \endif
+ */
+void QImPlotDigitalItemNode::setAdaptiveSampling(bool on)
+{
+    QIM_D(d);
+    d->isAdaptiveSampling = on;
+    d->decimator.invalidate();
+}
+
+bool QImPlotDigitalItemNode::isAdaptiveSampling() const
+{
+    return d_ptr->isAdaptiveSampling;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Notify the item that the current data series was appended to or modified in place
+ * @param count Number of appended samples
+ * @details The decimation cache is rebuilt before the next frame.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 通知绘图项当前数据系列追加了数据或被原地修改
+ * @param count 追加的点数
+ * @details 降采样缓存在下一帧绘制前重建。
+ * \endif
+ */
+void QImPlotDigitalItemNode::notifyDataAppended(qint64 count)
+{
+    Q_UNUSED(count);
+    d_ptr->decimator.invalidate();
+}
+
 /**
  * \if ENGLISH
  * @brief Begin drawing implementation
@@ -183,11 +257,23 @@ bool QImPlotDigitalItemNode::beginDraw()
     }
 
     // Call ImPlot API
-    if (d->data->isContiguous()) {
+    // ImPlot takes an int count: draw at most INT_MAX samples
+    const int count = static_cast< int >(std::min(d->data->size(), qimPlotMaxDrawCount()));
+    if (d->isAdaptiveSampling && updateColumnDecimator(d->decimator, *d->data)) {
+        // Per-pixel-column decimation: first, lowest, highest and last sample keep every transition
+        ImPlot::PlotDigital(
+            labelConstData(),
+            d->decimator.xs(),
+            d->decimator.ys(),
+            d->decimator.count(),
+            d->flags,
+            0,
+            sizeof(double));
+    } else if (d->data->isPackedDoubleData()) {
         // Continuous memory mode: use zero-copy fast path
         const double* xData = d->data->xRawData();
         const double* yData = d->data->yRawData();
-        int size = d->data->size();
+        const int size = count;
 
         if (xData) {
             // XY mode with explicit X coordinates
@@ -220,7 +306,7 @@ bool QImPlotDigitalItemNode::beginDraw()
         }
     } else {
         // Non-contiguous memory mode: copy data
-        int size = d->data->size();
+        const int size = count;
         std::vector<double> xValues(size);
         std::vector<double> yValues(size);
         for (int i = 0; i < size; ++i) {
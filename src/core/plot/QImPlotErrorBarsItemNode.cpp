@@ -1,4 +1,5 @@
 #include "QImPlotErrorBarsItemNode.h"
+#include "QImPlotColumnDecimator.h"
 #include <optional>
 #include "implot.h"
 #include "implot_internal.h"
@@ -14,8 +15,10 @@ class QImPlotErrorBarsItemNode::PrivateData
 public:
     PrivateData(QImPlotErrorBarsItemNode* p);
 
-    std::unique_ptr<QImAbstractErrorDataSeries> data;  ///< Error data series (X, Y, errors)
+    std::shared_ptr<QImAbstractErrorDataSeries> data;  ///< Error data series (X, Y, errors)
     ImPlotErrorBarsFlags flags { ImPlotErrorBarsFlags_None };
+    bool isAdaptiveSampling { true };
+    QImPlotColumnDecimator decimator { QImPlotColumnDecimator::ReduceErrorBars };
     // Style tracking values
     std::optional<QImTrackedValue<ImVec4, QIM::ImVecComparator<ImVec4>>> color;
 };
@@ -65,9 +68,26 @@ QImPlotErrorBarsItemNode::~QImPlotErrorBarsItemNode()
  * \endif
  */
 void QImPlotErrorBarsItemNode::setData(QImAbstractErrorDataSeries* errorDataSeries)
+{
+    setSharedData(std::shared_ptr< QImAbstractErrorDataSeries >(errorDataSeries));
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set a data series that may be shared with other items or inspection tools
+ * @param series Shared series, the item keeps a reference until the next setData()/setSharedData()
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置可与其它绘图项或检查工具共享的数据系列
+ * @param series 共享的数据系列，绘图项持有其引用直到下一次 setData()/setSharedData()
+ * \endif
+ */
+void QImPlotErrorBarsItemNode::setSharedData(std::shared_ptr< QImAbstractErrorDataSeries > series)
 {
     QIM_D(d);
-    d->data.reset(errorDataSeries);
+    d->data = std::move(series);
+    d->decimator.invalidate();
     emit dataChanged();
 }
 
@@ -87,6 +107,11 @@ QImAbstractErrorDataSeries* QImPlotErrorBarsItemNode::data() const
     return d_ptr->data.get();
 }
 
+std::shared_ptr< QImAbstractErrorDataSeries > QImPlotErrorBarsItemNode::sharedData() const
+{
+    return d_ptr->data;
+}
+
 /**
  * \if ENGLISH
  * @brief Check if horizontal orientation is enabled
@@ -223,6 +248,55 @@ bool QImPlotErrorBarsItemNode::isAsymmetricMode() const
     return d->data && d->data->isAsymmetric();
 }
 
+/**
+ * \if ENGLISH
+ * @brief Enable or disable per-pixel-column decimation
+ * @param on true to decimate series larger than 20000 samples (default)
+ * @details Each column is drawn as one bar spanning the lowest and highest error bound of its samples,
+ *          centered on the sample with the largest error. Horizontal error bars are not decimated.
+ *          The result is cached by visible range and recomputed when the view or the data changes.
+ * @see QImPlotColumnDecimator
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 启用或禁用按像素列降采样
+ * @param on 为 true 时对超过 20000 个点的数据降采样（默认）
+ * @details 每列绘制一根误差棒，覆盖列内各点最低与最高的误差边界，中心为误差最大的点。水平方向的误差棒不降采样。
+ *          结果按可见范围缓存，视图或数据变化时重新计算。
+ * @see QImPlotColumnDecimator
+ * \endif
+ */
+void QImPlotErrorBarsItemNode::setAdaptiveSampling(bool on)
+{
+    QIM_D(d);
+    d->isAdaptiveSampling = on;
+    d->decimator.invalidate();
+}
+
+bool QImPlotErrorBarsItemNode::isAdaptiveSampling() const
+{
+    return d_ptr->isAdaptiveSampling;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Notify the item that the current data series was appended to or modified in place
+ * @param count Number of appended samples
+ * @details The decimation cache is rebuilt before the next frame.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 通知绘图项当前数据系列追加了数据或被原地修改
+ * @param count 追加的点数
+ * @details 降采样缓存在下一帧绘制前重建。
+ * \endif
+ */
+void QImPlotErrorBarsItemNode::notifyDataAppended(qint64 count)
+{
+    Q_UNUSED(count);
+    d_ptr->decimator.invalidate();
+}
+
 /**
  * \if ENGLISH
  * @brief Begin drawing implementation
@@ -244,7 +318,8 @@ bool QImPlotErrorBarsItemNode::beginDraw()
         return false;
     }
 
-    int dataSize = d->data->size();
+    // One error bar per sample, ImPlot takes an int count: draw at most INT_MAX samples
+    const int dataSize = static_cast< int >(std::min(d->data->size(), qimPlotMaxDrawCount()));
     
     // Validate error array sizes
     if (d->data->isAsymmetric()) {
@@ -259,36 +334,56 @@ bool QImPlotErrorBarsItemNode::beginDraw()
     }
 
     // Get raw pointers for fast rendering
-    const double* xData = d->data->xRawData();
-    const double* yData = d->data->yRawData();
-    const double* negErrorData = d->data->negErrorRawData();
-    const double* posErrorData = d->data->posErrorRawData();
+    const void* xData        = d->data->xRawPointer();
+    const void* yData        = d->data->yRawPointer();
+    const void* negErrorData = d->data->negErrorRawPointer();
+    const void* posErrorData = d->data->posErrorRawPointer();
+    const QImPlotValueType valueType = d->data->yValueType();
+    const bool sameType = d->data->xValueType() == valueType && d->data->errorValueType() == valueType
+                          && d->data->xStride() == d->data->stride();
 
     // Call ImPlot API
-    if (xData && yData && negErrorData && posErrorData) {
-        // Fast path: all data is contiguous
-        if (d->data->isAsymmetric()) {
-            ImPlot::PlotErrorBars(
-                labelConstData(),
-                xData,
-                yData,
-                negErrorData,
-                posErrorData,
-                dataSize,
-                d->flags,
-                0,
-                sizeof(double));
-        } else {
-            ImPlot::PlotErrorBars(
-                labelConstData(),
-                xData,
-                yData,
-                posErrorData,
-                dataSize,
-                d->flags,
-                0,
-                sizeof(double));
-        }
+    // Columns run along X, horizontal error bars would need columns along Y
+    const bool horizontal = (d->flags & ImPlotErrorBarsFlags_Horizontal) != 0;
+    if (d->isAdaptiveSampling && !horizontal && updateColumnDecimator(d->decimator, *d->data)) {
+        // Per-pixel-column decimation: one bar covering the error range of the whole column
+        ImPlot::PlotErrorBars(
+            labelConstData(),
+            d->decimator.xs(),
+            d->decimator.ys(),
+            d->decimator.negErrors(),
+            d->decimator.posErrors(),
+            d->decimator.count(),
+            d->flags,
+            0,
+            sizeof(double));
+    } else if (xData && yData && negErrorData && posErrorData && sameType) {
+        // Fast path: all data is contiguous and shares one element type, call ImPlot::PlotErrorBars<T> directly
+        qimPlotDispatchValueType(valueType, [ & ](auto tag) {
+            using T = typename decltype(tag)::type;
+            if (d->data->isAsymmetric()) {
+                ImPlot::PlotErrorBars(
+                    labelConstData(),
+                    static_cast< const T* >(xData),
+                    static_cast< const T* >(yData),
+                    static_cast< const T* >(negErrorData),
+                    static_cast< const T* >(posErrorData),
+                    dataSize,
+                    d->flags,
+                    0,
+                    d->data->stride());
+            } else {
+                ImPlot::PlotErrorBars(
+                    labelConstData(),
+                    static_cast< const T* >(xData),
+                    static_cast< const T* >(yData),
+                    static_cast< const T* >(posErrorData),
+                    dataSize,
+                    d->flags,
+                    0,
+                    d->data->stride());
+            }
+        });
     } else {
         // Slow path: need to copy data to temporary buffers
         std::vector<double> xValues(dataSize);
@@ -3,6 +3,7 @@
 #include <QColor>
 #include "QImPlotItemNode.h"
 #include "QImPlotErrorDataSeries.h"
+#include <memory>
 
 namespace QIM
 {
@@ -131,6 +132,8 @@ public:
 
     // Sets error data series (symmetric or asymmetric)
     void setData(QImAbstractErrorDataSeries* errorDataSeries);
+    // Sets a series shared with other items, kept alive while this item uses it
+    void setSharedData(std::shared_ptr< QImAbstractErrorDataSeries > series);
 
     //----------------------------------------------------
     // Data setting interface - Symmetric error mode with arbitrary containers
@@ -158,6 +161,8 @@ public:
 
     // Gets the error data series
     QImAbstractErrorDataSeries* data() const;
+    // Gets the current data series as a shared reference
+    std::shared_ptr< QImAbstractErrorDataSeries > sharedData() const;
 
     //----------------------------------------------------
     // Style property accessors
@@ -184,6 +189,19 @@ public:
     // Checks if asymmetric error mode is active
     bool isAsymmetricMode() const;
 
+    //----------------------------------------------------
+    // Downsampling
+    //----------------------------------------------------
+
+    // Enables per-pixel-column decimation of large series
+    void setAdaptiveSampling(bool on);
+
+    // Checks if adaptive sampling is enabled
+    bool isAdaptiveSampling() const;
+
+    // Notifies the item that the data series was appended to or modified in place
+    void notifyDataAppended(qint64 count = 1);
+
 Q_SIGNALS:
     /**
      * \if ENGLISH
@@ -110,7 +110,7 @@ public:
      * @return 正误差值
      * \endif
      */
-    virtual double posError(int index) const = 0;
+    virtual double posError(qint64 index) const = 0;
 
     /**
      * \if ENGLISH
@@ -127,7 +127,7 @@ public:
      * @note 对于对称误差，返回与 posError() 相同的值
      * \endif
      */
-    virtual double negError(int index) const = 0;
+    virtual double negError(qint64 index) const = 0;
 
     /**
      * \if ENGLISH
@@ -156,6 +156,25 @@ public:
      * \endif
      */
     virtual const double* negErrorRawData() const { return nullptr; }
+
+    /**
+     * \if ENGLISH
+     * @brief Storage type of the error arrays
+     * @note When not Double, posErrorRawData()/negErrorRawData() return nullptr, use the raw pointer variants
+     * \endif
+     *
+     * \if CHINESE
+     * @brief 误差数组的存储类型
+     * @note 不是 Double 时 posErrorRawData()/negErrorRawData() 返回nullptr，应使用 RawPointer 版本
+     * \endif
+     */
+    virtual QImPlotValueType errorValueType() const { return QImPlotValueType::Double; }
+
+    // Type-erased pointer to positive error data, element type given by errorValueType()
+    virtual const void* posErrorRawPointer() const { return posErrorRawData(); }
+
+    // Type-erased pointer to negative error data, element type given by errorValueType()
+    virtual const void* negErrorRawPointer() const { return negErrorRawData(); }
 };
 
 /**
@@ -204,9 +223,12 @@ template<typename ContainerX, typename ContainerY, typename ContainerError>
 class QImVectorErrorDataSeries : public QImAbstractErrorDataSeries
 {
 public:
-    static_assert(std::is_same_v<typename ContainerX::value_type, double>, "ContainerX must store double");
-    static_assert(std::is_same_v<typename ContainerY::value_type, double>, "ContainerY must store double");
-    static_assert(std::is_same_v<typename ContainerError::value_type, double>, "ContainerError must store double");
+    using XValue     = typename ContainerX::value_type;
+    using YValue     = typename ContainerY::value_type;
+    using ErrorValue = typename ContainerError::value_type;
+    static_assert(std::is_arithmetic_v<XValue> && !std::is_same_v<XValue, bool>, "ContainerX must store numbers");
+    static_assert(std::is_arithmetic_v<YValue> && !std::is_same_v<YValue, bool>, "ContainerY must store numbers");
+    static_assert(std::is_arithmetic_v<ErrorValue> && !std::is_same_v<ErrorValue, bool>, "ContainerError must store numbers");
 
     /**
      * \if ENGLISH
@@ -266,9 +288,9 @@ public:
     virtual ~QImVectorErrorDataSeries() = default;
 
     // QImAbstractPlotDataSeries interface
-    int size() const override
+    qint64 size() const override
     {
-        return std::min({m_xs.size(), m_ys.size(), m_posErrors.size()});
+        return static_cast< qint64 >(std::min({m_xs.size(), m_ys.size(), m_posErrors.size()}));
     }
 
     // QImAbstractErrorDataSeries interface
@@ -277,33 +299,64 @@ public:
         return m_asymmetric ? AsymmetricError : SymmetricError;
     }
 
-    double posError(int index) const override
+    double posError(qint64 index) const override
     {
-        return m_posErrors[index];
+        return static_cast<double>(m_posErrors[index]);
     }
 
-    double negError(int index) const override
+    double negError(qint64 index) const override
     {
-        return m_asymmetric ? m_negErrors[index] : m_posErrors[index];
+        return static_cast<double>(m_asymmetric ? m_negErrors[index] : m_posErrors[index]);
     }
 
     const double* posErrorRawData() const override
     {
-        return m_posErrors.data();
+        if constexpr (std::is_same_v<ErrorValue, double>) {
+            return m_posErrors.data();
+        } else {
+            return nullptr;
+        }
     }
 
     const double* negErrorRawData() const override
     {
-        return m_asymmetric ? m_negErrors.data() : m_posErrors.data();
+        if constexpr (std::is_same_v<ErrorValue, double>) {
+            return m_asymmetric ? m_negErrors.data() : m_posErrors.data();
+        } else {
+            return nullptr;
+        }
     }
 
+    QImPlotValueType errorValueType() const override { return qimPlotValueType<ErrorValue>(); }
+    const void* posErrorRawPointer() const override { return m_posErrors.data(); }
+    const void* negErrorRawPointer() const override { return m_asymmetric ? m_negErrors.data() : m_posErrors.data(); }
+
     // QImAbstractXYDataSeries interface
     bool isContiguous() const override { return true; }
-    int stride() const override { return sizeof(double); }
-    const double* xRawData() const override { return m_xs.data(); }
-    const double* yRawData() const override { return m_ys.data(); }
-    double xValue(int index) const override { return m_xs[index]; }
-    double yValue(int index) const override { return m_ys[index]; }
+    int stride() const override { return sizeof(YValue); }
+    int xStride() const override { return sizeof(XValue); }
+    const double* xRawData() const override
+    {
+        if constexpr (std::is_same_v<XValue, double>) {
+            return m_xs.data();
+        } else {
+            return nullptr;
+        }
+    }
+    const double* yRawData() const override
+    {
+        if constexpr (std::is_same_v<YValue, double>) {
+            return m_ys.data();
+        } else {
+            return nullptr;
+        }
+    }
+    QImPlotValueType xValueType() const override { return qimPlotValueType<XValue>(); }
+    QImPlotValueType yValueType() const override { return qimPlotValueType<YValue>(); }
+    const void* xRawPointer() const override { return m_xs.data(); }
+    const void* yRawPointer() const override { return m_ys.data(); }
+    double xValue(qint64 index) const override { return static_cast<double>(m_xs[index]); }
+    double yValue(qint64 index) const override { return static_cast<double>(m_ys[index]); }
 
 private:
     ContainerX m_xs;
@@ -114,6 +114,29 @@ public:
      */
     virtual const double* valuesRawData() const = 0;
 
+    /**
+     * \if ENGLISH
+     * @brief Storage type of the values matrix
+     * @note When not Double, valuesRawData() returns nullptr and valuesRawPointer() must be used
+     * \endif
+     *
+     * \if CHINESE
+     * @brief 值矩阵的存储类型
+     * @note 不是 Double 时 valuesRawData() 返回nullptr，应使用 valuesRawPointer()
+     * \endif
+     */
+    virtual QImPlotValueType valueType() const { return QImPlotValueType::Double; }
+
+    // Type-erased pointer to the values matrix, element type given by valueType()
+    virtual const void* valuesRawPointer() const { return valuesRawData(); }
+
+    // Typed pointer to the values matrix, nullptr when T does not match valueType()
+    template<typename T>
+    const T* valuesRawDataAs() const
+    {
+        return valueType() == qimPlotValueType<T>() ? static_cast<const T*>(valuesRawPointer()) : nullptr;
+    }
+
     /**
      * \if ENGLISH
      * @brief Check if data is contiguous in memory
@@ -200,10 +223,10 @@ template<typename ContainerValues>
 class QImVectorHeatmapDataSeries : public QImAbstractHeatmapDataSeries
 {
 public:
-    static_assert(std::is_same_v<typename std::remove_reference_t<ContainerValues>::value_type, double>, 
-                  "ContainerValues must store double");
-    
     using StoredType = std::remove_cv_t<std::remove_reference_t<ContainerValues>>;
+    using ValueType  = typename StoredType::value_type;
+    static_assert(std::is_arithmetic_v<ValueType> && !std::is_same_v<ValueType, bool>,
+                  "ContainerValues must store numbers");
 
     /**
      * \if ENGLISH
@@ -237,9 +260,9 @@ public:
     virtual ~QImVectorHeatmapDataSeries() = default;
 
     // QImAbstractPlotDataSeries interface
-    int size() const override
+    qint64 size() const override
     {
-        return m_rows * m_cols;
+        return static_cast< qint64 >(m_rows) * m_cols;
     }
 
     // QImAbstractHeatmapDataSeries interface
@@ -254,6 +277,20 @@ public:
     }
 
     const double* valuesRawData() const override
+    {
+        if constexpr (std::is_same_v<ValueType, double>) {
+            return m_values.data();
+        } else {
+            return nullptr;
+        }
+    }
+
+    QImPlotValueType valueType() const override
+    {
+        return qimPlotValueType<ValueType>();
+    }
+
+    const void* valuesRawPointer() const override
     {
         return m_values.data();
     }
@@ -275,10 +312,10 @@ public:
         }
         if (m_colMajor) {
             // column-major: index = col * rows + row
-            return m_values[col * m_rows + row];
+            return static_cast<double>(m_values[col * m_rows + row]);
         } else {
             // row-major: index = row * cols + col
-            return m_values[row * m_cols + col];
+            return static_cast<double>(m_values[row * m_cols + col]);
         }
     }
 
@@ -1,8 +1,15 @@
 #include "QImPlotHeatmapItemNode.h"
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <optional>
+#include <type_traits>
+#include <vector>
 #include "implot.h"
 #include "implot_internal.h"
+#include "QImPlotMinMaxKernel.h"
+#include "QImPlotParallel.h"
+#include "QImPlotTexture.h"
 #include "QImTrackedValue.hpp"
 #include "QtImGuiUtils.h"
 #include <QDebug>
@@ -10,11 +17,38 @@
 namespace QIM
 {
 
+namespace
+{
+// RenderAuto 超过该单元格数时使用纹理
+constexpr qint64 kAutoTextureCells = 128 * 128;
+// 每个任务至少着色的单元格数
+constexpr qint64 kParallelGrainCells = 1 << 16;
+
+// 自动缩放的数据范围，跳过 NaN；没有有效值时保持 lo、hi 不变
+template< typename T >
+void valueRange(const T* values, qint64 count, double& lo, double& hi)
+{
+    if constexpr (std::is_same_v< T, double > || std::is_same_v< T, float >) {
+        const QImPlotMinMaxIndex mm = qimPlotMinMaxIndex(values, count);
+        if (mm.minIdx >= 0) {
+            lo = mm.minValue;
+            hi = mm.maxValue;
+        }
+    } else {
+        const auto [ mn, mx ] = std::minmax_element(values, values + count);
+        lo                    = static_cast< double >(*mn);
+        hi                    = static_cast< double >(*mx);
+    }
+}
+}  // namespace
+
 class QImPlotHeatmapItemNode::PrivateData
 {
     QIM_DECLARE_PUBLIC(QImPlotHeatmapItemNode)
 public:
     PrivateData(QImPlotHeatmapItemNode* p);
+    // 按颜色映射生成 RGBA 图像并上传为纹理，无法使用纹理时返回 false
+    bool uploadTexture(ImPlotColormap cmap);
 
     std::unique_ptr< QImAbstractHeatmapDataSeries > data;
     ImPlotHeatmapFlags flags { ImPlotHeatmapFlags_None };
@@ -25,12 +59,69 @@ public:
     QPointF boundsMax { 1.0, 1.0 };
     // Style tracking values
     std::optional< QImTrackedValue< ImVec4, QIM::ImVecComparator< ImVec4 > > > color;
+    // Texture rendering
+    RenderMode renderMode { RenderAuto };
+    QImPlotTexture texture;
+    bool textureDirty { true };  ///< 数据、缩放范围或布局变化后需要重新着色
+    ImPlotColormap textureColormap { -1 };
+    bool textureActive { false };
 };
 
 QImPlotHeatmapItemNode::PrivateData::PrivateData(QImPlotHeatmapItemNode* p) : q_ptr(p)
 {
 }
 
+/**
+ * @brief 与 ImPlot::PlotHeatmap 相同的颜色映射，按行并行着色后上传；数据不变时不会调用
+ */
+bool QImPlotHeatmapItemNode::PrivateData::uploadTexture(ImPlotColormap cmap)
+{
+    const int rows      = data->rows();
+    const int cols      = data->cols();
+    const int limitSize = QImPlotTexture::maximumSize();
+    // 没有当前上下文时 limitSize 为 0
+    if (rows <= 0 || cols <= 0 || rows > limitSize || cols > limitSize) {
+        return false;
+    }
+    const bool colMajor            = data->isColMajor();
+    const ImPlotColormapData& maps = ImPlot::GetCurrentContext()->ColormapData;
+    const qint64 count             = static_cast< qint64 >(rows) * cols;
+    std::vector< quint32 > pixels(static_cast< std::size_t >(count));
+
+    qimPlotDispatchValueType(data->valueType(), [ & ](auto tag) {
+        using T         = typename decltype(tag)::type;
+        const T* values = static_cast< const T* >(data->valuesRawPointer());
+        double lo       = scaleMin;
+        double hi       = scaleMax;
+        if (lo == 0 && hi == 0) {
+            valueRange(values, count, lo, hi);
+        }
+        if (lo == hi) {
+            // ImPlot 此时以颜色映射的第一个颜色填充整个区域
+            std::fill(pixels.begin(), pixels.end(), maps.GetKeyColor(cmap, 0));
+            return;
+        }
+        const double range = hi - lo;
+        const qint64 grain  = std::max< qint64 >(1, kParallelGrainCells / cols);
+        qimPlotParallelFor(rows, grain, [ & ](qint64 begin, qint64 end) {
+            for (qint64 r = begin; r < end; ++r) {
+                quint32* out = &pixels[ static_cast< std::size_t >(r * cols) ];
+                for (qint64 c = 0; c < cols; ++c) {
+                    const double v = static_cast< double >(values[ colMajor ? c * rows + r : r * cols + c ]);
+                    if (std::isnan(v)) {
+                        // NaN 单元格透明
+                        out[ c ] = 0;
+                        continue;
+                    }
+                    const float t = ImClamp(static_cast< float >((v - lo) / range), 0.0f, 1.0f);
+                    out[ c ]      = maps.LerpTable(cmap, t);
+                }
+            }
+        });
+    });
+    return texture.upload(cols, rows, pixels.data());
+}
+
 /**
  * \if ENGLISH
  * @brief Constructor for QImPlotHeatmapItemNode
@@ -74,6 +165,7 @@ void QImPlotHeatmapItemNode::setData(QImAbstractHeatmapDataSeries* series)
 {
     QIM_D(d);
     d->data.reset(series);
+    d->textureDirty = true;
     emit dataChanged();
 }
 
@@ -93,6 +185,24 @@ QImAbstractHeatmapDataSeries* QImPlotHeatmapItemNode::data() const
     return d_ptr->data.get();
 }
 
+/**
+ * \if ENGLISH
+ * @brief Notifies that the values of the data series were modified in place
+ * @details The texture is colormapped again before the next frame. Not needed after setData().
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 通知数据系列的值被原地修改
+ * @details 下一帧绘制前重新着色纹理。setData() 之后无需调用。
+ * \endif
+ */
+void QImPlotHeatmapItemNode::notifyDataChanged()
+{
+    QIM_D(d);
+    d->textureDirty = true;
+    requestRender();
+}
+
 /**
  * \if ENGLISH
  * @brief Get minimum scale value
@@ -125,7 +235,8 @@ void QImPlotHeatmapItemNode::setScaleMin(double min)
 {
     QIM_D(d);
     if (d->scaleMin != min) {
-        d->scaleMin = min;
+        d->scaleMin     = min;
+        d->textureDirty = true;
         emit scaleMinChanged(min);
     }
 }
@@ -162,7 +273,8 @@ void QImPlotHeatmapItemNode::setScaleMax(double max)
 {
     QIM_D(d);
     if (d->scaleMax != max) {
-        d->scaleMax = max;
+        d->scaleMax     = max;
+        d->textureDirty = true;
         emit scaleMaxChanged(max);
     }
 }
@@ -359,6 +471,64 @@ void QImPlotHeatmapItemNode::setHeatmapFlags(int flags)
     }
 }
 
+/**
+ * \if ENGLISH
+ * @brief Get the rendering path of the cells
+ * @return Current render mode
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 获取单元格的绘制方式
+ * @return 当前绘制方式
+ * \endif
+ */
+QImPlotHeatmapItemNode::RenderMode QImPlotHeatmapItemNode::renderMode() const
+{
+    QIM_DC(d);
+    return d->renderMode;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set the rendering path of the cells
+ * @param mode RenderAuto (default), RenderCells or RenderTexture
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置单元格的绘制方式
+ * @param mode RenderAuto（默认）、RenderCells 或 RenderTexture
+ * \endif
+ */
+void QImPlotHeatmapItemNode::setRenderMode(RenderMode mode)
+{
+    QIM_D(d);
+    if (d->renderMode == mode) {
+        return;
+    }
+    d->renderMode = mode;
+    if (mode == RenderCells) {
+        d->texture.release();
+        d->textureDirty = true;
+    }
+}
+
+/**
+ * \if ENGLISH
+ * @brief Check if the last frame was drawn from the texture
+ * @return true if the heatmap was drawn as one textured quad, false if cells were drawn
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 检查上一帧是否以纹理绘制
+ * @return 以一个纹理四边形绘制时返回 true，按单元格绘制时返回 false
+ * \endif
+ */
+bool QImPlotHeatmapItemNode::isTextureActive() const
+{
+    QIM_DC(d);
+    return d->textureActive;
+}
+
 /**
  * \if ENGLISH
  * @brief Begin drawing implementation
@@ -381,7 +551,7 @@ bool QImPlotHeatmapItemNode::beginDraw()
     // Color tracking not used for heatmap (colormap is separate). We'll ignore color for now.
 
     // Prepare parameters
-    const double* values = d->data->valuesRawData();
+    const void* values = d->data->valuesRawPointer();
     if (!values) {
         // Non-contiguous data not supported for heatmap (ImPlot doesn't have callback version)
         // Fallback to copying data? We'll just return false.
@@ -405,19 +575,48 @@ bool QImPlotHeatmapItemNode::beginDraw()
         flags &= ~ImPlotHeatmapFlags_ColMajor;
     }
 
-    // Call ImPlot API
-    ImPlot::PlotHeatmap(
-        labelConstData(),
-        values,
-        rows,
-        cols,
-        scale_min,
-        scale_max,
-        label_fmt,
-        bounds_min,
-        bounds_max,
-        flags
-    );
+    // Texture mode: colormap once, then one quad per frame
+    const bool useTexture = d->renderMode == RenderTexture
+                            || (d->renderMode == RenderAuto && static_cast< qint64 >(rows) * cols > kAutoTextureCells);
+    bool textureReady = false;
+    if (useTexture) {
+        const ImPlotColormap cmap = ImPlot::GetStyle().Colormap;
+        textureReady              = d->texture.isValid() && !d->textureDirty && d->textureColormap == cmap;
+        if (!textureReady && d->uploadTexture(cmap)) {
+            d->textureDirty    = false;
+            d->textureColormap = cmap;
+            textureReady       = true;
+        }
+    }
+    d->textureActive = textureReady;
+
+    if (textureReady) {
+        // Row 0 of the image is the top row, as in ImPlot::PlotHeatmap
+        ImPlot::PlotImage(labelConstData(),
+                          (ImTextureID)d->texture.textureId(),
+                          bounds_min,
+                          bounds_max,
+                          ImVec2(0, 0),
+                          ImVec2(1, 1),
+                          ImVec4(1, 1, 1, 1));
+    } else {
+        // Call ImPlot API, using the instantiation that matches the stored element type (no conversion)
+        qimPlotDispatchValueType(d->data->valueType(), [ & ](auto tag) {
+            using T = typename decltype(tag)::type;
+            ImPlot::PlotHeatmap(
+                labelConstData(),
+                static_cast< const T* >(values),
+                rows,
+                cols,
+                scale_min,
+                scale_max,
+                label_fmt,
+                bounds_min,
+                bounds_max,
+                flags
+            );
+        });
+    }
 
     // Update item status
     ImPlotContext* ct    = ImPlot::GetCurrentContext();
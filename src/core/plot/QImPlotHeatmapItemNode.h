@@ -26,7 +26,8 @@ class QImAbstractHeatmapDataSeries;
  *
  * @note Heatmaps visualize 2D data as a color grid, useful for matrix data,
  *       correlation matrices, and 2D density plots.
- * @warning Large heatmaps (>1000x1000) may impact performance.
+ * @note Matrices of more than 128x128 cells are drawn as a texture by default (see renderMode),
+ *       so the per-frame cost does not depend on the matrix size.
  *
  * @param[in] parent Parent QObject (optional)
  *
@@ -46,7 +47,7 @@ class QImAbstractHeatmapDataSeries;
  *          继承自QImPlotItemNode，并遵循与QImPlotBarsItemNode相同的PIMPL设计模式以保持一致性。
  *
  * @note 热力图将二维数据可视化为颜色网格，适用于矩阵数据、相关矩阵和二维密度图。
- * @warning 大型热力图（>1000x1000）可能影响性能。
+ * @note 超过 128x128 个单元格的矩阵默认以纹理绘制（见 renderMode），每帧的代价与矩阵大小无关。
  *
  * @param[in] parent 父QObject对象（可选）
  *
@@ -194,7 +195,45 @@ class QIM_CORE_API QImPlotHeatmapItemNode : public QImPlotItemNode
      */
     Q_PROPERTY(bool colMajor READ isColMajor WRITE setColMajor NOTIFY colMajorChanged)
 
+    /**
+     * \if ENGLISH
+     * @property QImPlotHeatmapItemNode::renderMode
+     * @brief How the cells are drawn
+     *
+     * @details RenderCells emits one filled rectangle (and optionally one label) per cell every frame.
+     *          RenderTexture colormaps the matrix into an RGBA image once, uploads it to an OpenGL
+     *          texture and draws it as a single quad with ImPlot::PlotImage(); the image is rebuilt only
+     *          when the data, the colormap, the scale or the layout changes. Labels are not drawn in
+     *          texture mode. RenderAuto (default) uses the texture above 128x128 cells.
+     *          Without a current OpenGL context, or when the matrix exceeds the maximum texture
+     *          size, cells are drawn.
+     * @accessors READ renderMode WRITE setRenderMode
+     * \endif
+     *
+     * \if CHINESE
+     * @property QImPlotHeatmapItemNode::renderMode
+     * @brief 单元格的绘制方式
+     *
+     * @details RenderCells 每帧为每个单元格绘制一个填充矩形（以及可选的标签）。
+     *          RenderTexture 把矩阵按颜色映射一次性转换为 RGBA 图像，上传为 OpenGL 纹理，
+     *          通过 ImPlot::PlotImage() 以一个四边形绘制；只在数据、颜色映射、缩放范围或布局变化时重建图像。
+     *          纹理模式不绘制标签。RenderAuto（默认）在超过 128x128 个单元格时使用纹理。
+     *          没有当前 OpenGL 上下文或矩阵超过最大纹理尺寸时按单元格绘制。
+     * @accessors READ renderMode WRITE setRenderMode
+     * \endif
+     */
+    Q_PROPERTY(RenderMode renderMode READ renderMode WRITE setRenderMode)
+
 public:
+    // Rendering path of the cells
+    enum RenderMode
+    {
+        RenderAuto = 0,  ///< 超过 128x128 个单元格时使用纹理（默认）
+        RenderCells,     ///< 每个单元格一个矩形，可绘制标签
+        RenderTexture    ///< 颜色映射为纹理，每帧一个四边形
+    };
+    Q_ENUM(RenderMode)
+
     // Unique type identifier for QImPlotHeatmapItemNode
     enum
     {
@@ -235,6 +274,9 @@ public:
     // Gets the current data series
     QImAbstractHeatmapDataSeries* data() const;
 
+    // Call after the values of the data series were modified in place, rebuilds the texture
+    void notifyDataChanged();
+
     //----------------------------------------------------
     // Style property accessors
     //----------------------------------------------------
@@ -281,6 +323,15 @@ public:
     // Sets the raw ImPlotHeatmapFlags
     void setHeatmapFlags(int flags);
 
+    // Gets the rendering path of the cells
+    RenderMode renderMode() const;
+
+    // Sets the rendering path of the cells
+    void setRenderMode(RenderMode mode);
+
+    // Checks if the last frame was drawn from the texture
+    bool isTextureActive() const;
+
 Q_SIGNALS:
     /**
      * \if ENGLISH
@@ -124,7 +124,7 @@ public:
      * @return 位置处的X值
      * \endif
      */
-    virtual double xValueAt(int index) const = 0;
+    virtual double xValueAt(qint64 index) const = 0;
 
     /**
      * \if ENGLISH
@@ -139,7 +139,7 @@ public:
      * @return 位置处的Y值
      * \endif
      */
-    virtual double yValueAt(int index) const = 0;
+    virtual double yValueAt(qint64 index) const = 0;
 };
 
 /**
@@ -232,9 +232,9 @@ public:
     virtual ~QImVectorHistogram2DDataSeries() = default;
 
     // QImAbstractPlotDataSeries interface
-    int size() const override
+    qint64 size() const override
     {
-        return std::min(m_xs.size(), m_ys.size());
+        return static_cast< qint64 >(std::min(m_xs.size(), m_ys.size()));
     }
 
     // QImAbstractHistogram2DDataSeries interface
@@ -253,17 +253,17 @@ public:
         return m_ys.data();
     }
 
-    double xValueAt(int index) const override
+    double xValueAt(qint64 index) const override
     {
-        if (index < 0 || index >= static_cast<int>(m_xs.size())) {
+        if (index < 0 || index >= static_cast<qint64>(m_xs.size())) {
             return std::numeric_limits<double>::quiet_NaN();
         }
         return m_xs[index];
     }
 
-    double yValueAt(int index) const override
+    double yValueAt(qint64 index) const override
     {
-        if (index < 0 || index >= static_cast<int>(m_ys.size())) {
+        if (index < 0 || index >= static_cast<qint64>(m_ys.size())) {
             return std::numeric_limits<double>::quiet_NaN();
         }
         return m_ys[index];
@@ -272,8 +272,8 @@ public:
     // QImAbstractXYDataSeries interface (delegated)
     const double* xRawData() const override { return xValuesRawData(); }
     const double* yRawData() const override { return yValuesRawData(); }
-    double xValue(int index) const override { return xValueAt(index); }
-    double yValue(int index) const override { return yValueAt(index); }
+    double xValue(qint64 index) const override { return xValueAt(index); }
+    double yValue(qint64 index) const override { return yValueAt(index); }
 
 private:
     ContainerX m_xs;
@@ -17,7 +17,7 @@ class QImPlotHistogram2DItemNode::PrivateData
 public:
     PrivateData(QImPlotHistogram2DItemNode* p);
 
-    std::unique_ptr< QImAbstractXYDataSeries > data;
+    std::shared_ptr< QImAbstractXYDataSeries > data;
     ImPlotHistogramFlags flags { ImPlotHistogramFlags_None };
     int xBins { -2 };  // ImPlotBin_Sturges
     int yBins { -2 };
@@ -72,9 +72,25 @@ QImPlotHistogram2DItemNode::~QImPlotHistogram2DItemNode()
  * \endif
  */
 void QImPlotHistogram2DItemNode::setData(QImAbstractXYDataSeries* series)
+{
+    setSharedData(std::shared_ptr< QImAbstractXYDataSeries >(series));
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set a data series that may be shared with other items or inspection tools
+ * @param series Shared series, the item keeps a reference until the next setData()/setSharedData()
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置可与其它绘图项或检查工具共享的数据系列
+ * @param series 共享的数据系列，绘图项持有其引用直到下一次 setData()/setSharedData()
+ * \endif
+ */
+void QImPlotHistogram2DItemNode::setSharedData(std::shared_ptr< QImAbstractXYDataSeries > series)
 {
     QIM_D(d);
-    d->data.reset(series);
+    d->data = std::move(series);
     emit dataChanged();
 }
 
@@ -94,6 +110,11 @@ QImAbstractXYDataSeries* QImPlotHistogram2DItemNode::data() const
     return d_ptr->data.get();
 }
 
+std::shared_ptr< QImAbstractXYDataSeries > QImPlotHistogram2DItemNode::sharedData() const
+{
+    return d_ptr->data;
+}
+
 /**
  * \if ENGLISH
  * @brief Get X bin count or automatic method
@@ -6,6 +6,7 @@
 #include <QPointF>
 #include "QImPlotItemNode.h"
 #include "QImPlotDataSeries.h"
+#include <memory>
 
 namespace QIM
 {
@@ -284,6 +285,8 @@ public:
 
     // Sets the data series for the 2D histogram (X and Y arrays)
     void setData(QImAbstractXYDataSeries* series);
+    // Sets a series shared with other items, kept alive while this item uses it
+    void setSharedData(std::shared_ptr< QImAbstractXYDataSeries > series);
 
     // Sets 2D histogram data from X and Y containers
     template< typename ContainerX, typename ContainerY >
@@ -295,6 +298,8 @@ public:
 
     // Gets the current data series
     QImAbstractXYDataSeries* data() const;
+    // Gets the current data series as a shared reference
+    std::shared_ptr< QImAbstractXYDataSeries > sharedData() const;
 
     //----------------------------------------------------
     // Style property accessors
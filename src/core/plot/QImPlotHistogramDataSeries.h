@@ -98,6 +98,9 @@ public:
      */
     virtual const double* valuesRawData() const = 0;
 
+    // Type-erased pointer to the values array, element type given by yValueType()
+    virtual const void* valuesRawPointer() const { return yRawPointer(); }
+
     /**
      * \if ENGLISH
      * @brief Get value at specified index
@@ -111,7 +114,7 @@ public:
      * @return 位置处的值
      * \endif
      */
-    virtual double value(int index) const = 0;
+    virtual double value(qint64 index) const = 0;
 };
 
 /**
@@ -129,7 +132,7 @@ public:
  *          - size() method
  *          - operator[]
  *
- * @tparam ContainerValues Type for values container (must store double)
+ * @tparam ContainerValues Type for values container (double, float or integer elements)
  *
  * @see QImAbstractHistogramDataSeries
  * \endif
@@ -147,7 +150,7 @@ public:
  *          - size() 方法
  *          - operator[]
  *
- * @tparam ContainerValues 值容器类型（必须存储double）
+ * @tparam ContainerValues 值容器类型（元素可以是double、float或整数）
  *
  * @see QImAbstractHistogramDataSeries
  * \endif
@@ -156,8 +159,9 @@ template<typename ContainerValues>
 class QImVectorHistogramDataSeries : public QImAbstractHistogramDataSeries
 {
 public:
-    static_assert(std::is_same_v<typename ContainerValues::value_type, double>, 
-                  "ContainerValues must store double");
+    using ValueType = typename ContainerValues::value_type;
+    static_assert(std::is_arithmetic_v<ValueType> && !std::is_same_v<ValueType, bool>,
+                  "ContainerValues must store numbers");
 
     /**
      * \if ENGLISH
@@ -194,9 +198,9 @@ public:
     virtual ~QImVectorHistogramDataSeries() = default;
 
     // QImAbstractPlotDataSeries interface
-    int size() const override
+    qint64 size() const override
     {
-        return m_values.size();
+        return static_cast< qint64 >(m_values.size());
     }
 
     // QImAbstractHistogramDataSeries interface
@@ -207,26 +211,32 @@ public:
 
     const double* valuesRawData() const override
     {
-        return m_values.data();
+        if constexpr (std::is_same_v<ValueType, double>) {
+            return m_values.data();
+        } else {
+            return nullptr;
+        }
     }
 
-    double value(int index) const override
+    double value(qint64 index) const override
     {
-        if (index < 0 || index >= static_cast<int>(m_values.size())) {
+        if (index < 0 || index >= static_cast<qint64>(m_values.size())) {
             return std::numeric_limits<double>::quiet_NaN();
         }
-        return m_values[index];
+        return static_cast<double>(m_values[index]);
     }
 
     // QImAbstractXYDataSeries interface
-    int stride() const override { return sizeof(double); }
+    int stride() const override { return sizeof(ValueType); }
     const double* xRawData() const override { return nullptr; }
-    const double* yRawData() const override { return m_values.data(); }
-    double xValue(int index) const override { return static_cast<double>(index); }
-    double yValue(int index) const override { return value(index); }
+    const double* yRawData() const override { return valuesRawData(); }
+    QImPlotValueType yValueType() const override { return qimPlotValueType<ValueType>(); }
+    const void* yRawPointer() const override { return m_values.data(); }
+    double xValue(qint64 index) const override { return static_cast<double>(index); }
+    double yValue(qint64 index) const override { return value(index); }
     double xScale() const override { return 1.0; }
     double xStart() const override { return 0.0; }
-    int offset() const override { return 0; }
+    qint64 offset() const override { return 0; }
 
 private:
     ContainerValues m_values;
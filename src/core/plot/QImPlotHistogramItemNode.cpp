@@ -1,10 +1,10 @@
 #include "QImPlotHistogramItemNode.h"
+#include "QImHistogramBinner.h"
 #include <optional>
 #include "implot.h"
 #include "implot_internal.h"
 #include "QImTrackedValue.hpp"
 #include "QtImGuiUtils.h"
-#include <QDebug>
 
 namespace QIM
 {
@@ -14,8 +14,10 @@ class QImPlotHistogramItemNode::PrivateData
     QIM_DECLARE_PUBLIC(QImPlotHistogramItemNode)
 public:
     PrivateData(QImPlotHistogramItemNode* p);
+    // 由当前属性得到分箱设置
+    QImHistogramBinner::Settings binSettings() const;
 
-    std::unique_ptr< QImAbstractXYDataSeries > data;
+    std::shared_ptr< QImAbstractXYDataSeries > data;
     ImPlotHistogramFlags flags { ImPlotHistogramFlags_None };
     int bins { -2 };  // ImPlotBin_Sturges
     double barScale { 1.0 };
@@ -23,12 +25,29 @@ public:
     double rangeMax { 0.0 };  // 0 = auto
     // Style tracking values
     std::optional< QImTrackedValue< ImVec4, QIM::ImVecComparator< ImVec4 > > > color;
+    // 缓存的分箱结果，只在数据或分箱设置变化时重新计算
+    QImHistogramBinner binner;
+    bool binsDirty { true };
+    qint64 binnedSize { -1 };  ///< 已分箱的样本数
+    qint64 appended { 0 };     ///< 上次分箱后通知追加的样本数
 };
 
 QImPlotHistogramItemNode::PrivateData::PrivateData(QImPlotHistogramItemNode* p) : q_ptr(p)
 {
 }
 
+QImHistogramBinner::Settings QImPlotHistogramItemNode::PrivateData::binSettings() const
+{
+    QImHistogramBinner::Settings s;
+    s.bins       = bins;
+    s.rangeMin   = rangeMin;
+    s.rangeMax   = rangeMax;
+    s.cumulative = (flags & ImPlotHistogramFlags_Cumulative) != 0;
+    s.density    = (flags & ImPlotHistogramFlags_Density) != 0;
+    s.outliers   = (flags & ImPlotHistogramFlags_NoOutliers) == 0;
+    return s;
+}
+
 /**
  * \if ENGLISH
  * @brief Constructor for QImPlotHistogramItemNode
@@ -61,17 +80,42 @@ QImPlotHistogramItemNode::~QImPlotHistogramItemNode()
  * \if ENGLISH
  * @brief Set data series for the histogram
  * @param series Pointer to QImAbstractXYDataSeries
+ * @details The bin counts are cached and recomputed only when the series, its size or a binning property
+ *          changes. After modifying values of the series in place without changing its size, call
+ *          notifyDataChanged(); after appending values, call notifyDataAppended().
  * \endif
  *
  * \if CHINESE
  * @brief 设置直方图的数据系列
  * @param series QImAbstractXYDataSeries指针
+ * @details 分箱结果被缓存，只在数据系列、点数或分箱属性变化时重新计算。原地修改数据系列的值且点数不变时，
+ *          需调用 notifyDataChanged()；追加数据后调用 notifyDataAppended()。
  * \endif
  */
 void QImPlotHistogramItemNode::setData(QImAbstractXYDataSeries* series)
+{
+    setSharedData(std::shared_ptr< QImAbstractXYDataSeries >(series));
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set a data series that may be shared with other items or inspection tools
+ * @param series Shared series, the item keeps a reference until the next setData()/setSharedData()
+ * @details In-place edits and appends must be notified as described in setData().
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置可与其它绘图项或检查工具共享的数据系列
+ * @param series 共享的数据系列，绘图项持有其引用直到下一次 setData()/setSharedData()
+ * @details 原地修改与追加数据的通知方式见 setData()。
+ * \endif
+ */
+void QImPlotHistogramItemNode::setSharedData(std::shared_ptr< QImAbstractXYDataSeries > series)
 {
     QIM_D(d);
-    d->data.reset(series);
+    d->data      = std::move(series);
+    d->binsDirty = true;
+    d->appended  = 0;
     Q_EMIT dataChanged();
 }
 
@@ -91,6 +135,58 @@ QImAbstractXYDataSeries* QImPlotHistogramItemNode::data() const
     return d_ptr->data.get();
 }
 
+std::shared_ptr< QImAbstractXYDataSeries > QImPlotHistogramItemNode::sharedData() const
+{
+    return d_ptr->data;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Notifies that the values of the data series were modified in place
+ * @details The values are binned again before the next frame. Not needed after setData(), use
+ *          notifyDataAppended() after appending values.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 通知数据系列的值被原地修改
+ * @details 下一帧绘制前重新分箱。setData() 之后无需调用，追加数据后请使用 notifyDataAppended()。
+ * \endif
+ */
+void QImPlotHistogramItemNode::notifyDataChanged()
+{
+    QIM_D(d);
+    d->binsDirty = true;
+    requestRender();
+}
+
+/**
+ * \if ENGLISH
+ * @brief Notifies the item that samples were appended to the current data series
+ * @param count Number of appended samples
+ * @details Use this with streaming series instead of calling setData() again. When the series grew by
+ *          exactly the notified count, only the new values are binned before the next frame
+ *          (QImHistogramBinner::append()), however many appends happened in between. If samples were
+ *          also evicted (sliding window, wrapped ring buffer), the series is binned again.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 通知绘图项当前数据系列追加了数据
+ * @param count 追加的点数
+ * @details 配合流式数据系列使用，代替再次调用 setData()。数据系列恰好增长了通知的点数时，
+ *          下一帧绘制前只对新增的值分箱（QImHistogramBinner::append()），无论两帧之间追加了多少次。
+ *          同时淘汰了旧数据（滑动窗口、已回绕的环形缓冲）时重新分箱。
+ * \endif
+ */
+void QImPlotHistogramItemNode::notifyDataAppended(qint64 count)
+{
+    QIM_D(d);
+    if (count <= 0 || !d->data) {
+        return;
+    }
+    d->appended += count;
+    requestRender();
+}
+
 /**
  * \if ENGLISH
  * @brief Get bin count or automatic method
@@ -494,23 +590,14 @@ QColor QImPlotHistogramItemNode::color() const
  */
 void QImPlotHistogramItemNode::setColor(const QColor& c)
 {
-    qDebug() << "[HistogramItemNode] setColor called with:" << c;
-    
-    ImVec4 imColor = toImVec4(c);
-    
+    const ImVec4 imColor = toImVec4(c);
     if (d_ptr->color.has_value()) {
-        qDebug() << "[HistogramItemNode] color optional has value, current dirty=" << d_ptr->color->is_dirty();
-        qDebug() << "[HistogramItemNode] current color value:" << toQColor(d_ptr->color->value());
         d_ptr->color->operator=(imColor);  // Explicitly call assignment to trigger dirty
-        qDebug() << "[HistogramItemNode] after assignment, dirty=" << d_ptr->color->is_dirty();
     } else {
-        qDebug() << "[HistogramItemNode] color optional has NO value, creating new QImTrackedValue";
         // Create with value and then mark dirty
         d_ptr->color.emplace(imColor);
         d_ptr->color->mark_dirty();  // Force dirty because this is a new color being set
-        qDebug() << "[HistogramItemNode] after emplace+mark_dirty, dirty=" << d_ptr->color->is_dirty();
     }
-    
     Q_EMIT colorChanged(c);
 }
 
@@ -569,54 +656,41 @@ bool QImPlotHistogramItemNode::beginDraw()
         return false;
     }
 
-    // Debug: Check color state before applying style
-    qDebug() << "[HistogramItemNode] beginDraw - color has_value:" << d->color.has_value();
-    if (d->color.has_value()) {
-        qDebug() << "[HistogramItemNode] beginDraw - color is_dirty:" << d->color->is_dirty();
-        qDebug() << "[HistogramItemNode] beginDraw - color value:" << toQColor(d->color->value());
-    }
-
     // Apply style - use SetNextFillStyle for histogram bars
     if (d->color.has_value() && d->color->is_dirty()) {
-        qDebug() << "[HistogramItemNode] beginDraw - calling SetNextFillStyle with color:" << toQColor(d->color->value());
         ImPlot::SetNextFillStyle(d->color->value());
         d->color->clear();  // Clear dirty flag after applying
-    } else {
-        qDebug() << "[HistogramItemNode] beginDraw - NOT calling SetNextFillStyle (color not dirty or no value)";
     }
 
-    // Prepare ImPlotRange
-    ImPlotRange range;
-    if (d->rangeMin != 0.0 || d->rangeMax != 0.0) {
-        range.Min = d->rangeMin;
-        range.Max = d->rangeMax;
-    } else {
-        // Auto range: use data min/max
-        // Since histogram uses only Y values, we need to compute min/max of Y data
-        // For simplicity, let ImPlot compute automatically by passing ImPlotRange()
-        range = ImPlotRange();
+    // Rebin only when the data or a binning property changed, a static histogram costs O(bins) per frame;
+    // notified appends are binned on their own without reading the history again
+    const QImHistogramBinner::Settings settings = d->binSettings();
+    const qint64 size                           = d->data->size();
+    // 通知了追加但大小不符时说明同时淘汰了旧数据，需要重新分箱
+    const bool appendedOnly = d->appended > 0 && size == d->binnedSize + d->appended;
+    const bool sizeChanged  = (d->appended > 0) ? !appendedOnly : (size != d->binnedSize);
+    if (d->binsDirty || sizeChanged || d->binner.settings() != settings) {
+        d->binner.compute(*d->data, settings);
+    } else if (appendedOnly) {
+        d->binner.append(*d->data, d->binnedSize);
+    }
+    d->binsDirty  = false;
+    d->binnedSize = size;
+    d->appended   = 0;
+
+    const int binCount = d->binner.binCount();
+    if (binCount <= 0) {
+        return false;
     }
 
-    // Call ImPlot API
-    if (d->data->isContiguous()) {
-        // Continuous memory mode: use zero-copy fast path
-        const double* values = d->data->yRawData();
-        int count = d->data->size();
-        ImPlot::PlotHistogram(
-            labelConstData(), values, count, d->bins, d->barScale, range, d->flags);
+    // Draw the cached bars the same way ImPlot::PlotHistogram() does
+    const double* centers = d->binner.binCenters().data();
+    const double* counts  = d->binner.binCounts().data();
+    const double barSize  = d->barScale * d->binner.binWidth();
+    if (d->flags & ImPlotHistogramFlags_Horizontal) {
+        ImPlot::PlotBars(labelConstData(), counts, centers, binCount, barSize, ImPlotBarsFlags_Horizontal);
     } else {
-        // Non-contiguous memory mode: use callback (ImPlot doesn't provide PlotHistogramG, but we can use PlotHistogram with getter?)
-        // Actually ImPlot::PlotHistogram has no getter version. We'll need to extract values into temporary array.
-        // For simplicity, we'll extract values (might be inefficient for large data).
-        // This is a limitation; we could implement a custom getter using ImPlot::PlotHistogramG? Not exist.
-        // We'll just extract.
-        int count = d->data->size();
-        std::vector<double> values(count);
-        for (int i = 0; i < count; ++i) {
-            values[i] = d->data->yValue(i);
-        }
-        ImPlot::PlotHistogram(
-            labelConstData(), values.data(), count, d->bins, d->barScale, range, d->flags);
+        ImPlot::PlotBars(labelConstData(), centers, counts, binCount, barSize);
     }
 
     // Update item status
@@ -7,6 +7,7 @@
 #include "QImPlotItemNode.h"
 #include "QImPlotDataSeries.h"
 #include "QImPlotHistogramDataSeries.h"
+#include <memory>
 
 namespace QIM
 {
@@ -100,6 +101,8 @@ public:
 
     // Sets the data series for the histogram (Y values only)
     void setData(QImAbstractXYDataSeries* series);
+    // Sets a series shared with other items, kept alive while this item uses it
+    void setSharedData(std::shared_ptr< QImAbstractXYDataSeries > series);
 
     // Sets histogram data from single value container (Y-only mode)
     template< typename ContainerY >
@@ -113,6 +116,12 @@ public:
 
     // Gets the current data series
     QImAbstractXYDataSeries* data() const;
+    // Gets the current data series as a shared reference
+    std::shared_ptr< QImAbstractXYDataSeries > sharedData() const;
+    // Call after the values of the data series were modified in place, rebins before the next frame
+    void notifyDataChanged();
+    // Call after count values were appended to the data series, only the new values are binned
+    void notifyDataAppended(qint64 count = 1);
 
     //----------------------------------------------------
     // Style property accessors
@@ -0,0 +1,152 @@
+#include "QImPlotHistogramKernel.h"
+#include "QImPlotMinMaxKernel.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define QIM_HISTOGRAM_X86 1
+#include <immintrin.h>
+#endif
+
+// GCC/Clang 需要为单个函数开启指令集，MSVC 可直接使用内建函数
+#if defined(__GNUC__) || defined(__clang__)
+#define QIM_HISTOGRAM_TARGET(isa) __attribute__((target(isa)))
+#else
+#define QIM_HISTOGRAM_TARGET(isa)
+#endif
+
+namespace QIM
+{
+
+namespace
+{
+
+template< typename T >
+void binScalar(const T* p, qint64 n, const QImPlotUniformBins& bins, qint64* counts)
+{
+    for (qint64 i = 0; i < n; ++i) {
+        ++counts[ qimPlotUniformBinSlot(bins, static_cast< double >(p[ i ])) ];
+    }
+}
+
+#if QIM_HISTOGRAM_X86
+
+/**
+ * SIMD 内核只计算槽位，计数仍逐个累加（没有无冲突的散射加法）。
+ * 箱索引在 double 域中先钳制到 [0, count - 1] 再截断，对范围内的值与 qimPlotUniformBinSlot 的
+ * 先截断后钳制结果相同；0/0（width 为 0）得到的 NaN 由 max 归为 0。
+ */
+
+QIM_HISTOGRAM_TARGET("avx2") inline __m256d loadAvx2(const double* p)
+{
+    return _mm256_loadu_pd(p);
+}
+
+QIM_HISTOGRAM_TARGET("avx2") inline __m256d loadAvx2(const float* p)
+{
+    return _mm256_cvtps_pd(_mm_loadu_ps(p));
+}
+
+template< typename T >
+QIM_HISTOGRAM_TARGET("avx2") void binAvx2(const T* p, qint64 n, const QImPlotUniformBins& bins, qint64* counts)
+{
+    const __m256d lo    = _mm256_set1_pd(bins.lower);
+    const __m256d hi    = _mm256_set1_pd(bins.upper);
+    const __m256d width = _mm256_set1_pd(bins.width);
+    const __m256d zero  = _mm256_setzero_pd();
+    const __m256d last  = _mm256_set1_pd(bins.count - 1);
+    const __m256d below = _mm256_set1_pd(bins.count);
+    const __m256d above = _mm256_set1_pd(bins.count + 1);
+    alignas(16) int slots[ 8 ];
+    qint64 i = 0;
+    for (; i + 8 <= n; i += 8) {
+        for (int k = 0; k < 2; ++k) {
+            const __m256d v       = loadAvx2(p + i + 4 * k);
+            const __m256d inRange = _mm256_and_pd(_mm256_cmp_pd(v, lo, _CMP_GE_OQ), _mm256_cmp_pd(v, hi, _CMP_LE_OQ));
+            const __m256d isBelow = _mm256_cmp_pd(v, lo, _CMP_LT_OQ);
+            __m256d q             = _mm256_div_pd(_mm256_sub_pd(v, lo), width);
+            q                     = _mm256_min_pd(_mm256_max_pd(q, zero), last);
+            q                     = _mm256_blendv_pd(_mm256_blendv_pd(above, below, isBelow), q, inRange);
+            _mm_store_si128(reinterpret_cast< __m128i* >(slots + 4 * k), _mm256_cvttpd_epi32(q));
+        }
+        for (int k = 0; k < 8; ++k) {
+            ++counts[ slots[ k ] ];
+        }
+    }
+    binScalar(p + i, n - i, bins, counts);
+}
+
+QIM_HISTOGRAM_TARGET("avx512f") inline __m512d loadAvx512(const double* p)
+{
+    return _mm512_loadu_pd(p);
+}
+
+QIM_HISTOGRAM_TARGET("avx512f") inline __m512d loadAvx512(const float* p)
+{
+    return _mm512_cvtps_pd(_mm256_loadu_ps(p));
+}
+
+template< typename T >
+QIM_HISTOGRAM_TARGET("avx512f") void binAvx512(const T* p, qint64 n, const QImPlotUniformBins& bins, qint64* counts)
+{
+    const __m512d lo    = _mm512_set1_pd(bins.lower);
+    const __m512d hi    = _mm512_set1_pd(bins.upper);
+    const __m512d width = _mm512_set1_pd(bins.width);
+    const __m512d zero  = _mm512_setzero_pd();
+    const __m512d last  = _mm512_set1_pd(bins.count - 1);
+    const __m512d below = _mm512_set1_pd(bins.count);
+    const __m512d above = _mm512_set1_pd(bins.count + 1);
+    alignas(32) int slots[ 16 ];
+    qint64 i = 0;
+    for (; i + 16 <= n; i += 16) {
+        for (int k = 0; k < 2; ++k) {
+            const __m512d v        = loadAvx512(p + i + 8 * k);
+            const __mmask8 inRange = _mm512_cmp_pd_mask(v, lo, _CMP_GE_OQ) & _mm512_cmp_pd_mask(v, hi, _CMP_LE_OQ);
+            const __mmask8 isBelow = _mm512_cmp_pd_mask(v, lo, _CMP_LT_OQ);
+            __m512d q              = _mm512_div_pd(_mm512_sub_pd(v, lo), width);
+            q                      = _mm512_min_pd(_mm512_max_pd(q, zero), last);
+            q = _mm512_mask_blend_pd(inRange, _mm512_mask_blend_pd(isBelow, above, below), q);
+            _mm256_store_si256(reinterpret_cast< __m256i* >(slots + 8 * k), _mm512_cvttpd_epi32(q));
+        }
+        for (int k = 0; k < 16; ++k) {
+            ++counts[ slots[ k ] ];
+        }
+    }
+    binScalar(p + i, n - i, bins, counts);
+}
+
+#endif  // QIM_HISTOGRAM_X86
+
+template< typename T >
+void dispatchBin(const T* p, qint64 n, const QImPlotUniformBins& bins, qint64* counts)
+{
+    if (!p || n <= 0 || bins.count <= 0) {
+        return;
+    }
+    // 与最大/最小值内核共用 qimPlotSetSimdLevel() 的设置
+    switch (qimPlotSimdLevel()) {
+#if QIM_HISTOGRAM_X86
+    case QImPlotSimdLevel::AVX512:
+        binAvx512(p, n, bins, counts);
+        return;
+    case QImPlotSimdLevel::AVX2:
+        binAvx2(p, n, bins, counts);
+        return;
+#endif
+    default:
+        break;
+    }
+    binScalar(p, n, bins, counts);
+}
+
+}  // namespace
+
+void qimPlotBinUniform(const double* data, qint64 n, const QImPlotUniformBins& bins, qint64* counts)
+{
+    dispatchBin(data, n, bins, counts);
+}
+
+void qimPlotBinUniform(const float* data, qint64 n, const QImPlotUniformBins& bins, qint64* counts)
+{
+    dispatchBin(data, n, bins, counts);
+}
+
+}  // namespace QIM
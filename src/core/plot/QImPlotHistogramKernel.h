@@ -0,0 +1,112 @@
+#ifndef QIMPLOTHISTOGRAMKERNEL_H
+#define QIMPLOTHISTOGRAMKERNEL_H
+
+#include "QImPlotDataSeriesView.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace QIM
+{
+
+/**
+ * @brief 均匀分箱的网格
+ *
+ * [lower, upper] 内的值 v 落入第 clamp((int)((v - lower) / width), 0, count - 1) 个箱，与 ImPlot::PlotHistogram 一致；
+ * width 为 0 时全部落入第一个箱
+ */
+struct QImPlotUniformBins
+{
+    double lower { 0.0 };
+    double upper { 0.0 };
+    double width { 0.0 };
+    int count { 0 };
+};
+
+/**
+ * @brief 值 v 的计数槽位
+ *
+ * 计数数组共 count + 2 个槽位：[0, count) 为各箱，count 为低于 lower 的值，count + 1 为高于 upper 的值与 NaN
+ */
+inline int qimPlotUniformBinSlot(const QImPlotUniformBins& bins, double v)
+{
+    if (v >= bins.lower && v <= bins.upper) {
+        return (bins.width > 0) ? std::clamp(static_cast< int >((v - bins.lower) / bins.width), 0, bins.count - 1) : 0;
+    }
+    return (v < bins.lower) ? bins.count : bins.count + 1;
+}
+
+// 把连续数组 [0, n) 计入 counts（bins.count + 2 个槽位，见 qimPlotUniformBinSlot），按 qimPlotSimdLevel() 选择内核
+QIM_CORE_API void qimPlotBinUniform(const double* data, qint64 n, const QImPlotUniformBins& bins, qint64* counts);
+QIM_CORE_API void qimPlotBinUniform(const float* data, qint64 n, const QImPlotUniformBins& bins, qint64* counts);
+
+namespace detail
+{
+template< typename View >
+struct ViewBinUniform
+{
+    static void run(const View& view, qint64 first, qint64 last, const QImPlotUniformBins& bins, qint64* counts)
+    {
+        for (qint64 i = first; i < last; ++i) {
+            ++counts[ qimPlotUniformBinSlot(bins, view.y(i)) ];
+        }
+    }
+};
+
+// 紧凑存储的 double/float Y 值走 SIMD 内核，环形缓冲回绕处拆为两段
+template< typename TX, typename TY >
+struct ViewBinUniform< QImPlotXYView< TX, TY > >
+{
+    static void run(const QImPlotXYView< TX, TY >& view,
+                    qint64 first,
+                    qint64 last,
+                    const QImPlotUniformBins& bins,
+                    qint64* counts)
+    {
+        if constexpr (std::is_same_v< TY, double > || std::is_same_v< TY, float >) {
+            if (view.yStride == static_cast< int >(sizeof(TY)) && last > first) {
+                const TY* ys      = reinterpret_cast< const TY* >(view.ys);
+                const qint64 raw  = view.rawIndex(first);
+                const qint64 n    = last - first;
+                const qint64 head = std::min(n, view.count - raw);
+                qimPlotBinUniform(ys + raw, head, bins, counts);
+                if (head < n) {
+                    qimPlotBinUniform(ys, n - head, bins, counts);
+                }
+                return;
+            }
+        }
+        for (qint64 i = first; i < last; ++i) {
+            ++counts[ qimPlotUniformBinSlot(bins, view.y(i)) ];
+        }
+    }
+};
+}  // namespace detail
+
+/**
+ * \if ENGLISH
+ * @brief Adds the Y values of the logical range [first, last) of a view to uniform bin counts
+ * @details counts holds bins.count + 2 slots, see qimPlotUniformBinSlot(). Packed double/float storage
+ *          computes the bin indices with the SIMD kernel selected at runtime, other views are binned
+ *          point by point. The result is the same on every path.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 把视图逻辑区间 [first, last) 内的 Y 值计入均匀分箱
+ * @details counts 共 bins.count + 2 个槽位，见 qimPlotUniformBinSlot()。紧凑存储的 double/float 数据
+ *          使用运行时选择的 SIMD 内核计算箱索引，其它视图逐点分箱。各路径的结果相同。
+ * \endif
+ */
+template< typename View >
+void qimPlotViewBinUniform(const View& view,
+                           qint64 first,
+                           qint64 last,
+                           const QImPlotUniformBins& bins,
+                           qint64* counts)
+{
+    detail::ViewBinUniform< View >::run(view, first, last, bins, counts);
+}
+
+}  // namespace QIM
+
+#endif  // QIMPLOTHISTOGRAMKERNEL_H
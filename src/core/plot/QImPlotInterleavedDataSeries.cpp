@@ -0,0 +1,211 @@
+#include "QImPlotInterleavedDataSeries.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace QIM
+{
+
+//===============================================================
+// QImRecordBuffer
+//===============================================================
+
+QImRecordBuffer::QImRecordBuffer(int recordSize) : m_recordSize(std::max(recordSize, 1))
+{
+}
+
+QImRecordBuffer::QImRecordBuffer(const void* records, int count, int recordSize) : m_recordSize(std::max(recordSize, 1))
+{
+    if (records && count > 0) {
+        m_bytes = QByteArray(static_cast< const char* >(records), count * m_recordSize);
+    }
+}
+
+/**
+ * \if ENGLISH
+ * @brief Wraps external records without copying
+ * @param records Pointer to the first record, must outlive the buffer and every series using it
+ * @param count Number of records
+ * @param recordSize Size of one record in bytes
+ * @return Shared buffer ready to be passed to QImInterleavedXYDataSeries
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 不拷贝地包装外部记录
+ * @param records 首条记录指针，生命周期必须长于缓冲区及所有使用它的数据系列
+ * @param count 记录条数
+ * @param recordSize 单条记录字节数
+ * @return 可直接传给 QImInterleavedXYDataSeries 的共享缓冲区
+ * \endif
+ */
+std::shared_ptr< QImRecordBuffer > QImRecordBuffer::fromRawData(const void* records, int count, int recordSize)
+{
+    auto buffer = std::make_shared< QImRecordBuffer >(recordSize);
+    if (records && count > 0) {
+        buffer->m_bytes = QByteArray::fromRawData(static_cast< const char* >(records), count * buffer->m_recordSize);
+    }
+    return buffer;
+}
+
+int QImRecordBuffer::recordSize() const
+{
+    return m_recordSize;
+}
+
+int QImRecordBuffer::count() const
+{
+    return m_bytes.size() / m_recordSize;
+}
+
+const char* QImRecordBuffer::constData() const
+{
+    return m_bytes.constData();
+}
+
+void QImRecordBuffer::append(const void* records, int count)
+{
+    if (!records || count <= 0) {
+        return;
+    }
+    m_bytes.append(static_cast< const char* >(records), count * m_recordSize);
+}
+
+void QImRecordBuffer::clear()
+{
+    m_bytes.clear();
+}
+
+//===============================================================
+// QImInterleavedXYDataSeries
+//===============================================================
+
+QImInterleavedXYDataSeries::QImInterleavedXYDataSeries(std::shared_ptr< const QImRecordBuffer > buffer,
+                                                       QImRecordField x,
+                                                       QImRecordField y)
+    : QImAbstractXYDataSeries(), m_buffer(std::move(buffer)), m_x(x), m_y(y)
+{
+}
+
+QImInterleavedXYDataSeries::QImInterleavedXYDataSeries(std::shared_ptr< const QImRecordBuffer > buffer,
+                                                       QImRecordField y,
+                                                       double xStart,
+                                                       double xScale)
+    : QImAbstractXYDataSeries(), m_buffer(std::move(buffer)), m_y(y), m_yOnly(true), m_xStart(xStart), m_xScale(xScale)
+{
+}
+
+qint64 QImInterleavedXYDataSeries::size() const
+{
+    return m_buffer ? m_buffer->count() : 0;
+}
+
+bool QImInterleavedXYDataSeries::isContiguous() const
+{
+    // 按固定步幅连续存放，ImPlot 可直接按 stride 访问
+    return true;
+}
+
+int QImInterleavedXYDataSeries::stride() const
+{
+    return m_buffer ? m_buffer->recordSize() : qimPlotValueTypeSize(m_y.type);
+}
+
+int QImInterleavedXYDataSeries::xStride() const
+{
+    return stride();
+}
+
+const double* QImInterleavedXYDataSeries::xRawData() const
+{
+    if (m_x.type != QImPlotValueType::Double) {
+        return nullptr;
+    }
+    return static_cast< const double* >(xRawPointer());
+}
+
+const double* QImInterleavedXYDataSeries::yRawData() const
+{
+    if (m_y.type != QImPlotValueType::Double) {
+        return nullptr;
+    }
+    return static_cast< const double* >(yRawPointer());
+}
+
+QImPlotValueType QImInterleavedXYDataSeries::xValueType() const
+{
+    return m_yOnly ? QImPlotValueType::Double : m_x.type;
+}
+
+QImPlotValueType QImInterleavedXYDataSeries::yValueType() const
+{
+    return m_y.type;
+}
+
+const void* QImInterleavedXYDataSeries::xRawPointer() const
+{
+    if (m_yOnly || size() == 0) {
+        return nullptr;
+    }
+    return m_buffer->constData() + m_x.offset;
+}
+
+const void* QImInterleavedXYDataSeries::yRawPointer() const
+{
+    if (size() == 0) {
+        return nullptr;
+    }
+    return m_buffer->constData() + m_y.offset;
+}
+
+double QImInterleavedXYDataSeries::xScale() const
+{
+    return m_xScale;
+}
+
+double QImInterleavedXYDataSeries::xStart() const
+{
+    return m_xStart;
+}
+
+double QImInterleavedXYDataSeries::xValue(qint64 index) const
+{
+    if (index < 0 || index >= size()) {
+        return std::numeric_limits< double >::quiet_NaN();
+    }
+    if (m_yOnly) {
+        return m_xStart + m_xScale * index;
+    }
+    return fieldValue(m_x, index);
+}
+
+double QImInterleavedXYDataSeries::yValue(qint64 index) const
+{
+    if (index < 0 || index >= size()) {
+        return std::numeric_limits< double >::quiet_NaN();
+    }
+    return fieldValue(m_y, index);
+}
+
+std::shared_ptr< const QImRecordBuffer > QImInterleavedXYDataSeries::buffer() const
+{
+    return m_buffer;
+}
+
+bool QImInterleavedXYDataSeries::isYOnly() const
+{
+    return m_yOnly;
+}
+
+double QImInterleavedXYDataSeries::fieldValue(const QImRecordField& field, qint64 index) const
+{
+    const char* p = m_buffer->constData() + index * m_buffer->recordSize() + field.offset;
+    return qimPlotDispatchValueType(field.type, [ p ](auto tag) -> double {
+        using T = typename decltype(tag)::type;
+        // 记录内字段不一定按类型对齐，使用 memcpy 读取
+        T v;
+        std::memcpy(&v, p, sizeof(T));
+        return static_cast< double >(v);
+    });
+}
+
+}  // namespace QIM
@@ -0,0 +1,167 @@
+#ifndef QIMPLOTINTERLEAVEDDATASERIES_H
+#define QIMPLOTINTERLEAVEDDATASERIES_H
+
+#include "QImPlotDataSeries.h"
+#include <QByteArray>
+#include <QtGlobal>
+#include <memory>
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief Packed record storage (array of structs) shared by several interleaved series
+ *
+ * @class QImRecordBuffer
+ * @ingroup plot_data
+ *
+ * @details Holds count() records of recordSize() bytes each, back to back, exactly as delivered
+ *          by acquisition hardware, e.g. `{double t; float ch[16]; quint32 flags;}`.
+ *          Wrap it in a std::shared_ptr and hand it to one QImInterleavedXYDataSeries per field;
+ *          every series reads the same memory through a byte stride, nothing is de-interleaved.
+ *
+ *          fromRawData() wraps external memory without copying (like QByteArray::fromRawData()),
+ *          the caller must then keep that memory alive and unchanged.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 多个交错数据系列共享的紧凑记录存储（结构体数组）
+ *
+ * @class QImRecordBuffer
+ * @ingroup plot_data
+ *
+ * @details 连续存放 count() 条、每条 recordSize() 字节的记录，与采集硬件给出的格式完全一致，
+ *          例如 `{double t; float ch[16]; quint32 flags;}`。
+ *          用 std::shared_ptr 包装后，每个字段交给一个 QImInterleavedXYDataSeries；
+ *          所有数据系列按字节步幅读取同一块内存，不做任何拆分拷贝。
+ *
+ *          fromRawData() 不拷贝地包装外部内存（与 QByteArray::fromRawData() 相同），
+ *          调用者需保证该内存在使用期间有效且不被修改。
+ * \endif
+ */
+class QIM_CORE_API QImRecordBuffer
+{
+public:
+    // Constructs an empty buffer of records of recordSize bytes
+    explicit QImRecordBuffer(int recordSize);
+    // Copies count records of recordSize bytes
+    QImRecordBuffer(const void* records, int count, int recordSize);
+    // Wraps external records without copying
+    static std::shared_ptr< QImRecordBuffer > fromRawData(const void* records, int count, int recordSize);
+
+    // Size of one record in bytes, also the stride of every field
+    int recordSize() const;
+    // Number of records
+    int count() const;
+    // Pointer to the first record
+    const char* constData() const;
+    // Appends count records (detaches raw data)
+    void append(const void* records, int count);
+    // Removes all records
+    void clear();
+
+private:
+    QByteArray m_bytes;
+    int m_recordSize { 1 };
+};
+
+/**
+ * \if ENGLISH
+ * @brief Location and type of one field inside a record
+ * @details Build it with QImRecordField::of<T>(offsetof(Record, member)).
+ *          Array members are addressed as offsetof(Record, ch) + k * sizeof(float).
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 记录中一个字段的位置与类型
+ * @details 通过 QImRecordField::of<T>(offsetof(Record, member)) 构造。
+ *          数组成员按 offsetof(Record, ch) + k * sizeof(float) 寻址。
+ * \endif
+ */
+struct QImRecordField
+{
+    int offset { 0 };  ///< 字段在记录中的字节偏移
+    QImPlotValueType type { QImPlotValueType::Double };
+
+    template< typename T >
+    static QImRecordField of(std::size_t byteOffset)
+    {
+        return QImRecordField { static_cast< int >(byteOffset), qimPlotValueType< T >() };
+    }
+};
+
+/**
+ * \if ENGLISH
+ * @brief XY data series viewing two fields of a shared QImRecordBuffer
+ *
+ * @class QImInterleavedXYDataSeries
+ * @ingroup plot_data
+ *
+ * @details xRawPointer()/yRawPointer() point at the first record's field and stride()/xStride()
+ *          are the record size, so ImPlot and the downsamplers walk the packed buffer directly.
+ *          When X and Y share one type ImPlot::PlotLine<T> is called with the byte stride,
+ *          otherwise the item uses a typed getter; no copy is made in either case.
+ * @note bounds() only scans records appended since its last call; after clearing and refilling
+ *       the shared buffer call invalidateBounds().
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 查看共享 QImRecordBuffer 中两个字段的 XY 数据系列
+ *
+ * @class QImInterleavedXYDataSeries
+ * @ingroup plot_data
+ *
+ * @details xRawPointer()/yRawPointer() 指向首条记录中的字段，stride()/xStride() 为记录大小，
+ *          ImPlot 与降采样器直接按步幅遍历紧凑缓冲区。
+ *          X、Y 类型相同时以字节步幅调用 ImPlot::PlotLine<T>，否则绘图项使用类型化的 getter，两种情况都不拷贝。
+ * @note bounds() 只扫描上次调用之后追加的记录；清空并重新填充共享缓冲后需调用 invalidateBounds()。
+ * \endif
+ */
+class QIM_CORE_API QImInterleavedXYDataSeries : public QImAbstractXYDataSeries
+{
+public:
+    // Views field x against field y of every record
+    QImInterleavedXYDataSeries(std::shared_ptr< const QImRecordBuffer > buffer, QImRecordField x, QImRecordField y);
+    // Views field y in Y-only mode, x = xStart + index * xScale
+    QImInterleavedXYDataSeries(std::shared_ptr< const QImRecordBuffer > buffer, QImRecordField y, double xStart, double xScale);
+    ~QImInterleavedXYDataSeries() override = default;
+
+    // QImAbstractPlotDataSeries interface
+    qint64 size() const override;
+
+    // QImAbstractXYDataSeries interface
+    bool isContiguous() const override;
+    int stride() const override;
+    int xStride() const override;
+    const double* xRawData() const override;
+    const double* yRawData() const override;
+    QImPlotValueType xValueType() const override;
+    QImPlotValueType yValueType() const override;
+    const void* xRawPointer() const override;
+    const void* yRawPointer() const override;
+    double xScale() const override;
+    double xStart() const override;
+    double xValue(qint64 index) const override;
+    double yValue(qint64 index) const override;
+
+    // The shared record buffer
+    std::shared_ptr< const QImRecordBuffer > buffer() const;
+    // True when only the Y field is used
+    bool isYOnly() const;
+
+private:
+    double fieldValue(const QImRecordField& field, qint64 index) const;
+
+private:
+    std::shared_ptr< const QImRecordBuffer > m_buffer;
+    QImRecordField m_x;
+    QImRecordField m_y;
+    bool m_yOnly { false };
+    double m_xStart { 0.0 };
+    double m_xScale { 1.0 };
+};
+
+}  // namespace QIM
+
+#endif  // QIMPLOTINTERLEAVEDDATASERIES_H
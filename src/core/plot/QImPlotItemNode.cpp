@@ -3,6 +3,10 @@
 #include "implot_internal.h"
 #include "QtImGuiUtils.h"
 #include "QImPlotNode.h"
+#include "QImPlotDataSeries.h"
+#include "QImPlotMultiChannelDataSeries.h"
+#include "QImPlotErrorDataSeries.h"
+#include "QImPlotColumnDecimator.h"
 
 namespace QIM
 {
@@ -170,4 +174,210 @@ void QImPlotItemNode::setImPlotItem(ImPlotItem* item)
     }
 }
 
+namespace
+{
+// 范围只在自适应帧计算（bounds() 虽有缓存，Y-only 数据每次仍需访问首尾点）
+template< typename BoundsFn >
+int fitBounds(bool visible, BoundsFn&& boundsFn)
+{
+    ImPlotContext* ct = ImPlot::GetCurrentContext();
+    if (!ct || !ct->CurrentPlot) {
+        return 0;
+    }
+    // 双击等交互触发的自适应在 SetupLock 时才生效，ImPlot 绘图函数内部同样会调用
+    ImPlot::SetupLock();
+    ImPlotPlot& plot = *ct->CurrentPlot;
+    if (!plot.FitThisFrame || !visible) {
+        // 隐藏的绘图项不参与自适应
+        return 0;
+    }
+    const ImPlotAxis& xAxis = plot.Axes[ plot.CurrentX ];
+    const ImPlotAxis& yAxis = plot.Axes[ plot.CurrentY ];
+    if (ImHasFlag(xAxis.Flags, ImPlotAxisFlags_RangeFit) || ImHasFlag(yAxis.Flags, ImPlotAxisFlags_RangeFit)) {
+        return 0;
+    }
+    const QImPlotDataBounds b = boundsFn();
+    if ((xAxis.Scale == ImPlotScale_Log10 && b.xMin <= 0) || (yAxis.Scale == ImPlotScale_Log10 && b.yMin <= 0)) {
+        return 0;
+    }
+    // 非有限值（空数据时的 ±inf）会被 ImPlot 忽略
+    ImPlot::FitPoint(ImPlotPoint(b.xMin, b.yMin));
+    ImPlot::FitPoint(ImPlotPoint(b.xMax, b.yMax));
+    return ImPlotItemFlags_NoFit;
+}
+}  // namespace
+
+/**
+ * \if ENGLISH
+ * @brief Fits the current axes to the cached bounds of series instead of letting ImPlot scan every point
+ * @param series Data drawn by the next ImPlot call of this item
+ * @return ImPlotItemFlags_NoFit if the axes were extended here, to be OR-ed into the flags of the
+ *         ImPlot calls of this frame; 0 when nothing has to be fitted or ImPlot must fit point by point
+ * @details On a fit frame (QImPlotNode::rescaleAxes(), double click) ImPlot visits every sample of
+ *          every item. QImAbstractXYDataSeries::bounds() is cached and updated incrementally, so
+ *          extending the axes with its two corners makes fitting O(items). Axes with
+ *          ImPlotAxisFlags_RangeFit (only points inside the other axis' range count) and log axes
+ *          whose data reaches zero or below keep ImPlot's per-point fit.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 用数据系列缓存的范围自适应当前坐标轴，代替 ImPlot 逐点扫描
+ * @param series 本绘图项下一次 ImPlot 调用绘制的数据
+ * @return 已在此扩展坐标轴时返回 ImPlotItemFlags_NoFit，需并入本帧 ImPlot 调用的 flags；
+ *         无需自适应或必须由 ImPlot 逐点拟合时返回 0
+ * @details 自适应帧（QImPlotNode::rescaleAxes()、双击）中 ImPlot 会遍历每个绘图项的每个点。
+ *          QImAbstractXYDataSeries::bounds() 有缓存且增量更新，用其两个角点扩展坐标轴，
+ *          自适应的代价变为 O(绘图项数)。带 ImPlotAxisFlags_RangeFit 的坐标轴（只统计另一轴范围内的点）
+ *          以及数据包含非正值的对数轴仍由 ImPlot 逐点拟合。
+ * \endif
+ */
+int QImPlotItemNode::fitDataBounds(const QImAbstractXYDataSeries* series) const
+{
+    return series ? fitBounds(isVisible(), [ series ] { return series->bounds(); }) : 0;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Same as fitDataBounds(const QImAbstractXYDataSeries*) for all channels of a multi-channel series
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 与 fitDataBounds(const QImAbstractXYDataSeries*) 相同，范围为多通道数据的所有通道
+ * \endif
+ */
+int QImPlotItemNode::fitDataBounds(const QImAbstractMultiChannelDataSeries* series) const
+{
+    return series ? fitBounds(isVisible(), [ series ] { return series->bounds(); }) : 0;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Visible X range and plot area width of the current frame, for view-dependent downsampling
+ * @param[out] xMin Left limit of the X axis the item is drawn on
+ * @param[out] xMax Right limit of the X axis the item is drawn on
+ * @param[out] pixelWidth Width of the plot area in pixels
+ * @return false outside of a plot, on a fit frame where the limits are about to change, or when the
+ *         X axis is not linear (log, custom transform): pixel columns then do not split X evenly and
+ *         the callers fall back to downsampling the whole series
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 当前帧绘图项所在 X 轴的可见范围与绘图区像素宽度，用于视图相关的降采样
+ * @param[out] xMin X 轴可见范围左边界
+ * @param[out] xMax X 轴可见范围右边界
+ * @param[out] pixelWidth 绘图区像素宽度
+ * @return 不在绘图中、处于坐标轴即将改变的自适应帧，或 X 轴不是线性（对数、自定义变换）时返回 false：
+ *         此时像素列不是等宽的 X 区间，调用方改为对全部数据降采样
+ * \endif
+ */
+bool QImPlotItemNode::plotViewXRange(double& xMin, double& xMax, int& pixelWidth) const
+{
+    ImPlotContext* ct = ImPlot::GetCurrentContext();
+    if (!ct || !ct->CurrentPlot) {
+        return false;
+    }
+    // 坐标轴范围在 SetupLock 后才确定
+    ImPlot::SetupLock();
+    const ImPlotPlot& plot = *ct->CurrentPlot;
+    if (plot.FitThisFrame) {
+        return false;
+    }
+    const ImPlotAxis& xAxis = plot.Axes[ plot.CurrentX ];
+    // 对数等非线性坐标轴的等宽像素列不对应等宽的 X 区间
+    if (xAxis.TransformForward) {
+        return false;
+    }
+    xMin       = xAxis.Range.Min;
+    xMax       = xAxis.Range.Max;
+    pixelWidth = static_cast< int >(plot.PlotRect.GetWidth());
+    return pixelWidth > 0;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Visible rectangle and plot area size of the current frame, for screen-space decimation
+ * @param[out] xMin Left limit of the X axis the item is drawn on
+ * @param[out] xMax Right limit of the X axis the item is drawn on
+ * @param[out] yMin Lower limit of the Y axis the item is drawn on
+ * @param[out] yMax Upper limit of the Y axis the item is drawn on
+ * @param[out] pixelWidth Width of the plot area in pixels
+ * @param[out] pixelHeight Height of the plot area in pixels
+ * @return false outside of a plot, on a fit frame, or when one of the axes is not linear
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 当前帧绘图项所在 X/Y 轴的可见矩形与绘图区像素尺寸，用于屏幕空间的降采样
+ * @param[out] xMin X 轴可见范围左边界
+ * @param[out] xMax X 轴可见范围右边界
+ * @param[out] yMin Y 轴可见范围下边界
+ * @param[out] yMax Y 轴可见范围上边界
+ * @param[out] pixelWidth 绘图区像素宽度
+ * @param[out] pixelHeight 绘图区像素高度
+ * @return 不在绘图中、处于自适应帧或任一坐标轴不是线性时返回 false
+ * \endif
+ */
+bool QImPlotItemNode::plotViewRect(double& xMin,
+                                   double& xMax,
+                                   double& yMin,
+                                   double& yMax,
+                                   int& pixelWidth,
+                                   int& pixelHeight) const
+{
+    int width = 0;
+    if (!plotViewXRange(xMin, xMax, width)) {
+        return false;
+    }
+    const ImPlotPlot& plot  = *ImPlot::GetCurrentContext()->CurrentPlot;
+    const ImPlotAxis& yAxis = plot.Axes[ plot.CurrentY ];
+    // X 轴已由 plotViewXRange() 检查，Y 轴同样要求线性
+    if (yAxis.TransformForward) {
+        return false;
+    }
+    yMin        = yAxis.Range.Min;
+    yMax        = yAxis.Range.Max;
+    pixelWidth  = width;
+    pixelHeight = static_cast< int >(plot.PlotRect.GetHeight());
+    return pixelHeight > 0;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Updates a per-column decimator with the visible X range of the current frame
+ * @param decimator Decimator owned by the item
+ * @param series Data drawn by the item
+ * @return true if the item should draw the decimator output instead of @p series
+ * @details On a fit frame, or with a non-linear X axis, the whole series is decimated with the last pixel width.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 按当前帧的可见 X 范围更新按列降采样器
+ * @param decimator 绘图项持有的降采样器
+ * @param series 绘图项绘制的数据
+ * @return 返回 true 时绘图项应绘制降采样结果代替 @p series
+ * @details 自适应帧或 X 轴不是线性时，按上一次的像素宽度对全部数据降采样。
+ * \endif
+ */
+bool QImPlotItemNode::updateColumnDecimator(QImPlotColumnDecimator& decimator, const QImAbstractXYDataSeries& series) const
+{
+    double xMin    = 0.0;
+    double xMax    = 0.0;
+    int pixelWidth = 0;
+    if (!plotViewXRange(xMin, xMax, pixelWidth)) {
+        pixelWidth = 0;
+    }
+    return decimator.update(series, xMin, xMax, pixelWidth);
+}
+
+bool QImPlotItemNode::updateColumnDecimator(QImPlotColumnDecimator& decimator,
+                                            const QImAbstractErrorDataSeries& series) const
+{
+    double xMin    = 0.0;
+    double xMax    = 0.0;
+    int pixelWidth = 0;
+    if (!plotViewXRange(xMin, xMax, pixelWidth)) {
+        pixelWidth = 0;
+    }
+    return decimator.update(series, xMin, xMax, pixelWidth);
+}
+
 }  // end namespace QIM
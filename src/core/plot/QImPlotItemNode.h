@@ -7,6 +7,10 @@ struct ImPlotItem;
 namespace QIM
 {
 class QImPlotNode;
+class QImAbstractXYDataSeries;
+class QImAbstractMultiChannelDataSeries;
+class QImAbstractErrorDataSeries;
+class QImPlotColumnDecimator;
 /**
  * @brief PlotItem对应的基类
  */
@@ -56,6 +60,16 @@ protected:
     // ImPlotItem的操作
     ImPlotItem* imPlotItem() const;
     void setImPlotItem(ImPlotItem* item);
+    // 自适应坐标轴时用数据系列缓存的范围代替逐点拟合，返回需附加到 ImPlot 绘图函数 flags 的标志
+    int fitDataBounds(const QImAbstractXYDataSeries* series) const;
+    int fitDataBounds(const QImAbstractMultiChannelDataSeries* series) const;
+    // 当前帧绑定 X 轴的可见范围与绘图区像素宽度，用于视图相关的降采样；自适应帧或不在绘图中返回 false
+    bool plotViewXRange(double& xMin, double& xMax, int& pixelWidth) const;
+    // 当前帧绑定 X/Y 轴的可见矩形与绘图区像素尺寸，用于屏幕空间的降采样；非线性坐标轴同样返回 false
+    bool plotViewRect(double& xMin, double& xMax, double& yMin, double& yMax, int& pixelWidth, int& pixelHeight) const;
+    // 按当前帧的可见范围更新按列降采样，返回 true 时应绘制降采样结果代替原始数据
+    bool updateColumnDecimator(QImPlotColumnDecimator& decimator, const QImAbstractXYDataSeries& series) const;
+    bool updateColumnDecimator(QImPlotColumnDecimator& decimator, const QImAbstractErrorDataSeries& series) const;
 };
 }  // end namespace QIM
 
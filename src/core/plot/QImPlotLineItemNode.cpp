@@ -1,13 +1,19 @@
 ﻿#include "QImPlotLineItemNode.h"
 #include <optional>
 #include "QImPlotDataSeries.h"
+#include "QImPlotDataSeriesView.h"
+#include "QImGuaranteedExtremaDownsampler.h"
 #include "QImLTTBDownsampler.h"
+#include "QImM4Downsampler.h"
 #include "QImMinMaxLTTBDownsampler.h"
+#include "QImPlotParallel.h"
 #include "implot.h"
 #include "implot_internal.h"
 #include "QImTrackedValue.hpp"
 #include "QtImGuiUtils.h"
 #include <QDebug>
+#include <atomic>
+#include <mutex>
 namespace QIM
 {
 // ImPlotMarker_None   ->   无标记
@@ -22,16 +28,107 @@ namespace QIM
 // ImPlotMarker_Plus   ->   ＋ 加号
 // ImPlotMarker_Asterisk   ->   ✻ 星形
 
+namespace
+{
+// 小于该点数的数据在调用线程同步降采样，后台任务的调度开销不值得
+constexpr qint64 kAsyncMinimumPoints = 1 << 20;
+
+// 等间隔抽取 points 个点作为粗略预览，代价与 points 成正比而不是数据点数
+QImAbstractXYDataSeries* createStridePreview(const QImAbstractXYDataSeries& series, int points)
+{
+    const qint64 n = series.size();
+    std::vector< double > xs, ys;
+    xs.reserve(points);
+    ys.reserve(points);
+    qimPlotVisitXYSeries(series, [ & ](const auto& view) {
+        for (qint64 i = 0; i < points; ++i) {
+            const qint64 idx = i * (n - 1) / (points - 1);
+            xs.push_back(view.x(idx));
+            ys.push_back(view.y(idx));
+        }
+    });
+    return new QImVectorXYDataSeries< std::vector< double >, std::vector< double > >(std::move(xs), std::move(ys));
+}
+
+// 降采样代理的参数，后台降采样时按值拷贝到工作线程
+struct DownsampleParams
+{
+    QImPlotLineItemNode::DownsampleStrategy strategy { QImPlotLineItemNode::DownsampleMinMaxLTTB };
+    int targetPoints { 20000 };  ///< 全量结果的点数（M4 每列最多 4 个点）
+    double spikeThreshold { 0.0 };
+    double spikeReference { 0.0 };
+};
+
+// 按算法创建降采样代理
+QImAbstractXYDataSeries* createDownsampler(const DownsampleParams& params, QImAbstractXYDataSeries* source)
+{
+    switch (params.strategy) {
+    case QImPlotLineItemNode::DownsampleLTTB:
+        return new QImLTTBDownsampler(source, params.targetPoints);
+    case QImPlotLineItemNode::DownsampleM4:
+        return new QImM4Downsampler(source, params.targetPoints / 4);
+    case QImPlotLineItemNode::DownsampleGuaranteedExtrema:
+        return new QImGuaranteedExtremaDownsampler(
+            source, params.targetPoints, params.spikeThreshold, params.spikeReference);
+    default:
+        return new QImMinMaxLTTBDownsampler(source, params.targetPoints);
+    }
+}
+
+// 后台降采样的结果，工作线程发布后由 GUI 线程取走
+struct AsyncDownsampleResult
+{
+    quint64 generation { 0 };
+    std::shared_ptr< QImAbstractXYDataSeries > source;  ///< 保证计算期间原始数据不被释放
+    QImPlotLineItemNode::DownsampleStrategy strategy { QImPlotLineItemNode::DownsampleMinMaxLTTB };
+    std::unique_ptr< QImAbstractXYDataSeries > sampler;
+    QImPlotDataBounds bounds;  ///< 前 boundsCount 个点的范围，由 GUI 线程填入数据系列的缓存
+    qint64 boundsCount { 0 };
+};
+
+// 工作线程与绘图项共享的状态，绘图项析构后工作线程仍可安全访问
+struct AsyncDownsampleState
+{
+    std::atomic< AsyncDownsampleResult* > ready { nullptr };  ///< 最新完成的结果，发布与取走都是无锁交换
+    std::atomic< quint64 > publishedGeneration { 0 };         ///< 已发布过的最新一代
+    std::mutex ownerMutex;                                     ///< 只保护 owner 与析构的竞争
+    QImPlotLineItemNode* owner { nullptr };
+
+    ~AsyncDownsampleState()
+    {
+        delete ready.exchange(nullptr);
+    }
+};
+}  // namespace
+
 class QImPlotLineItemNode::PrivateData
 {
     QIM_DECLARE_PUBLIC(QImPlotLineItemNode)
 public:
     PrivateData(QImPlotLineItemNode* p);
+    ~PrivateData();
     void resetDownSamplerData();
-    std::unique_ptr< QImAbstractXYDataSeries > data;
+    void installDownsampler(QImAbstractXYDataSeries* sampler, DownsampleStrategy samplerStrategy);
+    void startAsyncDownsampling();
+    void takeAsyncResult();
+    void refreshAppendedData();
+    void updateViewSampling(int fitFlags);
+    DownsampleParams downsampleParams() const;
+    std::shared_ptr< QImAbstractXYDataSeries > data;
     std::unique_ptr< QImAbstractXYDataSeries > dataLTTB;
+    QImMinMaxLTTBDownsampler* viewSampler { nullptr };            ///< dataLTTB 支持视图相关下采样时指向它
+    QImM4Downsampler* m4Sampler { nullptr };                      ///< dataLTTB 为 M4 代理时指向它
+    QImGuaranteedExtremaDownsampler* extremaSampler { nullptr };  ///< dataLTTB 为保证极值的代理时指向它
+    DownsampleStrategy strategy { DownsampleMinMaxLTTB };
+    double spikeThreshold { 0.0 };
+    double spikeReference { 0.0 };
     bool isAdaptiveSampling { true };
+    bool downsampleDirty { false };  ///< 数据追加后降采样缓存过期，在下一帧绘制前刷新
     int downsampleThreshold { 20000 };
+    bool isAsyncDownsampling { false };
+    bool asyncPending { false };  ///< dataLTTB 当前为预览，后台结果尚未发布
+    quint64 asyncGeneration { 0 };  ///< 每次重置降采样加一，丢弃过期的后台结果
+    std::shared_ptr< AsyncDownsampleState > asyncState;
     ImPlotLineFlags lineFlags { ImPlotLineFlags_None };
     std::optional< QImTrackedValue< ImVec4, ImVecComparator< ImVec4 > > > color;  ///< 颜色
     QImTrackedValue< float > lineWidth { 1.0f };                                  ///< 线宽
@@ -42,24 +139,204 @@ QImPlotLineItemNode::PrivateData::PrivateData(QImPlotLineItemNode* p) : q_ptr(p)
 {
 }
 
+QImPlotLineItemNode::PrivateData::~PrivateData()
+{
+    // 仍在运行的后台任务完成后不再通知已销毁的绘图项
+    if (asyncState) {
+        std::lock_guard< std::mutex > lock(asyncState->ownerMutex);
+        asyncState->owner = nullptr;
+    }
+}
+
 /**
  * @brief 重置降采样数据，在设置数据后或者
  */
 void QImPlotLineItemNode::PrivateData::resetDownSamplerData()
 {
+    viewSampler    = nullptr;
+    m4Sampler      = nullptr;
+    extremaSampler = nullptr;
+    asyncPending   = false;
+    ++asyncGeneration;
     if (isAdaptiveSampling) {
-        if (data && (data->size() > downsampleThreshold)) {
-#if 0
-            QImLTTBDownsampler* lttb = new QImLTTBDownsampler(data.get(), downsampleThreshold);
-            dataLTTB.reset(lttb);
-#else
-            QImMinMaxLTTBDownsampler* lttb = new QImMinMaxLTTBDownsampler(data.get(), downsampleThreshold);
-            dataLTTB.reset(lttb);
-#endif
+        if (isAsyncDownsampling && data && data->size() > std::max< qint64 >(downsampleThreshold, kAsyncMinimumPoints)) {
+            startAsyncDownsampling();
+        } else if (data && (data->size() > downsampleThreshold)) {
+            installDownsampler(createDownsampler(downsampleParams(), data.get()), strategy);
+        } else {
+            // 数据量不足阈值，旧的降采样代理可能还指向已释放的数据
+            dataLTTB.reset(nullptr);
         }
     } else {
         dataLTTB.reset(nullptr);
     }
+    downsampleDirty = false;
+}
+
+/**
+ * @brief 替换降采样代理，并按算法记录支持视图相关下采样的类型化指针
+ */
+void QImPlotLineItemNode::PrivateData::installDownsampler(QImAbstractXYDataSeries* sampler,
+                                                           DownsampleStrategy samplerStrategy)
+{
+    dataLTTB.reset(sampler);
+    viewSampler    = (samplerStrategy == DownsampleMinMaxLTTB) ? static_cast< QImMinMaxLTTBDownsampler* >(sampler)
+                                                               : nullptr;
+    m4Sampler      = (samplerStrategy == DownsampleM4) ? static_cast< QImM4Downsampler* >(sampler) : nullptr;
+    extremaSampler = (samplerStrategy == DownsampleGuaranteedExtrema)
+                         ? static_cast< QImGuaranteedExtremaDownsampler* >(sampler)
+                         : nullptr;
+}
+
+DownsampleParams QImPlotLineItemNode::PrivateData::downsampleParams() const
+{
+    DownsampleParams params;
+    params.strategy       = strategy;
+    params.targetPoints   = downsampleThreshold;
+    params.spikeThreshold = spikeThreshold;
+    params.spikeReference = spikeReference;
+    return params;
+}
+
+/**
+ * @brief 先绘制等间隔抽取的预览，在后台线程计算完整的降采样结果
+ *
+ * 结果通过原子指针交换发布，再以排队调用回到 GUI 线程替换预览，渲染循环不会等待计算
+ */
+void QImPlotLineItemNode::PrivateData::startAsyncDownsampling()
+{
+    if (!asyncState) {
+        asyncState        = std::make_shared< AsyncDownsampleState >();
+        asyncState->owner = q_ptr;
+    }
+    dataLTTB.reset(createStridePreview(*data, downsampleThreshold));
+    asyncPending = true;
+
+    std::shared_ptr< AsyncDownsampleState > state = asyncState;
+    std::shared_ptr< QImAbstractXYDataSeries > source = data;
+    const quint64 generation                          = asyncGeneration;
+    const DownsampleParams params                     = downsampleParams();
+    qimPlotRunAsync([ state, source, generation, params ]() {
+        auto* result       = new AsyncDownsampleResult;
+        result->generation = generation;
+        result->source     = source;
+        result->strategy   = params.strategy;
+        // 数据范围也在后台扫描，但不写入数据系列的缓存（GUI 线程同时在读），由 takeAsyncResult() 填入
+        result->boundsCount = source->size();
+        result->bounds      = qimPlotVisitXYSeries(*source, [](const auto& view) { return qimPlotScanBounds(view); });
+        result->sampler.reset(createDownsampler(params, source.get()));
+        // 任务可能乱序完成：只替换更旧的结果，较新的结果已发布时丢弃自己
+        AsyncDownsampleResult* current = state->ready.load(std::memory_order_acquire);
+        do {
+            if (current && current->generation >= generation) {
+                delete result;
+                return;
+            }
+        } while (!state->ready.compare_exchange_weak(current, result, std::memory_order_acq_rel));
+        delete current;
+        quint64 published = state->publishedGeneration.load(std::memory_order_relaxed);
+        while (published < generation
+               && !state->publishedGeneration.compare_exchange_weak(published, generation, std::memory_order_relaxed)) {
+        }
+
+        std::lock_guard< std::mutex > lock(state->ownerMutex);
+        if (QImPlotLineItemNode* owner = state->owner) {
+            // owner 在事件处理前被销毁时 Qt 会丢弃该调用
+            QMetaObject::invokeMethod(owner, [ owner ]() { owner->d_ptr->takeAsyncResult(); }, Qt::QueuedConnection);
+        }
+    });
+}
+
+/**
+ * @brief 在 GUI 线程取走后台结果，属于当前数据时替换预览并请求重绘
+ */
+void QImPlotLineItemNode::PrivateData::takeAsyncResult()
+{
+    std::unique_ptr< AsyncDownsampleResult > result(asyncState->ready.exchange(nullptr, std::memory_order_acq_rel));
+    if (!result) {
+        // 当前一代已经发布却没有取到结果时（不应发生）重新计算，避免一直停留在预览
+        if (asyncPending && asyncState->publishedGeneration.load(std::memory_order_relaxed) >= asyncGeneration) {
+            startAsyncDownsampling();
+        }
+        return;
+    }
+    if (!asyncPending || result->generation != asyncGeneration) {
+        // 数据在计算期间被替换，结果已过期；当前一代的任务完成后会再次调用本函数
+        return;
+    }
+    result->source->seedBounds(result->bounds, result->boundsCount);
+    installDownsampler(result->sampler.release(), result->strategy);
+    asyncPending = false;
+    if (downsampleDirty) {
+        // 计算期间通知的追加在结果就绪后补上
+        refreshAppendedData();
+    }
+    emit q_ptr->downsamplingFinished();
+    q_ptr->requestRender();
+}
+
+/**
+ * @brief 数据追加后刷新降采样：已有视图相关的降采样代理时增量更新（金字塔与全量分桶只处理新增的点），否则重建
+ */
+void QImPlotLineItemNode::PrivateData::refreshAppendedData()
+{
+    if (asyncPending) {
+        // 后台任务仍在读取数据系列，不再启动新的全量计算；保留 downsampleDirty，结果发布后再处理追加
+        return;
+    }
+    if (m4Sampler && data && data->size() > downsampleThreshold) {
+        // 视图模式下只检查新增点，下一帧按可见范围重新计算
+        m4Sampler->sourceAppended();
+        downsampleDirty = false;
+        return;
+    }
+    if (extremaSampler && data && data->size() > downsampleThreshold) {
+        extremaSampler->sourceAppended();
+        downsampleDirty = false;
+        return;
+    }
+    if (viewSampler && data && data->size() > downsampleThreshold) {
+        // 追加数据说明是只追加的数据流，全量结果切换为增量分桶（切换时重建一次）
+        if (!viewSampler->isIncrementalMode()) {
+            viewSampler->setIncrementalMode(true);
+        }
+        viewSampler->sourceAppended();
+        downsampleDirty = false;
+        return;
+    }
+    resetDownSamplerData();
+}
+
+/**
+ * @brief 按当前帧的可见 X 范围与像素宽度重新下采样，范围不变时使用缓存
+ * @param fitFlags fitDataBounds() 的返回值，为 0 的自适应帧由 ImPlot 逐点拟合，需要全量数据的下采样结果
+ */
+void QImPlotLineItemNode::PrivateData::updateViewSampling(int fitFlags)
+{
+    if (!viewSampler && !m4Sampler && !extremaSampler) {
+        return;
+    }
+    double xMin = 0, xMax = 0;
+    int pixelWidth = 0;
+    if (q_ptr->plotViewXRange(xMin, xMax, pixelWidth)) {
+        if (viewSampler) {
+            viewSampler->setViewRange(xMin, xMax, pixelWidth);
+        } else if (m4Sampler) {
+            // M4 的列与绘图区的像素列一一对应
+            m4Sampler->setViewRange(xMin, xMax, pixelWidth);
+        } else {
+            // 保证极值的列同样与像素列对应，每列的超限点一定落在该列绘制的线段上
+            extremaSampler->setViewRange(xMin, xMax, pixelWidth);
+        }
+    } else if (fitFlags == 0) {
+        if (viewSampler) {
+            viewSampler->clearViewRange();
+        } else if (m4Sampler) {
+            m4Sampler->clearViewRange();
+        } else {
+            extremaSampler->clearViewRange();
+        }
+    }
 }
 //----------------------------------------------------
 // QImPlotLineItemNode
@@ -73,9 +350,25 @@ QImPlotLineItemNode::~QImPlotLineItemNode()
 }
 
 void QImPlotLineItemNode::setData(QImAbstractXYDataSeries* series)
+{
+    setSharedData(std::shared_ptr< QImAbstractXYDataSeries >(series));
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set a data series that may be shared with other items or inspection tools
+ * @param series Shared series, the item keeps a reference until the next setData()/setSharedData()
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置可与其它绘图项或检查工具共享的数据系列
+ * @param series 共享的数据系列，绘图项持有其引用直到下一次 setData()/setSharedData()
+ * \endif
+ */
+void QImPlotLineItemNode::setSharedData(std::shared_ptr< QImAbstractXYDataSeries > series)
 {
     QIM_D(d);
-    d->data.reset(series);
+    d->data = std::move(series);
     if (d->isAdaptiveSampling) {
         d->resetDownSamplerData();
     }
@@ -87,6 +380,41 @@ QImAbstractXYDataSeries* QImPlotLineItemNode::data() const
     return d_ptr->data.get();
 }
 
+std::shared_ptr< QImAbstractXYDataSeries > QImPlotLineItemNode::sharedData() const
+{
+    return d_ptr->data;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Notifies the item that samples were appended to its current series
+ * @param count Number of appended samples
+ * @details Use this with streaming series such as QImRingBufferXYDataSeries instead of calling
+ *          setData() again. The series is kept, only the downsampling cache is marked stale and
+ *          rebuilt once before the next frame, no matter how many appends happened in between.
+ * @see QImRingBufferXYDataSeries
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 通知绘图项当前数据系列追加了数据
+ * @param count 追加的点数
+ * @details 配合 QImRingBufferXYDataSeries 等流式数据系列使用，代替再次调用 setData()。
+ *          数据系列保持不变，只把降采样缓存标记为过期，无论两帧之间追加了多少次，
+ *          都只在下一帧绘制前重建一次。
+ * @see QImRingBufferXYDataSeries
+ * \endif
+ */
+void QImPlotLineItemNode::notifyDataAppended(qint64 count)
+{
+    QIM_D(d);
+    if (count <= 0 || !d->data) {
+        return;
+    }
+    if (d->isAdaptiveSampling) {
+        d->downsampleDirty = true;
+    }
+}
+
 // ===== 在 CPP 文件顶部添加辅助宏定义 =====
 #ifndef QImPlotLineItemNode_FLAG_ACCESSOR
 #define QImPlotLineItemNode_FLAG_ACCESSOR(FlagName, FlagEnum)                                                          \
@@ -223,6 +551,157 @@ bool QImPlotLineItemNode::isAdaptiveSampling() const
     return d_ptr->isAdaptiveSampling;
 }
 
+/**
+ * \if ENGLISH
+ * @brief Selects the downsampling algorithm used for series larger than the downsampling threshold
+ * @param strategy DownsampleMinMaxLTTB (default), DownsampleLTTB, DownsampleM4 or DownsampleGuaranteedExtrema
+ * @details DownsampleMinMaxLTTB, DownsampleM4 and DownsampleGuaranteedExtrema follow the visible X range and
+ *          the plot's pixel width; M4 keeps the first, last, minimum and maximum sample of every pixel column,
+ *          so the polyline covers exactly the pixels of the full data at the lowest cost.
+ *          DownsampleGuaranteedExtrema draws the MinMaxLTTB curve and adds every pixel column's extreme
+ *          outside the band set by setSpikeThreshold(), so no alarm-level transient can be dropped.
+ *          DownsampleLTTB only keeps a fixed number of points for the whole series.
+ *          Changing the strategy rebuilds the downsampling.
+ * @see QImMinMaxLTTBDownsampler, QImLTTBDownsampler, QImM4Downsampler, QImGuaranteedExtremaDownsampler
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 选择超过降采样阈值的数据使用的降采样算法
+ * @param strategy DownsampleMinMaxLTTB（默认）、DownsampleLTTB、DownsampleM4 或 DownsampleGuaranteedExtrema
+ * @details DownsampleMinMaxLTTB、DownsampleM4 与 DownsampleGuaranteedExtrema 随可见 X 范围与绘图区像素宽度重新采样；
+ *          M4 保留每个像素列的首、尾、最小、最大点，以最低的代价绘制出与全量数据相同的像素。
+ *          DownsampleGuaranteedExtrema 绘制 MinMaxLTTB 的曲线，并加入每个像素列中位于 setSpikeThreshold()
+ *          阈值带外的极值点，告警级别的瞬态不会被丢弃。DownsampleLTTB 只对全量数据保留固定点数。
+ *          修改算法后重新降采样。
+ * @see QImMinMaxLTTBDownsampler, QImLTTBDownsampler, QImM4Downsampler, QImGuaranteedExtremaDownsampler
+ * \endif
+ */
+void QImPlotLineItemNode::setDownsampleStrategy(DownsampleStrategy strategy)
+{
+    QIM_D(d);
+    if (d->strategy == strategy) {
+        return;
+    }
+    d->strategy = strategy;
+    d->resetDownSamplerData();
+}
+
+QImPlotLineItemNode::DownsampleStrategy QImPlotLineItemNode::downsampleStrategy() const
+{
+    return d_ptr->strategy;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Sets the band of DownsampleGuaranteedExtrema: samples with |y - spikeReference()| >= threshold are always drawn
+ * @param threshold Distance from the reference, negative values are treated as 0
+ * @details A threshold of 0 keeps the minimum and maximum of every pixel column. Set it to the alarm
+ *          limit of the trace so that every excursion beyond the limit stays visible at any zoom level.
+ *          Rebuilds the downsampling when the strategy is DownsampleGuaranteedExtrema.
+ * @see setSpikeReference, QImGuaranteedExtremaDownsampler
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置 DownsampleGuaranteedExtrema 的阈值带：|y - spikeReference()| >= threshold 的点一定被绘制
+ * @param threshold 与参考值的距离，负值按 0 处理
+ * @details 阈值为 0 时保留每个像素列的最小、最大点。设置为曲线的告警限值，
+ *          任意缩放级别下超出限值的偏移都可见。算法为 DownsampleGuaranteedExtrema 时重新降采样。
+ * @see setSpikeReference, QImGuaranteedExtremaDownsampler
+ * \endif
+ */
+void QImPlotLineItemNode::setSpikeThreshold(double threshold)
+{
+    QIM_D(d);
+    threshold = std::max(threshold, 0.0);
+    if (d->spikeThreshold == threshold) {
+        return;
+    }
+    d->spikeThreshold = threshold;
+    if (d->strategy == DownsampleGuaranteedExtrema) {
+        d->resetDownSamplerData();
+    }
+}
+
+double QImPlotLineItemNode::spikeThreshold() const
+{
+    return d_ptr->spikeThreshold;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Sets the center of the DownsampleGuaranteedExtrema band (the baseline of the trace), 0 by default
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置 DownsampleGuaranteedExtrema 阈值带的中心（曲线的基线），默认 0
+ * \endif
+ */
+void QImPlotLineItemNode::setSpikeReference(double reference)
+{
+    QIM_D(d);
+    if (d->spikeReference == reference) {
+        return;
+    }
+    d->spikeReference = reference;
+    if (d->strategy == DownsampleGuaranteedExtrema) {
+        d->resetDownSamplerData();
+    }
+}
+
+double QImPlotLineItemNode::spikeReference() const
+{
+    return d_ptr->spikeReference;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Downsample large series on a background thread instead of inside setData()
+ * @param on true to enable asynchronous downsampling
+ * @details Series with more than about a million points are not decimated in setData() any more.
+ *          The item draws an evenly strided preview (as many points as the downsampling target)
+ *          while a worker builds the result of downsampleStrategy() and scans the data bounds. The finished
+ *          result is published with a lock-free pointer swap, replaces the preview on the GUI
+ *          thread, requests a render and emits downsamplingFinished(). Results of data that was
+ *          replaced in the meantime are discarded. notifyDataAppended() calls made while a result is
+ *          pending are applied once it has been published, they do not start another background pass.
+ * @note The series must not be modified while isDownsamplingPending() is true, the worker reads it:
+ *       buffer streamed samples and append them after downsamplingFinished().
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 在后台线程对大数据降采样，不再阻塞 setData()
+ * @param on true 启用异步降采样
+ * @details 约一百万点以上的数据不再在 setData() 中降采样。工作线程按 downsampleStrategy() 计算降采样结果并扫描数据范围，
+ *          期间绘制等间隔抽取的预览（点数与降采样目标相同）。完成的结果通过无锁指针交换发布，
+ *          在 GUI 线程替换预览，请求重绘并发出 downsamplingFinished()。计算期间数据被替换时丢弃旧结果。
+ *          结果未发布期间调用的 notifyDataAppended() 在结果发布后处理，不会再启动一次后台计算。
+ * @note isDownsamplingPending() 为 true 时工作线程正在读取数据系列，不能修改它：
+ *       流式数据请先缓存，downsamplingFinished() 之后再追加。
+ * \endif
+ */
+void QImPlotLineItemNode::setAsyncDownsampling(bool on)
+{
+    QIM_D(d);
+    if (d->isAsyncDownsampling == on) {
+        return;
+    }
+    d->isAsyncDownsampling = on;
+    if (!on && d->asyncPending) {
+        // 关闭后不再等待后台结果，立即同步计算
+        d->resetDownSamplerData();
+    }
+}
+
+bool QImPlotLineItemNode::isAsyncDownsampling() const
+{
+    return d_ptr->isAsyncDownsampling;
+}
+
+bool QImPlotLineItemNode::isDownsamplingPending() const
+{
+    return d_ptr->asyncPending;
+}
+
 // ===== 标志访问器实现（带 Doxygen 注释）=====
 // clang-format off
 
@@ -369,8 +848,16 @@ QImPlotLineItemNode_FLAG_ACCESSOR(Shaded, ImPlotLineFlags_Shaded)
         // 没有数据
         return false;
     }
+    if (d->downsampleDirty) {
+        d->refreshAppendedData();
+    }
     QImAbstractXYDataSeries* series = d->data.get();
+    // 自适应坐标轴时使用缓存的数据范围，不让 ImPlot 逐点拟合（降采样代理的范围与原始数据相同）
+    // 后台降采样期间原始数据的范围由工作线程扫描，先使用预览的范围
+    const int fitFlags = fitDataBounds(d->asyncPending ? d->dataLTTB.get() : series);
     if (d->isAdaptiveSampling && d->dataLTTB) {
+        // 只对可见范围按绘图区像素宽度下采样，缩放到局部时显示全分辨率数据
+        d->updateViewSampling(fitFlags);
         series = d->dataLTTB.get();
     }
     if (!series) {
@@ -382,34 +869,27 @@ QImPlotLineItemNode_FLAG_ACCESSOR(Shaded, ImPlotLineFlags_Shaded)
     if (d->color) {
         ImPlot::SetNextLineStyle(d->color->value(), d->lineWidth.value());
     }
-    if (series->isContiguous()) {
-        if (series->xRawData()) {
-            // 有x指针，说明不是yonly
-            ImPlot::PlotLine(
-                labelConstData(),
-                series->xRawData(),
-                series->yRawData(),
-                series->size(),
-                d->lineFlags,
-                series->offset(),
-                series->stride()
-            );
-        } else {
+    // 按存储类型直接调用 ImPlot::PlotLine<T>，float/整数数据无需转换为double
+    const char* label = labelConstData();
+    // 超过 INT_MAX 个点时按区间分段调用（同一 label，ImPlot 视为同一个 item）
+    const int stride  = series->stride();
+    const ImPlotLineFlags flags = d->lineFlags | fitFlags;
+    qimPlotDispatchXYSeries(
+        *series,
+        [ & ](const auto* ys, int count, int offset, double xStart) {
             // x指针没有说明是yonly
-            ImPlot::PlotLine(
-                labelConstData(),
-                series->yRawData(),
-                series->size(),
-                series->xScale(),
-                series->xStart(),
-                d->lineFlags,
-                series->offset(),
-                series->stride()
-            );
-        }
-    } else {
-        // TODO:非连续内存
-    }
+            ImPlot::PlotLine(label, ys, count, series->xScale(), xStart, flags, offset, stride);
+        },
+        [ & ](const auto* xs, const auto* ys, int count, int offset) {
+            // 有x指针，说明不是yonly
+            ImPlot::PlotLine(label, xs, ys, count, flags, offset, stride);
+        },
+        [ & ](const auto& view) {
+            // X/Y类型或步幅不同、或分块存储（非连续内存），走编译期特化的getter
+            using View = std::decay_t< decltype(view) >;
+            ImPlot::PlotLineG(
+                label, &qimPlotViewGetter< View >, const_cast< View* >(&view), static_cast< int >(view.count), flags);
+        });
     // 更新item的状态
     ImPlotContext* ct    = ImPlot::GetCurrentContext();
     if (!ct) {
@@ -2,6 +2,7 @@
 #define QIMPLOTLINEITEMNODE_H
 #include "QImPlotItemNode.h"
 #include "QImPlotDataSeries.h"
+#include <memory>
 
 namespace QIM
 {
@@ -18,7 +19,20 @@ class QIM_CORE_API QImPlotLineItemNode : public QImPlotItemNode
     Q_PROPERTY(bool skipNaN READ isSkipNaN WRITE setSkipNaN NOTIFY lineFlagChanged)
     Q_PROPERTY(bool clippingEnabled READ isClippingEnabled WRITE setClippingEnabled NOTIFY lineFlagChanged)
     Q_PROPERTY(bool shaded READ isShaded WRITE setShaded NOTIFY lineFlagChanged)
+    Q_PROPERTY(DownsampleStrategy downsampleStrategy READ downsampleStrategy WRITE setDownsampleStrategy)
 public:
+    /**
+     * @brief 大数据的降采样算法
+     */
+    enum DownsampleStrategy
+    {
+        DownsampleMinMaxLTTB = 0,    ///< MinMax 预筛选 + LTTB，保留极值与形状（默认）
+        DownsampleLTTB,              ///< 经典 LTTB，只按三角形面积选点，不支持视图相关下采样
+        DownsampleM4,                ///< 每个像素列保留首、尾、最小、最大点，折线光栅化结果与原始数据一致
+        DownsampleGuaranteedExtrema  ///< MinMaxLTTB，并保证超出阈值带的点（尖峰、告警）一定被绘制
+    };
+    Q_ENUM(DownsampleStrategy)
+
     QImPlotLineItemNode(QObject* par = nullptr);
     ~QImPlotLineItemNode();
     enum
@@ -33,12 +47,18 @@ public:
     // 数据设置
     //----------------------------------------------------
     void setData(QImAbstractXYDataSeries* series);
+    // 设置共享的数据系列，可被多个绘图项或数值追踪器同时持有
+    void setSharedData(std::shared_ptr< QImAbstractXYDataSeries > series);
     template< typename ContainerX, typename ContainerY >
     QImAbstractXYDataSeries* setData(const ContainerX& x, const ContainerY& y);
     template< typename ContainerX, typename ContainerY >
     QImAbstractXYDataSeries* setData(ContainerX&& x, ContainerY&& y);
     // 获取数据
     QImAbstractXYDataSeries* data() const;
+    // 获取数据的共享引用
+    std::shared_ptr< QImAbstractXYDataSeries > sharedData() const;
+    // 通知数据系列追加了数据（流式数据，无需重新setData）
+    void notifyDataAppended(qint64 count = 1);
     //----------------------------------------------------
     // ImPlotLineFlags
     //----------------------------------------------------
@@ -73,8 +93,23 @@ public:
     //===============================================================
     void setAdaptivesSampling(bool on);
     bool isAdaptiveSampling() const;
+    // 降采样算法，默认 DownsampleMinMaxLTTB，修改后重新降采样
+    void setDownsampleStrategy(DownsampleStrategy strategy);
+    DownsampleStrategy downsampleStrategy() const;
+    // DownsampleGuaranteedExtrema 的阈值带：与参考值的距离达到阈值的点一定保留，默认均为 0
+    void setSpikeThreshold(double threshold);
+    double spikeThreshold() const;
+    void setSpikeReference(double reference);
+    double spikeReference() const;
+    // 在后台线程降采样，计算期间绘制等间隔抽取的预览，默认关闭
+    void setAsyncDownsampling(bool on);
+    bool isAsyncDownsampling() const;
+    // 后台降采样是否尚未完成（正在绘制预览）
+    bool isDownsamplingPending() const;
 Q_SIGNALS:
     void lineFlagChanged();
+    // 后台降采样完成，完整的降采样结果已替换预览
+    void downsamplingFinished();
 
 protected:
     virtual bool beginDraw() override;
@@ -0,0 +1,318 @@
+#include "QImPlotMappedDataSeries.h"
+#include <QIODevice>
+#include <cstring>
+#include <limits>
+
+namespace QIM
+{
+
+namespace
+{
+// 可选文件头，按本机字节序存储，大小为8的倍数以保证后续记录对齐
+struct MappedFileHeader
+{
+    char magic[ 8 ];
+    quint32 version;
+    quint32 headerSize;
+    quint32 valueType;
+    quint32 channelCount;
+    qint32 xChannel;
+    quint32 reserved;
+    double xStart;
+    double xScale;
+};
+static_assert(sizeof(MappedFileHeader) == 48, "unexpected header padding");
+
+constexpr char c_magic[ 8 ] = { 'Q', 'I', 'M', 'D', 'A', 'T', 'A', '\0' };
+constexpr quint32 c_version  = 1;
+}  // namespace
+
+//===============================================================
+// QImMappedFile
+//===============================================================
+
+QImMappedFile::QImMappedFile(const QString& fileName) : m_file(fileName)
+{
+    map(true);
+}
+
+QImMappedFile::QImMappedFile(const QString& fileName, const QImMappedFileFormat& format)
+    : m_file(fileName), m_format(format)
+{
+    map(false);
+}
+
+QImMappedFile::~QImMappedFile()
+{
+    if (m_bytes) {
+        m_file.unmap(const_cast< uchar* >(m_bytes));
+    }
+}
+
+bool QImMappedFile::isValid() const
+{
+    return m_bytes != nullptr;
+}
+
+QString QImMappedFile::errorString() const
+{
+    return m_error;
+}
+
+QString QImMappedFile::fileName() const
+{
+    return m_file.fileName();
+}
+
+const QImMappedFileFormat& QImMappedFile::format() const
+{
+    return m_format;
+}
+
+qint64 QImMappedFile::recordCount() const
+{
+    if (!m_bytes) {
+        return 0;
+    }
+    return (m_fileSize - m_format.headerSize) / m_format.recordSize();
+}
+
+const char* QImMappedFile::constData() const
+{
+    return m_bytes ? reinterpret_cast< const char* >(m_bytes) + m_format.headerSize : nullptr;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Writes the optional header at the current position of device
+ * @param device Open, writable device; the records must follow the header directly
+ * @param format Layout of the records, headerSize is ignored
+ * @return false if the header could not be written completely
+ * @details Values are stored in native byte order, like the records themselves.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 在 device 当前位置写入可选文件头
+ * @param device 已打开的可写设备，记录需紧跟在文件头之后
+ * @param format 记录布局，忽略其中的 headerSize
+ * @return 文件头未能完整写入时返回 false
+ * @details 与记录本身一样，按本机字节序存储。
+ * \endif
+ */
+bool QImMappedFile::writeHeader(QIODevice* device, const QImMappedFileFormat& format)
+{
+    if (!device || !device->isWritable()) {
+        return false;
+    }
+    MappedFileHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, c_magic, sizeof(c_magic));
+    h.version      = c_version;
+    h.headerSize   = sizeof(MappedFileHeader);
+    h.valueType    = static_cast< quint32 >(format.valueType);
+    h.channelCount = static_cast< quint32 >(format.channelCount);
+    h.xChannel     = format.xChannel < 0 ? -1 : format.xChannel;
+    h.xStart       = format.xStart;
+    h.xScale       = format.xScale;
+    return device->write(reinterpret_cast< const char* >(&h), sizeof(h)) == static_cast< qint64 >(sizeof(h));
+}
+
+qint64 QImMappedFile::headerSize()
+{
+    return sizeof(MappedFileHeader);
+}
+
+void QImMappedFile::map(bool readHeader)
+{
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = m_file.errorString();
+        return;
+    }
+    m_fileSize = m_file.size();
+    if (m_fileSize <= 0) {
+        m_error = QStringLiteral("file is empty");
+        return;
+    }
+    // 映射整个文件，不读取内容，页面在首次访问时由操作系统调入
+    const uchar* bytes = m_file.map(0, m_fileSize);
+    if (!bytes) {
+        m_error = m_file.errorString();
+        return;
+    }
+    const bool hasHeader = readHeader && parseHeader(bytes, m_fileSize);
+    if (readHeader && !hasHeader) {
+        // 没有文件头：视为单通道 double 原始数据
+        m_format = QImMappedFileFormat();
+    }
+    // 通道数来自文件头，不可信：记录大小以 qint64 计算，至少要能容纳一条记录，且不超过 int（ImPlot 的步长）
+    const qint64 recordBytes = static_cast< qint64 >(m_format.channelCount) * qimPlotValueTypeSize(m_format.valueType);
+    const qint64 minHeader   = hasHeader ? static_cast< qint64 >(sizeof(MappedFileHeader)) : 0;
+    if (m_format.channelCount < 1 || m_format.xChannel >= m_format.channelCount || m_format.headerSize < minHeader
+        || m_format.headerSize > m_fileSize || recordBytes <= 0 || recordBytes > m_fileSize - m_format.headerSize
+        || recordBytes > std::numeric_limits< int >::max()) {
+        m_error = QStringLiteral("invalid record layout");
+        m_file.unmap(const_cast< uchar* >(bytes));
+        return;
+    }
+    m_bytes = bytes;
+}
+
+bool QImMappedFile::parseHeader(const uchar* bytes, qint64 size)
+{
+    if (size < static_cast< qint64 >(sizeof(MappedFileHeader))) {
+        return false;
+    }
+    MappedFileHeader h;
+    std::memcpy(&h, bytes, sizeof(h));
+    if (std::memcmp(h.magic, c_magic, sizeof(c_magic)) != 0 || h.version != c_version
+        || h.valueType > static_cast< quint32 >(QImPlotValueType::Double)) {
+        return false;
+    }
+    m_format.valueType    = static_cast< QImPlotValueType >(h.valueType);
+    m_format.channelCount = static_cast< int >(h.channelCount);
+    m_format.xChannel     = h.xChannel;
+    m_format.xStart       = h.xStart;
+    m_format.xScale       = h.xScale;
+    m_format.headerSize   = h.headerSize;
+    return true;
+}
+
+//===============================================================
+// QImMappedXYDataSeries
+//===============================================================
+
+QImMappedXYDataSeries::QImMappedXYDataSeries(std::shared_ptr< const QImMappedFile > file, int yChannel)
+    : QImAbstractXYDataSeries(), m_file(std::move(file)), m_yChannel(yChannel)
+{
+}
+
+QImMappedXYDataSeries::QImMappedXYDataSeries(const QString& fileName, int yChannel)
+    : QImMappedXYDataSeries(std::make_shared< QImMappedFile >(fileName), yChannel)
+{
+}
+
+qint64 QImMappedXYDataSeries::size() const
+{
+    if (!m_file || !m_file->isValid() || m_yChannel < 0 || m_yChannel >= m_file->format().channelCount) {
+        return 0;
+    }
+    return m_file->recordCount();
+}
+
+bool QImMappedXYDataSeries::isContiguous() const
+{
+    // 按记录大小的固定步幅存放，ImPlot 可直接访问映射内存
+    return true;
+}
+
+int QImMappedXYDataSeries::stride() const
+{
+    return m_file ? m_file->format().recordSize() : static_cast< int >(sizeof(double));
+}
+
+int QImMappedXYDataSeries::xStride() const
+{
+    return stride();
+}
+
+const double* QImMappedXYDataSeries::xRawData() const
+{
+    if (xValueType() != QImPlotValueType::Double) {
+        return nullptr;
+    }
+    return static_cast< const double* >(xRawPointer());
+}
+
+const double* QImMappedXYDataSeries::yRawData() const
+{
+    if (yValueType() != QImPlotValueType::Double) {
+        return nullptr;
+    }
+    return static_cast< const double* >(yRawPointer());
+}
+
+QImPlotValueType QImMappedXYDataSeries::xValueType() const
+{
+    if (!m_file || m_file->format().xChannel < 0) {
+        return QImPlotValueType::Double;
+    }
+    return m_file->format().valueType;
+}
+
+QImPlotValueType QImMappedXYDataSeries::yValueType() const
+{
+    return m_file ? m_file->format().valueType : QImPlotValueType::Double;
+}
+
+const void* QImMappedXYDataSeries::xRawPointer() const
+{
+    if (size() == 0 || m_file->format().xChannel < 0) {
+        return nullptr;
+    }
+    const QImMappedFileFormat& fmt = m_file->format();
+    return m_file->constData() + fmt.xChannel * qimPlotValueTypeSize(fmt.valueType);
+}
+
+const void* QImMappedXYDataSeries::yRawPointer() const
+{
+    if (size() == 0) {
+        return nullptr;
+    }
+    return m_file->constData() + m_yChannel * qimPlotValueTypeSize(m_file->format().valueType);
+}
+
+double QImMappedXYDataSeries::xScale() const
+{
+    return m_file ? m_file->format().xScale : 1.0;
+}
+
+double QImMappedXYDataSeries::xStart() const
+{
+    return m_file ? m_file->format().xStart : 0.0;
+}
+
+double QImMappedXYDataSeries::xValue(qint64 index) const
+{
+    if (index < 0 || index >= size()) {
+        return std::numeric_limits< double >::quiet_NaN();
+    }
+    const int xChannel = m_file->format().xChannel;
+    if (xChannel < 0) {
+        return xStart() + xScale() * index;
+    }
+    return channelValue(xChannel, index);
+}
+
+double QImMappedXYDataSeries::yValue(qint64 index) const
+{
+    if (index < 0 || index >= size()) {
+        return std::numeric_limits< double >::quiet_NaN();
+    }
+    return channelValue(m_yChannel, index);
+}
+
+std::shared_ptr< const QImMappedFile > QImMappedXYDataSeries::file() const
+{
+    return m_file;
+}
+
+int QImMappedXYDataSeries::yChannel() const
+{
+    return m_yChannel;
+}
+
+double QImMappedXYDataSeries::channelValue(int channel, qint64 index) const
+{
+    const QImMappedFileFormat& fmt = m_file->format();
+    const char* p = m_file->constData() + index * fmt.recordSize()
+                    + channel * qimPlotValueTypeSize(fmt.valueType);
+    return qimPlotDispatchValueType(fmt.valueType, [ p ](auto tag) -> double {
+        using T = typename decltype(tag)::type;
+        // 自定义文件头长度时数据不一定对齐，使用 memcpy 读取
+        T v;
+        std::memcpy(&v, p, sizeof(T));
+        return static_cast< double >(v);
+    });
+}
+
+}  // namespace QIM
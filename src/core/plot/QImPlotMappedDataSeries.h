@@ -0,0 +1,181 @@
+#ifndef QIMPLOTMAPPEDDATASERIES_H
+#define QIMPLOTMAPPEDDATASERIES_H
+
+#include "QImPlotDataSeries.h"
+#include <QFile>
+#include <QString>
+#include <QtGlobal>
+#include <memory>
+
+class QIODevice;
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief Layout of a flat binary recording
+ * @details Records of channelCount values of one valueType, back to back, starting at headerSize.
+ *          xChannel < 0 means Y-only mode, x = xStart + index * xScale.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 扁平二进制记录文件的布局
+ * @details 从 headerSize 处开始连续存放记录，每条记录包含 channelCount 个 valueType 类型的值。
+ *          xChannel < 0 表示 Y-only 模式，x = xStart + index * xScale。
+ * \endif
+ */
+struct QImMappedFileFormat
+{
+    QImPlotValueType valueType { QImPlotValueType::Double };
+    int channelCount { 1 };
+    int xChannel { -1 };     ///< X 所在通道，<0 表示 Y-only
+    double xStart { 0.0 };
+    double xScale { 1.0 };
+    qint64 headerSize { 0 };  ///< 第一条记录之前需跳过的字节数
+
+    // Size of one record in bytes, QImMappedFile rejects layouts where it does not fit in int
+    int recordSize() const
+    {
+        return channelCount * qimPlotValueTypeSize(valueType);
+    }
+};
+
+/**
+ * \if ENGLISH
+ * @brief Read-only memory mapping of a multi-GB binary recording
+ *
+ * @class QImMappedFile
+ * @ingroup plot_data
+ *
+ * @details Maps the whole file with QFile::map(); nothing is read up front, so opening a 10 GB
+ *          file is instant and only the pages the renderer and the downsamplers touch are faulted
+ *          in by the OS page cache. Share one instance between the QImMappedXYDataSeries of
+ *          all channels through std::shared_ptr.
+ *
+ *          The file may start with the optional header written by writeHeader() (magic "QIMDATA"),
+ *          which describes dtype, channel count and X scale; otherwise the layout is given explicitly.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 多 GB 二进制记录文件的只读内存映射
+ *
+ * @class QImMappedFile
+ * @ingroup plot_data
+ *
+ * @details 通过 QFile::map() 映射整个文件，打开时不读取任何数据，10 GB 的文件也能瞬间打开，
+ *          只有绘制与降采样实际访问到的页面才会由操作系统页缓存调入。
+ *          通过 std::shared_ptr 在各通道的 QImMappedXYDataSeries 之间共享同一个实例。
+ *
+ *          文件可以以 writeHeader() 写出的可选文件头（魔数 "QIMDATA"）开始，
+ *          文件头描述数据类型、通道数与 X 缩放；没有文件头时需显式指定布局。
+ * \endif
+ */
+class QIM_CORE_API QImMappedFile
+{
+public:
+    // Maps fileName and reads its header, raw files without header are treated as one channel of double
+    explicit QImMappedFile(const QString& fileName);
+    // Maps fileName with an explicit layout, any header is skipped through format.headerSize
+    QImMappedFile(const QString& fileName, const QImMappedFileFormat& format);
+    ~QImMappedFile();
+
+    // True when the file is mapped and the layout fits its size: at least one record after the header,
+    // and a header read from the file no shorter than the header written by writeHeader()
+    bool isValid() const;
+    // Reason why the file could not be mapped
+    QString errorString() const;
+    QString fileName() const;
+    // Layout of the records
+    const QImMappedFileFormat& format() const;
+    // Number of complete records
+    qint64 recordCount() const;
+    // Pointer to the first record, nullptr when invalid
+    const char* constData() const;
+
+    // Writes the optional header describing format, returns false on I/O error
+    static bool writeHeader(QIODevice* device, const QImMappedFileFormat& format);
+    // Size of the header written by writeHeader()
+    static qint64 headerSize();
+
+private:
+    void map(bool readHeader);
+    bool parseHeader(const uchar* bytes, qint64 size);
+
+private:
+    QFile m_file;
+    QImMappedFileFormat m_format;
+    const uchar* m_bytes { nullptr };
+    qint64 m_fileSize { 0 };
+    QString m_error;
+    Q_DISABLE_COPY(QImMappedFile)
+};
+
+/**
+ * \if ENGLISH
+ * @brief Read-only XY data series over one channel of a QImMappedFile
+ *
+ * @class QImMappedXYDataSeries
+ * @ingroup plot_data
+ *
+ * @details Raw pointers address the mapping directly with the record size as byte stride,
+ *          so items call the typed ImPlot API and the downsamplers scan the file without any
+ *          copy into QVector. Y-only files take xStart()/xScale() from the file format.
+ * @note Files with more than 2^31 records are supported, items split the ImPlot calls and
+ *       the downsamplers work on 64-bit indices.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 基于 QImMappedFile 某一通道的只读 XY 数据系列
+ *
+ * @class QImMappedXYDataSeries
+ * @ingroup plot_data
+ *
+ * @details 原始指针直接指向映射内存，字节步幅为记录大小，绘图项调用类型化的 ImPlot 接口，
+ *          降采样器直接扫描文件内容，无需先拷贝到 QVector。Y-only 文件的 xStart()/xScale() 取自文件格式。
+ * @note 支持超过 2^31 条记录的文件，绘图项会分段调用 ImPlot，降采样器使用 64 位索引。
+ * \endif
+ */
+class QIM_CORE_API QImMappedXYDataSeries : public QImAbstractXYDataSeries
+{
+public:
+    // Views channel yChannel of file, X comes from the file format
+    explicit QImMappedXYDataSeries(std::shared_ptr< const QImMappedFile > file, int yChannel = 0);
+    // Maps fileName (header or raw doubles) and views channel yChannel
+    explicit QImMappedXYDataSeries(const QString& fileName, int yChannel = 0);
+    ~QImMappedXYDataSeries() override = default;
+
+    // QImAbstractPlotDataSeries interface
+    qint64 size() const override;
+
+    // QImAbstractXYDataSeries interface
+    bool isContiguous() const override;
+    int stride() const override;
+    int xStride() const override;
+    const double* xRawData() const override;
+    const double* yRawData() const override;
+    QImPlotValueType xValueType() const override;
+    QImPlotValueType yValueType() const override;
+    const void* xRawPointer() const override;
+    const void* yRawPointer() const override;
+    double xScale() const override;
+    double xStart() const override;
+    double xValue(qint64 index) const override;
+    double yValue(qint64 index) const override;
+
+    // The shared mapping
+    std::shared_ptr< const QImMappedFile > file() const;
+    // Channel shown as Y
+    int yChannel() const;
+
+private:
+    double channelValue(int channel, qint64 index) const;
+
+private:
+    std::shared_ptr< const QImMappedFile > m_file;
+    int m_yChannel { 0 };
+};
+
+}  // namespace QIM
+
+#endif  // QIMPLOTMAPPEDDATASERIES_H
@@ -0,0 +1,295 @@
+#include "QImPlotMinMaxKernel.h"
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define QIM_MINMAX_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang 需要为单个函数开启指令集，MSVC 可直接使用内建函数
+#if defined(__GNUC__) || defined(__clang__)
+#define QIM_MINMAX_TARGET(isa) __attribute__((target(isa)))
+#else
+#define QIM_MINMAX_TARGET(isa)
+#endif
+
+namespace QIM
+{
+
+namespace
+{
+// 短区间的 SIMD 初始化与通道归约开销超过收益，直接使用标量循环
+constexpr qint64 kMinSimdSamples = 64;
+
+template< typename T >
+QImPlotMinMaxIndex minMaxScalar(const T* p, qint64 n)
+{
+    QImPlotMinMaxIndex r;
+    for (qint64 i = 0; i < n; ++i) {
+        const double y = static_cast< double >(p[ i ]);
+        if (std::isnan(y)) {
+            continue;
+        }
+        if (r.minIdx < 0) {
+            r.minValue = r.maxValue = y;
+            r.minIdx = r.maxIdx = i;
+            continue;
+        }
+        if (y < r.minValue) {
+            r.minValue = y;
+            r.minIdx   = i;
+        }
+        if (y > r.maxValue) {
+            r.maxValue = y;
+            r.maxIdx   = i;
+        }
+    }
+    return r;
+}
+
+/**
+ * @brief 合并各通道（lane）的结果并处理尾部
+ *
+ * 通道内使用严格比较，保留的是该通道第一次出现的极值；合并时值相等取索引较小者，
+ * 因此结果与逐点扫描一致。通道的初值为 ±inf，等于初值的点不会被记录：
+ * 结果的最小值为 +inf（或最大值为 -inf）时无法确定第一次出现的位置，回退到逐点扫描。
+ */
+template< typename T, int Lanes >
+QImPlotMinMaxIndex reduceLanes(const double* mins,
+                               const double* minIdx,
+                               const double* maxs,
+                               const double* maxIdx,
+                               const T* p,
+                               qint64 vecEnd,
+                               qint64 n)
+{
+    QImPlotMinMaxIndex r;
+    for (int l = 0; l < Lanes; ++l) {
+        const qint64 mi = static_cast< qint64 >(minIdx[ l ]);
+        if (mi >= 0 && (r.minIdx < 0 || mins[ l ] < r.minValue || (mins[ l ] == r.minValue && mi < r.minIdx))) {
+            r.minValue = mins[ l ];
+            r.minIdx   = mi;
+        }
+        const qint64 ma = static_cast< qint64 >(maxIdx[ l ]);
+        if (ma >= 0 && (r.maxIdx < 0 || maxs[ l ] > r.maxValue || (maxs[ l ] == r.maxValue && ma < r.maxIdx))) {
+            r.maxValue = maxs[ l ];
+            r.maxIdx   = ma;
+        }
+    }
+    detail::mergeMinMax(r, minMaxScalar(p + vecEnd, n - vecEnd), vecEnd);
+    if (r.minIdx < 0 || r.maxIdx < 0 || r.minValue == std::numeric_limits< double >::infinity()
+        || r.maxValue == -std::numeric_limits< double >::infinity()) {
+        return minMaxScalar(p, n);
+    }
+    return r;
+}
+
+#if QIM_MINMAX_X86
+
+QIM_MINMAX_TARGET("avx2") inline __m256d loadAvx2(const double* p)
+{
+    return _mm256_loadu_pd(p);
+}
+
+QIM_MINMAX_TARGET("avx2") inline __m256d loadAvx2(const float* p)
+{
+    return _mm256_cvtps_pd(_mm_loadu_ps(p));
+}
+
+template< typename T >
+QIM_MINMAX_TARGET("avx2") QImPlotMinMaxIndex minMaxAvx2(const T* p, qint64 n)
+{
+    __m256d vmin[ 2 ], vmax[ 2 ], imin[ 2 ], imax[ 2 ];
+    for (int k = 0; k < 2; ++k) {
+        vmin[ k ] = _mm256_set1_pd(std::numeric_limits< double >::infinity());
+        vmax[ k ] = _mm256_set1_pd(-std::numeric_limits< double >::infinity());
+        imin[ k ] = _mm256_set1_pd(-1.0);
+        imax[ k ] = _mm256_set1_pd(-1.0);
+    }
+    __m256d idx[ 2 ]   = { _mm256_set_pd(3.0, 2.0, 1.0, 0.0), _mm256_set_pd(7.0, 6.0, 5.0, 4.0) };
+    const __m256d step = _mm256_set1_pd(8.0);
+    qint64 i           = 0;
+    for (; i + 8 <= n; i += 8) {
+        for (int k = 0; k < 2; ++k) {
+            const __m256d v  = loadAvx2(p + i + 4 * k);
+            const __m256d lt = _mm256_cmp_pd(v, vmin[ k ], _CMP_LT_OQ);
+            const __m256d gt = _mm256_cmp_pd(v, vmax[ k ], _CMP_GT_OQ);
+            vmin[ k ]        = _mm256_blendv_pd(vmin[ k ], v, lt);
+            imin[ k ]        = _mm256_blendv_pd(imin[ k ], idx[ k ], lt);
+            vmax[ k ]        = _mm256_blendv_pd(vmax[ k ], v, gt);
+            imax[ k ]        = _mm256_blendv_pd(imax[ k ], idx[ k ], gt);
+            idx[ k ]         = _mm256_add_pd(idx[ k ], step);
+        }
+    }
+    alignas(32) double mins[ 8 ], mini[ 8 ], maxs[ 8 ], maxi[ 8 ];
+    for (int k = 0; k < 2; ++k) {
+        _mm256_store_pd(mins + 4 * k, vmin[ k ]);
+        _mm256_store_pd(mini + 4 * k, imin[ k ]);
+        _mm256_store_pd(maxs + 4 * k, vmax[ k ]);
+        _mm256_store_pd(maxi + 4 * k, imax[ k ]);
+    }
+    return reduceLanes< T, 8 >(mins, mini, maxs, maxi, p, i, n);
+}
+
+QIM_MINMAX_TARGET("avx512f") inline __m512d loadAvx512(const double* p)
+{
+    return _mm512_loadu_pd(p);
+}
+
+QIM_MINMAX_TARGET("avx512f") inline __m512d loadAvx512(const float* p)
+{
+    return _mm512_cvtps_pd(_mm256_loadu_ps(p));
+}
+
+template< typename T >
+QIM_MINMAX_TARGET("avx512f") QImPlotMinMaxIndex minMaxAvx512(const T* p, qint64 n)
+{
+    __m512d vmin[ 2 ], vmax[ 2 ], imin[ 2 ], imax[ 2 ];
+    for (int k = 0; k < 2; ++k) {
+        vmin[ k ] = _mm512_set1_pd(std::numeric_limits< double >::infinity());
+        vmax[ k ] = _mm512_set1_pd(-std::numeric_limits< double >::infinity());
+        imin[ k ] = _mm512_set1_pd(-1.0);
+        imax[ k ] = _mm512_set1_pd(-1.0);
+    }
+    __m512d idx[ 2 ]   = { _mm512_set_pd(7.0, 6.0, 5.0, 4.0, 3.0, 2.0, 1.0, 0.0),
+                           _mm512_set_pd(15.0, 14.0, 13.0, 12.0, 11.0, 10.0, 9.0, 8.0) };
+    const __m512d step = _mm512_set1_pd(16.0);
+    qint64 i           = 0;
+    for (; i + 16 <= n; i += 16) {
+        for (int k = 0; k < 2; ++k) {
+            const __m512d v   = loadAvx512(p + i + 8 * k);
+            const __mmask8 lt = _mm512_cmp_pd_mask(v, vmin[ k ], _CMP_LT_OQ);
+            const __mmask8 gt = _mm512_cmp_pd_mask(v, vmax[ k ], _CMP_GT_OQ);
+            vmin[ k ]         = _mm512_mask_blend_pd(lt, vmin[ k ], v);
+            imin[ k ]         = _mm512_mask_blend_pd(lt, imin[ k ], idx[ k ]);
+            vmax[ k ]         = _mm512_mask_blend_pd(gt, vmax[ k ], v);
+            imax[ k ]         = _mm512_mask_blend_pd(gt, imax[ k ], idx[ k ]);
+            idx[ k ]          = _mm512_add_pd(idx[ k ], step);
+        }
+    }
+    alignas(64) double mins[ 16 ], mini[ 16 ], maxs[ 16 ], maxi[ 16 ];
+    for (int k = 0; k < 2; ++k) {
+        _mm512_store_pd(mins + 8 * k, vmin[ k ]);
+        _mm512_store_pd(mini + 8 * k, imin[ k ]);
+        _mm512_store_pd(maxs + 8 * k, vmax[ k ]);
+        _mm512_store_pd(maxi + 8 * k, imax[ k ]);
+    }
+    return reduceLanes< T, 16 >(mins, mini, maxs, maxi, p, i, n);
+}
+
+#endif  // QIM_MINMAX_X86
+
+QImPlotSimdLevel detectSimdLevel()
+{
+#if QIM_MINMAX_X86
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return QImPlotSimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return QImPlotSimdLevel::AVX2;
+    }
+#elif defined(_MSC_VER)
+    int info[ 4 ] = { 0 };
+    __cpuid(info, 0);
+    const int maxLeaf = info[ 0 ];
+    __cpuid(info, 1);
+    const bool osxsave = (info[ 2 ] & (1 << 27)) != 0;
+    const bool avx     = (info[ 2 ] & (1 << 28)) != 0;
+    bool avx2 = false, avx512f = false;
+    if (maxLeaf >= 7) {
+        __cpuidex(info, 7, 0);
+        avx2    = (info[ 1 ] & (1 << 5)) != 0;
+        avx512f = (info[ 1 ] & (1 << 16)) != 0;
+    }
+    // 操作系统必须保存 YMM/ZMM 寄存器状态
+    const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+    if (avx512f && (xcr0 & 0xE6) == 0xE6) {
+        return QImPlotSimdLevel::AVX512;
+    }
+    if (avx && avx2 && (xcr0 & 0x6) == 0x6) {
+        return QImPlotSimdLevel::AVX2;
+    }
+#endif
+#endif
+    return QImPlotSimdLevel::Scalar;
+}
+
+std::atomic< int >& activeLevel()
+{
+    static std::atomic< int > level { static_cast< int >(qimPlotSupportedSimdLevel()) };
+    return level;
+}
+
+template< typename T >
+QImPlotMinMaxIndex dispatchMinMax(const T* p, qint64 n)
+{
+    if (!p || n <= 0) {
+        return QImPlotMinMaxIndex();
+    }
+    if (n < kMinSimdSamples) {
+        return minMaxScalar(p, n);
+    }
+    switch (static_cast< QImPlotSimdLevel >(activeLevel().load(std::memory_order_relaxed))) {
+#if QIM_MINMAX_X86
+    case QImPlotSimdLevel::AVX512:
+        return minMaxAvx512(p, n);
+    case QImPlotSimdLevel::AVX2:
+        return minMaxAvx2(p, n);
+#endif
+    default:
+        break;
+    }
+    return minMaxScalar(p, n);
+}
+
+}  // namespace
+
+QImPlotSimdLevel qimPlotSupportedSimdLevel()
+{
+    static const QImPlotSimdLevel level = detectSimdLevel();
+    return level;
+}
+
+QImPlotSimdLevel qimPlotSimdLevel()
+{
+    return static_cast< QImPlotSimdLevel >(activeLevel().load(std::memory_order_relaxed));
+}
+
+QImPlotSimdLevel qimPlotSetSimdLevel(QImPlotSimdLevel level)
+{
+    const QImPlotSimdLevel effective = std::min(level, qimPlotSupportedSimdLevel());
+    activeLevel().store(static_cast< int >(effective), std::memory_order_relaxed);
+    return effective;
+}
+
+const char* qimPlotSimdLevelName(QImPlotSimdLevel level)
+{
+    switch (level) {
+    case QImPlotSimdLevel::AVX2:
+        return "AVX2";
+    case QImPlotSimdLevel::AVX512:
+        return "AVX-512";
+    default:
+        break;
+    }
+    return "Scalar";
+}
+
+QImPlotMinMaxIndex qimPlotMinMaxIndex(const double* data, qint64 n)
+{
+    return dispatchMinMax(data, n);
+}
+
+QImPlotMinMaxIndex qimPlotMinMaxIndex(const float* data, qint64 n)
+{
+    return dispatchMinMax(data, n);
+}
+
+}  // namespace QIM
@@ -0,0 +1,146 @@
+#ifndef QIMPLOTMINMAXKERNEL_H
+#define QIMPLOTMINMAXKERNEL_H
+
+#include "QImPlotDataSeriesView.h"
+#include <type_traits>
+
+namespace QIM
+{
+
+/**
+ * @brief 最大/最小值内核使用的指令集
+ *
+ * 运行时按 CPU 特性选择，不支持 AVX2 的 CPU 与非 x86 平台只有 Scalar
+ * （SSE2 只有 2 路 double 且没有 blend 指令，实测不快于标量循环，不提供）
+ */
+enum class QImPlotSimdLevel
+{
+    Scalar,
+    AVX2,
+    AVX512
+};
+
+/**
+ * @brief 区间内的最小/最大值及其索引
+ *
+ * NaN 被跳过，相等时取第一个出现的点；区间内没有可比较的值时索引为 -1
+ */
+struct QImPlotMinMaxIndex
+{
+    qint64 minIdx { -1 };
+    qint64 maxIdx { -1 };
+    double minValue { 0.0 };
+    double maxValue { 0.0 };
+};
+
+// CPU 支持的最高指令集（检测一次）
+QIM_CORE_API QImPlotSimdLevel qimPlotSupportedSimdLevel();
+// 当前使用的指令集，默认为 CPU 支持的最高级别
+QIM_CORE_API QImPlotSimdLevel qimPlotSimdLevel();
+// 限制使用的指令集（用于基准测试与排查），超过 CPU 支持的级别时取支持的最高级别，返回实际生效的级别
+QIM_CORE_API QImPlotSimdLevel qimPlotSetSimdLevel(QImPlotSimdLevel level);
+// 指令集名称
+QIM_CORE_API const char* qimPlotSimdLevelName(QImPlotSimdLevel level);
+
+// 连续数组 [0, n) 的最小/最大值，返回的索引相对于 data
+QIM_CORE_API QImPlotMinMaxIndex qimPlotMinMaxIndex(const double* data, qint64 n);
+QIM_CORE_API QImPlotMinMaxIndex qimPlotMinMaxIndex(const float* data, qint64 n);
+
+namespace detail
+{
+// 逐点扫描视图的 Y 值
+template< typename View >
+QImPlotMinMaxIndex viewMinMaxScalar(const View& view, qint64 first, qint64 last)
+{
+    QImPlotMinMaxIndex r;
+    for (qint64 i = first; i < last; ++i) {
+        const double y = view.y(i);
+        if (std::isnan(y)) {
+            continue;
+        }
+        if (r.minIdx < 0) {
+            r.minValue = r.maxValue = y;
+            r.minIdx = r.maxIdx = i;
+            continue;
+        }
+        if (y < r.minValue) {
+            r.minValue = y;
+            r.minIdx   = i;
+        }
+        if (y > r.maxValue) {
+            r.maxValue = y;
+            r.maxIdx   = i;
+        }
+    }
+    return r;
+}
+
+// 把相对于 base 的内核结果合并到 r，相等时保留 r 中（索引较小）的点
+inline void mergeMinMax(QImPlotMinMaxIndex& r, const QImPlotMinMaxIndex& part, qint64 base)
+{
+    if (part.minIdx >= 0 && (r.minIdx < 0 || part.minValue < r.minValue)) {
+        r.minValue = part.minValue;
+        r.minIdx   = part.minIdx + base;
+    }
+    if (part.maxIdx >= 0 && (r.maxIdx < 0 || part.maxValue > r.maxValue)) {
+        r.maxValue = part.maxValue;
+        r.maxIdx   = part.maxIdx + base;
+    }
+}
+
+template< typename View >
+struct ViewMinMax
+{
+    static QImPlotMinMaxIndex run(const View& view, qint64 first, qint64 last)
+    {
+        return viewMinMaxScalar(view, first, last);
+    }
+};
+
+// 紧凑存储的 double/float Y 值走 SIMD 内核，环形缓冲回绕处拆为两段
+template< typename TX, typename TY >
+struct ViewMinMax< QImPlotXYView< TX, TY > >
+{
+    static QImPlotMinMaxIndex run(const QImPlotXYView< TX, TY >& view, qint64 first, qint64 last)
+    {
+        if constexpr (std::is_same_v< TY, double > || std::is_same_v< TY, float >) {
+            if (view.yStride == static_cast< int >(sizeof(TY)) && last > first) {
+                const TY* ys       = reinterpret_cast< const TY* >(view.ys);
+                const qint64 raw   = view.rawIndex(first);
+                const qint64 n     = last - first;
+                const qint64 head  = std::min(n, view.count - raw);
+                QImPlotMinMaxIndex r;
+                mergeMinMax(r, qimPlotMinMaxIndex(ys + raw, head), first);
+                if (head < n) {
+                    mergeMinMax(r, qimPlotMinMaxIndex(ys, n - head), first + head);
+                }
+                return r;
+            }
+        }
+        return viewMinMaxScalar(view, first, last);
+    }
+};
+}  // namespace detail
+
+/**
+ * \if ENGLISH
+ * @brief Minimum and maximum Y of the logical range [first, last) of a view, with their indices
+ * @details Packed double/float storage goes through the SIMD kernel selected at runtime, other views
+ *          are scanned point by point. Returned indices are logical indices of the view.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 视图逻辑区间 [first, last) 内 Y 的最小/最大值及其索引
+ * @details 紧凑存储的 double/float 数据使用运行时选择的 SIMD 内核，其它视图逐点扫描。
+ *          返回的索引为视图的逻辑索引。
+ * \endif
+ */
+template< typename View >
+QImPlotMinMaxIndex qimPlotViewMinMax(const View& view, qint64 first, qint64 last)
+{
+    return detail::ViewMinMax< View >::run(view, first, last);
+}
+
+}  // namespace QIM
+
+#endif  // QIMPLOTMINMAXKERNEL_H
@@ -0,0 +1,41 @@
+#include "QImPlotMultiChannelDataSeries.h"
+#include "QImPlotDataSeriesView.h"
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief Finite X/Y extent over all channels, used to fit the axes once for the whole matrix
+ * @return Union of the bounds of every channel; NaN and Inf are skipped
+ * @details Cached like QImAbstractXYDataSeries::bounds(): when size() has grown only the new rows
+ *          are scanned, when it has shrunk or invalidateBounds() was called everything is scanned again.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 所有通道中有限值的 X/Y 范围，用于对整个矩阵只做一次坐标轴自适应
+ * @return 各通道范围的并集，跳过 NaN 与 Inf
+ * @details 与 QImAbstractXYDataSeries::bounds() 一样有缓存：size() 增加时只扫描新增的行，
+ *          size() 减小或调用了 invalidateBounds() 时重新完整扫描。
+ * \endif
+ */
+QImPlotDataBounds QImAbstractMultiChannelDataSeries::bounds() const
+{
+    const qint64 n = size();
+    if (m_boundsCount < 0 || m_boundsCount > n) {
+        m_bounds      = QImPlotDataBounds();
+        m_boundsCount = 0;
+    }
+    if (m_boundsCount < n) {
+        const qint64 first = m_boundsCount;
+        for (int c = 0; c < channelCount(); ++c) {
+            m_bounds.extend(qimPlotVisitChannel(*this, c, [ first, n ](const auto& view) {
+                return qimPlotScanBounds(view.slice(first, n - first));
+            }));
+        }
+        m_boundsCount = n;
+    }
+    return m_bounds;
+}
+
+}  // namespace QIM
@@ -0,0 +1,344 @@
+#ifndef QIMPLOTMULTICHANNELDATASERIES_H
+#define QIMPLOTMULTICHANNELDATASERIES_H
+
+#include "QImPlotDataSeries.h"
+#include "QImPlotColumnDataSeries.h"
+#include <QtGlobal>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief Multi-channel data sharing one X axis: N Y channels stored as one matrix
+ *
+ * @class QImAbstractMultiChannelDataSeries
+ * @ingroup plot_data
+ *
+ * @details size() is the number of samples per channel. Each channel is addressed as a strided
+ *          array: sample i of channel c is at channelRawPointer(c) + i * channelStride() bytes,
+ *          which covers both row-major (interleaved) and column-major (channel after channel) matrices.
+ *          X is shared by all channels, xRawPointer() returns nullptr for Y-only data
+ *          (x = xStart() + index * xScale()).
+ *
+ *          Rendered by QImPlotMultiLineItemNode, which downsamples all channels in one pass.
+ * @see QImMultiChannelDataSeries, QImPlotMultiLineItemNode
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 共享同一 X 轴的多通道数据：N 个 Y 通道以一个矩阵存储
+ *
+ * @class QImAbstractMultiChannelDataSeries
+ * @ingroup plot_data
+ *
+ * @details size() 为每个通道的点数。每个通道按带步幅的数组访问：通道 c 的第 i 个点位于
+ *          channelRawPointer(c) + i * channelStride() 字节处，同时适用于行主序（交错）与列主序（逐通道）矩阵。
+ *          所有通道共享 X，Y-only 数据的 xRawPointer() 返回 nullptr（x = xStart() + index * xScale()）。
+ *
+ *          由 QImPlotMultiLineItemNode 绘制，所有通道在一次遍历中完成降采样。
+ * @see QImMultiChannelDataSeries, QImPlotMultiLineItemNode
+ * \endif
+ */
+class QIM_CORE_API QImAbstractMultiChannelDataSeries : public QImAbstractPlotDataSeries
+{
+public:
+    // 矩阵的存储顺序
+    enum Layout
+    {
+        RowMajor,    ///< 按行存储，一行为同一时刻所有通道的值（交错）
+        ColumnMajor  ///< 按列存储，一个通道的所有值连续
+    };
+
+public:
+    QImAbstractMultiChannelDataSeries() : QImAbstractPlotDataSeries()
+    {
+    }
+    virtual ~QImAbstractMultiChannelDataSeries() = default;
+
+    virtual int type() const override
+    {
+        return MultiChannelData;
+    }
+
+    // 通道数
+    virtual int channelCount() const = 0;
+    // 存储顺序
+    virtual Layout layout() const = 0;
+
+    // X数据的存储类型，默认double
+    virtual QImPlotValueType xValueType() const
+    {
+        return QImPlotValueType::Double;
+    }
+    // 通道数据的存储类型，默认double
+    virtual QImPlotValueType valueType() const
+    {
+        return QImPlotValueType::Double;
+    }
+
+    // 类型无关的X数据指针，返回nullptr表示Y-only模式
+    virtual const void* xRawPointer() const = 0;
+    // X数据的步幅（字节）
+    virtual int xStride() const
+    {
+        return qimPlotValueTypeSize(xValueType());
+    }
+    // 通道 channel 第一个点的指针，实际类型由 valueType() 给出
+    virtual const void* channelRawPointer(int channel) const = 0;
+    // 同一通道相邻两个点之间的字节数
+    virtual int channelStride() const = 0;
+
+    // Y-only模式参数
+    virtual double xScale() const
+    {
+        return 1.0;
+    }
+    virtual double xStart() const
+    {
+        return 0.0;
+    }
+
+    virtual double xValue(qint64 index) const = 0;
+    virtual double value(int channel, qint64 index) const = 0;
+
+    // 所有通道的有限值范围（缓存，追加数据时只扫描新增部分）
+    virtual QImPlotDataBounds bounds() const;
+    // 数据被修改（非追加）后调用，使缓存的范围失效
+    void invalidateBounds()
+    {
+        m_boundsCount = -1;
+    }
+
+private:
+    mutable QImPlotDataBounds m_bounds;
+    mutable qint64 m_boundsCount { -1 };
+};
+
+/**
+ * \if ENGLISH
+ * @brief Multi-channel matrix series owning its samples, with an optional shared X column
+ *
+ * @class QImMultiChannelDataSeries
+ * @ingroup plot_data
+ *
+ * @details Stores channelCount() channels of type T in one std::vector. Row-major matrices
+ *          (one row = all channels at one time) can be streamed with appendRow()/appendRows();
+ *          column-major matrices are set as a whole with setValues(). X is either a shared
+ *          QImDataColumn (the same timestamps can also back QImColumnXYDataSeries instances)
+ *          or computed from xStart/xScale.
+ *
+ * @code
+ * auto t = QImDataColumn< double >::create(timestamps);
+ * auto* m = new QImMultiChannelDataSeries< float >(t, 64);
+ * m->setValues(std::move(samples));  // rows * 64 values, row-major
+ * auto* item = new QImPlotMultiLineItemNode();
+ * item->setData(m);
+ * @endcode
+ *
+ * @tparam T Channel element type (double, float or integer)
+ * @tparam TX X element type
+ * @note After appending rows, call notifyDataAppended() on the item.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 自身持有采样值的多通道矩阵数据系列，X 可为共享的数据列
+ *
+ * @class QImMultiChannelDataSeries
+ * @ingroup plot_data
+ *
+ * @details 以一个 std::vector 存储 channelCount() 个类型为 T 的通道。行主序矩阵
+ *          （一行为同一时刻所有通道的值）可通过 appendRow()/appendRows() 流式追加；
+ *          列主序矩阵通过 setValues() 整体设置。X 为共享的 QImDataColumn
+ *          （同一时间戳列也可用于 QImColumnXYDataSeries），或由 xStart/xScale 计算。
+ *
+ * @code
+ * auto t = QImDataColumn< double >::create(timestamps);
+ * auto* m = new QImMultiChannelDataSeries< float >(t, 64);
+ * m->setValues(std::move(samples));  // rows * 64 个值，行主序
+ * auto* item = new QImPlotMultiLineItemNode();
+ * item->setData(m);
+ * @endcode
+ *
+ * @tparam T 通道元素类型（double、float 或整数）
+ * @tparam TX X 元素类型
+ * @note 追加数据后需调用绘图项的 notifyDataAppended()。
+ * \endif
+ */
+template< typename T = double, typename TX = double >
+class QImMultiChannelDataSeries : public QImAbstractMultiChannelDataSeries
+{
+public:
+    static_assert(std::is_arithmetic_v< T > && !std::is_same_v< T, bool >, "T must be numeric");
+    using XColumn = QImDataColumn< TX >;
+
+    // XY 模式，所有通道共享 X 数据列
+    QImMultiChannelDataSeries(std::shared_ptr< const XColumn > x, int channels, Layout layout = RowMajor)
+        : QImAbstractMultiChannelDataSeries(), m_x(std::move(x)), m_channels(qMax(1, channels)), m_layout(layout)
+    {
+    }
+
+    // Y-only 模式，x = xStart + index * xScale
+    QImMultiChannelDataSeries(int channels, double xStart, double xScale, Layout layout = RowMajor)
+        : QImAbstractMultiChannelDataSeries()
+        , m_channels(qMax(1, channels))
+        , m_layout(layout)
+        , m_xStart(xStart)
+        , m_xScale(xScale)
+    {
+    }
+
+    ~QImMultiChannelDataSeries() override = default;
+
+    qint64 size() const override
+    {
+        return m_x ? std::min(m_x->size(), rowCount()) : rowCount();
+    }
+
+    int channelCount() const override
+    {
+        return m_channels;
+    }
+
+    Layout layout() const override
+    {
+        return m_layout;
+    }
+
+    QImPlotValueType xValueType() const override
+    {
+        return qimPlotValueType< TX >();
+    }
+
+    QImPlotValueType valueType() const override
+    {
+        return qimPlotValueType< T >();
+    }
+
+    const void* xRawPointer() const override
+    {
+        return m_x ? m_x->constData() : nullptr;
+    }
+
+    int xStride() const override
+    {
+        return sizeof(TX);
+    }
+
+    const void* channelRawPointer(int channel) const override
+    {
+        if (channel < 0 || channel >= m_channels || m_values.empty()) {
+            return nullptr;
+        }
+        return m_values.data() + channelOffset(channel);
+    }
+
+    int channelStride() const override
+    {
+        return static_cast< int >(m_layout == RowMajor ? sizeof(T) * m_channels : sizeof(T));
+    }
+
+    double xScale() const override
+    {
+        return m_xScale;
+    }
+
+    double xStart() const override
+    {
+        return m_xStart;
+    }
+
+    double xValue(qint64 index) const override
+    {
+        if (index < 0 || index >= size()) {
+            return std::numeric_limits< double >::quiet_NaN();
+        }
+        if (!m_x) {
+            return m_xStart + m_xScale * index;
+        }
+        return static_cast< double >(m_x->at(index));
+    }
+
+    double value(int channel, qint64 index) const override
+    {
+        if (channel < 0 || channel >= m_channels || index < 0 || index >= size()) {
+            return std::numeric_limits< double >::quiet_NaN();
+        }
+        const qint64 step = (m_layout == RowMajor) ? m_channels : 1;
+        return static_cast< double >(m_values[ static_cast< std::size_t >(channelOffset(channel) + index * step) ]);
+    }
+
+    // 存储的行数（每个通道的点数，不受X列长度限制）
+    qint64 rowCount() const
+    {
+        return static_cast< qint64 >(m_values.size()) / m_channels;
+    }
+
+    // 整体设置矩阵，values 的长度应为 channelCount() 的整数倍，按 layout() 解释
+    void setValues(std::vector< T > values)
+    {
+        m_values = std::move(values);
+        m_values.resize(static_cast< std::size_t >(rowCount() * m_channels));
+        invalidateBounds();
+    }
+
+    // 追加一行（channelCount() 个值），仅行主序支持
+    void appendRow(const T* row)
+    {
+        appendRows(row, 1);
+    }
+
+    // 追加 rows 行，仅行主序支持；列主序追加需要整体搬移，请使用 setValues()
+    void appendRows(const T* values, qint64 rows)
+    {
+        Q_ASSERT(m_layout == RowMajor);
+        if (m_layout != RowMajor || !values || rows <= 0) {
+            return;
+        }
+        m_values.insert(m_values.end(), values, values + rows * m_channels);
+    }
+
+    // 预留行数，避免流式追加时反复扩容
+    void reserveRows(qint64 rows)
+    {
+        m_values.reserve(static_cast< std::size_t >(rows * m_channels));
+    }
+
+    void clear()
+    {
+        m_values.clear();
+        invalidateBounds();
+    }
+
+    // 全部采样值，按 layout() 排列
+    const std::vector< T >& values() const
+    {
+        return m_values;
+    }
+
+    // X 数据列，Y-only 模式为 nullptr
+    std::shared_ptr< const XColumn > xColumn() const
+    {
+        return m_x;
+    }
+
+private:
+    qint64 channelOffset(int channel) const
+    {
+        return (m_layout == RowMajor) ? channel : channel * rowCount();
+    }
+
+private:
+    std::shared_ptr< const XColumn > m_x;
+    std::vector< T > m_values;
+    int m_channels { 1 };
+    Layout m_layout { RowMajor };
+    double m_xStart { 0.0 };
+    double m_xScale { 1.0 };
+};
+
+}  // namespace QIM
+
+#endif  // QIMPLOTMULTICHANNELDATASERIES_H
@@ -0,0 +1,354 @@
+#include "QImPlotMultiLineItemNode.h"
+#include <optional>
+#include <vector>
+#include "QImPlotDataSeriesView.h"
+#include "QImMultiChannelMinMaxDownsampler.h"
+#include "implot.h"
+#include "implot_internal.h"
+#include "QtImGuiUtils.h"
+namespace QIM
+{
+
+class QImPlotMultiLineItemNode::PrivateData
+{
+    QIM_DECLARE_PUBLIC(QImPlotMultiLineItemNode)
+public:
+    PrivateData(QImPlotMultiLineItemNode* p);
+    void resetDownSamplerData();
+    void refreshAppendedData();
+    // 按通道数与标签重新生成各通道的 utf8 标签
+    void updateLabels();
+    std::shared_ptr< QImAbstractMultiChannelDataSeries > data;
+    std::unique_ptr< QImMultiChannelMinMaxDownsampler > downsampler;
+    bool isAdaptiveSampling { true };
+    bool downsampleDirty { false };  ///< 数据追加后降采样缓存过期，在下一帧绘制前刷新
+    int downsampleThreshold { 20000 };
+    ImPlotLineFlags lineFlags { ImPlotLineFlags_None };
+    QStringList channelLabels;
+    std::vector< QByteArray > utf8Labels;  ///< 各通道实际使用的标签
+    bool labelsDirty { true };
+    std::vector< std::optional< ImVec4 > > colors;  ///< 各通道颜色
+    std::vector< ImPlotItem* > plotItems;         ///< 各通道上一帧的 ImPlotItem
+};
+
+QImPlotMultiLineItemNode::PrivateData::PrivateData(QImPlotMultiLineItemNode* p) : q_ptr(p)
+{
+}
+
+void QImPlotMultiLineItemNode::PrivateData::resetDownSamplerData()
+{
+    if (isAdaptiveSampling && data && (data->size() > downsampleThreshold)) {
+        downsampler.reset(new QImMultiChannelMinMaxDownsampler(data.get(), downsampleThreshold));
+    } else {
+        // 数据量不足阈值，旧的降采样器可能还指向已释放的数据
+        downsampler.reset(nullptr);
+    }
+    downsampleDirty = false;
+}
+
+/**
+ * @brief 数据追加后刷新降采样：已有降采样器时各通道的分桶只处理新增的行，否则重建
+ */
+void QImPlotMultiLineItemNode::PrivateData::refreshAppendedData()
+{
+    if (downsampler && data && data->size() > downsampleThreshold) {
+        downsampler->sourceAppended();
+        downsampleDirty = false;
+        return;
+    }
+    resetDownSamplerData();
+}
+
+void QImPlotMultiLineItemNode::PrivateData::updateLabels()
+{
+    const int channels = data ? data->channelCount() : 0;
+    if (!labelsDirty && static_cast< int >(utf8Labels.size()) == channels) {
+        return;
+    }
+    utf8Labels.resize(channels);
+    for (int c = 0; c < channels; ++c) {
+        utf8Labels[ c ] = q_ptr->channelLabel(c).toUtf8();
+    }
+    labelsDirty = false;
+}
+
+//----------------------------------------------------
+// QImPlotMultiLineItemNode
+//----------------------------------------------------
+QImPlotMultiLineItemNode::QImPlotMultiLineItemNode(QObject* par) : QImPlotItemNode(par), QIM_PIMPL_CONSTRUCT
+{
+    connect(this, &QImPlotItemNode::labelChanged, this, [ this ]() { d_ptr->labelsDirty = true; });
+}
+
+QImPlotMultiLineItemNode::~QImPlotMultiLineItemNode()
+{
+}
+
+void QImPlotMultiLineItemNode::setData(QImAbstractMultiChannelDataSeries* series)
+{
+    setSharedData(std::shared_ptr< QImAbstractMultiChannelDataSeries >(series));
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set a multi-channel series that may be shared with other items
+ * @param series Shared series, the item keeps a reference until the next setData()/setSharedData()
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置可与其它绘图项共享的多通道数据系列
+ * @param series 共享的数据系列，绘图项持有其引用直到下一次 setData()/setSharedData()
+ * \endif
+ */
+void QImPlotMultiLineItemNode::setSharedData(std::shared_ptr< QImAbstractMultiChannelDataSeries > series)
+{
+    QIM_D(d);
+    d->data        = std::move(series);
+    d->labelsDirty = true;
+    d->resetDownSamplerData();
+}
+
+QImAbstractMultiChannelDataSeries* QImPlotMultiLineItemNode::data() const
+{
+    return d_ptr->data.get();
+}
+
+std::shared_ptr< QImAbstractMultiChannelDataSeries > QImPlotMultiLineItemNode::sharedData() const
+{
+    return d_ptr->data;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Notifies the item that rows were appended to its current series
+ * @param count Number of appended rows
+ * @details Same as QImPlotLineItemNode::notifyDataAppended(): the downsampling cache of all
+ *          channels is rebuilt once before the next frame.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 通知绘图项当前数据系列追加了数据
+ * @param count 追加的行数
+ * @details 与 QImPlotLineItemNode::notifyDataAppended() 相同：所有通道的降采样缓存在下一帧绘制前重建一次。
+ * \endif
+ */
+void QImPlotMultiLineItemNode::notifyDataAppended(qint64 count)
+{
+    QIM_D(d);
+    if (count <= 0 || !d->data) {
+        return;
+    }
+    if (d->isAdaptiveSampling) {
+        d->downsampleDirty = true;
+    }
+}
+
+int QImPlotMultiLineItemNode::channelCount() const
+{
+    return d_ptr->data ? d_ptr->data->channelCount() : 0;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Sets the legend labels of the channels
+ * @param labels One label per channel; channels beyond the list use the default label
+ * @note Labels are also ImPlot item ids, they must be unique within the plot.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置各通道的图例标签
+ * @param labels 每个通道一个标签；超出列表的通道使用默认标签
+ * @note 标签同时是 ImPlot item 的 id，在同一个绘图中必须唯一。
+ * \endif
+ */
+void QImPlotMultiLineItemNode::setChannelLabels(const QStringList& labels)
+{
+    QIM_D(d);
+    d->channelLabels = labels;
+    d->labelsDirty   = true;
+}
+
+QStringList QImPlotMultiLineItemNode::channelLabels() const
+{
+    return d_ptr->channelLabels;
+}
+
+QString QImPlotMultiLineItemNode::channelLabel(int channel) const
+{
+    QIM_DC(d);
+    if (channel >= 0 && channel < d->channelLabels.size() && !d->channelLabels[ channel ].isEmpty()) {
+        return d->channelLabels[ channel ];
+    }
+    const QString base = label();
+    return base.isEmpty() ? QStringLiteral("ch %1").arg(channel) : QStringLiteral("%1[%2]").arg(base).arg(channel);
+}
+
+void QImPlotMultiLineItemNode::setChannelColor(int channel, const QColor& c)
+{
+    QIM_D(d);
+    if (channel < 0) {
+        return;
+    }
+    if (channel >= static_cast< int >(d->colors.size())) {
+        d->colors.resize(channel + 1);
+    }
+    d->colors[ channel ] = toImVec4(c);
+}
+
+QColor QImPlotMultiLineItemNode::channelColor(int channel) const
+{
+    QIM_DC(d);
+    if (channel < 0 || channel >= static_cast< int >(d->colors.size()) || !d->colors[ channel ]) {
+        return QColor();
+    }
+    return toQColor(*d->colors[ channel ]);
+}
+
+int QImPlotMultiLineItemNode::lineFlags() const
+{
+    QIM_DC(d);
+    return d->lineFlags;
+}
+
+void QImPlotMultiLineItemNode::setLineFlags(int flags)
+{
+    QIM_D(d);
+    if (d->lineFlags != flags) {
+        d->lineFlags = flags;
+        emit lineFlagChanged();
+    }
+}
+
+void QImPlotMultiLineItemNode::setAdaptiveSampling(bool on)
+{
+    d_ptr->isAdaptiveSampling = on;
+    d_ptr->resetDownSamplerData();
+}
+
+bool QImPlotMultiLineItemNode::isAdaptiveSampling() const
+{
+    return d_ptr->isAdaptiveSampling;
+}
+
+/**
+ * \if ENGLISH
+ * @brief The item is visible while at least one channel is shown
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 至少一个通道显示时绘图项可见
+ * \endif
+ */
+bool QImPlotMultiLineItemNode::isVisible() const
+{
+    QIM_DC(d);
+    if (!imPlotItem()) {
+        // 首次渲染前返回用户设置的预期状态
+        return QImPlotItemNode::isVisible();
+    }
+    for (const ImPlotItem* item : d->plotItems) {
+        if (item && item->Show) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void QImPlotMultiLineItemNode::setVisible(bool visible)
+{
+    QIM_D(d);
+    for (ImPlotItem* item : d->plotItems) {
+        if (item) {
+            item->Show = visible;
+        }
+    }
+    QImPlotItemNode::setVisible(visible);
+}
+
+/**
+ * @brief 绘图，每个通道调用一次 ImPlot::PlotLine，各自对应一个 ImPlotItem 与图例条目
+ * @return  这里直接返回false，避免调用endDraw
+ */
+bool QImPlotMultiLineItemNode::beginDraw()
+{
+    QIM_D(d);
+    QImAbstractMultiChannelDataSeries* series = d->data.get();
+    if (!series || series->size() <= 0) {
+        return false;
+    }
+    ImPlotContext* ct = ImPlot::GetCurrentContext();
+    if (!ct) {
+        return false;
+    }
+    if (d->downsampleDirty) {
+        d->refreshAppendedData();
+    }
+    d->updateLabels();
+    const int channels = series->channelCount();
+    if (static_cast< int >(d->colors.size()) < channels) {
+        d->colors.resize(channels);
+    }
+    d->plotItems.resize(channels, nullptr);
+    // 整个矩阵只做一次坐标轴自适应
+    const ImPlotLineFlags flags = d->lineFlags | fitDataBounds(series);
+    const QImMultiChannelMinMaxDownsampler* ds =
+        (d->isAdaptiveSampling && d->downsampler && d->downsampler->isValid()) ? d->downsampler.get() : nullptr;
+    const bool nodeVisible = QImAbstractNode::isVisible();
+    bool anyShown          = false;
+    for (int c = 0; c < channels; ++c) {
+        const char* label = d->utf8Labels[ c ].constData();
+        if (d->colors[ c ]) {
+            ImPlot::SetNextLineStyle(*d->colors[ c ]);
+        }
+        if (ds) {
+            ImPlot::PlotLine(label, ds->xData(c), ds->yData(c), ds->size(c), flags);
+        } else {
+            qimPlotVisitChannel(*series, c, [ & ](const auto& view) {
+                qimPlotForEachSlice(view, [ & ](const auto& slice) {
+                    using View = std::decay_t< decltype(slice) >;
+                    if (slice.isYOnly()) {
+                        // Y-only 按通道步幅直接调用类型化接口
+                        ImPlot::PlotLine(label,
+                                         reinterpret_cast< const typename View::YValue* >(slice.ys),
+                                         static_cast< int >(slice.count),
+                                         slice.xScale,
+                                         slice.xStart,
+                                         flags,
+                                         0,
+                                         slice.yStride);
+                    } else {
+                        ImPlot::PlotLineG(label,
+                                          &qimPlotViewGetter< View >,
+                                          const_cast< View* >(&slice),
+                                          static_cast< int >(slice.count),
+                                          flags);
+                    }
+                });
+            });
+        }
+        ImPlotItem* plotItem = ct->PreviousItem;
+        if (!plotItem) {
+            continue;
+        }
+        if (!d->plotItems[ c ] && c > 0) {
+            // 通道首次出现时跟随节点的可见性（通道0由 setImPlotItem 处理）
+            plotItem->Show = nodeVisible;
+        }
+        d->plotItems[ c ] = plotItem;
+        if (c == 0) {
+            setImPlotItem(plotItem);
+        }
+        if (!d->colors[ c ]) {
+            // 首次渲染且没设定颜色，记录 implot 给的默认颜色，保证每帧颜色稳定
+            d->colors[ c ] = ImPlot::GetLastItemColor();
+        }
+        anyShown = anyShown || plotItem->Show;
+    }
+    if (imPlotItem() && anyShown != nodeVisible) {
+        // 通过图例点击改变了通道的显示状态，同步节点的可见性
+        QImAbstractNode::setVisible(anyShown);
+    }
+    return false;
+}
+
+}  // end namespace QIM
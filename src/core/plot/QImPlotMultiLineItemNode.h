@@ -0,0 +1,98 @@
+#ifndef QIMPLOTMULTILINEITEMNODE_H
+#define QIMPLOTMULTILINEITEMNODE_H
+#include "QImPlotItemNode.h"
+#include "QImPlotMultiChannelDataSeries.h"
+#include <QStringList>
+#include <memory>
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief Draws every channel of a multi-channel series as its own curve from a single item
+ *
+ * @details Replaces N QImPlotLineItemNode instances sharing one time base: there is one node,
+ *          one series and one downsampler, and all channels are downsampled in a single pass
+ *          with shared bucket boundaries (QImMultiChannelMinMaxDownsampler). Each channel is a
+ *          separate ImPlot item, so it gets its own legend entry, color and legend toggle.
+ *
+ *          Channel labels default to "label[k]" (or "ch k" when the item has no label) and can be
+ *          set with setChannelLabels(). Node visibility applies to all channels.
+ * @see QImAbstractMultiChannelDataSeries, QImPlotLineItemNode
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 以一个绘图项把多通道数据的每个通道绘制为独立的曲线
+ *
+ * @details 代替共享同一时间轴的 N 个 QImPlotLineItemNode：只有一个节点、一个数据系列与一个降采样器，
+ *          所有通道以共享的桶边界在一次遍历中完成降采样（QImMultiChannelMinMaxDownsampler）。
+ *          每个通道是独立的 ImPlot item，拥有各自的图例条目、颜色与图例开关。
+ *
+ *          通道标签默认为 "label[k]"（绘图项没有标签时为 "ch k"），可通过 setChannelLabels() 设置。
+ *          节点的可见性作用于所有通道。
+ * @see QImAbstractMultiChannelDataSeries, QImPlotLineItemNode
+ * \endif
+ */
+class QIM_CORE_API QImPlotMultiLineItemNode : public QImPlotItemNode
+{
+    Q_OBJECT
+    QIM_DECLARE_PRIVATE(QImPlotMultiLineItemNode)
+public:
+    QImPlotMultiLineItemNode(QObject* par = nullptr);
+    ~QImPlotMultiLineItemNode();
+    enum
+    {
+        Type = InnerType + 27
+    };
+    virtual int type() const override
+    {
+        return Type;
+    }
+    //----------------------------------------------------
+    // 数据设置
+    //----------------------------------------------------
+    void setData(QImAbstractMultiChannelDataSeries* series);
+    // 设置共享的数据系列
+    void setSharedData(std::shared_ptr< QImAbstractMultiChannelDataSeries > series);
+    // 获取数据
+    QImAbstractMultiChannelDataSeries* data() const;
+    // 获取数据的共享引用
+    std::shared_ptr< QImAbstractMultiChannelDataSeries > sharedData() const;
+    // 通知数据系列追加了数据（流式数据，无需重新setData）
+    void notifyDataAppended(qint64 count = 1);
+    // 通道数，没有数据时为0
+    int channelCount() const;
+    //----------------------------------------------------
+    // 通道
+    //----------------------------------------------------
+    // 设置各通道的图例标签，未设置的通道使用默认标签
+    void setChannelLabels(const QStringList& labels);
+    QStringList channelLabels() const;
+    // 通道 channel 实际使用的标签
+    QString channelLabel(int channel) const;
+    // 设置通道颜色，未设置时使用 ImPlot 的默认颜色
+    void setChannelColor(int channel, const QColor& c);
+    QColor channelColor(int channel) const;
+    //----------------------------------------------------
+    // ImPlotLineFlags
+    //----------------------------------------------------
+    int lineFlags() const;
+    void setLineFlags(int flags);
+    //===============================================================
+    // 降采样
+    //===============================================================
+    void setAdaptiveSampling(bool on);
+    bool isAdaptiveSampling() const;
+    //
+    virtual bool isVisible() const override;
+    virtual void setVisible(bool visible) override;
+Q_SIGNALS:
+    void lineFlagChanged();
+
+protected:
+    virtual bool beginDraw() override;
+};
+
+}  // end namespace QIM
+#endif  // QIMPLOTMULTILINEITEMNODE_H
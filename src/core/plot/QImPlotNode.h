@@ -141,7 +141,7 @@ public:
     QPointF plotToPixels(const double& doubleX, const double& doubleY);
     // 坐标轴上渲染的文字内容，注意此函数一定只能在当前绘图的beginDraw内部使用
     std::string axisValueText(double val, QImPlotAxisId axisId) const;
-    // 自适应坐标轴，让所有曲线都能显示
+    // 自适应坐标轴，让所有曲线都能显示；XY 绘图项使用数据系列缓存的范围，代价与点数无关
     void rescaleAxes();
     void setAxesToFit();
 Q_SIGNALS:
@@ -0,0 +1,148 @@
+#include "QImPlotParallel.h"
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace QIM
+{
+
+namespace
+{
+std::atomic< int > g_threadCount { 0 };
+
+int effectiveThreadCount()
+{
+    const int count = g_threadCount.load(std::memory_order_relaxed);
+    return (count > 0) ? count : std::max(1, QThread::idealThreadCount());
+}
+
+// 专用线程池，不与 QThreadPool::globalInstance() 上的用户任务争用线程
+QThreadPool* workerPool()
+{
+    static QThreadPool pool;
+    return &pool;
+}
+
+// 一次 qimPlotParallelFor 调用的共享状态，晚启动的工作任务可能在调用返回后才访问它
+struct ParallelJob
+{
+    const std::function< void(qint64, qint64) >* fn { nullptr };
+    qint64 count { 0 };
+    qint64 grain { 1 };
+    qint64 chunks { 0 };
+    std::atomic< qint64 > next { 0 };
+    std::atomic< qint64 > done { 0 };
+    std::mutex mutex;
+    std::condition_variable finished;
+
+    // 领取并执行分组直到没有剩余，fn 只在领取到分组时访问（此时调用者仍在等待）
+    void run()
+    {
+        for (;;) {
+            const qint64 chunk = next.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunks) {
+                return;
+            }
+            const qint64 begin = chunk * grain;
+            (*fn)(begin, std::min(count, begin + grain));
+            if (done.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks) {
+                std::lock_guard< std::mutex > lock(mutex);
+                finished.notify_all();
+            }
+        }
+    }
+};
+
+class ParallelRunnable : public QRunnable
+{
+public:
+    explicit ParallelRunnable(std::shared_ptr< ParallelJob > job) : m_job(std::move(job))
+    {
+        setAutoDelete(true);
+    }
+    void run() override
+    {
+        m_job->run();
+    }
+
+private:
+    std::shared_ptr< ParallelJob > m_job;
+};
+
+class AsyncRunnable : public QRunnable
+{
+public:
+    explicit AsyncRunnable(std::function< void() > task) : m_task(std::move(task))
+    {
+        setAutoDelete(true);
+    }
+    void run() override
+    {
+        m_task();
+    }
+
+private:
+    std::function< void() > m_task;
+};
+}  // namespace
+
+void qimPlotSetThreadCount(int count)
+{
+    g_threadCount.store(std::max(0, count), std::memory_order_relaxed);
+}
+
+int qimPlotThreadCount()
+{
+    return effectiveThreadCount();
+}
+
+void qimPlotParallelFor(qint64 count, qint64 grain, const std::function< void(qint64, qint64) >& fn)
+{
+    if (count <= 0) {
+        return;
+    }
+    grain               = std::max< qint64 >(1, grain);
+    const qint64 chunks = (count + grain - 1) / grain;
+    const int threads   = effectiveThreadCount();
+    if (threads <= 1 || chunks <= 1) {
+        for (qint64 begin = 0; begin < count; begin += grain) {
+            fn(begin, std::min(count, begin + grain));
+        }
+        return;
+    }
+
+    auto job    = std::make_shared< ParallelJob >();
+    job->fn     = &fn;
+    job->count  = count;
+    job->grain  = grain;
+    job->chunks = chunks;
+
+    QThreadPool* pool = workerPool();
+    // 调用线程也参与计算，线程池只需要 threads - 1 个线程
+    if (pool->maxThreadCount() != threads - 1) {
+        pool->setMaxThreadCount(threads - 1);
+    }
+    const qint64 helpers = std::min< qint64 >(threads - 1, chunks - 1);
+    for (qint64 i = 0; i < helpers; ++i) {
+        pool->start(new ParallelRunnable(job));
+    }
+    job->run();
+
+    std::unique_lock< std::mutex > lock(job->mutex);
+    job->finished.wait(lock, [ &job ]() { return job->done.load(std::memory_order_acquire) == job->chunks; });
+}
+
+void qimPlotRunAsync(std::function< void() > task)
+{
+    if (task) {
+        // 后台任务可能运行很久，不占用 qimPlotParallelFor 的专用线程池
+        QThreadPool::globalInstance()->start(new AsyncRunnable(std::move(task)));
+    }
+}
+
+}  // namespace QIM
@@ -0,0 +1,45 @@
+#ifndef QIMPLOTPARALLEL_H
+#define QIMPLOTPARALLEL_H
+
+#include "QImAPI.h"
+#include <QtGlobal>
+#include <functional>
+
+namespace QIM
+{
+
+// 降采样等数据处理使用的线程数：1 表示串行，0 表示自动（QThread::idealThreadCount()），默认 0
+QIM_CORE_API void qimPlotSetThreadCount(int count);
+QIM_CORE_API int qimPlotThreadCount();
+
+/**
+ * \if ENGLISH
+ * @brief Runs fn over [0, count) split into chunks of grain items, on a dedicated thread pool
+ * @param count Number of items
+ * @param grain Items per chunk, fn is called with [begin, end) of one chunk at a time
+ * @param fn Chunk function, must only write to state owned by its chunk
+ * @details Chunks are handed out from a shared counter, so idle threads take the remaining work.
+ *          The calling thread runs chunks as well and returns after every chunk has finished, so
+ *          nested calls cannot deadlock. With one thread, or a single chunk, fn runs inline.
+ *          Chunk boundaries do not depend on the thread count: callers that combine per-chunk
+ *          results in chunk order get the same output as a serial run.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 把 [0, count) 按 grain 个一组划分，在专用线程池上执行 fn
+ * @param count 元素个数
+ * @param grain 每组的元素个数，fn 每次以一组的 [begin, end) 调用
+ * @param fn 分组函数，只能写入属于本组的数据
+ * @details 分组通过共享计数器分发，空闲的线程领取剩余的工作。调用线程同样执行分组，
+ *          所有分组完成后才返回，因此嵌套调用不会死锁。只有一个线程或只有一组时直接在调用线程执行。
+ *          分组边界与线程数无关：按分组顺序合并结果的调用者得到与串行执行相同的输出。
+ * \endif
+ */
+QIM_CORE_API void qimPlotParallelFor(qint64 count, qint64 grain, const std::function< void(qint64, qint64) >& fn);
+
+// 在 QThreadPool::globalInstance() 上执行一次后台任务（不阻塞调用线程）
+QIM_CORE_API void qimPlotRunAsync(std::function< void() > task);
+
+}  // namespace QIM
+
+#endif  // QIMPLOTPARALLEL_H
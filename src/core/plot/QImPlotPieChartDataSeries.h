@@ -244,7 +244,7 @@ public:
     virtual ~QImVectorPieChartDataSeries() = default;
 
     // QImAbstractPlotDataSeries interface
-    int size() const override
+    qint64 size() const override
     {
         return sliceCount();
     }
@@ -0,0 +1,258 @@
+#include "QImPlotRingBufferDataSeries.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief Constructs an XY ring buffer
+ * @param capacity Maximum number of samples, storage is allocated once here
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 构造 XY 环形缓冲
+ * @param capacity 最大采样点数，存储空间在此一次性分配
+ * \endif
+ */
+QImRingBufferXYDataSeries::QImRingBufferXYDataSeries(int capacity)
+    : QImAbstractXYDataSeries(), m_capacity(std::max(capacity, 1))
+{
+    m_xs.resize(m_capacity);
+    m_ys.resize(m_capacity);
+}
+
+/**
+ * \if ENGLISH
+ * @brief Constructs a Y-only ring buffer
+ * @param capacity Maximum number of samples
+ * @param xStart X value of the first appended sample
+ * @param xScale X increment between two samples
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 构造 Y-only 环形缓冲
+ * @param capacity 最大采样点数
+ * @param xStart 第一个追加点的 X 值
+ * @param xScale 相邻两点的 X 增量
+ * \endif
+ */
+QImRingBufferXYDataSeries::QImRingBufferXYDataSeries(int capacity, double xStart, double xScale)
+    : QImAbstractXYDataSeries(), m_capacity(std::max(capacity, 1)), m_yOnly(true), m_xStart(xStart), m_xScale(xScale)
+{
+    m_ys.resize(m_capacity);
+}
+
+qint64 QImRingBufferXYDataSeries::size() const
+{
+    return m_size;
+}
+
+bool QImRingBufferXYDataSeries::isContiguous() const
+{
+    return true;
+}
+
+const double* QImRingBufferXYDataSeries::xRawData() const
+{
+    return m_yOnly ? nullptr : m_xs.data();
+}
+
+const double* QImRingBufferXYDataSeries::yRawData() const
+{
+    return m_ys.data();
+}
+
+double QImRingBufferXYDataSeries::xScale() const
+{
+    return m_xScale;
+}
+
+/**
+ * \if ENGLISH
+ * @brief X value of the oldest sample still held in Y-only mode
+ * @details Advances by xScale() for every overwritten sample.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief Y-only 模式下仍保留的最旧数据的 X 值
+ * @details 每覆盖一个旧数据前移一个 xScale()。
+ * \endif
+ */
+double QImRingBufferXYDataSeries::xStart() const
+{
+    return m_xStart + static_cast< double >(m_total - m_size) * m_xScale;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Physical index of the oldest sample, passed to ImPlot as offset
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 最旧数据的物理索引，作为 offset 传给 ImPlot
+ * \endif
+ */
+qint64 QImRingBufferXYDataSeries::offset() const
+{
+    return (m_size < m_capacity) ? 0 : m_head;
+}
+
+double QImRingBufferXYDataSeries::xValue(qint64 index) const
+{
+    if (index < 0 || index >= m_size) {
+        return std::numeric_limits< double >::quiet_NaN();
+    }
+    if (m_yOnly) {
+        return xStart() + m_xScale * index;
+    }
+    return m_xs[ (offset() + index) % m_capacity ];
+}
+
+double QImRingBufferXYDataSeries::yValue(qint64 index) const
+{
+    if (index < 0 || index >= m_size) {
+        return std::numeric_limits< double >::quiet_NaN();
+    }
+    return m_ys[ (offset() + index) % m_capacity ];
+}
+
+void QImRingBufferXYDataSeries::append(double x, double y)
+{
+    if (m_size == m_capacity) {
+        evictSample(m_head);
+    }
+    extendBounds(m_yOnly ? std::numeric_limits< double >::quiet_NaN() : x, y);
+    if (!m_yOnly) {
+        m_xs[ m_head ] = x;
+    }
+    m_ys[ m_head ] = y;
+    m_head         = (m_head + 1) % m_capacity;
+    m_size         = std::min(m_size + 1, m_capacity);
+    ++m_total;
+}
+
+void QImRingBufferXYDataSeries::append(double y)
+{
+    // XY 模式下只写 Y 会与旧的（或任意的）X 配对
+    Q_ASSERT(m_yOnly);
+    if (!m_yOnly) {
+        return;
+    }
+    append(0.0, y);
+}
+
+/**
+ * \if ENGLISH
+ * @brief Appends a batch of XY samples
+ * @param xs X values, ignored in Y-only mode (may be nullptr there); required for an XY buffer
+ * @param ys Y values
+ * @param count Number of samples; when larger than capacity() only the newest ones are kept
+ * @details Copies at most two contiguous segments, no allocation happens. On an XY buffer a nullptr
+ *          xs would pair the new Y values with the stale X values of the overwritten slots, so the call
+ *          asserts and is ignored; appendBatch(ys, count) is for Y-only buffers only.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 批量追加 XY 数据
+ * @param xs X 值，Y-only 模式下忽略（此时可为 nullptr）；XY 缓冲必须提供
+ * @param ys Y 值
+ * @param count 点数；大于 capacity() 时只保留最新的部分
+ * @details 最多拷贝两段连续内存，不会发生内存分配。XY 缓冲传入 nullptr 的 xs 会使新的 Y 值
+ *          与被覆盖位置上旧的 X 值配对，因此断言失败并忽略本次调用；appendBatch(ys, count) 只用于 Y-only 缓冲。
+ * \endif
+ */
+void QImRingBufferXYDataSeries::appendBatch(const double* xs, const double* ys, int count)
+{
+    if (!ys || count <= 0) {
+        return;
+    }
+    Q_ASSERT(m_yOnly || xs);
+    if (!m_yOnly && !xs) {
+        return;
+    }
+    m_total += count;
+    if (count > m_capacity) {
+        // 只保留最新的 capacity 个点
+        const int skip = count - m_capacity;
+        ys += skip;
+        if (xs) {
+            xs += skip;
+        }
+        count = m_capacity;
+    }
+    if (isBoundsCached()) {
+        // 被覆盖的旧数据位于 head 之后，写满前没有被覆盖的数据
+        const int overwritten = std::max(0, m_size + count - m_capacity);
+        for (int i = 0; i < overwritten && isBoundsCached(); ++i) {
+            evictSample((m_head + i) % m_capacity);
+        }
+        for (int i = 0; i < count && isBoundsCached(); ++i) {
+            extendBounds(m_yOnly ? std::numeric_limits< double >::quiet_NaN() : xs[ i ], ys[ i ]);
+        }
+    }
+    copyIn(xs, ys, count);
+    m_size = std::min(m_size + count, m_capacity);
+}
+
+void QImRingBufferXYDataSeries::appendBatch(const double* ys, int count)
+{
+    appendBatch(nullptr, ys, count);
+}
+
+void QImRingBufferXYDataSeries::clear()
+{
+    m_head  = 0;
+    m_size  = 0;
+    m_total = 0;
+    invalidateBounds();
+}
+
+int QImRingBufferXYDataSeries::capacity() const
+{
+    return m_capacity;
+}
+
+bool QImRingBufferXYDataSeries::isFull() const
+{
+    return m_size == m_capacity;
+}
+
+bool QImRingBufferXYDataSeries::isYOnly() const
+{
+    return m_yOnly;
+}
+
+qint64 QImRingBufferXYDataSeries::totalAppended() const
+{
+    return m_total;
+}
+
+void QImRingBufferXYDataSeries::evictSample(int physicalIndex)
+{
+    // Y-only 模式的 X 范围由首尾索引计算，只需检查 Y
+    evictBounds(m_yOnly ? std::numeric_limits< double >::quiet_NaN() : m_xs[ physicalIndex ], m_ys[ physicalIndex ]);
+}
+
+void QImRingBufferXYDataSeries::copyIn(const double* xs, const double* ys, int count)
+{
+    // 第一段：从 head 写到数组末尾
+    const int first = std::min(count, m_capacity - m_head);
+    std::memcpy(m_ys.data() + m_head, ys, sizeof(double) * first);
+    if (!m_yOnly && xs) {
+        std::memcpy(m_xs.data() + m_head, xs, sizeof(double) * first);
+    }
+    // 第二段：回绕到数组开头
+    const int second = count - first;
+    if (second > 0) {
+        std::memcpy(m_ys.data(), ys + first, sizeof(double) * second);
+        if (!m_yOnly && xs) {
+            std::memcpy(m_xs.data(), xs + first, sizeof(double) * second);
+        }
+    }
+    m_head = (m_head + count) % m_capacity;
+}
+
+}  // namespace QIM
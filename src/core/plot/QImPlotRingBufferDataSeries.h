@@ -0,0 +1,113 @@
+#ifndef QIMPLOTRINGBUFFERDATASERIES_H
+#define QIMPLOTRINGBUFFERDATASERIES_H
+
+#include "QImPlotDataSeries.h"
+#include <vector>
+#include <QtGlobal>
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief Fixed-capacity circular buffer XY data series for live acquisition
+ *
+ * @class QImRingBufferXYDataSeries
+ * @ingroup plot_data
+ *
+ * @details Stores the newest capacity() samples in two preallocated arrays.
+ *          append()/appendBatch() are O(1) per sample and never reallocate.
+ *          Once the buffer is full, the write position wraps around and offset()
+ *          reports the index of the oldest sample, so ImPlot::PlotLine can render
+ *          the buffer directly (zero-copy) through its offset parameter.
+ *
+ *          In Y-only mode only Y values are stored; xStart() advances automatically
+ *          as old samples are overwritten, keeping the X axis continuous. The Y-only
+ *          append(y)/appendBatch(ys, count) overloads are only valid in this mode.
+ *
+ * @note After appending, call QImPlotLineItemNode::notifyDataAppended() instead of setData()
+ *       so the owning item only refreshes its downsampling cache.
+ * @see QImAbstractXYDataSeries
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 用于实时采集的定容环形缓冲 XY 数据系列
+ *
+ * @class QImRingBufferXYDataSeries
+ * @ingroup plot_data
+ *
+ * @details 在两块预分配的数组中保存最新的 capacity() 个采样点。
+ *          append()/appendBatch() 每个点的代价为 O(1)，且不会重新分配内存。
+ *          缓冲区写满后写入位置回绕，offset() 返回最旧数据的索引，
+ *          ImPlot::PlotLine 可通过其 offset 参数直接（零拷贝）绘制缓冲区。
+ *
+ *          Y-only 模式下仅存储 Y 值，旧数据被覆盖时 xStart() 自动前移，保持 X 轴连续。
+ *          只传 Y 值的 append(y)/appendBatch(ys, count) 仅可用于该模式。
+ *
+ * @note 追加数据后应调用 QImPlotLineItemNode::notifyDataAppended() 而不是 setData()，
+ *       这样绘图项只会刷新降采样缓存。
+ * @see QImAbstractXYDataSeries
+ * \endif
+ */
+class QIM_CORE_API QImRingBufferXYDataSeries : public QImAbstractXYDataSeries
+{
+public:
+    // Constructs an XY ring buffer with the given capacity
+    explicit QImRingBufferXYDataSeries(int capacity);
+    // Constructs a Y-only ring buffer, x = xStart + index * xScale
+    QImRingBufferXYDataSeries(int capacity, double xStart, double xScale);
+    ~QImRingBufferXYDataSeries() override = default;
+
+    // QImAbstractPlotDataSeries interface
+    qint64 size() const override;
+
+    // QImAbstractXYDataSeries interface
+    bool isContiguous() const override;
+    const double* xRawData() const override;
+    const double* yRawData() const override;
+    double xScale() const override;
+    double xStart() const override;
+    qint64 offset() const override;
+    double xValue(qint64 index) const override;
+    double yValue(qint64 index) const override;
+
+    // Appends one XY sample, overwriting the oldest one when full
+    void append(double x, double y);
+    // Appends one Y sample, Y-only buffers only (asserts and is ignored on an XY buffer)
+    void append(double y);
+    // Appends count XY samples, xs may only be nullptr on a Y-only buffer
+    void appendBatch(const double* xs, const double* ys, int count);
+    // Appends count Y samples, Y-only buffers only (asserts and is ignored on an XY buffer)
+    void appendBatch(const double* ys, int count);
+    // Removes all samples, keeps the allocated storage
+    void clear();
+
+    // Maximum number of samples held by the buffer
+    int capacity() const;
+    // True when the buffer has wrapped at least once
+    bool isFull() const;
+    // True when only Y values are stored
+    bool isYOnly() const;
+    // Total number of samples appended since construction or clear()
+    qint64 totalAppended() const;
+
+private:
+    void copyIn(const double* xs, const double* ys, int count);
+    // 覆盖 physicalIndex 处的数据前更新缓存的数据范围
+    void evictSample(int physicalIndex);
+
+private:
+    std::vector< double > m_xs;
+    std::vector< double > m_ys;
+    int m_capacity { 0 };
+    int m_head { 0 };  ///< 下一个写入位置，写满后也是最旧数据的位置
+    int m_size { 0 };
+    qint64 m_total { 0 };
+    bool m_yOnly { false };
+    double m_xStart { 0.0 };
+    double m_xScale { 1.0 };
+};
+
+}  // namespace QIM
+
+#endif  // QIMPLOTRINGBUFFERDATASERIES_H
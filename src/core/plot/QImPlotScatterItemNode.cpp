@@ -1,8 +1,10 @@
 #include "QImPlotScatterItemNode.h"
 #include <optional>
 #include "QImPlotDataSeries.h"
+#include "QImPlotDataSeriesView.h"
 #include "QImLTTBDownsampler.h"
 #include "QImMinMaxLTTBDownsampler.h"
+#include "QImScatterDensityDecimator.h"
 #include "implot.h"
 #include "implot_internal.h"
 #include "QImTrackedValue.hpp"
@@ -23,15 +25,29 @@ namespace QIM
 // ImPlotMarker_Plus   ->   ＋ 加号
 // ImPlotMarker_Asterisk   ->   ✻ 星形
 
+namespace
+{
+// 按点数表现密度时划分的等级数，每个等级调用一次 PlotScatter
+constexpr int kDensityLevels = 4;
+}  // namespace
+
 class QImPlotScatterItemNode::PrivateData
 {
     QIM_DECLARE_PUBLIC(QImPlotScatterItemNode)
 public:
     PrivateData(QImPlotScatterItemNode* p);
     void resetDownSamplerData();
-    std::unique_ptr< QImAbstractXYDataSeries > data;
+    void refreshAppendedData();
+    void updateViewSampling(int fitFlags);
+    void plotDensityLevels(const char* label, const ImVec4& col, ImPlotScatterFlags flags);
+    std::shared_ptr< QImAbstractXYDataSeries > data;
     std::unique_ptr< QImAbstractXYDataSeries > dataLTTB;
+    QImMinMaxLTTBDownsampler* viewSampler { nullptr };          ///< dataLTTB 支持视图相关下采样时指向它
+    QImScatterDensityDecimator* densitySampler { nullptr };     ///< dataLTTB 为占用网格时指向它
+    DownsampleStrategy strategy { DownsampleDensity };
+    DensityEncoding densityEncoding { DensityNone };
     bool isAdaptiveSampling { true };
+    bool downsampleDirty { false };  ///< 数据追加后降采样缓存过期，在下一帧绘制前刷新
     int downsampleThreshold { 20000 };
     QImTrackedValue< int > markerShape { ImPlotMarker_Circle };                      ///< 标记形状
     bool markerFill { true };
@@ -50,19 +66,115 @@ QImPlotScatterItemNode::PrivateData::PrivateData(QImPlotScatterItemNode* p) : q_
  */
 void QImPlotScatterItemNode::PrivateData::resetDownSamplerData()
 {
+    viewSampler    = nullptr;
+    densitySampler = nullptr;
     if (isAdaptiveSampling) {
-        if (data && (data->size() > downsampleThreshold)) {
-#if 0
-            QImLTTBDownsampler* lttb = new QImLTTBDownsampler(data.get(), downsampleThreshold);
-            dataLTTB.reset(lttb);
-#else
+        if (data && (data->size() > downsampleThreshold) && strategy == DownsampleDensity) {
+            QImScatterDensityDecimator* density = new QImScatterDensityDecimator(data.get());
+            density->setCellSize(markerSize.value());
+            density->setCounting(densityEncoding != DensityNone);
+            density->setDensityLevels(kDensityLevels);
+            // 在得到绘图区尺寸之前先按数据范围降采样，首帧不会绘制全部的点
+            density->clearViewRect();
+            dataLTTB.reset(density);
+            densitySampler = density;
+        } else if (data && (data->size() > downsampleThreshold)) {
             QImMinMaxLTTBDownsampler* lttb = new QImMinMaxLTTBDownsampler(data.get(), downsampleThreshold);
             dataLTTB.reset(lttb);
-#endif
+            viewSampler = lttb;
+        } else {
+            // 数据量不足阈值，旧的降采样代理可能还指向已释放的数据
+            dataLTTB.reset(nullptr);
         }
     } else {
         dataLTTB.reset(nullptr);
     }
+    downsampleDirty = false;
+}
+
+/**
+ * @brief 数据追加后刷新降采样：已有视图相关的降采样代理时增量更新（金字塔与全量分桶只处理新增的点），否则重建
+ */
+void QImPlotScatterItemNode::PrivateData::refreshAppendedData()
+{
+    if (densitySampler && data && data->size() > downsampleThreshold) {
+        // 视图不变时下一帧只把新增的点并入网格
+        densitySampler->sourceAppended();
+        downsampleDirty = false;
+        return;
+    }
+    if (viewSampler && data && data->size() > downsampleThreshold) {
+        // 追加数据说明是只追加的数据流，全量结果切换为增量分桶（切换时重建一次）
+        if (!viewSampler->isIncrementalMode()) {
+            viewSampler->setIncrementalMode(true);
+        }
+        viewSampler->sourceAppended();
+        downsampleDirty = false;
+        return;
+    }
+    resetDownSamplerData();
+}
+
+/**
+ * @brief 按当前帧的可见 X 范围与像素宽度重新下采样，范围不变时使用缓存
+ * @param fitFlags fitDataBounds() 的返回值，为 0 的自适应帧由 ImPlot 逐点拟合，需要全量数据的下采样结果
+ */
+void QImPlotScatterItemNode::PrivateData::updateViewSampling(int fitFlags)
+{
+    if (densitySampler) {
+        // 单元边长取标记半径，保留的标记之间仍然相互覆盖，密集区域看起来是连续的
+        densitySampler->setCellSize(markerSize.value());
+        densitySampler->setCounting(densityEncoding != DensityNone);
+        double xMin = 0, xMax = 0, yMin = 0, yMax = 0;
+        int pixelWidth = 0, pixelHeight = 0;
+        if (q_ptr->plotViewRect(xMin, xMax, yMin, yMax, pixelWidth, pixelHeight)) {
+            densitySampler->setViewRect(xMin, xMax, yMin, yMax, pixelWidth, pixelHeight);
+        } else if (fitFlags == 0) {
+            densitySampler->clearViewRect();
+        }
+        return;
+    }
+    if (!viewSampler) {
+        return;
+    }
+    double xMin = 0, xMax = 0;
+    int pixelWidth = 0;
+    if (q_ptr->plotViewXRange(xMin, xMax, pixelWidth)) {
+        viewSampler->setViewRange(xMin, xMax, pixelWidth);
+    } else if (fitFlags == 0) {
+        viewSampler->clearViewRange();
+    }
+}
+
+/**
+ * @brief 按密度等级分别绘制占用网格的输出，同一 label 的多次调用在 ImPlot 中是同一个 item
+ */
+void QImPlotScatterItemNode::PrivateData::plotDensityLevels(const char* label, const ImVec4& col, ImPlotScatterFlags flags)
+{
+    const ImPlotMarker marker         = static_cast< ImPlotMarker >(markerShape.value());
+    const float size                  = markerSize.value();
+    const double* xs                  = densitySampler->xRawData();
+    const double* ys                  = densitySampler->yRawData();
+    const std::vector< qint64 >& offs = densitySampler->levelOffsets();
+    const int levels                  = static_cast< int >(offs.size()) - 1;
+    for (int l = 0; l < levels; ++l) {
+        const qint64 count = offs[ l + 1 ] - offs[ l ];
+        if (count <= 0) {
+            continue;
+        }
+        // 最稀疏的等级仍保持可见
+        const float weight = static_cast< float >(l + 1) / levels;
+        ImVec4 levelCol    = col;
+        float levelSize    = size;
+        if (densityEncoding == DensityAlpha) {
+            levelCol.w *= 0.25f + 0.75f * weight;
+        } else {
+            levelSize *= 0.5f + 0.5f * weight;
+        }
+        ImPlot::SetNextMarkerStyle(marker, levelSize, levelCol, IMPLOT_AUTO, markerFill ? levelCol : ImVec4(0, 0, 0, 0));
+        // 输出点数不超过网格单元数，不会超过 int 范围
+        ImPlot::PlotScatter(label, xs + offs[ l ], ys + offs[ l ], static_cast< int >(count), flags);
+    }
 }
 //----------------------------------------------------
 // QImPlotScatterItemNode
@@ -76,9 +188,25 @@ QImPlotScatterItemNode::~QImPlotScatterItemNode()
 }
 
 void QImPlotScatterItemNode::setData(QImAbstractXYDataSeries* series)
+{
+    setSharedData(std::shared_ptr< QImAbstractXYDataSeries >(series));
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set a data series that may be shared with other items or inspection tools
+ * @param series Shared series, the item keeps a reference until the next setData()/setSharedData()
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置可与其它绘图项或检查工具共享的数据系列
+ * @param series 共享的数据系列，绘图项持有其引用直到下一次 setData()/setSharedData()
+ * \endif
+ */
+void QImPlotScatterItemNode::setSharedData(std::shared_ptr< QImAbstractXYDataSeries > series)
 {
     QIM_D(d);
-    d->data.reset(series);
+    d->data = std::move(series);
     if (d->isAdaptiveSampling) {
         d->resetDownSamplerData();
     }
@@ -90,6 +218,38 @@ QImAbstractXYDataSeries* QImPlotScatterItemNode::data() const
     return d_ptr->data.get();
 }
 
+std::shared_ptr< QImAbstractXYDataSeries > QImPlotScatterItemNode::sharedData() const
+{
+    return d_ptr->data;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Notifies the item that samples were appended to its current series
+ * @param[in] count Number of appended samples
+ * @details Keeps the series and only marks the downsampling cache stale, it is rebuilt once
+ *          before the next frame.
+ * @see QImPlotLineItemNode::notifyDataAppended()
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 通知绘图项当前数据系列追加了数据
+ * @param[in] count 追加的点数
+ * @details 保留数据系列，仅把降采样缓存标记为过期，在下一帧绘制前重建一次。
+ * @see QImPlotLineItemNode::notifyDataAppended()
+ * \endif
+ */
+void QImPlotScatterItemNode::notifyDataAppended(qint64 count)
+{
+    QIM_D(d);
+    if (count <= 0 || !d->data) {
+        return;
+    }
+    if (d->isAdaptiveSampling) {
+        d->downsampleDirty = true;
+    }
+}
+
 
 /**
  * \if ENGLISH
@@ -354,6 +514,96 @@ void QImPlotScatterItemNode::setDownsampleThreshold(int threshold)
     }
 }
 
+/**
+ * \if ENGLISH
+ * @brief Gets the decimation algorithm
+ * @return Current DownsampleStrategy, default DownsampleDensity
+ * @see setDownsampleStrategy()
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 获取降采样算法
+ * @return 当前的 DownsampleStrategy，默认 DownsampleDensity
+ * @see setDownsampleStrategy()
+ * \endif
+ */
+QImPlotScatterItemNode::DownsampleStrategy QImPlotScatterItemNode::downsampleStrategy() const
+{
+    QIM_DC(d);
+    return d->strategy;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Sets the decimation algorithm for datasets exceeding downsampleThreshold
+ * @param[in] strategy DownsampleDensity or DownsampleMinMaxLTTB
+ * @details DownsampleDensity divides the visible rectangle into cells about the size of a marker and
+ *          keeps the first sample of every occupied cell, so at most one marker is drawn per cell.
+ *          It is recomputed only when the view, the plot size or the marker size changes; appended
+ *          samples are added to the existing grid. Logarithmic axes fall back to a grid over the
+ *          data bounds.
+ * @see QImScatterDensityDecimator, setDensityEncoding()
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置超过downsampleThreshold的数据集使用的降采样算法
+ * @param[in] strategy DownsampleDensity 或 DownsampleMinMaxLTTB
+ * @details DownsampleDensity 把可见矩形划分为约一个标记大小的单元，每个被占用的单元保留第一个点，
+ *          因此每个单元最多绘制一个标记。只有视图、绘图区尺寸或标记大小变化时才重新计算，
+ *          追加的点并入现有网格。对数坐标轴退化为按数据范围划分的网格。
+ * @see QImScatterDensityDecimator, setDensityEncoding()
+ * \endif
+ */
+void QImPlotScatterItemNode::setDownsampleStrategy(DownsampleStrategy strategy)
+{
+    QIM_D(d);
+    if (d->strategy != strategy) {
+        d->strategy = strategy;
+        d->resetDownSamplerData();
+    }
+}
+
+/**
+ * \if ENGLISH
+ * @brief Gets the density encoding of DownsampleDensity
+ * @return Current DensityEncoding, default DensityNone
+ * @see setDensityEncoding()
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 获取 DownsampleDensity 的密度表现方式
+ * @return 当前的 DensityEncoding，默认 DensityNone
+ * @see setDensityEncoding()
+ * \endif
+ */
+QImPlotScatterItemNode::DensityEncoding QImPlotScatterItemNode::densityEncoding() const
+{
+    QIM_DC(d);
+    return d->densityEncoding;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Shows how many samples each decimated marker stands for
+ * @param[in] encoding DensityNone, DensityAlpha or DensitySize
+ * @details Counts the samples per cell and splits the cells into a few levels, logarithmic in the
+ *          count. Each level is drawn with its own alpha (DensityAlpha) or marker size (DensitySize).
+ *          Only affects DownsampleDensity.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 表现每个降采样后的标记代表的点数
+ * @param[in] encoding DensityNone、DensityAlpha 或 DensitySize
+ * @details 统计每个单元的点数并按点数的对数划分为若干等级，每个等级使用不同的透明度（DensityAlpha）
+ *          或标记大小（DensitySize）绘制。只对 DownsampleDensity 有效。
+ * \endif
+ */
+void QImPlotScatterItemNode::setDensityEncoding(DensityEncoding encoding)
+{
+    QIM_D(d);
+    d->densityEncoding = encoding;
+}
+
 /**
  * \if ENGLISH
  * @brief Gets the marker color
@@ -519,8 +769,15 @@ bool QImPlotScatterItemNode::beginDraw()
         // 没有数据
         return false;
     }
+    if (d->downsampleDirty) {
+        d->refreshAppendedData();
+    }
     QImAbstractXYDataSeries* series = d->data.get();
+    // 自适应坐标轴时使用缓存的数据范围，不让 ImPlot 逐点拟合（降采样代理的范围与原始数据相同）
+    const int fitFlags = fitDataBounds(series);
     if (d->isAdaptiveSampling && d->dataLTTB) {
+        // 只对可见范围按绘图区像素宽度下采样，缩放到局部时显示全分辨率数据
+        d->updateViewSampling(fitFlags);
         series = d->dataLTTB.get();
     }
     if (!series) {
@@ -543,29 +800,35 @@ bool QImPlotScatterItemNode::beginDraw()
         d->color->clear();
     }
 
-    if (series->isContiguous()) {
-        if (series->xRawData()) {
-            // 有x指针，说明不是yonly
-            ImPlot::PlotScatter(labelConstData(),
-                                series->xRawData(),
-                                series->yRawData(),
-                                series->size(),
-                                d->scatterFlags,
-                                series->offset(),
-                                series->stride());
-        } else {
-            // x指针没有说明是yonly
-            ImPlot::PlotScatter(labelConstData(),
-                                series->yRawData(),
-                                series->size(),
-                                series->xScale(),
-                                series->xStart(),
-                                d->scatterFlags,
-                                series->offset(),
-                                series->stride());
-        }
+    // 按存储类型直接调用 ImPlot::PlotScatter<T>，float/整数数据无需转换为double
+    const char* label = labelConstData();
+    // 超过 INT_MAX 个点时按区间分段调用（同一 label，ImPlot 视为同一个 item）
+    const int stride  = series->stride();
+    const ImPlotScatterFlags flags = d->scatterFlags | fitFlags;
+    if (d->densitySampler && d->densityEncoding != DensityNone && d->densitySampler->levelOffsets().size() > 2
+        && d->color) {
+        // 按密度等级分别设置透明度或大小（首帧尚未取得默认颜色时按普通方式绘制）
+        d->plotDensityLevels(label, col, flags);
     } else {
-        // TODO:非连续内存
+        qimPlotDispatchXYSeries(
+            *series,
+            [ & ](const auto* ys, int count, int offset, double xStart) {
+                // x指针没有说明是yonly
+                ImPlot::PlotScatter(label, ys, count, series->xScale(), xStart, flags, offset, stride);
+            },
+            [ & ](const auto* xs, const auto* ys, int count, int offset) {
+                // 有x指针，说明不是yonly
+                ImPlot::PlotScatter(label, xs, ys, count, flags, offset, stride);
+            },
+            [ & ](const auto& view) {
+                // X/Y类型或步幅不同、或分块存储（非连续内存），走编译期特化的getter
+                using View = std::decay_t< decltype(view) >;
+                ImPlot::PlotScatterG(label,
+                                     &qimPlotViewGetter< View >,
+                                     const_cast< View* >(&view),
+                                     static_cast< int >(view.count),
+                                     flags);
+            });
     }
 
     // 更新item的状态
@@ -2,6 +2,7 @@
 #define QIMPLOTSCATTERITEMNODE_H
 #include "QImPlotItemNode.h"
 #include "QImPlotDataSeries.h"
+#include <memory>
 
 namespace QIM
 {
@@ -136,7 +137,7 @@ class QIM_CORE_API QImPlotScatterItemNode : public QImPlotItemNode
      * @property QImPlotScatterItemNode::adaptiveSampling
      * @brief Enable/disable adaptive sampling for large datasets
      *
-     * @details When enabled, applies downsampling algorithms (LTTB/MinMaxLTTB)
+     * @details When enabled, applies the decimation selected by downsampleStrategy
      *          to reduce rendering load for datasets exceeding downsampleThreshold.
      *          Preserves visual characteristics while improving performance.
      *          Default value is true (adaptive sampling enabled).
@@ -147,7 +148,7 @@ class QIM_CORE_API QImPlotScatterItemNode : public QImPlotItemNode
      * @property QImPlotScatterItemNode::adaptiveSampling
      * @brief 启用/禁用大数据集的自适应采样
      *
-     * @details 启用时，对超过downsampleThreshold的数据集应用降采样算法（LTTB/MinMaxLTTB），
+     * @details 启用时，对超过downsampleThreshold的数据集应用downsampleStrategy选择的降采样算法，
      *          以减少渲染负载。在提高性能的同时保留视觉特征。
      *          默认值为true（启用自适应采样）。
      * @accessors READ isAdaptiveSampling WRITE setAdaptiveSampling NOTIFY adaptiveSamplingChanged
@@ -228,7 +229,68 @@ class QIM_CORE_API QImPlotScatterItemNode : public QImPlotItemNode
      */
     Q_PROPERTY(bool clippingEnabled READ isClippingEnabled WRITE setClippingEnabled NOTIFY scatterFlagChanged)
 
+    /**
+     * \if ENGLISH
+     * @property QImPlotScatterItemNode::downsampleStrategy
+     * @brief Decimation used for datasets exceeding downsampleThreshold
+     *
+     * @details DownsampleDensity (default) keeps one sample per screen cell of about one marker,
+     *          so the marker count is bounded by the plot area. DownsampleMinMaxLTTB treats the
+     *          points as a curve ordered by X, which only suits time-series scatter plots.
+     * @accessors READ downsampleStrategy WRITE setDownsampleStrategy
+     * \endif
+     *
+     * \if CHINESE
+     * @property QImPlotScatterItemNode::downsampleStrategy
+     * @brief 超过downsampleThreshold的数据集使用的降采样算法
+     *
+     * @details DownsampleDensity（默认）在约一个标记大小的屏幕单元内只保留一个点，标记数不超过绘图区面积决定的上限。
+     *          DownsampleMinMaxLTTB 把点视为按 X 排列的曲线，只适合时间序列散点图。
+     * @accessors READ downsampleStrategy WRITE setDownsampleStrategy
+     * \endif
+     */
+    Q_PROPERTY(DownsampleStrategy downsampleStrategy READ downsampleStrategy WRITE setDownsampleStrategy)
+
+    /**
+     * \if ENGLISH
+     * @property QImPlotScatterItemNode::densityEncoding
+     * @brief How DownsampleDensity shows the number of samples behind each marker
+     *
+     * @details DensityNone draws all markers alike. DensityAlpha and DensitySize count the samples per
+     *          cell and draw denser cells more opaque or larger, in a few logarithmic levels.
+     *          Default is DensityNone.
+     * @accessors READ densityEncoding WRITE setDensityEncoding
+     * \endif
+     *
+     * \if CHINESE
+     * @property QImPlotScatterItemNode::densityEncoding
+     * @brief DownsampleDensity 如何表现每个标记代表的点数
+     *
+     * @details DensityNone 所有标记相同。DensityAlpha 与 DensitySize 统计每个单元的点数，
+     *          按对数划分的若干等级，点越密集的单元越不透明或标记越大。默认为 DensityNone。
+     * @accessors READ densityEncoding WRITE setDensityEncoding
+     * \endif
+     */
+    Q_PROPERTY(DensityEncoding densityEncoding READ densityEncoding WRITE setDensityEncoding)
+
 public:
+    // Decimation algorithm for large datasets
+    enum DownsampleStrategy
+    {
+        DownsampleDensity = 0,  ///< 屏幕空间占用网格，每个单元保留一个点（默认）
+        DownsampleMinMaxLTTB    ///< 按 X 排列的曲线降采样，适合时间序列散点图
+    };
+    Q_ENUM(DownsampleStrategy)
+
+    // Visual encoding of the per-cell sample count of DownsampleDensity
+    enum DensityEncoding
+    {
+        DensityNone = 0,  ///< 不表现点数
+        DensityAlpha,     ///< 点数越多越不透明
+        DensitySize       ///< 点数越多标记越大
+    };
+    Q_ENUM(DensityEncoding)
+
     // Unique type identifier for QImPlotScatterItemNode
     enum
     {
@@ -253,6 +315,8 @@ public:
 
     // Sets the data series for the scatter plot
     void setData(QImAbstractXYDataSeries* series);
+    // Sets a series shared with other items, kept alive while this item uses it
+    void setSharedData(std::shared_ptr< QImAbstractXYDataSeries > series);
 
     // Sets scatter plot data from X and Y containers
     template< typename ContainerX, typename ContainerY >
@@ -264,6 +328,11 @@ public:
 
     // Gets the current data series
     QImAbstractXYDataSeries* data() const;
+    // Gets the current data series as a shared reference
+    std::shared_ptr< QImAbstractXYDataSeries > sharedData() const;
+
+    // Notifies that samples were appended to the current series
+    void notifyDataAppended(qint64 count = 1);
 
     //----------------------------------------------------
     // 样式属性访问器
@@ -299,6 +368,18 @@ public:
     // Sets the downsample threshold
     void setDownsampleThreshold(int threshold);
 
+    // Gets the decimation algorithm
+    DownsampleStrategy downsampleStrategy() const;
+
+    // Sets the decimation algorithm
+    void setDownsampleStrategy(DownsampleStrategy strategy);
+
+    // Gets the density encoding of DownsampleDensity
+    DensityEncoding densityEncoding() const;
+
+    // Sets the density encoding of DownsampleDensity
+    void setDensityEncoding(DensityEncoding encoding);
+
     // Gets the marker color
     QColor color() const;
 
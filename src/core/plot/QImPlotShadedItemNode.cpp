@@ -1,4 +1,6 @@
 #include "QImPlotShadedItemNode.h"
+#include "QImPlotDataSeriesView.h"
+#include "QImPlotColumnDecimator.h"
 #include <optional>
 #include <cmath>
 #include "implot.h"
@@ -15,10 +17,12 @@ class QImPlotShadedItemNode::PrivateData
 public:
     PrivateData(QImPlotShadedItemNode* p);
 
-    std::unique_ptr< QImAbstractXYDataSeries > data;   ///< Primary data series
-    std::unique_ptr< QImAbstractXYDataSeries > data2;  ///< Secondary data series (for two-line mode)
+    std::shared_ptr< QImAbstractXYDataSeries > data;   ///< Primary data series
+    std::shared_ptr< QImAbstractXYDataSeries > data2;  ///< Secondary data series (for two-line mode)
     ImPlotShadedFlags flags { ImPlotShadedFlags_None };
     double referenceValue { 0.0 };  ///< Reference value for single-line fill mode
+    bool isAdaptiveSampling { true };
+    QImPlotColumnDecimator decimator { QImPlotColumnDecimator::ReduceEnvelope };
     // Style tracking values
     std::optional< QImTrackedValue< ImVec4, QIM::ImVecComparator< ImVec4 > > > color;
 };
@@ -71,10 +75,27 @@ QImPlotShadedItemNode::~QImPlotShadedItemNode()
  * \endif
  */
 void QImPlotShadedItemNode::setData(QImAbstractXYDataSeries* series)
+{
+    setSharedData(std::shared_ptr< QImAbstractXYDataSeries >(series));
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set a shared data series for single-line fill mode
+ * @param series Series that may also be used by other items, kept alive while this item uses it
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置单线填充模式的共享数据系列
+ * @param series 可同时被其它绘图项使用的数据系列，本绘图项使用期间不会被释放
+ * \endif
+ */
+void QImPlotShadedItemNode::setSharedData(std::shared_ptr< QImAbstractXYDataSeries > series)
 {
     QIM_D(d);
-    d->data.reset(series);
+    d->data = std::move(series);
     d->data2.reset();  // Clear secondary data for two-line mode
+    d->decimator.invalidate();
     emit dataChanged();
 }
 
@@ -96,10 +117,30 @@ void QImPlotShadedItemNode::setData(QImAbstractXYDataSeries* series)
  * \endif
  */
 void QImPlotShadedItemNode::setData(QImAbstractXYDataSeries* series1, QImAbstractXYDataSeries* series2)
+{
+    setSharedData(std::shared_ptr< QImAbstractXYDataSeries >(series1), std::shared_ptr< QImAbstractXYDataSeries >(series2));
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set two shared data series for two-line fill mode
+ * @param series1 Primary series (lower bound)
+ * @param series2 Secondary series (upper bound), e.g. sharing its X column with series1
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置双线填充模式的两个共享数据系列
+ * @param series1 主数据系列（下边界）
+ * @param series2 辅助数据系列（上边界），例如与 series1 共享 X 数据列
+ * \endif
+ */
+void QImPlotShadedItemNode::setSharedData(std::shared_ptr< QImAbstractXYDataSeries > series1,
+                                          std::shared_ptr< QImAbstractXYDataSeries > series2)
 {
     QIM_D(d);
-    d->data.reset(series1);
-    d->data2.reset(series2);
+    d->data  = std::move(series1);
+    d->data2 = std::move(series2);
+    d->decimator.invalidate();
     emit dataChanged();
 }
 
@@ -169,6 +210,11 @@ QImAbstractXYDataSeries* QImPlotShadedItemNode::data() const
     return d_ptr->data.get();
 }
 
+std::shared_ptr< QImAbstractXYDataSeries > QImPlotShadedItemNode::sharedData() const
+{
+    return d_ptr->data;
+}
+
 /**
  * \if ENGLISH
  * @brief Get secondary data series (for two-line fill mode)
@@ -185,6 +231,11 @@ QImAbstractXYDataSeries* QImPlotShadedItemNode::data2() const
     return d_ptr->data2.get();
 }
 
+std::shared_ptr< QImAbstractXYDataSeries > QImPlotShadedItemNode::sharedData2() const
+{
+    return d_ptr->data2;
+}
+
 /**
  * \if ENGLISH
  * @brief Get reference value for single-line fill mode
@@ -321,6 +372,55 @@ bool QImPlotShadedItemNode::isTwoLineMode() const
     return d->data2 != nullptr;
 }
 
+/**
+ * \if ENGLISH
+ * @brief Enable or disable per-pixel-column decimation
+ * @param on true to decimate series larger than 20000 samples (default)
+ * @details Each column is reduced to the lower and upper bound of the filled area (between the two
+ *          lines, or between the line and the reference value), so the filled envelope is unchanged.
+ *          The result is cached by visible range and recomputed when the view or the data changes.
+ * @see QImPlotColumnDecimator
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 启用或禁用按像素列降采样
+ * @param on 为 true 时对超过 20000 个点的数据降采样（默认）
+ * @details 每列归约为填充区域（两条线之间，或线与参考值之间）的下界与上界，填充的包络不变。
+ *          结果按可见范围缓存，视图或数据变化时重新计算。
+ * @see QImPlotColumnDecimator
+ * \endif
+ */
+void QImPlotShadedItemNode::setAdaptiveSampling(bool on)
+{
+    QIM_D(d);
+    d->isAdaptiveSampling = on;
+    d->decimator.invalidate();
+}
+
+bool QImPlotShadedItemNode::isAdaptiveSampling() const
+{
+    return d_ptr->isAdaptiveSampling;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Notify the item that the current data series was appended to or modified in place
+ * @param count Number of appended samples
+ * @details The decimation cache is rebuilt before the next frame.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 通知绘图项当前数据系列追加了数据或被原地修改
+ * @param count 追加的点数
+ * @details 降采样缓存在下一帧绘制前重建。
+ * \endif
+ */
+void QImPlotShadedItemNode::notifyDataAppended(qint64 count)
+{
+    Q_UNUSED(count);
+    d_ptr->decimator.invalidate();
+}
+
 /**
  * \if ENGLISH
  * @brief Begin drawing implementation
@@ -355,9 +455,22 @@ bool QImPlotShadedItemNode::beginDraw()
     // Determine if we're in two-line mode
     bool twoLineMode = (d->data2 != nullptr && d->data2->size() > 0);
 
-    if (twoLineMode) {
+    // The envelope is taken between the two lines, or between the line and the reference value
+    d->decimator.setEnvelopeReference(twoLineMode ? d->data2.get() : nullptr, d->referenceValue);
+    if (d->isAdaptiveSampling && updateColumnDecimator(d->decimator, *d->data)) {
+        // Per-pixel-column decimation: fill between the lower and upper bound of each column
+        ImPlot::PlotShaded(labelConstData(),
+                           d->decimator.xs(),
+                           d->decimator.lowerYs(),
+                           d->decimator.upperYs(),
+                           d->decimator.count(),
+                           d->flags,
+                           0,
+                           sizeof(double));
+    } else if (twoLineMode) {
         // Two-line fill mode: fill between two lines
-        if (d->data->isContiguous() && d->data2->isContiguous()) {
+        if (d->data->isPackedDoubleData() && d->data2->isPackedDoubleData()
+            && d->data->size() <= qimPlotMaxDrawCount()) {
             // Continuous memory mode: use zero-copy fast path
             const double* xData = d->data->xRawData();
             const double* y1Data = d->data->yRawData();
@@ -394,80 +507,64 @@ bool QImPlotShadedItemNode::beginDraw()
                     sizeof(double));
             }
         } else {
-            // Non-contiguous memory mode: use callback
-            // For two-line mode with callbacks, we need to use PlotShadedG
-            struct ShadedData {
-                QImAbstractXYDataSeries* series1;
-                QImAbstractXYDataSeries* series2;
-            };
-            ShadedData shadedData{ d->data.get(), d->data2.get() };
-
-            ImPlot::PlotShadedG(
-                labelConstData(),
-                [](int idx, void* data) -> ImPlotPoint {
-                    ShadedData* sd = static_cast< ShadedData* >(data);
-                    return ImPlotPoint(sd->series1->xValue(idx), sd->series1->yValue(idx));
-                },
-                &shadedData,
-                [](int idx, void* data) -> ImPlotPoint {
-                    ShadedData* sd = static_cast< ShadedData* >(data);
-                    return ImPlotPoint(sd->series2->xValue(idx), sd->series2->yValue(idx));
-                },
-                &shadedData,
-                d->data->size(),
-                d->flags);
+            // Other element types, strides or chunked storage: typed getter for the primary series.
+            // The secondary series is read through QImPlotVirtualXYView, dispatching both series
+            // would instantiate every type combination twice over.
+            // More than INT_MAX samples are drawn in consecutive ranges.
+            const QImPlotVirtualXYView view2 { d->data2.get(), 0, d->data2->size() };
+            qimPlotVisitXYSeries(*d->data, [ & ](const auto& view) {
+                using View = std::decay_t< decltype(view) >;
+                qimPlotForEachRange(std::min(view.count, view2.count), [ & ](qint64 first, int n) {
+                    const View v1                 = view.slice(first, n);
+                    const QImPlotVirtualXYView v2 = view2.slice(first, n);
+                    ImPlot::PlotShadedG(labelConstData(),
+                                        &qimPlotViewGetter< View >,
+                                        const_cast< View* >(&v1),
+                                        &qimPlotViewGetter< QImPlotVirtualXYView >,
+                                        const_cast< QImPlotVirtualXYView* >(&v2),
+                                        n,
+                                        d->flags);
+                });
+            });
         }
     } else {
-        // Single-line fill mode: fill between data line and reference value
-        if (d->data->isContiguous()) {
-            // Continuous memory mode: use zero-copy fast path
-            const double* xData = d->data->xRawData();
-            const double* yData = d->data->yRawData();
-            int size = d->data->size();
-
-            if (xData) {
-                // XY mode with explicit X coordinates
-                ImPlot::PlotShaded(
-                    labelConstData(),
-                    xData,
-                    yData,
-                    size,
-                    d->referenceValue,
-                    d->flags,
-                    0,
-                    sizeof(double));
-            } else {
+        // Single-line fill mode: fill between data line and reference value.
+        // Calls ImPlot::PlotShaded<T> on the stored type, split into ranges beyond INT_MAX samples
+        const char* label = labelConstData();
+        const int stride  = d->data->stride();
+        qimPlotDispatchXYSeries(
+            *d->data,
+            [ & ](const auto* ys, int count, int offset, double xStart) {
                 // Y-only mode
                 ImPlot::PlotShaded(
-                    labelConstData(),
-                    yData,
-                    size,
-                    d->referenceValue,
-                    d->data->xScale(),
-                    d->data->xStart(),
-                    d->flags,
-                    0,
-                    sizeof(double));
-            }
-        } else {
-            // Non-contiguous memory mode: use callback
-            ImPlot::PlotShadedG(
-                labelConstData(),
-                [](int idx, void* data) -> ImPlotPoint {
-                    QImAbstractXYDataSeries* series = static_cast< QImAbstractXYDataSeries* >(data);
-                    return ImPlotPoint(series->xValue(idx), series->yValue(idx));
-                },
-                d->data.get(),
-                [](int idx, void* data) -> ImPlotPoint {
-                    // For single-line mode, the second getter returns the reference value
-                    QImPlotShadedItemNode::PrivateData* pd = static_cast< QImPlotShadedItemNode::PrivateData* >(data);
-                    QImAbstractXYDataSeries* series = pd->data.get();
-                    return ImPlotPoint(series->xValue(idx), pd->referenceValue);
-                },
-                d,
-                d->data->size(),
-                d->flags);
-        }
+                    label, ys, count, d->referenceValue, d->data->xScale(), xStart, d->flags, offset, stride);
+            },
+            [ & ](const auto* xs, const auto* ys, int count, int offset) {
+                // XY mode with explicit X coordinates
+                ImPlot::PlotShaded(label, xs, ys, count, d->referenceValue, d->flags, offset, stride);
+            },
+            [ & ](const auto& view) {
+                // Other element types, strides or chunked storage: typed getter built at compile time
+                using View = std::decay_t< decltype(view) >;
+                // The second getter returns the reference value at the same X
+                struct RefLine
+                {
+                    const View* view;
+                    double value;
+                };
+                RefLine ref { &view, d->referenceValue };
+                ImPlot::PlotShadedG(
+                    label,
+                    &qimPlotViewGetter< View >,
+                    const_cast< View* >(&view),
+                    [](int idx, void* data) -> ImPlotPoint {
+                        const RefLine* r = static_cast< const RefLine* >(data);
+                        return ImPlotPoint(r->view->x(idx), r->value);
+                    },
+                    &ref,
+                    static_cast< int >(view.count),
+                    d->flags);
+            });
     }
 
     // Update item status
@@ -3,6 +3,7 @@
 #include <QColor>
 #include "QImPlotItemNode.h"
 #include "QImPlotDataSeries.h"
+#include <memory>
 
 namespace QIM
 {
@@ -134,6 +135,9 @@ public:
     // Sets the data series for single-line fill mode (fill to reference value)
     void setData(QImAbstractXYDataSeries* series);
 
+    // Sets a shared series for single-line fill mode, kept alive while this item uses it
+    void setSharedData(std::shared_ptr< QImAbstractXYDataSeries > series);
+
     // Sets shaded data from X and Y containers (single-line mode)
     template< typename ContainerX, typename ContainerY >
     QImAbstractXYDataSeries* setData(const ContainerX& x, const ContainerY& y);
@@ -149,6 +153,10 @@ public:
     // Sets two data series for filling between two lines (upper and lower bounds)
     void setData(QImAbstractXYDataSeries* series1, QImAbstractXYDataSeries* series2);
 
+    // Sets two shared series for filling between two lines
+    void setSharedData(std::shared_ptr< QImAbstractXYDataSeries > series1,
+                       std::shared_ptr< QImAbstractXYDataSeries > series2);
+
     // Sets two-line fill data from X, Y1, and Y2 containers
     template< typename ContainerX, typename ContainerY1, typename ContainerY2 >
     void setData(const ContainerX& x, const ContainerY1& y1, const ContainerY2& y2);
@@ -163,6 +171,12 @@ public:
     // Gets the secondary data series (for two-line fill mode)
     QImAbstractXYDataSeries* data2() const;
 
+    // Gets the primary data series as a shared reference
+    std::shared_ptr< QImAbstractXYDataSeries > sharedData() const;
+
+    // Gets the secondary data series as a shared reference
+    std::shared_ptr< QImAbstractXYDataSeries > sharedData2() const;
+
     //----------------------------------------------------
     // Style property accessors
     //----------------------------------------------------
@@ -188,6 +202,19 @@ public:
     // Checks if two-line fill mode is active
     bool isTwoLineMode() const;
 
+    //----------------------------------------------------
+    // Downsampling
+    //----------------------------------------------------
+
+    // Enables per-pixel-column decimation of large series
+    void setAdaptiveSampling(bool on);
+
+    // Checks if adaptive sampling is enabled
+    bool isAdaptiveSampling() const;
+
+    // Notifies the item that the data series was appended to or modified in place
+    void notifyDataAppended(qint64 count = 1);
+
 Q_SIGNALS:
     /**
      * \if ENGLISH
@@ -1,4 +1,6 @@
 #include "QImPlotStairsItemNode.h"
+#include "QImPlotDataSeriesView.h"
+#include "QImPlotColumnDecimator.h"
 #include <optional>
 #include "implot.h"
 #include "implot_internal.h"
@@ -14,8 +16,10 @@ class QImPlotStairsItemNode::PrivateData
 public:
     PrivateData(QImPlotStairsItemNode* p);
 
-    std::unique_ptr< QImAbstractXYDataSeries > data;
+    std::shared_ptr< QImAbstractXYDataSeries > data;
     ImPlotStairsFlags flags { ImPlotStairsFlags_None };
+    bool isAdaptiveSampling { true };
+    QImPlotColumnDecimator decimator { QImPlotColumnDecimator::ReduceM4 };
     // 样式跟踪值
     std::optional< QImTrackedValue< ImVec4, QIM::ImVecComparator< ImVec4 > > > color;
 };
@@ -64,9 +68,26 @@ QImPlotStairsItemNode::~QImPlotStairsItemNode()
  * \endif
  */
 void QImPlotStairsItemNode::setData(QImAbstractXYDataSeries* series)
+{
+    setSharedData(std::shared_ptr< QImAbstractXYDataSeries >(series));
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set a data series that may be shared with other items or inspection tools
+ * @param series Shared series, the item keeps a reference until the next setData()/setSharedData()
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置可与其它绘图项或检查工具共享的数据系列
+ * @param series 共享的数据系列，绘图项持有其引用直到下一次 setData()/setSharedData()
+ * \endif
+ */
+void QImPlotStairsItemNode::setSharedData(std::shared_ptr< QImAbstractXYDataSeries > series)
 {
     QIM_D(d);
-    d->data.reset(series);
+    d->data = std::move(series);
+    d->decimator.invalidate();
 }
 
 /**
@@ -85,6 +106,11 @@ QImAbstractXYDataSeries* QImPlotStairsItemNode::data() const
     return d_ptr->data.get();
 }
 
+std::shared_ptr< QImAbstractXYDataSeries > QImPlotStairsItemNode::sharedData() const
+{
+    return d_ptr->data;
+}
+
 /**
  * \if ENGLISH
  * @brief Check if shaded mode is enabled
@@ -254,6 +280,55 @@ QColor QImPlotStairsItemNode::color() const
     return (d_ptr->color.has_value()) ? toQColor(d_ptr->color->value()) : QColor();
 }
 
+/**
+ * \if ENGLISH
+ * @brief Enable or disable per-pixel-column decimation
+ * @param on true to decimate series larger than 20000 samples (default)
+ * @details Each column keeps its first, lowest, highest and last sample, so every step level and the
+ *          level a column ends on are still drawn.
+ *          The result is cached by visible range and recomputed when the view or the data changes.
+ * @see QImPlotColumnDecimator
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 启用或禁用按像素列降采样
+ * @param on 为 true 时对超过 20000 个点的数据降采样（默认）
+ * @details 每列保留首点、最低点、最高点与尾点，每个阶梯电平与列末的电平仍会绘制。
+ *          结果按可见范围缓存，视图或数据变化时重新计算。
+ * @see QImPlotColumnDecimator
+ * \endif
+ */
+void QImPlotStairsItemNode::setAdaptiveSampling(bool on)
+{
+    QIM_D(d);
+    d->isAdaptiveSampling = on;
+    d->decimator.invalidate();
+}
+
+bool QImPlotStairsItemNode::isAdaptiveSampling() const
+{
+    return d_ptr->isAdaptiveSampling;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Notify the item that the current data series was appended to or modified in place
+ * @param count Number of appended samples
+ * @details The decimation cache is rebuilt before the next frame.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 通知绘图项当前数据系列追加了数据或被原地修改
+ * @param count 追加的点数
+ * @details 降采样缓存在下一帧绘制前重建。
+ * \endif
+ */
+void QImPlotStairsItemNode::notifyDataAppended(qint64 count)
+{
+    Q_UNUSED(count);
+    d_ptr->decimator.invalidate();
+}
+
 /**
  * \if ENGLISH
  * @brief Begin drawing implementation
@@ -277,32 +352,34 @@ bool QImPlotStairsItemNode::beginDraw()
         ImPlot::SetNextLineStyle(d->color->value());
     }
 
-    // 调用 ImPlot API
-    if (d->data->isContiguous()) {
-        // 连续内存模式：使用零拷贝快速路径
-        const double* xData = d->data->xRawData();
-        const double* yData = d->data->yRawData();
-        int size            = d->data->size();
-
-        if (xData) {
-            // XY模式
-            ImPlot::PlotStairs(labelConstData(), xData, yData, size, d->flags, 0, sizeof(double));
-        } else {
-            // Y-only模式
-            ImPlot::PlotStairs(
-                labelConstData(), yData, size, d->data->xStart(), d->data->xScale(), d->flags, 0, sizeof(double));
-        }
+    // 调用 ImPlot API：按存储类型直接调用 ImPlot::PlotStairs<T>，超过 INT_MAX 个点时分段调用
+    const char* label = labelConstData();
+    const int stride  = d->data->stride();
+    // 自适应坐标轴时使用缓存的数据范围，不让 ImPlot 逐点拟合
+    const ImPlotStairsFlags flags = d->flags | fitDataBounds(d->data.get());
+    if (d->isAdaptiveSampling && updateColumnDecimator(d->decimator, *d->data)) {
+        // 每个像素列保留首、最小、最大、尾四个点，每个跳变电平与列末的电平都保留
+        ImPlot::PlotStairs(label, d->decimator.xs(), d->decimator.ys(), d->decimator.count(), flags);
     } else {
-        // 非连续内存模式：使用回调
-        ImPlot::PlotStairsG(
-            labelConstData(),
-            [](int idx, void* data) -> ImPlotPoint {
-                QImAbstractXYDataSeries* series = static_cast< QImAbstractXYDataSeries* >(data);
-                return ImPlotPoint(series->xValue(idx), series->yValue(idx));
+        qimPlotDispatchXYSeries(
+            *d->data,
+            [ & ](const auto* ys, int count, int offset, double xStart) {
+                // Y-only模式
+                ImPlot::PlotStairs(label, ys, count, d->data->xScale(), xStart, flags, offset, stride);
+            },
+            [ & ](const auto* xs, const auto* ys, int count, int offset) {
+                // XY模式
+                ImPlot::PlotStairs(label, xs, ys, count, flags, offset, stride);
             },
-            d->data.get(),
-            d->data->size(),
-            d->flags);
+            [ & ](const auto& view) {
+                // 其它存储类型、步幅或分块存储（非连续内存），走编译期特化的getter
+                using View = std::decay_t< decltype(view) >;
+                ImPlot::PlotStairsG(label,
+                                    &qimPlotViewGetter< View >,
+                                    const_cast< View* >(&view),
+                                    static_cast< int >(view.count),
+                                    flags);
+            });
     }
 
     // 更新item的状态
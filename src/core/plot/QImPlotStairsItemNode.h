@@ -2,6 +2,7 @@
 #define QIMPLOTSTAIRSITEMNODE_H
 #include "QImPlotItemNode.h"
 #include "QImPlotDataSeries.h"
+#include <memory>
 
 namespace QIM
 {
@@ -70,6 +71,8 @@ public:
     //----------------------------------------------------
     // Set data series for the stairs plot
     void setData(QImAbstractXYDataSeries* series);
+    // Sets a series shared with other items, kept alive while this item uses it
+    void setSharedData(std::shared_ptr< QImAbstractXYDataSeries > series);
     // Set data from containers
     template< typename ContainerX, typename ContainerY >
     QImAbstractXYDataSeries* setData(const ContainerX& x, const ContainerY& y);
@@ -78,6 +81,8 @@ public:
     QImAbstractXYDataSeries* setData(ContainerX&& x, ContainerY&& y);
     // Get current data series
     QImAbstractXYDataSeries* data() const;
+    // Gets the current data series as a shared reference
+    std::shared_ptr< QImAbstractXYDataSeries > sharedData() const;
     //----------------------------------------------------
     // ImPlotStairsFlags
     //----------------------------------------------------
@@ -104,6 +109,16 @@ public:
     void setColor(const QColor& c);
     // Get line color
     QColor color() const;
+
+    //===============================================================
+    // 降采样
+    //===============================================================
+    // Enable per-pixel-column decimation of large series
+    void setAdaptiveSampling(bool on);
+    // Check if adaptive sampling is enabled
+    bool isAdaptiveSampling() const;
+    // Notify the item that the data series was appended to or modified in place
+    void notifyDataAppended(qint64 count = 1);
 Q_SIGNALS:
     /**
      * \if ENGLISH
@@ -1,4 +1,5 @@
 #include "QImPlotStemsItemNode.h"
+#include "QImPlotColumnDecimator.h"
 #include <optional>
 #include "implot.h"
 #include "implot_internal.h"
@@ -14,9 +15,11 @@ class QImPlotStemsItemNode::PrivateData
 public:
     PrivateData(QImPlotStemsItemNode* p);
 
-    std::unique_ptr<QImAbstractXYDataSeries> data;  ///< Data series (X, Y values)
+    std::shared_ptr<QImAbstractXYDataSeries> data;  ///< Data series (X, Y values)
     ImPlotStemsFlags flags { ImPlotStemsFlags_None };
     double referenceValue { 0.0 };  ///< Reference value (baseline)
+    bool isAdaptiveSampling { true };
+    QImPlotColumnDecimator decimator { QImPlotColumnDecimator::ReduceMinMax };
     // Style tracking values
     std::optional<QImTrackedValue<ImVec4, QIM::ImVecComparator<ImVec4>>> color;
 };
@@ -66,9 +69,26 @@ QImPlotStemsItemNode::~QImPlotStemsItemNode()
  * \endif
  */
 void QImPlotStemsItemNode::setData(QImAbstractXYDataSeries* series)
+{
+    setSharedData(std::shared_ptr< QImAbstractXYDataSeries >(series));
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set a data series that may be shared with other items or inspection tools
+ * @param series Shared series, the item keeps a reference until the next setData()/setSharedData()
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置可与其它绘图项或检查工具共享的数据系列
+ * @param series 共享的数据系列，绘图项持有其引用直到下一次 setData()/setSharedData()
+ * \endif
+ */
+void QImPlotStemsItemNode::setSharedData(std::shared_ptr< QImAbstractXYDataSeries > series)
 {
     QIM_D(d);
-    d->data.reset(series);
+    d->data = std::move(series);
+    d->decimator.invalidate();
     emit dataChanged();
 }
 
@@ -88,6 +108,11 @@ QImAbstractXYDataSeries* QImPlotStemsItemNode::data() const
     return d_ptr->data.get();
 }
 
+std::shared_ptr< QImAbstractXYDataSeries > QImPlotStemsItemNode::sharedData() const
+{
+    return d_ptr->data;
+}
+
 /**
  * \if ENGLISH
  * @brief Get reference value (baseline)
@@ -238,6 +263,55 @@ void QImPlotStemsItemNode::setStemsFlags(int flags)
     }
 }
 
+/**
+ * \if ENGLISH
+ * @brief Enable or disable per-pixel-column decimation
+ * @param on true to decimate series larger than 20000 samples (default)
+ * @details Each column keeps its lowest and highest sample, the stems of a column cover the same span
+ *          from the baseline. Horizontal stems are not decimated.
+ *          The result is cached by visible range and recomputed when the view or the data changes.
+ * @see QImPlotColumnDecimator
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 启用或禁用按像素列降采样
+ * @param on 为 true 时对超过 20000 个点的数据降采样（默认）
+ * @details 每列保留最低点与最高点，从基线出发的茎叶覆盖相同的范围。水平方向的茎叶图不降采样。
+ *          结果按可见范围缓存，视图或数据变化时重新计算。
+ * @see QImPlotColumnDecimator
+ * \endif
+ */
+void QImPlotStemsItemNode::setAdaptiveSampling(bool on)
+{
+    QIM_D(d);
+    d->isAdaptiveSampling = on;
+    d->decimator.invalidate();
+}
+
+bool QImPlotStemsItemNode::isAdaptiveSampling() const
+{
+    return d_ptr->isAdaptiveSampling;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Notify the item that the current data series was appended to or modified in place
+ * @param count Number of appended samples
+ * @details The decimation cache is rebuilt before the next frame.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 通知绘图项当前数据系列追加了数据或被原地修改
+ * @param count 追加的点数
+ * @details 降采样缓存在下一帧绘制前重建。
+ * \endif
+ */
+void QImPlotStemsItemNode::notifyDataAppended(qint64 count)
+{
+    Q_UNUSED(count);
+    d_ptr->decimator.invalidate();
+}
+
 /**
  * \if ENGLISH
  * @brief Begin drawing implementation
@@ -264,11 +338,26 @@ bool QImPlotStemsItemNode::beginDraw()
     }
 
     // Call ImPlot API
-    if (d->data->isContiguous()) {
+    // One stem per sample, ImPlot takes an int count: draw at most INT_MAX samples
+    const int count = static_cast< int >(std::min(d->data->size(), qimPlotMaxDrawCount()));
+    // Columns run along X, horizontal stems would need columns along Y
+    const bool horizontal = (d->flags & ImPlotStemsFlags_Horizontal) != 0;
+    if (d->isAdaptiveSampling && !horizontal && updateColumnDecimator(d->decimator, *d->data)) {
+        // Per-pixel-column decimation: the lowest and highest stem of each column
+        ImPlot::PlotStems(
+            labelConstData(),
+            d->decimator.xs(),
+            d->decimator.ys(),
+            d->decimator.count(),
+            d->referenceValue,
+            d->flags,
+            0,
+            sizeof(double));
+    } else if (d->data->isPackedDoubleData()) {
         // Continuous memory mode: use zero-copy fast path
         const double* xData = d->data->xRawData();
         const double* yData = d->data->yRawData();
-        int size = d->data->size();
+        const int size = count;
 
         if (xData) {
             // XY mode with explicit X coordinates
@@ -297,7 +386,7 @@ bool QImPlotStemsItemNode::beginDraw()
     } else {
         // Non-contiguous memory mode: use callback
         // Note: ImPlot doesn't have PlotStemsG, so we need to copy data
-        int size = d->data->size();
+        const int size = count;
         std::vector<double> xValues(size);
         std::vector<double> yValues(size);
         for (int i = 0; i < size; ++i) {
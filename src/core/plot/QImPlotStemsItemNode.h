@@ -3,6 +3,7 @@
 #include <QColor>
 #include "QImPlotItemNode.h"
 #include "QImPlotDataSeries.h"
+#include <memory>
 
 namespace QIM
 {
@@ -148,6 +149,8 @@ public:
 
     // Sets the data series for stems
     void setData(QImAbstractXYDataSeries* series);
+    // Sets a series shared with other items, kept alive while this item uses it
+    void setSharedData(std::shared_ptr< QImAbstractXYDataSeries > series);
 
     // Sets stems data from X and Y containers
     template< typename ContainerX, typename ContainerY >
@@ -159,6 +162,8 @@ public:
 
     // Gets the data series
     QImAbstractXYDataSeries* data() const;
+    // Gets the current data series as a shared reference
+    std::shared_ptr< QImAbstractXYDataSeries > sharedData() const;
 
     //----------------------------------------------------
     // Style property accessors
@@ -188,6 +193,19 @@ public:
     // Sets the raw ImPlotStemsFlags
     void setStemsFlags(int flags);
 
+    //----------------------------------------------------
+    // Downsampling
+    //----------------------------------------------------
+
+    // Enables per-pixel-column decimation of large series
+    void setAdaptiveSampling(bool on);
+
+    // Checks if adaptive sampling is enabled
+    bool isAdaptiveSampling() const;
+
+    // Notifies the item that the data series was appended to or modified in place
+    void notifyDataAppended(qint64 count = 1);
+
 Q_SIGNALS:
     /**
      * \if ENGLISH
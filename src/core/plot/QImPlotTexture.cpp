@@ -0,0 +1,205 @@
+#include "QImPlotTexture.h"
+#include <QHash>
+#include <QMutex>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <vector>
+
+namespace QIM
+{
+
+namespace
+{
+// 销毁时所属上下文不是当前上下文的纹理，等该上下文下一次上传时删除
+QMutex g_pendingMutex;
+QHash< QOpenGLContext*, std::vector< unsigned int > > g_pendingDeletes;
+
+void deleteLater(QOpenGLContext* context, unsigned int id)
+{
+    QMutexLocker locker(&g_pendingMutex);
+    auto it = g_pendingDeletes.find(context);
+    if (it == g_pendingDeletes.end()) {
+        it = g_pendingDeletes.insert(context, {});
+        // 上下文销毁时纹理随之释放，丢弃记录，避免新上下文复用同一地址时误删
+        QObject::connect(context, &QOpenGLContext::aboutToBeDestroyed, context, [ context ]() {
+            QMutexLocker locker(&g_pendingMutex);
+            g_pendingDeletes.remove(context);
+        });
+    }
+    it.value().push_back(id);
+}
+
+void deletePending(QOpenGLContext* context)
+{
+    std::vector< unsigned int > ids;
+    {
+        QMutexLocker locker(&g_pendingMutex);
+        auto it = g_pendingDeletes.find(context);
+        if (it == g_pendingDeletes.end() || it.value().empty()) {
+            return;
+        }
+        ids.swap(it.value());
+    }
+    context->functions()->glDeleteTextures(static_cast< GLsizei >(ids.size()), ids.data());
+}
+
+// 上传期间保存并恢复纹理绑定与像素对齐，不影响 ImGui 渲染器的状态
+class UploadStateGuard
+{
+public:
+    explicit UploadStateGuard(QOpenGLFunctions* gl) : m_gl(gl)
+    {
+        m_gl->glGetIntegerv(GL_TEXTURE_BINDING_2D, &m_lastTexture);
+        m_gl->glGetIntegerv(GL_UNPACK_ALIGNMENT, &m_lastAlignment);
+        m_gl->glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+    ~UploadStateGuard()
+    {
+        m_gl->glPixelStorei(GL_UNPACK_ALIGNMENT, m_lastAlignment);
+        m_gl->glBindTexture(GL_TEXTURE_2D, static_cast< GLuint >(m_lastTexture));
+    }
+
+private:
+    QOpenGLFunctions* m_gl;
+    GLint m_lastTexture { 0 };
+    GLint m_lastAlignment { 4 };
+};
+}  // namespace
+
+QImPlotTexture::QImPlotTexture()
+{
+}
+
+QImPlotTexture::~QImPlotTexture()
+{
+    release();
+}
+
+bool QImPlotTexture::upload(int width, int height, const quint32* rgba)
+{
+    QOpenGLContext* context = QOpenGLContext::currentContext();
+    if (!context || width <= 0 || height <= 0 || !rgba) {
+        return false;
+    }
+    if (width > maximumSize() || height > maximumSize()) {
+        return false;
+    }
+    if (m_context != context) {
+        // 绘图项换到了另一个上下文，旧纹理交给旧上下文延迟删除
+        release();
+    }
+    deletePending(context);
+
+    QOpenGLFunctions* gl = context->functions();
+    UploadStateGuard guard(gl);
+    if (m_id == 0) {
+        gl->glGenTextures(1, &m_id);
+        m_context           = context;
+        m_contextConnection = QObject::connect(
+            context, &QOpenGLContext::aboutToBeDestroyed, [ this ]() { contextDestroyed(); });
+        m_width       = 0;
+        m_height      = 0;
+        m_filterDirty = true;
+    }
+    gl->glBindTexture(GL_TEXTURE_2D, m_id);
+    if (m_filterDirty) {
+        const GLint filter = m_smooth ? GL_LINEAR : GL_NEAREST;
+        gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+        gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+        gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        gl->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        m_filterDirty = false;
+    }
+    if (width == m_width && height == m_height) {
+        gl->glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+    } else {
+        gl->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+        m_width  = width;
+        m_height = height;
+    }
+    return true;
+}
+
+bool QImPlotTexture::uploadRows(int firstRow, int rowCount, const quint32* rgba)
+{
+    if (!isValid() || !rgba || firstRow < 0 || rowCount <= 0 || firstRow + rowCount > m_height) {
+        return false;
+    }
+    QOpenGLFunctions* gl = m_context->functions();
+    UploadStateGuard guard(gl);
+    gl->glBindTexture(GL_TEXTURE_2D, m_id);
+    gl->glTexSubImage2D(GL_TEXTURE_2D, 0, 0, firstRow, m_width, rowCount, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+    return true;
+}
+
+bool QImPlotTexture::isValid() const
+{
+    return m_id != 0 && m_context == QOpenGLContext::currentContext();
+}
+
+quintptr QImPlotTexture::textureId() const
+{
+    return m_id;
+}
+
+int QImPlotTexture::width() const
+{
+    return m_width;
+}
+
+int QImPlotTexture::height() const
+{
+    return m_height;
+}
+
+void QImPlotTexture::setSmooth(bool on)
+{
+    if (m_smooth != on) {
+        m_smooth      = on;
+        m_filterDirty = true;
+    }
+}
+
+bool QImPlotTexture::isSmooth() const
+{
+    return m_smooth;
+}
+
+void QImPlotTexture::release()
+{
+    if (m_id != 0 && m_context) {
+        if (m_context == QOpenGLContext::currentContext()) {
+            m_context->functions()->glDeleteTextures(1, &m_id);
+        } else {
+            deleteLater(m_context, m_id);
+        }
+    }
+    QObject::disconnect(m_contextConnection);
+    m_context = nullptr;
+    m_id      = 0;
+    m_width   = 0;
+    m_height  = 0;
+}
+
+int QImPlotTexture::maximumSize()
+{
+    QOpenGLContext* context = QOpenGLContext::currentContext();
+    if (!context) {
+        return 0;
+    }
+    GLint size = 0;
+    context->functions()->glGetIntegerv(GL_MAX_TEXTURE_SIZE, &size);
+    return size;
+}
+
+void QImPlotTexture::contextDestroyed()
+{
+    // 上下文销毁时其纹理随之释放，只需丢弃句柄
+    QObject::disconnect(m_contextConnection);
+    m_context = nullptr;
+    m_id      = 0;
+    m_width   = 0;
+    m_height  = 0;
+}
+
+}  // namespace QIM
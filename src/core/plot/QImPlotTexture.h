@@ -0,0 +1,87 @@
+#ifndef QIMPLOTTEXTURE_H
+#define QIMPLOTTEXTURE_H
+
+#include "QImAPI.h"
+#include <QMetaObject>
+#include <QtGlobal>
+
+class QOpenGLContext;
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief OpenGL texture owned by a plot item, drawn through ImPlot::PlotImage()
+ *
+ * @class QImPlotTexture
+ *
+ * @details Wraps one RGBA8 texture of the OpenGL context that renders the plot. upload() must be called
+ *          while that context is current, i.e. from QImAbstractNode::beginDraw(); the texture is
+ *          (re)created on the first upload, when the size changes or when the item moves to another
+ *          context. uploadRows() replaces a band of rows in place, e.g. the new rows of a ring buffer.
+ *          textureId() is the value ImGui's OpenGL renderer binds for ImTextureID.
+ *
+ *          A texture destroyed while its context is not current is deleted the next time any texture
+ *          uploads in that context. Textures of a destroyed context become invalid and are recreated
+ *          by the next upload().
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 绘图项持有的 OpenGL 纹理，通过 ImPlot::PlotImage() 绘制
+ *
+ * @class QImPlotTexture
+ *
+ * @details 封装渲染绘图的 OpenGL 上下文中的一个 RGBA8 纹理。upload() 必须在该上下文为当前上下文时调用，
+ *          即在 QImAbstractNode::beginDraw() 中调用；首次上传、尺寸变化或绘图项换到其他上下文时创建纹理。
+ *          uploadRows() 原地替换若干行，例如环形缓冲中新写入的行。
+ *          textureId() 即 ImGui 的 OpenGL 渲染器作为 ImTextureID 绑定的值。
+ *
+ *          上下文不是当前上下文时销毁的纹理，在该上下文中下一次上传任意纹理时删除。
+ *          上下文销毁后纹理失效，下一次 upload() 重新创建。
+ * \endif
+ */
+class QIM_CORE_API QImPlotTexture
+{
+public:
+    QImPlotTexture();
+    ~QImPlotTexture();
+    QImPlotTexture(const QImPlotTexture&)            = delete;
+    QImPlotTexture& operator=(const QImPlotTexture&) = delete;
+
+    // 上传 width x height 的 RGBA8 图像（行主序，第 0 行显示在上方），尺寸不变时只更新内容。
+    // 没有当前 OpenGL 上下文或尺寸超过 maximumSize() 时返回 false
+    bool upload(int width, int height, const quint32* rgba);
+    // 只更新 [firstRow, firstRow + rowCount) 行，rgba 为这些行的 width() * rowCount 个像素。
+    // 纹理必须已在当前上下文中上传过，否则返回 false
+    bool uploadRows(int firstRow, int rowCount, const quint32* rgba);
+    // 纹理存在且属于当前 OpenGL 上下文
+    bool isValid() const;
+    quintptr textureId() const;
+    int width() const;
+    int height() const;
+    // 放大时线性插值，默认 false（最近邻，单元格边界清晰），下一次 upload() 时生效
+    void setSmooth(bool on);
+    bool isSmooth() const;
+    // 释放纹理
+    void release();
+
+    // 当前 OpenGL 上下文支持的最大纹理边长，没有当前上下文时返回 0
+    static int maximumSize();
+
+private:
+    void contextDestroyed();
+
+private:
+    QOpenGLContext* m_context { nullptr };
+    QMetaObject::Connection m_contextConnection;
+    unsigned int m_id { 0 };
+    int m_width { 0 };
+    int m_height { 0 };
+    bool m_smooth { false };
+    bool m_filterDirty { false };
+};
+
+}  // namespace QIM
+
+#endif  // QIMPLOTTEXTURE_H
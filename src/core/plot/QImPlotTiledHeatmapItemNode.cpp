@@ -0,0 +1,776 @@
+#include "QImPlotTiledHeatmapItemNode.h"
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <memory>
+#include <vector>
+#include <QHash>
+#include "implot.h"
+#include "implot_internal.h"
+#include "QImHeatmapPyramid.h"
+#include "QImPlotParallel.h"
+#include "QImPlotTexture.h"
+
+namespace QIM
+{
+
+namespace
+{
+// 瓦片边长（单元格）
+constexpr int kTileSize = 256;
+// 一个完整瓦片的纹理字节数
+constexpr qint64 kTileBytes = static_cast< qint64 >(kTileSize) * kTileSize * 4;
+// 默认显存预算
+constexpr qint64 kDefaultTextureBudget = 256ll * 1024 * 1024;
+// 每帧最多上传的瓦片数，其余瓦片留到下一帧，避免缩放时卡顿
+constexpr int kMaxUploadsPerFrame = 8;
+// 每个任务至少着色的单元格数
+constexpr qint64 kParallelGrainCells = 1 << 16;
+
+quint64 tileKey(int level, int tileRow, int tileCol)
+{
+    return (static_cast< quint64 >(level) << 56) | (static_cast< quint64 >(tileRow) << 28)
+           | static_cast< quint64 >(tileCol);
+}
+
+// 第 0 层的单元格矩形 [col0, col1) x [row0, row1)
+struct CellRect
+{
+    qint64 col0 { 0 };
+    qint64 col1 { 0 };
+    qint64 row0 { 0 };
+    qint64 row1 { 0 };
+
+    bool isEmpty() const
+    {
+        return col1 <= col0 || row1 <= row0;
+    }
+};
+
+// 某层中与 CellRect 相交的瓦片 [col0, col1) x [row0, row1)
+struct TileRange
+{
+    int col0 { 0 };
+    int col1 { 0 };
+    int row0 { 0 };
+    int row1 { 0 };
+
+    qint64 count() const
+    {
+        return static_cast< qint64 >(std::max(col1 - col0, 0)) * std::max(row1 - row0, 0);
+    }
+};
+
+TileRange tilesAt(int level, const CellRect& cells)
+{
+    TileRange range;
+    if (cells.isEmpty()) {
+        return range;
+    }
+    const qint64 cellSpan = qint64(1) << level;
+    const qint64 tileSpan = cellSpan * kTileSize;
+    range.col0            = static_cast< int >(cells.col0 / tileSpan);
+    range.col1            = static_cast< int >((cells.col1 + tileSpan - 1) / tileSpan);
+    range.row0            = static_cast< int >(cells.row0 / tileSpan);
+    range.row1            = static_cast< int >((cells.row1 + tileSpan - 1) / tileSpan);
+    return range;
+}
+}  // namespace
+
+class QImPlotTiledHeatmapItemNode::PrivateData
+{
+    QIM_DECLARE_PUBLIC(QImPlotTiledHeatmapItemNode)
+public:
+    // 缓存中的一个瓦片纹理
+    struct Tile
+    {
+        quint64 key { 0 };
+        int level { 0 };
+        int row { 0 };  ///< 该层中的单元格起始行
+        int col { 0 };  ///< 该层中的单元格起始列
+        std::unique_ptr< QImPlotTexture > texture;
+        qint64 bytes { 0 };
+        quint64 lastFrame { 0 };
+    };
+
+    PrivateData(QImPlotTiledHeatmapItemNode* p);
+    // 丢弃全部瓦片纹理
+    void clearTiles();
+    // 查找瓦片并标记为本帧使用，不在缓存中时返回 nullptr
+    Tile* touchTile(int level, int tileRow, int tileCol);
+    // 淘汰本帧未使用的最久未用瓦片，直到再放入 bytes 字节不超过预算
+    void makeRoom(qint64 bytes);
+    // 着色并上传瓦片，成功时放入缓存并返回
+    Tile* uploadTile(int level, int tileRow, int tileCol);
+    // 颜色缩放范围
+    void colorRange(double& lo, double& hi);
+    // 以 tile 的纹理绘制第 0 层的单元格矩形 cells
+    void drawCells(ImDrawList& drawList, const Tile& tile, const CellRect& cells) const;
+
+    std::unique_ptr< QImAbstractHeatmapDataSeries > data;
+    QImHeatmapPyramid pyramid;
+    double scaleMin { 0.0 };
+    double scaleMax { 0.0 };
+    QPointF boundsMin { 0.0, 0.0 };
+    QPointF boundsMax { 1.0, 1.0 };
+    qint64 textureBudget { kDefaultTextureBudget };
+    // LRU 缓存，表头为最近使用
+    std::list< Tile > tiles;
+    QHash< quint64, std::list< Tile >::iterator > tileIndex;
+    qint64 cachedBytes { 0 };
+    ImPlotColormap colormap { -1 };
+    quint64 frame { 0 };
+    int currentLevel { 0 };
+    qint64 uploadedTiles { 0 };
+    // 着色缓冲，跨瓦片复用
+    std::vector< double > cells;
+    std::vector< quint32 > pixels;
+};
+
+QImPlotTiledHeatmapItemNode::PrivateData::PrivateData(QImPlotTiledHeatmapItemNode* p) : q_ptr(p)
+{
+}
+
+void QImPlotTiledHeatmapItemNode::PrivateData::clearTiles()
+{
+    tiles.clear();
+    tileIndex.clear();
+    cachedBytes = 0;
+}
+
+QImPlotTiledHeatmapItemNode::PrivateData::Tile*
+QImPlotTiledHeatmapItemNode::PrivateData::touchTile(int level, int tileRow, int tileCol)
+{
+    auto it = tileIndex.constFind(tileKey(level, tileRow, tileCol));
+    if (it == tileIndex.constEnd()) {
+        return nullptr;
+    }
+    auto tile = it.value();
+    if (!tile->texture->isValid()) {
+        // 上下文已销毁或切换，纹理需要重新上传
+        cachedBytes -= tile->bytes;
+        tileIndex.remove(tile->key);
+        tiles.erase(tile);
+        return nullptr;
+    }
+    tile->lastFrame = frame;
+    tiles.splice(tiles.begin(), tiles, tile);
+    return &*tile;
+}
+
+void QImPlotTiledHeatmapItemNode::PrivateData::makeRoom(qint64 bytes)
+{
+    while (!tiles.empty() && cachedBytes + bytes > textureBudget && tiles.back().lastFrame != frame) {
+        const Tile& tile = tiles.back();
+        cachedBytes -= tile.bytes;
+        tileIndex.remove(tile.key);
+        tiles.pop_back();
+    }
+}
+
+void QImPlotTiledHeatmapItemNode::PrivateData::colorRange(double& lo, double& hi)
+{
+    lo = scaleMin;
+    hi = scaleMax;
+    if (lo == 0 && hi == 0) {
+        pyramid.valueRange(lo, hi);
+    }
+}
+
+/**
+ * @brief 与 ImPlot::PlotHeatmap 相同的颜色映射，按行并行着色后上传，NaN 单元格透明
+ */
+QImPlotTiledHeatmapItemNode::PrivateData::Tile*
+QImPlotTiledHeatmapItemNode::PrivateData::uploadTile(int level, int tileRow, int tileCol)
+{
+    const int row    = tileRow * kTileSize;
+    const int col    = tileCol * kTileSize;
+    const int height = std::min(kTileSize, pyramid.rows(level) - row);
+    const int width  = std::min(kTileSize, pyramid.cols(level) - col);
+    if (height <= 0 || width <= 0) {
+        return nullptr;
+    }
+    const qint64 count = static_cast< qint64 >(width) * height;
+    cells.resize(static_cast< std::size_t >(count));
+    pixels.resize(static_cast< std::size_t >(count));
+    pyramid.read(level, row, col, height, width, cells.data());
+
+    double lo = 0.0;
+    double hi = 0.0;
+    colorRange(lo, hi);
+    const ImPlotColormapData& maps = ImPlot::GetCurrentContext()->ColormapData;
+    const ImU32 flat               = maps.GetKeyColor(colormap, 0);
+    const double range             = hi - lo;
+    qimPlotParallelFor(height, std::max< qint64 >(1, kParallelGrainCells / width), [ & ](qint64 begin, qint64 end) {
+        for (qint64 r = begin; r < end; ++r) {
+            const double* in = &cells[ static_cast< std::size_t >(r * width) ];
+            quint32* out     = &pixels[ static_cast< std::size_t >(r * width) ];
+            for (int c = 0; c < width; ++c) {
+                const double v = in[ c ];
+                if (std::isnan(v)) {
+                    out[ c ] = 0;
+                } else if (range == 0) {
+                    // ImPlot 此时以颜色映射的第一个颜色填充
+                    out[ c ] = flat;
+                } else {
+                    out[ c ] = maps.LerpTable(colormap, ImClamp(static_cast< float >((v - lo) / range), 0.0f, 1.0f));
+                }
+            }
+        }
+    });
+
+    makeRoom(count * 4);
+    Tile tile;
+    tile.key       = tileKey(level, tileRow, tileCol);
+    tile.level     = level;
+    tile.row       = row;
+    tile.col       = col;
+    tile.texture   = std::make_unique< QImPlotTexture >();
+    tile.bytes     = count * 4;
+    tile.lastFrame = frame;
+    if (!tile.texture->upload(width, height, pixels.data())) {
+        return nullptr;
+    }
+    tiles.push_front(std::move(tile));
+    tileIndex.insert(tiles.front().key, tiles.begin());
+    cachedBytes += count * 4;
+    ++uploadedTiles;
+    return &tiles.front();
+}
+
+void QImPlotTiledHeatmapItemNode::PrivateData::drawCells(ImDrawList& drawList,
+                                                         const Tile& tile,
+                                                         const CellRect& cells) const
+{
+    const double rows0 = data->rows();
+    const double cols0 = data->cols();
+    const double x0    = boundsMin.x() + (boundsMax.x() - boundsMin.x()) * (cells.col0 / cols0);
+    const double x1    = boundsMin.x() + (boundsMax.x() - boundsMin.x()) * (cells.col1 / cols0);
+    // 第 0 行在上方
+    const double y0 = boundsMax.y() - (boundsMax.y() - boundsMin.y()) * (cells.row0 / rows0);
+    const double y1 = boundsMax.y() - (boundsMax.y() - boundsMin.y()) * (cells.row1 / rows0);
+    // 纹理坐标：第 0 层单元格 c 位于该层第 c / 2^level 个单元格
+    const double span = std::ldexp(1.0, tile.level);
+    const double w    = tile.texture->width();
+    const double h    = tile.texture->height();
+    const ImVec2 uv0(static_cast< float >((cells.col0 / span - tile.col) / w),
+                     static_cast< float >((cells.row0 / span - tile.row) / h));
+    const ImVec2 uv1(static_cast< float >((cells.col1 / span - tile.col) / w),
+                     static_cast< float >((cells.row1 / span - tile.row) / h));
+    drawList.AddImage((ImTextureID)tile.texture->textureId(),
+                      ImPlot::PlotToPixels(x0, y0, IMPLOT_AUTO, IMPLOT_AUTO),
+                      ImPlot::PlotToPixels(x1, y1, IMPLOT_AUTO, IMPLOT_AUTO),
+                      uv0,
+                      uv1,
+                      IM_COL32_WHITE);
+}
+
+/**
+ * \if ENGLISH
+ * @brief Constructor for QImPlotTiledHeatmapItemNode
+ * @param parent Parent QObject
+ * \endif
+ *
+ * \if CHINESE
+ * @brief QImPlotTiledHeatmapItemNode的构造函数
+ * @param parent 父QObject
+ * \endif
+ */
+QImPlotTiledHeatmapItemNode::QImPlotTiledHeatmapItemNode(QObject* parent)
+    : QImPlotItemNode(parent), QIM_PIMPL_CONSTRUCT
+{
+}
+
+/**
+ * \if ENGLISH
+ * @brief Destructor for QImPlotTiledHeatmapItemNode
+ * \endif
+ *
+ * \if CHINESE
+ * @brief QImPlotTiledHeatmapItemNode的析构函数
+ * \endif
+ */
+QImPlotTiledHeatmapItemNode::~QImPlotTiledHeatmapItemNode()
+{
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set data series for the heatmap
+ * @param series Pointer to QImAbstractHeatmapDataSeries, the item takes ownership
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置热力图的数据系列
+ * @param series QImAbstractHeatmapDataSeries指针，绘图项持有其所有权
+ * \endif
+ */
+void QImPlotTiledHeatmapItemNode::setData(QImAbstractHeatmapDataSeries* series)
+{
+    QIM_D(d);
+    d->pyramid.setSource(series);
+    d->data.reset(series);
+    d->clearTiles();
+    d->uploadedTiles = 0;
+    emit dataChanged();
+}
+
+/**
+ * \if ENGLISH
+ * @brief Get current data series
+ * @return Pointer to QImAbstractHeatmapDataSeries
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 获取当前数据系列
+ * @return QImAbstractHeatmapDataSeries指针
+ * \endif
+ */
+QImAbstractHeatmapDataSeries* QImPlotTiledHeatmapItemNode::data() const
+{
+    return d_ptr->data.get();
+}
+
+/**
+ * \if ENGLISH
+ * @brief Notifies that the values of the data series were modified in place
+ * @details The pyramid and the tiles are rebuilt before the next frame. Not needed after setData().
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 通知数据系列的值被原地修改
+ * @details 下一帧绘制前重建金字塔与瓦片。setData() 之后无需调用。
+ * \endif
+ */
+void QImPlotTiledHeatmapItemNode::notifyDataChanged()
+{
+    QIM_D(d);
+    d->pyramid.invalidate();
+    d->clearTiles();
+    requestRender();
+}
+
+/**
+ * \if ENGLISH
+ * @brief Get minimum scale value
+ * @return Current scale minimum
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 获取最小缩放值
+ * @return 当前缩放最小值
+ * \endif
+ */
+double QImPlotTiledHeatmapItemNode::scaleMin() const
+{
+    QIM_DC(d);
+    return d->scaleMin;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set minimum scale value, the tiles are colormapped again
+ * @param min New scale minimum
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置最小缩放值，瓦片重新着色
+ * @param min 新缩放最小值
+ * \endif
+ */
+void QImPlotTiledHeatmapItemNode::setScaleMin(double min)
+{
+    QIM_D(d);
+    if (d->scaleMin != min) {
+        d->scaleMin = min;
+        d->clearTiles();
+        emit scaleMinChanged(min);
+    }
+}
+
+/**
+ * \if ENGLISH
+ * @brief Get maximum scale value
+ * @return Current scale maximum
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 获取最大缩放值
+ * @return 当前缩放最大值
+ * \endif
+ */
+double QImPlotTiledHeatmapItemNode::scaleMax() const
+{
+    QIM_DC(d);
+    return d->scaleMax;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set maximum scale value, the tiles are colormapped again
+ * @param max New scale maximum
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置最大缩放值，瓦片重新着色
+ * @param max 新缩放最大值
+ * \endif
+ */
+void QImPlotTiledHeatmapItemNode::setScaleMax(double max)
+{
+    QIM_D(d);
+    if (d->scaleMax != max) {
+        d->scaleMax = max;
+        d->clearTiles();
+        emit scaleMaxChanged(max);
+    }
+}
+
+/**
+ * \if ENGLISH
+ * @brief Get lower-left bounds
+ * @return Current lower-left bounds
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 获取左下角边界
+ * @return 当前左下角边界
+ * \endif
+ */
+QPointF QImPlotTiledHeatmapItemNode::boundsMin() const
+{
+    QIM_DC(d);
+    return d->boundsMin;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set lower-left bounds
+ * @param min New lower-left bounds
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置左下角边界
+ * @param min 新左下角边界
+ * \endif
+ */
+void QImPlotTiledHeatmapItemNode::setBoundsMin(const QPointF& min)
+{
+    QIM_D(d);
+    if (d->boundsMin != min) {
+        d->boundsMin = min;
+        emit boundsMinChanged(min);
+    }
+}
+
+/**
+ * \if ENGLISH
+ * @brief Get upper-right bounds
+ * @return Current upper-right bounds
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 获取右上角边界
+ * @return 当前右上角边界
+ * \endif
+ */
+QPointF QImPlotTiledHeatmapItemNode::boundsMax() const
+{
+    QIM_DC(d);
+    return d->boundsMax;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set upper-right bounds
+ * @param max New upper-right bounds
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置右上角边界
+ * @param max 新右上角边界
+ * \endif
+ */
+void QImPlotTiledHeatmapItemNode::setBoundsMax(const QPointF& max)
+{
+    QIM_D(d);
+    if (d->boundsMax != max) {
+        d->boundsMax = max;
+        emit boundsMaxChanged(max);
+    }
+}
+
+/**
+ * \if ENGLISH
+ * @brief Get the reduction of the mip levels
+ * @return Current reduction
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 获取 mip 层的归约方式
+ * @return 当前归约方式
+ * \endif
+ */
+QImPlotTiledHeatmapItemNode::Reduction QImPlotTiledHeatmapItemNode::reduction() const
+{
+    QIM_DC(d);
+    return static_cast< Reduction >(d->pyramid.reduction());
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set the reduction of the mip levels, the pyramid and the tiles are rebuilt
+ * @param reduction ReduceMax (default) or ReduceMean
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置 mip 层的归约方式，重建金字塔与瓦片
+ * @param reduction ReduceMax（默认）或 ReduceMean
+ * \endif
+ */
+void QImPlotTiledHeatmapItemNode::setReduction(Reduction reduction)
+{
+    QIM_D(d);
+    if (reduction != this->reduction()) {
+        d->pyramid.setReduction(static_cast< QImHeatmapPyramid::Reduction >(reduction));
+        d->clearTiles();
+        emit reductionChanged(reduction);
+    }
+}
+
+/**
+ * \if ENGLISH
+ * @brief Get the video memory budget of the tile textures
+ * @return Budget in bytes
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 获取瓦片纹理的显存预算
+ * @return 预算字节数
+ * \endif
+ */
+qint64 QImPlotTiledHeatmapItemNode::textureBudget() const
+{
+    QIM_DC(d);
+    return d->textureBudget;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set the video memory budget of the tile textures
+ * @param bytes Budget in bytes, at least one tile (256 KiB)
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置瓦片纹理的显存预算
+ * @param bytes 预算字节数，至少为一个瓦片（256 KiB）
+ * \endif
+ */
+void QImPlotTiledHeatmapItemNode::setTextureBudget(qint64 bytes)
+{
+    QIM_D(d);
+    bytes = std::max(bytes, kTileBytes);
+    if (d->textureBudget != bytes) {
+        d->textureBudget = bytes;
+        emit textureBudgetChanged(bytes);
+    }
+}
+
+/**
+ * \if ENGLISH
+ * @brief Pyramid level drawn by the last frame
+ * @return 0 when the original cells were drawn, k when one texel covered 2^k x 2^k cells
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 上一帧绘制的金字塔层
+ * @return 绘制原始单元格时为 0，一个纹素覆盖 2^k x 2^k 个单元格时为 k
+ * \endif
+ */
+int QImPlotTiledHeatmapItemNode::currentLevel() const
+{
+    QIM_DC(d);
+    return d->currentLevel;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Number of tile textures in the cache
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 缓存中的瓦片纹理数
+ * \endif
+ */
+int QImPlotTiledHeatmapItemNode::cachedTileCount() const
+{
+    QIM_DC(d);
+    return static_cast< int >(d->tiles.size());
+}
+
+/**
+ * \if ENGLISH
+ * @brief Bytes of the tile textures in the cache, never above textureBudget() except for the tiles of one frame
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 缓存中瓦片纹理的字节数，除单帧所需的瓦片外不超过 textureBudget()
+ * \endif
+ */
+qint64 QImPlotTiledHeatmapItemNode::cachedTextureBytes() const
+{
+    QIM_DC(d);
+    return d->cachedBytes;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Number of tiles uploaded since the data was set, useful to check the cache hit rate
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置数据以来上传的瓦片数，可用于检查缓存命中率
+ * \endif
+ */
+qint64 QImPlotTiledHeatmapItemNode::uploadedTileCount() const
+{
+    QIM_DC(d);
+    return d->uploadedTiles;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Selects the level, uploads the missing visible tiles and draws them
+ * @return false to prevent endDraw from being called
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 选择层，上传缺少的可见瓦片并绘制
+ * @return false以防止调用endDraw
+ * \endif
+ */
+bool QImPlotTiledHeatmapItemNode::beginDraw()
+{
+    QIM_D(d);
+    if (!d->data || d->data->rows() <= 0 || d->data->cols() <= 0) {
+        return false;
+    }
+    ImPlotContext* ct = ImPlot::GetCurrentContext();
+    if (!ct || !ct->CurrentPlot) {
+        return false;
+    }
+
+    if (ImPlot::BeginItem(labelConstData())) {
+        const ImPlotPoint boundsMin(d->boundsMin.x(), d->boundsMin.y());
+        const ImPlotPoint boundsMax(d->boundsMax.x(), d->boundsMax.y());
+        if (ImPlot::FitThisFrame()) {
+            ImPlot::FitPoint(boundsMin);
+            ImPlot::FitPoint(boundsMax);
+        }
+        ImPlot::GetCurrentItem()->Color = IM_COL32_WHITE;
+
+        const ImPlotColormap cmap = ImPlot::GetStyle().Colormap;
+        if (d->colormap != cmap) {
+            d->clearTiles();
+            d->colormap = cmap;
+        }
+        ++d->frame;
+        // 预算被调小后先收缩缓存
+        d->makeRoom(0);
+
+        const qint64 rows0 = d->data->rows();
+        const qint64 cols0 = d->data->cols();
+        const int topLevel = d->pyramid.levelFor(kTileSize);
+
+        // 可见的第 0 层单元格，以及单元格约为一个像素的层
+        CellRect visible { 0, cols0, 0, rows0 };
+        int level = topLevel;
+        double xMin = 0, xMax = 0, yMin = 0, yMax = 0;
+        int pixelWidth = 0, pixelHeight = 0;
+        const double spanX = boundsMax.x - boundsMin.x;
+        const double spanY = boundsMax.y - boundsMin.y;
+        if (spanX != 0 && spanY != 0 && plotViewRect(xMin, xMax, yMin, yMax, pixelWidth, pixelHeight)) {
+            const double fx0 = (xMin - boundsMin.x) / spanX;
+            const double fx1 = (xMax - boundsMin.x) / spanX;
+            const double fy0 = (boundsMax.y - yMax) / spanY;
+            const double fy1 = (boundsMax.y - yMin) / spanY;
+            auto clampCell   = [](double v, qint64 n) {
+                return static_cast< qint64 >(std::clamp(v, 0.0, static_cast< double >(n)));
+            };
+            visible.col0 = clampCell(std::floor(std::min(fx0, fx1) * cols0), cols0);
+            visible.col1 = clampCell(std::ceil(std::max(fx0, fx1) * cols0), cols0);
+            visible.row0 = clampCell(std::floor(std::min(fy0, fy1) * rows0), rows0);
+            visible.row1 = clampCell(std::ceil(std::max(fy0, fy1) * rows0), rows0);
+            // 每个屏幕像素覆盖的单元格数，取 2^level 不小于它的最低层
+            const double density = std::max(cols0 * std::abs((xMax - xMin) / spanX) / pixelWidth,
+                                            rows0 * std::abs((yMax - yMin) / spanY) / pixelHeight);
+            level                = 0;
+            while (level < topLevel && std::ldexp(1.0, level) < density) {
+                ++level;
+            }
+        }
+        // 可见瓦片超出预算时改用更粗的层，最粗层的单个瓦片始终保留
+        while (level < topLevel && (tilesAt(level, visible).count() + 1) * kTileBytes > d->textureBudget) {
+            ++level;
+        }
+        d->currentLevel = level;
+        // 只构建本帧绘制的层，中间层不构建
+        d->pyramid.ensureLevel(level);
+
+        // 最粗层只有一个瓦片，作为尚未上传的瓦片的替代；只在有瓦片缺失时构建，且由可见层归约
+        PrivateData::Tile* fallback = d->touchTile(topLevel, 0, 0);
+        bool fallbackTried          = fallback != nullptr;
+
+        ImDrawList& drawList  = *ImPlot::GetPlotDrawList();
+        const TileRange range = tilesAt(level, visible);
+        int uploads           = 0;
+        bool pending          = false;
+        for (int tr = range.row0; tr < range.row1; ++tr) {
+            for (int tc = range.col0; tc < range.col1; ++tc) {
+                PrivateData::Tile* tile = d->touchTile(level, tr, tc);
+                if (!tile) {
+                    if (uploads < kMaxUploadsPerFrame) {
+                        tile = d->uploadTile(level, tr, tc);
+                        ++uploads;
+                    } else {
+                        pending = true;
+                    }
+                }
+                if (!tile && !fallbackTried) {
+                    fallbackTried = true;
+                    d->pyramid.ensureLevel(topLevel);
+                    fallback = d->uploadTile(topLevel, 0, 0);
+                }
+                // 瓦片覆盖的第 0 层单元格
+                const qint64 tileSpan = static_cast< qint64 >(kTileSize) << level;
+                const CellRect cells { tc * tileSpan,
+                                       std::min((tc + 1) * tileSpan, cols0),
+                                       tr * tileSpan,
+                                       std::min((tr + 1) * tileSpan, rows0) };
+                if (tile) {
+                    d->drawCells(drawList, *tile, cells);
+                } else if (fallback) {
+                    d->drawCells(drawList, *fallback, cells);
+                }
+            }
+        }
+        ImPlot::EndItem();
+        if (pending) {
+            // 剩余的瓦片在后续帧上传
+            requestRender();
+        }
+    }
+
+    // Update item status
+    ImPlotItem* plotItem = ct->PreviousItem;
+    if (!plotItem) {
+        return false;
+    }
+    setImPlotItem(plotItem);
+    if (plotItem->Show != QImAbstractNode::isVisible()) {
+        QImAbstractNode::setVisible(plotItem->Show);
+    }
+    return false;
+}
+
+}  // namespace QIM
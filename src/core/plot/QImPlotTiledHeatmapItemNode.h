@@ -0,0 +1,296 @@
+#ifndef QIMPLOTTILEDHEATMAPITEMNODE_H
+#define QIMPLOTTILEDHEATMAPITEMNODE_H
+
+#include "QImAPI.h"
+#include <QPointF>
+#include "QImPlotItemNode.h"
+#include "QImPlotHeatmapDataSeries.h"
+
+namespace QIM
+{
+class QImAbstractHeatmapDataSeries;
+
+/**
+ * \if ENGLISH
+ * @brief Heatmap for matrices too large for one texture, drawn from a tiled mip pyramid
+ *
+ * @class QImPlotTiledHeatmapItemNode
+ * @ingroup plot_items
+ *
+ * @details The matrix is reduced into a mip pyramid (QImHeatmapPyramid, 2x2 max or mean per level)
+ *          and every level is cut into 256x256 tiles. Each frame the item picks the level whose cells
+ *          are about one screen pixel for the current plot limits, colormaps and uploads only the tiles
+ *          of that level that intersect the limits, and draws one textured quad per tile. The draw
+ *          cost depends on the plot size and not on the matrix size, and zooming in shows the original
+ *          cells.
+ *
+ *          Tile textures live in an LRU cache bounded by textureBudget() bytes; tiles used by the
+ *          current frame are never evicted, and when the visible tiles of a level would exceed the
+ *          budget a coarser level is drawn. At most a few tiles are uploaded per frame; missing tiles
+ *          are drawn from the coarsest level meanwhile and another frame is requested.
+ *
+ *          Colors follow ImPlot::PlotHeatmap() (scaleMin/scaleMax, 0/0 for the data range, current
+ *          colormap), NaN cells are transparent and labels are not drawn. The cache is rebuilt when
+ *          the data, the scale, the reduction or the colormap changes; call notifyDataChanged() after
+ *          modifying the values in place. Requires a current OpenGL context, i.e. a QImWidget.
+ *
+ * @see QImPlotHeatmapItemNode, QImHeatmapPyramid
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 以瓦片化 mip 金字塔绘制、单个纹理容纳不下的超大热力图
+ *
+ * @class QImPlotTiledHeatmapItemNode
+ * @ingroup plot_items
+ *
+ * @details 矩阵被归约为 mip 金字塔（QImHeatmapPyramid，每层 2x2 取最大值或平均值），每层切分为 256x256
+ *          的瓦片。每帧按当前坐标范围选择单元格约为一个屏幕像素的层，只对与坐标范围相交的瓦片着色并上传，
+ *          每个瓦片以一个纹理四边形绘制。绘制代价取决于绘图区大小而不是矩阵大小，放大后显示原始单元格。
+ *
+ *          瓦片纹理保存在不超过 textureBudget() 字节的 LRU 缓存中；当前帧使用的瓦片不会被淘汰，
+ *          某层的可见瓦片超过预算时改为绘制更粗的层。每帧只上传少量瓦片，尚未上传的瓦片先以最粗的层绘制，
+ *          并请求下一帧继续上传。
+ *
+ *          颜色与 ImPlot::PlotHeatmap() 一致（scaleMin/scaleMax，均为 0 时使用数据范围，当前颜色映射），
+ *          NaN 单元格透明，不绘制标签。数据、缩放范围、归约方式或颜色映射变化时重建缓存；原地修改数据后
+ *          调用 notifyDataChanged()。需要当前 OpenGL 上下文，即在 QImWidget 中绘制。
+ *
+ * @see QImPlotHeatmapItemNode, QImHeatmapPyramid
+ * \endif
+ */
+class QIM_CORE_API QImPlotTiledHeatmapItemNode : public QImPlotItemNode
+{
+    Q_OBJECT
+    QIM_DECLARE_PRIVATE(QImPlotTiledHeatmapItemNode)
+
+    /**
+     * \if ENGLISH
+     * @property QImPlotTiledHeatmapItemNode::scaleMin
+     * @brief Minimum value for color scaling, 0 together with scaleMax = 0 uses the data range
+     * @accessors READ scaleMin WRITE setScaleMin NOTIFY scaleMinChanged
+     * \endif
+     *
+     * \if CHINESE
+     * @property QImPlotTiledHeatmapItemNode::scaleMin
+     * @brief 颜色缩放的最小值，与 scaleMax 均为 0 时使用数据范围
+     * @accessors READ scaleMin WRITE setScaleMin NOTIFY scaleMinChanged
+     * \endif
+     */
+    Q_PROPERTY(double scaleMin READ scaleMin WRITE setScaleMin NOTIFY scaleMinChanged)
+
+    /**
+     * \if ENGLISH
+     * @property QImPlotTiledHeatmapItemNode::scaleMax
+     * @brief Maximum value for color scaling, 0 together with scaleMin = 0 uses the data range
+     * @accessors READ scaleMax WRITE setScaleMax NOTIFY scaleMaxChanged
+     * \endif
+     *
+     * \if CHINESE
+     * @property QImPlotTiledHeatmapItemNode::scaleMax
+     * @brief 颜色缩放的最大值，与 scaleMin 均为 0 时使用数据范围
+     * @accessors READ scaleMax WRITE setScaleMax NOTIFY scaleMaxChanged
+     * \endif
+     */
+    Q_PROPERTY(double scaleMax READ scaleMax WRITE setScaleMax NOTIFY scaleMaxChanged)
+
+    /**
+     * \if ENGLISH
+     * @property QImPlotTiledHeatmapItemNode::boundsMin
+     * @brief Lower-left corner of the heatmap in plot coordinates, default (0, 0)
+     * @accessors READ boundsMin WRITE setBoundsMin NOTIFY boundsMinChanged
+     * \endif
+     *
+     * \if CHINESE
+     * @property QImPlotTiledHeatmapItemNode::boundsMin
+     * @brief 热力图左下角的绘图坐标，默认 (0, 0)
+     * @accessors READ boundsMin WRITE setBoundsMin NOTIFY boundsMinChanged
+     * \endif
+     */
+    Q_PROPERTY(QPointF boundsMin READ boundsMin WRITE setBoundsMin NOTIFY boundsMinChanged)
+
+    /**
+     * \if ENGLISH
+     * @property QImPlotTiledHeatmapItemNode::boundsMax
+     * @brief Upper-right corner of the heatmap in plot coordinates, default (1, 1)
+     * @accessors READ boundsMax WRITE setBoundsMax NOTIFY boundsMaxChanged
+     * \endif
+     *
+     * \if CHINESE
+     * @property QImPlotTiledHeatmapItemNode::boundsMax
+     * @brief 热力图右上角的绘图坐标，默认 (1, 1)
+     * @accessors READ boundsMax WRITE setBoundsMax NOTIFY boundsMaxChanged
+     * \endif
+     */
+    Q_PROPERTY(QPointF boundsMax READ boundsMax WRITE setBoundsMax NOTIFY boundsMaxChanged)
+
+    /**
+     * \if ENGLISH
+     * @property QImPlotTiledHeatmapItemNode::reduction
+     * @brief How the 2x2 cells of a level are combined into one cell of the next coarser level
+     *
+     * @details ReduceMax (default) keeps isolated hot cells visible when zoomed out, ReduceMean shows
+     *          the average intensity. Changing it rebuilds the pyramid.
+     * @accessors READ reduction WRITE setReduction NOTIFY reductionChanged
+     * \endif
+     *
+     * \if CHINESE
+     * @property QImPlotTiledHeatmapItemNode::reduction
+     * @brief 一层的 2x2 个单元格合并为上一层单元格的方式
+     *
+     * @details ReduceMax（默认）在缩小时仍能看到孤立的高值单元格，ReduceMean 显示平均强度。
+     *          修改后重建金字塔。
+     * @accessors READ reduction WRITE setReduction NOTIFY reductionChanged
+     * \endif
+     */
+    Q_PROPERTY(Reduction reduction READ reduction WRITE setReduction NOTIFY reductionChanged)
+
+    /**
+     * \if ENGLISH
+     * @property QImPlotTiledHeatmapItemNode::textureBudget
+     * @brief Upper bound of the tile textures kept in video memory, in bytes
+     *
+     * @details Default 256 MiB. Least recently used tiles are released when the budget is exceeded.
+     *          A budget smaller than the visible tiles makes the item draw a coarser level.
+     * @accessors READ textureBudget WRITE setTextureBudget NOTIFY textureBudgetChanged
+     * \endif
+     *
+     * \if CHINESE
+     * @property QImPlotTiledHeatmapItemNode::textureBudget
+     * @brief 显存中保留的瓦片纹理上限，单位字节
+     *
+     * @details 默认 256 MiB。超过预算时释放最久未使用的瓦片。预算小于可见瓦片时绘制更粗的层。
+     * @accessors READ textureBudget WRITE setTextureBudget NOTIFY textureBudgetChanged
+     * \endif
+     */
+    Q_PROPERTY(qint64 textureBudget READ textureBudget WRITE setTextureBudget NOTIFY textureBudgetChanged)
+
+public:
+    // Reduction of the mip levels, same values as QImHeatmapPyramid::Reduction
+    enum Reduction
+    {
+        ReduceMax = 0,  ///< 取最大值，保留峰值（默认）
+        ReduceMean      ///< 取平均值，保留平均强度
+    };
+    Q_ENUM(Reduction)
+
+    // Unique type identifier for QImPlotTiledHeatmapItemNode
+    enum
+    {
+        Type = InnerType + 14
+    };
+
+    // Returns the type identifier of this plot item
+    virtual int type() const override
+    {
+        return Type;
+    }
+
+    // Constructs a QImPlotTiledHeatmapItemNode with optional parent
+    QImPlotTiledHeatmapItemNode(QObject* parent = nullptr);
+
+    // Destroys the QImPlotTiledHeatmapItemNode
+    ~QImPlotTiledHeatmapItemNode();
+
+    //----------------------------------------------------
+    // Data setting interface
+    //----------------------------------------------------
+
+    // Sets the data series for the heatmap (takes ownership)
+    void setData(QImAbstractHeatmapDataSeries* series);
+
+    // Sets heatmap data from values matrix
+    template< typename ContainerValues >
+    QImAbstractHeatmapDataSeries* setData(const ContainerValues& values, int rows, int cols, bool colMajor = false);
+
+    // Sets heatmap data from values matrix (move semantics)
+    template< typename ContainerValues >
+    QImAbstractHeatmapDataSeries* setData(ContainerValues&& values, int rows, int cols, bool colMajor = false);
+
+    // Gets the current data series
+    QImAbstractHeatmapDataSeries* data() const;
+
+    // Call after the values of the data series were modified in place, rebuilds the pyramid and the tiles
+    void notifyDataChanged();
+
+    //----------------------------------------------------
+    // Property accessors
+    //----------------------------------------------------
+
+    double scaleMin() const;
+    void setScaleMin(double min);
+
+    double scaleMax() const;
+    void setScaleMax(double max);
+
+    QPointF boundsMin() const;
+    void setBoundsMin(const QPointF& min);
+
+    QPointF boundsMax() const;
+    void setBoundsMax(const QPointF& max);
+
+    Reduction reduction() const;
+    void setReduction(Reduction reduction);
+
+    qint64 textureBudget() const;
+    void setTextureBudget(qint64 bytes);
+
+    //----------------------------------------------------
+    // Statistics
+    //----------------------------------------------------
+
+    // Pyramid level drawn by the last frame (0 = original cells)
+    int currentLevel() const;
+
+    // Number of tile textures in the cache
+    int cachedTileCount() const;
+
+    // Bytes of the tile textures in the cache
+    qint64 cachedTextureBytes() const;
+
+    // Number of tiles uploaded since the data was set
+    qint64 uploadedTileCount() const;
+
+Q_SIGNALS:
+    // Emitted when the minimum scale value changes
+    void scaleMinChanged(double min);
+    // Emitted when the maximum scale value changes
+    void scaleMaxChanged(double max);
+    // Emitted when the lower-left bounds change
+    void boundsMinChanged(const QPointF& min);
+    // Emitted when the upper-right bounds change
+    void boundsMaxChanged(const QPointF& max);
+    // Emitted when the reduction changes
+    void reductionChanged(Reduction reduction);
+    // Emitted when the texture budget changes
+    void textureBudgetChanged(qint64 bytes);
+    // Emitted when a new data series is set
+    void dataChanged();
+
+protected:
+    // Draws the visible tiles
+    virtual bool beginDraw() override;
+};
+
+// Template function implementation
+template< typename ContainerValues >
+inline QImAbstractHeatmapDataSeries*
+QImPlotTiledHeatmapItemNode::setData(const ContainerValues& values, int rows, int cols, bool colMajor)
+{
+    QImAbstractHeatmapDataSeries* d = new QImVectorHeatmapDataSeries< ContainerValues >(values, rows, cols, colMajor);
+    setData(d);
+    return d;
+}
+
+template< typename ContainerValues >
+inline QImAbstractHeatmapDataSeries*
+QImPlotTiledHeatmapItemNode::setData(ContainerValues&& values, int rows, int cols, bool colMajor)
+{
+    QImAbstractHeatmapDataSeries* d =
+        new QImVectorHeatmapDataSeries< ContainerValues >(std::move(values), rows, cols, colMajor);
+    setData(d);
+    return d;
+}
+
+}  // end namespace QIM
+
+#endif  // QIMPLOTTILEDHEATMAPITEMNODE_H
@@ -6,6 +6,8 @@
 #include <QPainter>
 #include <QStyleOption>
 #include <QDebug>
+#include <QPointer>
+#include <memory>
 #include "implot.h"
 #include "implot_internal.h"
 #include "imgui.h"
@@ -30,7 +32,7 @@ public:
 
     std::vector< TrackedValue > trackedValues;
     QImPlotNode* plotNode { nullptr };                ///< 绘图节点
-    QList< QImAbstractXYDataSeries* > supportSeries;  ///< 记录支持的序列
+    QList< QPointer< QImPlotLineItemNode > > supportItems;  ///< 支持的绘图项，记录绘图项而不是数据指针，setData()后不会悬空
     bool isActive { false };                          ///< 是否激活
     bool lastActiveState { false };  ///< 记录上次激活状态,这个是用于识别首次active状态变化的辅助变量
     bool skipNanFiniteValues { false };  ///< 是否跳过nan
@@ -63,7 +65,7 @@ QImPlotValueTrackerNode::PrivateData::PrivateData(QImPlotValueTrackerNode* p) :
 
 void QImPlotValueTrackerNode::PrivateData::updateSupportSeries(QImPlotNode* plot)
 {
-    supportSeries.clear();
+    supportItems.clear();
     const auto items = plot->plotItemNodes();
     for (QImAbstractNode* n : items) {
         tryAddSeries(n);
@@ -73,7 +75,9 @@ void QImPlotValueTrackerNode::PrivateData::updateSupportSeries(QImPlotNode* plot
 bool QImPlotValueTrackerNode::PrivateData::tryAddSeries(QImAbstractNode* n)
 {
     if (QImPlotLineItemNode* line = qobject_cast< QImPlotLineItemNode* >(n)) {
-        supportSeries.push_back(line->data());
+        if (!supportItems.contains(line)) {
+            supportItems.push_back(line);
+        }
         return true;
     }
     return false;
@@ -82,7 +86,7 @@ bool QImPlotValueTrackerNode::PrivateData::tryAddSeries(QImAbstractNode* n)
 bool QImPlotValueTrackerNode::PrivateData::tryRemoveSeries(QImAbstractNode* n)
 {
     if (QImPlotLineItemNode* line = qobject_cast< QImPlotLineItemNode* >(n)) {
-        return (supportSeries.removeAll(line->data()) > 0);
+        return (supportItems.removeAll(line) > 0);
     }
     return false;
 }
@@ -147,9 +151,13 @@ void QImPlotValueTrackerNode::PrivateData::updateTrackingState()
             }
 
             if (QImPlotLineItemNode* lineItem = qobject_cast< QImPlotLineItemNode* >(itemNode)) {
-                QImAbstractXYDataSeries* series = lineItem->data();
-                const int size                  = series->size();
-                if (!series || size <= 0) {
+                // 持有共享引用，计算期间即使绘图项重新setData()数据也保持有效
+                const std::shared_ptr< QImAbstractXYDataSeries > series = lineItem->sharedData();
+                if (!series) {
+                    continue;
+                }
+                const qint64 size = series->size();
+                if (size <= 0) {
                     continue;
                 }
                 QPointF plotPos = lineItem->pixelsToPlot(mouseScreenPos.x, mouseScreenPos.y);
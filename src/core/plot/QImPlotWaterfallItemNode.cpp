@@ -0,0 +1,604 @@
+#include "QImPlotWaterfallItemNode.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "implot.h"
+#include "implot_internal.h"
+#include "QImPlotMinMaxKernel.h"
+#include "QImPlotParallel.h"
+#include "QImPlotTexture.h"
+
+namespace QIM
+{
+
+namespace
+{
+// 默认保留的行数
+constexpr int kDefaultHistoryRows = 512;
+// 每个任务至少着色的单元格数
+constexpr qint64 kParallelGrainCells = 1 << 16;
+}  // namespace
+
+class QImPlotWaterfallItemNode::PrivateData
+{
+    QIM_DECLARE_PUBLIC(QImPlotWaterfallItemNode)
+public:
+    PrivateData(QImPlotWaterfallItemNode* p);
+    // 按 bins 与 historyRows 分配环形缓冲
+    void ensureStorage();
+    // 清空全部行
+    void reset();
+    // 颜色缩放范围
+    void colorRange(double& lo, double& hi) const;
+    // 对环形缓冲的 [first, last) 行着色
+    void colorRows(int first, int last, ImPlotColormap cmap, double lo, double hi);
+    // 上传上一帧之后追加的行，必要时整体重新着色，返回纹理是否可用
+    bool syncTexture();
+
+    int bins { 0 };
+    int historyRows { kDefaultHistoryRows };
+    double scaleMin { 0.0 };
+    double scaleMax { 0.0 };
+    QPointF boundsMin { 0.0, 0.0 };
+    QPointF boundsMax { 1.0, 1.0 };
+    // 环形缓冲，historyRows x bins，行主序
+    std::vector< float > values;
+    std::vector< quint32 > pixels;  ///< 与纹理内容一致的着色结果
+    int head { 0 };                 ///< 下一行写入的位置
+    qint64 total { 0 };             ///< 追加的总行数
+    qint64 uploadedTotal { 0 };     ///< 已上传到纹理的总行数
+    // 自动缩放时至今出现过的范围
+    bool seenAny { false };
+    double seenMin { 0.0 };
+    double seenMax { 0.0 };
+    // 纹理当前内容使用的颜色映射与缩放范围
+    ImPlotColormap colormap { -1 };
+    double colorLo { 0.0 };
+    double colorHi { 0.0 };
+    QImPlotTexture texture;
+};
+
+QImPlotWaterfallItemNode::PrivateData::PrivateData(QImPlotWaterfallItemNode* p) : q_ptr(p)
+{
+}
+
+void QImPlotWaterfallItemNode::PrivateData::ensureStorage()
+{
+    const std::size_t size = static_cast< std::size_t >(historyRows) * bins;
+    if (values.size() != size) {
+        values.assign(size, std::numeric_limits< float >::quiet_NaN());
+        pixels.assign(size, 0);
+    }
+}
+
+void QImPlotWaterfallItemNode::PrivateData::reset()
+{
+    std::fill(values.begin(), values.end(), std::numeric_limits< float >::quiet_NaN());
+    head          = 0;
+    total         = 0;
+    uploadedTotal = 0;
+    seenAny       = false;
+    colormap      = -1;
+}
+
+void QImPlotWaterfallItemNode::PrivateData::colorRange(double& lo, double& hi) const
+{
+    lo = scaleMin;
+    hi = scaleMax;
+    if (lo == 0 && hi == 0 && seenAny) {
+        lo = seenMin;
+        hi = seenMax;
+    }
+}
+
+/**
+ * @brief 与 ImPlot::PlotHeatmap 相同的颜色映射，NaN 透明
+ */
+void QImPlotWaterfallItemNode::PrivateData::colorRows(int first, int last, ImPlotColormap cmap, double lo, double hi)
+{
+    const ImPlotColormapData& maps = ImPlot::GetCurrentContext()->ColormapData;
+    const ImU32 flat               = maps.GetKeyColor(cmap, 0);
+    const double range             = hi - lo;
+    const qint64 grain             = std::max< qint64 >(1, kParallelGrainCells / bins);
+    qimPlotParallelFor(last - first, grain, [ & ](qint64 begin, qint64 end) {
+        for (qint64 r = first + begin; r < first + end; ++r) {
+            const float* in = &values[ static_cast< std::size_t >(r * bins) ];
+            quint32* out    = &pixels[ static_cast< std::size_t >(r * bins) ];
+            for (int c = 0; c < bins; ++c) {
+                const double v = in[ c ];
+                if (std::isnan(v)) {
+                    out[ c ] = 0;
+                } else if (range == 0) {
+                    // ImPlot 此时以颜色映射的第一个颜色填充
+                    out[ c ] = flat;
+                } else {
+                    out[ c ] = maps.LerpTable(cmap, ImClamp(static_cast< float >((v - lo) / range), 0.0f, 1.0f));
+                }
+            }
+        }
+    });
+}
+
+bool QImPlotWaterfallItemNode::PrivateData::syncTexture()
+{
+    // 没有当前上下文时 limitSize 为 0
+    const int limitSize = QImPlotTexture::maximumSize();
+    if (bins > limitSize || historyRows > limitSize) {
+        return false;
+    }
+    const ImPlotColormap cmap = ImPlot::GetStyle().Colormap;
+    double lo                 = 0.0;
+    double hi                 = 0.0;
+    colorRange(lo, hi);
+    const qint64 pending = total - uploadedTotal;
+    const bool full      = !texture.isValid() || texture.width() != bins || texture.height() != historyRows
+                      || cmap != colormap || lo != colorLo || hi != colorHi || pending >= historyRows;
+    if (full) {
+        colorRows(0, historyRows, cmap, lo, hi);
+        if (!texture.upload(bins, historyRows, pixels.data())) {
+            return false;
+        }
+        colormap = cmap;
+        colorLo  = lo;
+        colorHi  = hi;
+    } else if (pending > 0) {
+        // 新行位于写入位置之前，跨过环形缓冲末尾时分两段上传
+        const int first = static_cast< int >((head - pending + historyRows) % historyRows);
+        const int count = static_cast< int >(pending);
+        const int tail  = std::min(count, historyRows - first);
+        colorRows(first, first + tail, cmap, lo, hi);
+        texture.uploadRows(first, tail, &pixels[ static_cast< std::size_t >(first) * bins ]);
+        if (count > tail) {
+            colorRows(0, count - tail, cmap, lo, hi);
+            texture.uploadRows(0, count - tail, pixels.data());
+        }
+    }
+    uploadedTotal = total;
+    return true;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Constructor for QImPlotWaterfallItemNode
+ * @param parent Parent QObject
+ * \endif
+ *
+ * \if CHINESE
+ * @brief QImPlotWaterfallItemNode的构造函数
+ * @param parent 父QObject
+ * \endif
+ */
+QImPlotWaterfallItemNode::QImPlotWaterfallItemNode(QObject* parent) : QImPlotItemNode(parent), QIM_PIMPL_CONSTRUCT
+{
+}
+
+/**
+ * \if ENGLISH
+ * @brief Destructor for QImPlotWaterfallItemNode
+ * \endif
+ *
+ * \if CHINESE
+ * @brief QImPlotWaterfallItemNode的析构函数
+ * \endif
+ */
+QImPlotWaterfallItemNode::~QImPlotWaterfallItemNode()
+{
+}
+
+template< typename T >
+void QImPlotWaterfallItemNode::appendRowImpl(const T* values, int count)
+{
+    QIM_D(d);
+    if (!values || count <= 0) {
+        return;
+    }
+    if (d->bins == 0) {
+        d->bins = count;
+        emit binsChanged(count);
+    }
+    d->ensureStorage();
+    const int n = std::min(count, d->bins);
+    float* row  = &d->values[ static_cast< std::size_t >(d->head) * d->bins ];
+    std::transform(values, values + n, row, [](T v) { return static_cast< float >(v); });
+    std::fill(row + n, row + d->bins, std::numeric_limits< float >::quiet_NaN());
+    // 自动缩放范围只会扩大，扩大时下一帧整体重新着色
+    const QImPlotMinMaxIndex mm = qimPlotMinMaxIndex(row, n);
+    if (mm.minIdx >= 0) {
+        d->seenMin = d->seenAny ? std::min(d->seenMin, mm.minValue) : mm.minValue;
+        d->seenMax = d->seenAny ? std::max(d->seenMax, mm.maxValue) : mm.maxValue;
+        d->seenAny = true;
+    }
+    d->head = (d->head + 1) % d->historyRows;
+    ++d->total;
+    requestRender();
+}
+
+/**
+ * \if ENGLISH
+ * @brief Append one row as the newest row
+ * @param values Row values, count elements
+ * @param count Number of values; truncated or padded with NaN to bins()
+ * @details Copies the row into the ring buffer, O(bins). The row is colormapped and uploaded by the
+ *          next frame.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 追加一行作为最新的行
+ * @param values 行数据，共 count 个
+ * @param count 值个数，按 bins() 截断或以 NaN 补齐
+ * @details 把该行拷贝进环形缓冲，代价为 O(bins)。下一帧绘制时着色并上传。
+ * \endif
+ */
+void QImPlotWaterfallItemNode::appendRow(const float* values, int count)
+{
+    appendRowImpl(values, count);
+}
+
+/**
+ * \if ENGLISH
+ * @brief Append one row as the newest row, values are stored as float
+ * @param values Row values, count elements
+ * @param count Number of values; truncated or padded with NaN to bins()
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 追加一行作为最新的行，值以 float 保存
+ * @param values 行数据，共 count 个
+ * @param count 值个数，按 bins() 截断或以 NaN 补齐
+ * \endif
+ */
+void QImPlotWaterfallItemNode::appendRow(const double* values, int count)
+{
+    appendRowImpl(values, count);
+}
+
+/**
+ * \if ENGLISH
+ * @brief Remove all rows, bins() and historyRows() are kept
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 清空全部行，保留 bins() 与 historyRows()
+ * \endif
+ */
+void QImPlotWaterfallItemNode::clear()
+{
+    QIM_D(d);
+    d->reset();
+    requestRender();
+}
+
+/**
+ * \if ENGLISH
+ * @brief Number of rows currently kept
+ * @return At most historyRows()
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 当前保留的行数
+ * @return 不超过 historyRows()
+ * \endif
+ */
+int QImPlotWaterfallItemNode::rowCount() const
+{
+    QIM_DC(d);
+    return static_cast< int >(std::min< qint64 >(d->total, d->historyRows));
+}
+
+/**
+ * \if ENGLISH
+ * @brief Number of rows appended since the last clear()
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 上次 clear() 以来追加的行数
+ * \endif
+ */
+qint64 QImPlotWaterfallItemNode::totalRowCount() const
+{
+    QIM_DC(d);
+    return d->total;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Get the number of values per row
+ * @return 0 until the first row is appended, unless set explicitly
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 获取每行的值个数
+ * @return 未显式设置时，追加第一行之前为 0
+ * \endif
+ */
+int QImPlotWaterfallItemNode::bins() const
+{
+    QIM_DC(d);
+    return d->bins;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set the number of values per row, clears the history
+ * @param bins Values per row, 0 takes the length of the next appended row
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置每行的值个数，清空历史
+ * @param bins 每行的值个数，0 表示取下一次追加的行的长度
+ * \endif
+ */
+void QImPlotWaterfallItemNode::setBins(int bins)
+{
+    QIM_D(d);
+    bins = std::max(bins, 0);
+    if (d->bins != bins) {
+        d->bins = bins;
+        d->values.clear();
+        d->pixels.clear();
+        d->reset();
+        emit binsChanged(bins);
+    }
+}
+
+/**
+ * \if ENGLISH
+ * @brief Get the number of rows kept and drawn
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 获取保留并绘制的行数
+ * \endif
+ */
+int QImPlotWaterfallItemNode::historyRows() const
+{
+    QIM_DC(d);
+    return d->historyRows;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set the number of rows kept and drawn, clears the history
+ * @param rows History length, at least 1
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置保留并绘制的行数，清空历史
+ * @param rows 历史长度，至少为 1
+ * \endif
+ */
+void QImPlotWaterfallItemNode::setHistoryRows(int rows)
+{
+    QIM_D(d);
+    rows = std::max(rows, 1);
+    if (d->historyRows != rows) {
+        d->historyRows = rows;
+        d->values.clear();
+        d->pixels.clear();
+        d->reset();
+        emit historyRowsChanged(rows);
+    }
+}
+
+/**
+ * \if ENGLISH
+ * @brief Get minimum scale value
+ * @return Current scale minimum
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 获取最小缩放值
+ * @return 当前缩放最小值
+ * \endif
+ */
+double QImPlotWaterfallItemNode::scaleMin() const
+{
+    QIM_DC(d);
+    return d->scaleMin;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set minimum scale value, the history is colormapped again
+ * @param min New scale minimum
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置最小缩放值，历史重新着色
+ * @param min 新缩放最小值
+ * \endif
+ */
+void QImPlotWaterfallItemNode::setScaleMin(double min)
+{
+    QIM_D(d);
+    if (d->scaleMin != min) {
+        d->scaleMin = min;
+        emit scaleMinChanged(min);
+    }
+}
+
+/**
+ * \if ENGLISH
+ * @brief Get maximum scale value
+ * @return Current scale maximum
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 获取最大缩放值
+ * @return 当前缩放最大值
+ * \endif
+ */
+double QImPlotWaterfallItemNode::scaleMax() const
+{
+    QIM_DC(d);
+    return d->scaleMax;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set maximum scale value, the history is colormapped again
+ * @param max New scale maximum
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置最大缩放值，历史重新着色
+ * @param max 新缩放最大值
+ * \endif
+ */
+void QImPlotWaterfallItemNode::setScaleMax(double max)
+{
+    QIM_D(d);
+    if (d->scaleMax != max) {
+        d->scaleMax = max;
+        emit scaleMaxChanged(max);
+    }
+}
+
+/**
+ * \if ENGLISH
+ * @brief Get lower-left bounds
+ * @return Current lower-left bounds
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 获取左下角边界
+ * @return 当前左下角边界
+ * \endif
+ */
+QPointF QImPlotWaterfallItemNode::boundsMin() const
+{
+    QIM_DC(d);
+    return d->boundsMin;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set lower-left bounds
+ * @param min New lower-left bounds
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置左下角边界
+ * @param min 新左下角边界
+ * \endif
+ */
+void QImPlotWaterfallItemNode::setBoundsMin(const QPointF& min)
+{
+    QIM_D(d);
+    if (d->boundsMin != min) {
+        d->boundsMin = min;
+        emit boundsMinChanged(min);
+    }
+}
+
+/**
+ * \if ENGLISH
+ * @brief Get upper-right bounds
+ * @return Current upper-right bounds
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 获取右上角边界
+ * @return 当前右上角边界
+ * \endif
+ */
+QPointF QImPlotWaterfallItemNode::boundsMax() const
+{
+    QIM_DC(d);
+    return d->boundsMax;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Set upper-right bounds
+ * @param max New upper-right bounds
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 设置右上角边界
+ * @param max 新右上角边界
+ * \endif
+ */
+void QImPlotWaterfallItemNode::setBoundsMax(const QPointF& max)
+{
+    QIM_D(d);
+    if (d->boundsMax != max) {
+        d->boundsMax = max;
+        emit boundsMaxChanged(max);
+    }
+}
+
+/**
+ * \if ENGLISH
+ * @brief Uploads the rows appended since the last frame and draws the ring as at most two quads
+ * @return false to prevent endDraw from being called
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 上传上一帧之后追加的行，以最多两个四边形绘制环形缓冲
+ * @return false以防止调用endDraw
+ * \endif
+ */
+bool QImPlotWaterfallItemNode::beginDraw()
+{
+    QIM_D(d);
+    if (d->bins <= 0 || d->total == 0) {
+        return false;
+    }
+    ImPlotContext* ct = ImPlot::GetCurrentContext();
+    if (!ct || !ct->CurrentPlot) {
+        return false;
+    }
+
+    if (ImPlot::BeginItem(labelConstData())) {
+        const ImPlotPoint boundsMin(d->boundsMin.x(), d->boundsMin.y());
+        const ImPlotPoint boundsMax(d->boundsMax.x(), d->boundsMax.y());
+        if (ImPlot::FitThisFrame()) {
+            ImPlot::FitPoint(boundsMin);
+            ImPlot::FitPoint(boundsMax);
+        }
+        ImPlot::GetCurrentItem()->Color = IM_COL32_WHITE;
+
+        if (d->syncTexture()) {
+            // 最新的行（写入位置之前一行）在上边缘，纹理坐标 v 向下递减；
+            // [0, head) 段在上，写满后 [head, historyRows) 段接在下方
+            ImDrawList& drawList = *ImPlot::GetPlotDrawList();
+            const ImTextureID id = (ImTextureID)d->texture.textureId();
+            const double rows    = d->historyRows;
+            const double rowSpan = (boundsMax.y - boundsMin.y) / rows;
+            const double headV   = d->head / rows;
+            const double splitY  = boundsMax.y - d->head * rowSpan;
+            if (d->head > 0) {
+                drawList.AddImage(id,
+                                  ImPlot::PlotToPixels(boundsMin.x, boundsMax.y, IMPLOT_AUTO, IMPLOT_AUTO),
+                                  ImPlot::PlotToPixels(boundsMax.x, splitY, IMPLOT_AUTO, IMPLOT_AUTO),
+                                  ImVec2(0, static_cast< float >(headV)),
+                                  ImVec2(1, 0),
+                                  IM_COL32_WHITE);
+            }
+            if (d->total >= d->historyRows) {
+                drawList.AddImage(id,
+                                  ImPlot::PlotToPixels(boundsMin.x, splitY, IMPLOT_AUTO, IMPLOT_AUTO),
+                                  ImPlot::PlotToPixels(boundsMax.x, boundsMin.y, IMPLOT_AUTO, IMPLOT_AUTO),
+                                  ImVec2(0, 1),
+                                  ImVec2(1, static_cast< float >(headV)),
+                                  IM_COL32_WHITE);
+            }
+        }
+        ImPlot::EndItem();
+    }
+
+    // Update item status
+    ImPlotItem* plotItem = ct->PreviousItem;
+    if (!plotItem) {
+        return false;
+    }
+    setImPlotItem(plotItem);
+    if (plotItem->Show != QImAbstractNode::isVisible()) {
+        QImAbstractNode::setVisible(plotItem->Show);
+    }
+    return false;
+}
+
+}  // namespace QIM
@@ -0,0 +1,264 @@
+#ifndef QIMPLOTWATERFALLITEMNODE_H
+#define QIMPLOTWATERFALLITEMNODE_H
+
+#include "QImAPI.h"
+#include <QPointF>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include "QImPlotItemNode.h"
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief Scrolling waterfall (spectrogram) fed one row at a time
+ *
+ * @class QImPlotWaterfallItemNode
+ * @ingroup plot_items
+ *
+ * @details Keeps the last historyRows() rows of bins() values in a ring buffer and mirrors it in a
+ *          ring-buffer OpenGL texture of the same size. appendRow() only copies the row into the ring,
+ *          O(bins). Each frame the rows appended since the last frame are colormapped and uploaded
+ *          with glTexSubImage2D (QImPlotTexture::uploadRows()), and the ring is drawn as at most two
+ *          textured quads whose texture coordinates start at the write position, so scrolling never
+ *          moves data and the draw cost does not depend on the history length.
+ *
+ *          The newest row is drawn at the top edge (boundsMax.y), older rows below it; X spans
+ *          boundsMin.x .. boundsMax.x over the bins. Colors follow ImPlot::PlotHeatmap() with the
+ *          current colormap, NaN values are transparent. With scaleMin = scaleMax = 0 (default) the
+ *          range of all values appended so far is used and every widening of the range recolors the
+ *          whole history once; set a fixed scale for live data. Changing the scale or the colormap
+ *          recolors the history.
+ *
+ *          appendRow() must be called from the GUI thread. Requires a current OpenGL context, i.e. a
+ *          QImWidget, and bins() not larger than the maximum texture size.
+ *
+ * @see QImPlotHeatmapItemNode, QImPlotTexture
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 逐行追加的滚动瀑布图（时频图）
+ *
+ * @class QImPlotWaterfallItemNode
+ * @ingroup plot_items
+ *
+ * @details 在环形缓冲中保存最近 historyRows() 行、每行 bins() 个值，并以同样大小的环形 OpenGL 纹理镜像。
+ *          appendRow() 只把一行拷贝进环形缓冲，代价为 O(bins)。每帧只对上一帧之后追加的行着色，
+ *          通过 glTexSubImage2D（QImPlotTexture::uploadRows()）上传，并以最多两个纹理四边形绘制环形缓冲，
+ *          纹理坐标从写入位置开始，滚动时不移动任何数据，绘制代价与历史长度无关。
+ *
+ *          最新的一行绘制在上边缘（boundsMax.y），较早的行依次向下；X 方向的 bins 覆盖 boundsMin.x 到 boundsMax.x。
+ *          颜色与 ImPlot::PlotHeatmap() 一致，使用当前颜色映射，NaN 透明。scaleMin = scaleMax = 0（默认）时
+ *          使用至今追加的全部值的范围，范围每扩大一次就重新着色整个历史；实时数据建议设置固定的缩放范围。
+ *          修改缩放范围或颜色映射会重新着色历史。
+ *
+ *          appendRow() 必须在 GUI 线程调用。需要当前 OpenGL 上下文（即在 QImWidget 中绘制），
+ *          且 bins() 不超过最大纹理尺寸。
+ *
+ * @see QImPlotHeatmapItemNode, QImPlotTexture
+ * \endif
+ */
+class QIM_CORE_API QImPlotWaterfallItemNode : public QImPlotItemNode
+{
+    Q_OBJECT
+    QIM_DECLARE_PRIVATE(QImPlotWaterfallItemNode)
+
+    /**
+     * \if ENGLISH
+     * @property QImPlotWaterfallItemNode::bins
+     * @brief Number of values per row
+     *
+     * @details 0 (default) takes the length of the first appended row. Changing it clears the history.
+     *          Longer rows are truncated, shorter rows are padded with NaN.
+     * @accessors READ bins WRITE setBins NOTIFY binsChanged
+     * \endif
+     *
+     * \if CHINESE
+     * @property QImPlotWaterfallItemNode::bins
+     * @brief 每行的值个数
+     *
+     * @details 0（默认）表示取第一次追加的行的长度。修改后清空历史。过长的行被截断，过短的行以 NaN 补齐。
+     * @accessors READ bins WRITE setBins NOTIFY binsChanged
+     * \endif
+     */
+    Q_PROPERTY(int bins READ bins WRITE setBins NOTIFY binsChanged)
+
+    /**
+     * \if ENGLISH
+     * @property QImPlotWaterfallItemNode::historyRows
+     * @brief Number of rows kept and drawn, default 512. Changing it clears the history
+     * @accessors READ historyRows WRITE setHistoryRows NOTIFY historyRowsChanged
+     * \endif
+     *
+     * \if CHINESE
+     * @property QImPlotWaterfallItemNode::historyRows
+     * @brief 保留并绘制的行数，默认 512。修改后清空历史
+     * @accessors READ historyRows WRITE setHistoryRows NOTIFY historyRowsChanged
+     * \endif
+     */
+    Q_PROPERTY(int historyRows READ historyRows WRITE setHistoryRows NOTIFY historyRowsChanged)
+
+    /**
+     * \if ENGLISH
+     * @property QImPlotWaterfallItemNode::scaleMin
+     * @brief Minimum value for color scaling, 0 together with scaleMax = 0 uses the range seen so far
+     * @accessors READ scaleMin WRITE setScaleMin NOTIFY scaleMinChanged
+     * \endif
+     *
+     * \if CHINESE
+     * @property QImPlotWaterfallItemNode::scaleMin
+     * @brief 颜色缩放的最小值，与 scaleMax 均为 0 时使用至今出现过的范围
+     * @accessors READ scaleMin WRITE setScaleMin NOTIFY scaleMinChanged
+     * \endif
+     */
+    Q_PROPERTY(double scaleMin READ scaleMin WRITE setScaleMin NOTIFY scaleMinChanged)
+
+    /**
+     * \if ENGLISH
+     * @property QImPlotWaterfallItemNode::scaleMax
+     * @brief Maximum value for color scaling, 0 together with scaleMin = 0 uses the range seen so far
+     * @accessors READ scaleMax WRITE setScaleMax NOTIFY scaleMaxChanged
+     * \endif
+     *
+     * \if CHINESE
+     * @property QImPlotWaterfallItemNode::scaleMax
+     * @brief 颜色缩放的最大值，与 scaleMin 均为 0 时使用至今出现过的范围
+     * @accessors READ scaleMax WRITE setScaleMax NOTIFY scaleMaxChanged
+     * \endif
+     */
+    Q_PROPERTY(double scaleMax READ scaleMax WRITE setScaleMax NOTIFY scaleMaxChanged)
+
+    /**
+     * \if ENGLISH
+     * @property QImPlotWaterfallItemNode::boundsMin
+     * @brief Lower-left corner in plot coordinates (first bin, oldest row), default (0, 0)
+     * @accessors READ boundsMin WRITE setBoundsMin NOTIFY boundsMinChanged
+     * \endif
+     *
+     * \if CHINESE
+     * @property QImPlotWaterfallItemNode::boundsMin
+     * @brief 左下角的绘图坐标（第一个 bin、最早的行），默认 (0, 0)
+     * @accessors READ boundsMin WRITE setBoundsMin NOTIFY boundsMinChanged
+     * \endif
+     */
+    Q_PROPERTY(QPointF boundsMin READ boundsMin WRITE setBoundsMin NOTIFY boundsMinChanged)
+
+    /**
+     * \if ENGLISH
+     * @property QImPlotWaterfallItemNode::boundsMax
+     * @brief Upper-right corner in plot coordinates (last bin, newest row), default (1, 1)
+     * @accessors READ boundsMax WRITE setBoundsMax NOTIFY boundsMaxChanged
+     * \endif
+     *
+     * \if CHINESE
+     * @property QImPlotWaterfallItemNode::boundsMax
+     * @brief 右上角的绘图坐标（最后一个 bin、最新的行），默认 (1, 1)
+     * @accessors READ boundsMax WRITE setBoundsMax NOTIFY boundsMaxChanged
+     * \endif
+     */
+    Q_PROPERTY(QPointF boundsMax READ boundsMax WRITE setBoundsMax NOTIFY boundsMaxChanged)
+
+public:
+    // Unique type identifier for QImPlotWaterfallItemNode
+    enum
+    {
+        Type = InnerType + 15
+    };
+
+    // Returns the type identifier of this plot item
+    virtual int type() const override
+    {
+        return Type;
+    }
+
+    // Constructs a QImPlotWaterfallItemNode with optional parent
+    QImPlotWaterfallItemNode(QObject* parent = nullptr);
+
+    // Destroys the QImPlotWaterfallItemNode
+    ~QImPlotWaterfallItemNode();
+
+    //----------------------------------------------------
+    // Data interface
+    //----------------------------------------------------
+
+    // Appends one row of count values as the newest row
+    void appendRow(const float* values, int count);
+    void appendRow(const double* values, int count);
+
+    // Appends one row from any contiguous container of numbers
+    template< typename Container >
+    void appendRow(const Container& values);
+
+    // Removes all rows
+    void clear();
+
+    // Number of rows currently kept, at most historyRows()
+    int rowCount() const;
+
+    // Number of rows appended since the last clear()
+    qint64 totalRowCount() const;
+
+    //----------------------------------------------------
+    // Property accessors
+    //----------------------------------------------------
+
+    int bins() const;
+    void setBins(int bins);
+
+    int historyRows() const;
+    void setHistoryRows(int rows);
+
+    double scaleMin() const;
+    void setScaleMin(double min);
+
+    double scaleMax() const;
+    void setScaleMax(double max);
+
+    QPointF boundsMin() const;
+    void setBoundsMin(const QPointF& min);
+
+    QPointF boundsMax() const;
+    void setBoundsMax(const QPointF& max);
+
+Q_SIGNALS:
+    // Emitted when the number of values per row changes
+    void binsChanged(int bins);
+    // Emitted when the history length changes
+    void historyRowsChanged(int rows);
+    // Emitted when the minimum scale value changes
+    void scaleMinChanged(double min);
+    // Emitted when the maximum scale value changes
+    void scaleMaxChanged(double max);
+    // Emitted when the lower-left bounds change
+    void boundsMinChanged(const QPointF& min);
+    // Emitted when the upper-right bounds change
+    void boundsMaxChanged(const QPointF& max);
+
+protected:
+    // Uploads the new rows and draws the ring
+    virtual bool beginDraw() override;
+
+private:
+    // 把 values 拷贝为最新的一行，超出 bins 的部分截断
+    template< typename T >
+    void appendRowImpl(const T* values, int count);
+};
+
+// Template function implementation
+template< typename Container >
+inline void QImPlotWaterfallItemNode::appendRow(const Container& values)
+{
+    using T = std::remove_cv_t< std::remove_pointer_t< decltype(std::data(values)) > >;
+    if constexpr (std::is_same_v< T, float > || std::is_same_v< T, double >) {
+        appendRow(std::data(values), static_cast< int >(std::size(values)));
+    } else {
+        const std::vector< double > row(std::begin(values), std::end(values));
+        appendRow(row.data(), static_cast< int >(row.size()));
+    }
+}
+
+}  // end namespace QIM
+
+#endif  // QIMPLOTWATERFALLITEMNODE_H
@@ -0,0 +1,458 @@
+#include "QImScatterDensityDecimator.h"
+#include "QImPlotDataSeriesView.h"
+#include "QImPlotParallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cassert>
+#include <limits>
+
+namespace QIM
+{
+
+namespace
+{
+// 每个任务至少处理的原始点数，太小的任务调度开销超过计算量
+constexpr qint64 kParallelGrainSamples = 1 << 16;
+// 单元数上限，避免异常的像素尺寸分配过多内存
+constexpr qint64 kMaxGridCells = 1 << 24;
+constexpr qint64 kEmptyCell    = std::numeric_limits< qint64 >::max();
+}  // namespace
+
+QImScatterDensityDecimator::QImScatterDensityDecimator(QImAbstractXYDataSeries* source) : m_source(source)
+{
+    assert(source && "Source must not be null");
+}
+
+qint64 QImScatterDensityDecimator::size() const
+{
+    return m_cached_valid ? static_cast< qint64 >(m_cached_x.size()) : (m_source ? m_source->size() : 0);
+}
+
+bool QImScatterDensityDecimator::isContiguous() const
+{
+    return m_cached_valid || (m_source && m_source->isContiguous());
+}
+
+int QImScatterDensityDecimator::stride() const
+{
+    if (m_cached_valid || !m_source) {
+        return sizeof(double);
+    }
+    return m_source->stride();
+}
+
+int QImScatterDensityDecimator::xStride() const
+{
+    if (m_cached_valid || !m_source) {
+        return sizeof(double);
+    }
+    return m_source->xStride();
+}
+
+const double* QImScatterDensityDecimator::xRawData() const
+{
+    if (m_cached_valid) {
+        return m_cached_x.data();
+    }
+    return m_source ? m_source->xRawData() : nullptr;
+}
+
+const double* QImScatterDensityDecimator::yRawData() const
+{
+    if (m_cached_valid) {
+        return m_cached_y.data();
+    }
+    return m_source ? m_source->yRawData() : nullptr;
+}
+
+QImPlotValueType QImScatterDensityDecimator::xValueType() const
+{
+    return (m_cached_valid || !m_source) ? QImPlotValueType::Double : m_source->xValueType();
+}
+
+QImPlotValueType QImScatterDensityDecimator::yValueType() const
+{
+    return (m_cached_valid || !m_source) ? QImPlotValueType::Double : m_source->yValueType();
+}
+
+const void* QImScatterDensityDecimator::xRawPointer() const
+{
+    if (m_cached_valid) {
+        return m_cached_x.data();
+    }
+    return m_source ? m_source->xRawPointer() : nullptr;
+}
+
+const void* QImScatterDensityDecimator::yRawPointer() const
+{
+    if (m_cached_valid) {
+        return m_cached_y.data();
+    }
+    return m_source ? m_source->yRawPointer() : nullptr;
+}
+
+bool QImScatterDensityDecimator::chunkLayout(QImPlotChunkLayout& layout) const
+{
+    return !m_cached_valid && m_source && m_source->chunkLayout(layout);
+}
+
+QImPlotDataBounds QImScatterDensityDecimator::bounds() const
+{
+    // 视图模式下输出只包含可见矩形内的点，坐标轴自适应使用原始数据的范围
+    return m_source ? m_source->bounds() : QImPlotDataBounds();
+}
+
+double QImScatterDensityDecimator::xScale() const
+{
+    return m_source->xScale();
+}
+
+double QImScatterDensityDecimator::xStart() const
+{
+    return m_source->xStart();
+}
+
+qint64 QImScatterDensityDecimator::offset() const
+{
+    return m_cached_valid ? 0 : m_source->offset();
+}
+
+double QImScatterDensityDecimator::xValue(qint64 index) const
+{
+    if (!m_cached_valid) {
+        return m_source ? m_source->xValue(index) : std::numeric_limits< double >::quiet_NaN();
+    }
+    return m_cached_x[ index ];
+}
+
+double QImScatterDensityDecimator::yValue(qint64 index) const
+{
+    if (!m_cached_valid) {
+        return m_source ? m_source->yValue(index) : std::numeric_limits< double >::quiet_NaN();
+    }
+    return m_cached_y[ index ];
+}
+
+void QImScatterDensityDecimator::setCellSize(float pixels)
+{
+    const float size = std::max(pixels, 1.0f);
+    if (size != m_cell_size) {
+        m_cell_size = size;
+        m_dirty     = true;
+    }
+}
+
+float QImScatterDensityDecimator::cellSize() const
+{
+    return m_cell_size;
+}
+
+void QImScatterDensityDecimator::setCounting(bool on)
+{
+    if (on != m_counting) {
+        m_counting = on;
+        m_dirty    = true;
+    }
+}
+
+bool QImScatterDensityDecimator::isCounting() const
+{
+    return m_counting;
+}
+
+void QImScatterDensityDecimator::setDensityLevels(int levels)
+{
+    const int new_levels = std::clamp(levels, 1, 16);
+    if (new_levels != m_levels) {
+        m_levels = new_levels;
+        // 网格不变，只需要重新分组输出
+        if (m_cached_valid) {
+            buildOutput();
+        }
+    }
+}
+
+int QImScatterDensityDecimator::densityLevels() const
+{
+    return m_levels;
+}
+
+/**
+ * \if ENGLISH
+ * @brief Decimates the samples inside the visible rectangle to one per cell
+ * @param x_min Left limit of the visible X range
+ * @param x_max Right limit of the visible X range
+ * @param y_min Lower limit of the visible Y range
+ * @param y_max Upper limit of the visible Y range
+ * @param pixel_width Width of the plot area in pixels
+ * @param pixel_height Height of the plot area in pixels
+ * @return true if the result was recomputed, false if the cached result was reused or the rectangle is invalid
+ * @details The grid has ceil(pixel_width / cellSize()) x ceil(pixel_height / cellSize()) cells. Samples
+ *          outside the rectangle are not drawn. If only samples were appended since the last call,
+ *          just those are added to the grid.
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 可见矩形内的点按单元降采样，每个单元保留一个点
+ * @param x_min 可见 X 范围的左边界
+ * @param x_max 可见 X 范围的右边界
+ * @param y_min 可见 Y 范围的下边界
+ * @param y_max 可见 Y 范围的上边界
+ * @param pixel_width 绘图区的像素宽度
+ * @param pixel_height 绘图区的像素高度
+ * @return 重新计算了结果返回 true；使用缓存或矩形无效时返回 false
+ * @details 网格为 ceil(pixel_width / cellSize()) x ceil(pixel_height / cellSize()) 个单元，
+ *          矩形外的点不绘制。上一次调用之后只追加了数据时，只把新增的点并入网格。
+ * \endif
+ */
+bool QImScatterDensityDecimator::setViewRect(double x_min,
+                                             double x_max,
+                                             double y_min,
+                                             double y_max,
+                                             int pixel_width,
+                                             int pixel_height)
+{
+    return update(x_min, x_max, y_min, y_max, pixel_width, pixel_height, true);
+}
+
+bool QImScatterDensityDecimator::clearViewRect()
+{
+    if (!m_source) {
+        return false;
+    }
+    QImPlotDataBounds b = m_source->bounds();
+    if (!b.isValid()) {
+        return false;
+    }
+    // 所有点的 X 或 Y 相同时扩展为单位宽度，保证网格有效
+    if (!(b.xMin < b.xMax)) {
+        b.xMin -= 0.5;
+        b.xMax += 0.5;
+    }
+    if (!(b.yMin < b.yMax)) {
+        b.yMin -= 0.5;
+        b.yMax += 0.5;
+    }
+    return update(b.xMin, b.xMax, b.yMin, b.yMax, m_pixel_width, m_pixel_height, false);
+}
+
+void QImScatterDensityDecimator::sourceAppended()
+{
+    if (!m_source) {
+        return;
+    }
+    // 环形缓冲写满后逻辑索引整体移动，网格中记录的索引不再有效
+    if (m_source->offset() != 0 || m_source->size() < m_scanned) {
+        m_dirty = true;
+    }
+}
+
+bool QImScatterDensityDecimator::isViewRectActive() const
+{
+    return m_view_active;
+}
+
+int QImScatterDensityDecimator::columns() const
+{
+    return m_columns;
+}
+
+int QImScatterDensityDecimator::rows() const
+{
+    return m_rows;
+}
+
+const std::vector< quint32 >& QImScatterDensityDecimator::counts() const
+{
+    return m_counts;
+}
+
+quint32 QImScatterDensityDecimator::maxCount() const
+{
+    return m_max_count;
+}
+
+const std::vector< qint64 >& QImScatterDensityDecimator::levelOffsets() const
+{
+    return m_level_offsets;
+}
+
+bool QImScatterDensityDecimator::update(double x_min,
+                                        double x_max,
+                                        double y_min,
+                                        double y_max,
+                                        int pixel_width,
+                                        int pixel_height,
+                                        bool view)
+{
+    if (!m_source || pixel_width <= 0 || pixel_height <= 0 || !(x_min < x_max) || !(y_min < y_max)) {
+        return false;
+    }
+    const qint64 n  = m_source->size();
+    const bool same = !m_dirty && m_cached_valid && view == m_view_active && m_x_min == x_min && m_x_max == x_max
+                      && m_y_min == y_min && m_y_max == y_max && m_pixel_width == pixel_width
+                      && m_pixel_height == pixel_height;
+    if (same && n == m_scanned) {
+        return false;
+    }
+    if (same) {
+        // 只追加了数据，新增的点并入现有网格
+        scan(m_scanned, n);
+    } else {
+        m_x_min        = x_min;
+        m_x_max        = x_max;
+        m_y_min        = y_min;
+        m_y_max        = y_max;
+        m_pixel_width  = pixel_width;
+        m_pixel_height = pixel_height;
+        m_columns      = std::max(1, static_cast< int >(std::ceil(pixel_width / m_cell_size)));
+        m_rows         = std::max(1, static_cast< int >(std::ceil(pixel_height / m_cell_size)));
+        // 超过单元数上限时等比例缩小网格
+        const qint64 cells = static_cast< qint64 >(m_columns) * m_rows;
+        if (cells > kMaxGridCells) {
+            const double shrink = std::sqrt(static_cast< double >(kMaxGridCells) / cells);
+            m_columns           = std::max(1, static_cast< int >(m_columns * shrink));
+            m_rows              = std::max(1, static_cast< int >(m_rows * shrink));
+        }
+        scan(0, n);
+    }
+    m_scanned     = n;
+    m_dirty       = false;
+    m_view_active = view;
+    buildOutput();
+    m_cached_valid = true;
+    return true;
+}
+
+void QImScatterDensityDecimator::scan(qint64 from, qint64 end)
+{
+    const qint64 cells = static_cast< qint64 >(m_columns) * m_rows;
+    if (from == 0) {
+        if (cells != m_grid_cells || (m_counting && !m_cell_counts)) {
+            m_first.reset(new std::atomic< qint64 >[ cells ]);
+            m_cell_counts.reset(m_counting ? new std::atomic< quint32 >[ cells ] : nullptr);
+            m_grid_cells = cells;
+        }
+        for (qint64 c = 0; c < cells; ++c) {
+            m_first[ c ].store(kEmptyCell, std::memory_order_relaxed);
+        }
+        if (m_counting) {
+            for (qint64 c = 0; c < cells; ++c) {
+                m_cell_counts[ c ].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+    const qint64 count = end - from;
+    if (count <= 0) {
+        return;
+    }
+    const double sx       = m_columns / (m_x_max - m_x_min);
+    const double sy       = m_rows / (m_y_max - m_y_min);
+    const int columns     = m_columns;
+    const int rows        = m_rows;
+    const bool counting   = m_counting;
+    // 单线程时不需要原子读改写，普通的读写即可
+    const bool concurrent = qimPlotThreadCount() > 1 && count > kParallelGrainSamples;
+    std::atomic< qint64 >* first_idx = m_first.get();
+    std::atomic< quint32 >* counts   = m_cell_counts.get();
+
+    qimPlotVisitXYSeries(*m_source, [ & ](const auto& view) {
+        qimPlotParallelFor(count, kParallelGrainSamples, [ & ](qint64 begin, qint64 stop) {
+            for (qint64 i = from + begin; i < from + stop; ++i) {
+                const double fx = (view.x(i) - m_x_min) * sx;
+                const double fy = (view.y(i) - m_y_min) * sy;
+                // NaN 与矩形外的点不参与
+                if (!(fx >= 0.0 && fx <= columns && fy >= 0.0 && fy <= rows)) {
+                    continue;
+                }
+                const qint64 cell = static_cast< qint64 >(std::min(static_cast< int >(fy), rows - 1)) * columns
+                                    + std::min(static_cast< int >(fx), columns - 1);
+                std::atomic< qint64 >& first = first_idx[ cell ];
+                qint64 current               = first.load(std::memory_order_relaxed);
+                if (i < current) {
+                    if (concurrent) {
+                        // 保留索引最小的点，结果与各分组的执行顺序无关
+                        while (i < current && !first.compare_exchange_weak(current, i, std::memory_order_relaxed)) {
+                        }
+                    } else {
+                        first.store(i, std::memory_order_relaxed);
+                    }
+                }
+                if (counting) {
+                    if (concurrent) {
+                        counts[ cell ].fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        counts[ cell ].store(counts[ cell ].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                    }
+                }
+            }
+        });
+    });
+}
+
+void QImScatterDensityDecimator::buildOutput()
+{
+    m_cached_x.clear();
+    m_cached_y.clear();
+    m_counts.clear();
+    m_max_count = 0;
+
+    const qint64 cells = m_grid_cells;
+    qint64 occupied    = 0;
+    for (qint64 c = 0; c < cells; ++c) {
+        if (m_first[ c ].load(std::memory_order_relaxed) != kEmptyCell) {
+            ++occupied;
+            if (m_counting) {
+                m_max_count = std::max(m_max_count, m_cell_counts[ c ].load(std::memory_order_relaxed));
+            }
+        }
+    }
+    const int levels = m_counting ? m_levels : 1;
+    // 密度等级按点数的对数划分：1 个点为最低等级，maxCount 为最高等级
+    const double level_scale = (m_max_count > 1) ? levels / std::log(m_max_count + 1.0) : 0.0;
+    auto levelOf             = [ & ](qint64 cell) {
+        if (levels <= 1) {
+            return 0;
+        }
+        const double count = m_cell_counts[ cell ].load(std::memory_order_relaxed);
+        return std::min(levels - 1, static_cast< int >(std::log(count) * level_scale));
+    };
+
+    // 按等级计数排序，同一等级内保持单元顺序
+    m_level_offsets.assign(levels + 1, 0);
+    if (levels > 1) {
+        for (qint64 c = 0; c < cells; ++c) {
+            if (m_first[ c ].load(std::memory_order_relaxed) != kEmptyCell) {
+                ++m_level_offsets[ levelOf(c) + 1 ];
+            }
+        }
+        for (int l = 0; l < levels; ++l) {
+            m_level_offsets[ l + 1 ] += m_level_offsets[ l ];
+        }
+    } else {
+        m_level_offsets[ 1 ] = occupied;
+    }
+
+    m_cached_x.resize(occupied);
+    m_cached_y.resize(occupied);
+    if (m_counting) {
+        m_counts.resize(occupied);
+    }
+    std::vector< qint64 > next(m_level_offsets.begin(), m_level_offsets.end() - 1);
+    qimPlotVisitXYSeries(*m_source, [ & ](const auto& view) {
+        for (qint64 c = 0; c < cells; ++c) {
+            const qint64 idx = m_first[ c ].load(std::memory_order_relaxed);
+            if (idx == kEmptyCell) {
+                continue;
+            }
+            const qint64 pos = next[ levelOf(c) ]++;
+            m_cached_x[ pos ] = view.x(idx);
+            m_cached_y[ pos ] = view.y(idx);
+            if (m_counting) {
+                m_counts[ pos ] = m_cell_counts[ c ].load(std::memory_order_relaxed);
+            }
+        }
+    });
+}
+
+}  // namespace QIM
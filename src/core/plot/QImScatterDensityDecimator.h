@@ -0,0 +1,157 @@
+#ifndef QIMSCATTERDENSITYDECIMATOR_H
+#define QIMSCATTERDENSITYDECIMATOR_H
+
+#include "QImPlotDataSeries.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace QIM
+{
+
+/**
+ * \if ENGLISH
+ * @brief Screen-space occupancy decimation for unordered point clouds
+ *
+ * @class QImScatterDensityDecimator
+ *
+ * @details The visible rectangle is divided into a grid of cells of cellSize() pixels (the marker
+ *          footprint). Every occupied cell keeps one representative, the sample with the lowest index,
+ *          so the number of drawn markers is bounded by the plot area divided by the cell area no
+ *          matter how many samples there are. The representative is a real sample, hover and tooltips
+ *          still show original values.
+ *
+ *          With setCounting() each cell also counts its samples; setDensityLevels() groups the output
+ *          by density level (logarithmic in the count) so the item can draw each level with its own
+ *          alpha or marker size.
+ *
+ *          The grid is rebuilt only when the view rectangle, the pixel size or the cell size changes.
+ *          Appended samples (sourceAppended()) are added to the existing grid, only the new samples are
+ *          read. Samples are scanned in parallel; the result does not depend on the thread count.
+ *          Only linear axes map cells to pixels exactly.
+ *
+ *          The source is not owned and must outlive the decimator.
+ * @see QImPlotScatterItemNode::setDownsampleStrategy()
+ * \endif
+ *
+ * \if CHINESE
+ * @brief 无序点云的屏幕空间占用降采样
+ *
+ * @class QImScatterDensityDecimator
+ *
+ * @details 把可见矩形划分为 cellSize() 像素（标记的大小）的网格，每个被占用的单元只保留一个代表点
+ *          （索引最小的点），因此无论数据有多少点，绘制的标记数都不超过绘图区面积除以单元面积。
+ *          代表点是真实的数据点，悬停与提示仍显示原始值。
+ *
+ *          setCounting() 开启后每个单元同时统计点数；setDensityLevels() 按密度等级（点数的对数）
+ *          对输出分组，绘图项可以为每个等级设置不同的透明度或标记大小。
+ *
+ *          只有可见矩形、像素尺寸或单元大小变化时才重建网格。追加的点（sourceAppended()）并入现有网格，
+ *          只读取新增的点。各点并行扫描，结果与线程数无关。只有线性坐标轴的单元与像素完全对应。
+ *
+ *          不持有原始数据，原始数据的生命周期必须长于该对象。
+ * @see QImPlotScatterItemNode::setDownsampleStrategy()
+ * \endif
+ */
+class QIM_CORE_API QImScatterDensityDecimator : public QImAbstractXYDataSeries
+{
+public:
+    explicit QImScatterDensityDecimator(QImAbstractXYDataSeries* source);
+    ~QImScatterDensityDecimator() override = default;
+
+    // ===== QImAbstractXYDataSeries 接口重写 =====
+    int type() const override
+    {
+        return XYData;
+    }  // 输出总是 XY 模式
+
+    qint64 size() const override;
+    bool isContiguous() const override;
+    int stride() const override;
+    int xStride() const override;
+    const double* xRawData() const override;
+    const double* yRawData() const override;
+    QImPlotValueType xValueType() const override;
+    QImPlotValueType yValueType() const override;
+    const void* xRawPointer() const override;
+    const void* yRawPointer() const override;
+    bool chunkLayout(QImPlotChunkLayout& layout) const override;
+    QImPlotDataBounds bounds() const override;
+    double xScale() const override;
+    double xStart() const override;
+    qint64 offset() const override;
+    double xValue(qint64 index) const override;
+    double yValue(qint64 index) const override;
+
+    // ===== 配置接口 =====
+    // 单元边长（像素），通常取标记大小，最小 1
+    void setCellSize(float pixels);
+    float cellSize() const;
+    // 是否统计每个单元的点数，默认关闭
+    void setCounting(bool on);
+    bool isCounting() const;
+    // 统计点数时按密度分组的等级数（1~16），默认 1 表示不分组
+    void setDensityLevels(int levels);
+    int densityLevels() const;
+
+    // ===== 视图相关降采样 =====
+    // 按可见矩形与绘图区像素尺寸划分网格，与上一次相同时直接使用缓存，返回是否重新计算
+    bool setViewRect(double x_min, double x_max, double y_min, double y_max, int pixel_width, int pixel_height);
+    // 按原始数据的范围与上一次的像素尺寸划分网格（自适应帧使用）
+    bool clearViewRect();
+    // 原始数据追加了点后调用，下一次 setViewRect()/clearViewRect() 只扫描新增的点
+    void sourceAppended();
+    bool isViewRectActive() const;
+
+    // ===== 结果 =====
+    int columns() const;
+    int rows() const;
+    // 每个输出点所在单元的点数（只在 isCounting() 时有效），与输出点一一对应
+    const std::vector< quint32 >& counts() const;
+    quint32 maxCount() const;
+    // 各密度等级在输出中的起始位置，共 densityLevels() + 1 个，等级 i 为 [offsets[i], offsets[i+1])
+    const std::vector< qint64 >& levelOffsets() const;
+
+private:
+    // 在当前网格上计算 [from, end) 的点，from 为 0 时重新建立网格
+    void scan(qint64 from, qint64 end);
+    // 由网格生成输出点
+    void buildOutput();
+    bool update(double x_min, double x_max, double y_min, double y_max, int pixel_width, int pixel_height, bool view);
+
+private:
+    QImAbstractXYDataSeries* m_source { nullptr };
+    float m_cell_size { 1.0f };
+    bool m_counting { false };
+    int m_levels { 1 };
+
+    // 网格，m_first 为每个单元内索引最小的点（空单元为 qint64 最大值），并行扫描时原子更新
+    int m_columns { 0 };
+    int m_rows { 0 };
+    qint64 m_grid_cells { 0 };  ///< 已分配的单元数
+    std::unique_ptr< std::atomic< qint64 >[] > m_first;
+    std::unique_ptr< std::atomic< quint32 >[] > m_cell_counts;
+
+    // 输出
+    std::vector< double > m_cached_x;
+    std::vector< double > m_cached_y;
+    std::vector< quint32 > m_counts;
+    std::vector< qint64 > m_level_offsets;
+    quint32 m_max_count { 0 };
+    bool m_cached_valid { false };
+
+    // 缓存键
+    bool m_view_active { false };
+    double m_x_min { 0.0 };
+    double m_x_max { 0.0 };
+    double m_y_min { 0.0 };
+    double m_y_max { 0.0 };
+    int m_pixel_width { 800 };  ///< 最近一次的像素尺寸，自适应帧沿用
+    int m_pixel_height { 600 };
+    qint64 m_scanned { 0 };  ///< 已并入网格的点数
+    bool m_dirty { true };   ///< 参数或数据整体变化，需要重建网格
+};
+
+}  // namespace QIM
+
+#endif  // QIMSCATTERDENSITYDECIMATOR_H
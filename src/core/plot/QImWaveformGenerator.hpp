@@ -4,6 +4,8 @@
 #include <cmath>
 #include <utility>  // for std::pair
 #include <tuple>
+#include <cstdint>
+#include <cstring>
 #ifndef M_PI
 constexpr double M_PI = 3.14159265358979323846;
 #endif
@@ -51,6 +53,59 @@ struct LinearWave
     }
 };
 
+// 方波，周期 2π，duty 为高电平占空比
+struct SquareWave
+{
+    static double eval(double x, double amplitude, double duty = 0.5)
+    {
+        const double cycles = x / (2.0 * M_PI);
+        return (cycles - std::floor(cycles) < duty) ? amplitude : -amplitude;
+    }
+};
+
+// 线性调频信号，瞬时角频率为 1 + rate * x
+struct ChirpWave
+{
+    static double eval(double x, double amplitude, double rate = 0.01)
+    {
+        return amplitude * std::sin(x + 0.5 * rate * x * x);
+    }
+};
+
+namespace detail
+{
+// 由 x 的位模式与种子得到 [0, 1) 的均匀分布值，相同输入总是得到相同结果
+inline double hash_unit(double x, std::uint64_t seed)
+{
+    std::uint64_t z = 0;
+    std::memcpy(&z, &x, sizeof(z));
+    z += seed * 0x9E3779B97F4A7C15ull + 0x9E3779B97F4A7C15ull;
+    // splitmix64
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return static_cast< double >(z >> 11) * (1.0 / 9007199254740992.0);
+}
+}  // namespace detail
+
+// 白噪声，[-amplitude, amplitude) 均匀分布；由 x 决定，不需要随机数状态，可并行生成
+struct NoiseWave
+{
+    static double eval(double x, double amplitude, int seed = 0)
+    {
+        return amplitude * (2.0 * detail::hash_unit(x, static_cast< std::uint64_t >(seed)) - 1.0);
+    }
+};
+
+// 稀疏尖峰，每个点以 probability 的概率取 amplitude，否则为 0
+struct SpikeTrain
+{
+    static double eval(double x, double amplitude, double probability = 1e-4, int seed = 0)
+    {
+        return detail::hash_unit(x, static_cast< std::uint64_t >(seed) + 1) < probability ? amplitude : 0.0;
+    }
+};
+
 // ============ 工具：递归调用 tuple 元素（C++14 友好） ============
 
 namespace detail
@@ -239,6 +294,51 @@ public:
         return {std::move(x), std::move(y)};
     }
 
+    /**
+     * \if ENGLISH
+     * @brief Generates only the y values over a specified x-interval.
+     *
+     * Same samples as generate(), without the x vector: pair the result with a Y-only series
+     * (x = x_start + i * dx). Intended for large datasets, the element type T halves the memory with float.
+     *
+     * @tparam T Element type of the returned vector (default: double).
+     * @param numPoints Number of data points to generate (must be >= 2).
+     * @param x_start Start of x-interval (default: 0.0).
+     * @param x_end End of x-interval (default: 4π). Must be > x_start.
+     * @return y values, empty on invalid input.
+     * \endif
+     *
+     * \if CHINESE
+     * @brief 只生成指定 x 区间内的 y 值。
+     *
+     * 采样点与 generate() 相同，但不生成 x 向量：结果配合 Y-only 数据系列使用（x = x_start + i * dx）。
+     * 用于大数据量，元素类型 T 取 float 时内存减半。
+     *
+     * @tparam T 返回向量的元素类型（默认：double）。
+     * @param numPoints 要生成的数据点数量（必须 ≥ 2）。
+     * @param x_start x 区间的起始值（默认：0.0）。
+     * @param x_end x 区间的结束值（默认：4π），必须大于 x_start。
+     * @return y 值，输入无效时返回空向量。
+     * \endif
+     */
+    template<typename T = double>
+    std::vector<T> generateY(std::size_t numPoints, double x_start = 0.0, double x_end = 4.0 * M_PI) const {
+        if (numPoints < 2 || x_end <= x_start) {
+            return {};
+        }
+
+        std::vector<T> y(numPoints);
+        const double dx = (x_end - x_start) / static_cast<double>(numPoints - 1);
+
+        constexpr std::size_t N = sizeof...(Params);
+        auto idx_seq = detail::make_index_sequence<N>{};
+
+        for (std::size_t i = 0; i < numPoints; ++i) {
+            y[i] = static_cast<T>(detail::call_eval_impl<WavePolicy>(x_start + static_cast<double>(i) * dx, params_, idx_seq));
+        }
+        return y;
+    }
+
 private:
     std::tuple<Params...> params_;
 };
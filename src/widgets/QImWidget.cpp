@@ -444,6 +444,8 @@ void QImWidget::PrivateData::drawFPSToast()
 
 QImWidget::QImWidget(QWidget* parent, Qt::WindowFlags f) : QOpenGLWidget(parent, f), QIM_PIMPL_CONSTRUCT
 {
+    // 节点在渲染循环之外发生变化（如后台降采样完成）时立即重绘
+    connect(d_ptr->rootRenderNode.get(), &QImAbstractNode::renderRequested, this, &QImWidget::requestRender);
 }
 
 QImWidget::~QImWidget()
@@ -0,0 +1,28 @@
+#ifndef QIMTESTCHECK_H
+#define QIMTESTCHECK_H
+// 单元测试共用的检查宏：失败时打印位置并计数，main() 以失败数作为返回值
+#include <cstdio>
+
+namespace QIM
+{
+namespace test
+{
+inline int& failureCount()
+{
+    static int count = 0;
+    return count;
+}
+}  // namespace test
+}  // namespace QIM
+
+#define QIM_CHECK(cond)                                                                                                \
+    do {                                                                                                               \
+        if (!(cond)) {                                                                                                 \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);                              \
+            ++QIM::test::failureCount();                                                                               \
+        }                                                                                                              \
+    } while (0)
+
+#define QIM_TEST_RESULT() (QIM::test::failureCount() == 0 ? 0 : 1)
+
+#endif  // QIMTESTCHECK_H
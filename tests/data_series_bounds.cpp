@@ -0,0 +1,158 @@
+// 数据范围缓存测试：追加、淘汰与清空数据后 bounds() 必须与完整扫描的结果一致
+#include "QImTestCheck.h"
+#include "plot/QImPlotChunkedDataSeries.h"
+#include "plot/QImPlotColumnDataSeries.h"
+#include "plot/QImPlotDataSeries.h"
+#include <cmath>
+#include <random>
+
+using namespace QIM;
+
+namespace
+{
+
+QImPlotDataBounds scanAll(const QImAbstractXYDataSeries& series)
+{
+    QImPlotDataBounds b;
+    for (qint64 i = 0; i < series.size(); ++i) {
+        b.extend(series.xValue(i), series.yValue(i));
+    }
+    return b;
+}
+
+bool sameBounds(const QImPlotDataBounds& a, const QImPlotDataBounds& b)
+{
+    return a.xMin == b.xMin && a.xMax == b.xMax && a.yMin == b.yMin && a.yMax == b.yMax;
+}
+
+// 滑动窗口：每轮追加 append 个点（第一个为尖峰）、淘汰 remove 个点，每轮都读取 bounds()
+template< typename Series, typename AppendFn >
+void slideWindow(Series& series, int rounds, int append, int remove, AppendFn&& appendOne)
+{
+    for (int round = 0; round < rounds; ++round) {
+        for (int k = 0; k < append; ++k) {
+            appendOne(series, k == 0 ? 100.0 + round : std::sin(0.1 * (round * append + k)));
+        }
+        series.removeFirst(remove);
+        QIM_CHECK(sameBounds(series.bounds(), scanAll(series)));
+    }
+}
+
+void testSortedXY()
+{
+    // chunkShift 4：每块 16 个点，淘汰时会跨块释放
+    QImChunkedXYDataSeries< double > series(4);
+    double x = 0.0;
+    for (int i = 0; i < 100; ++i) {
+        series.append(x, std::sin(0.1 * i));
+        x += 1.0;
+    }
+    QIM_CHECK(sameBounds(series.bounds(), scanAll(series)));
+    auto appendOne = [ &x ](QImChunkedXYDataSeries< double >& s, double y) {
+        s.append(x, y);
+        x += 1.0;
+    };
+    // 追加与淘汰的点数相同（窗口大小不变）、多于、少于
+    slideWindow(series, 20, 10, 10, appendOne);
+    slideWindow(series, 10, 7, 3, appendOne);
+    slideWindow(series, 10, 3, 7, appendOne);
+    // X 单调时 X 范围等于首尾点
+    const QImPlotDataBounds b = series.bounds();
+    QIM_CHECK(b.xMin == series.xValue(0));
+    QIM_CHECK(b.xMax == series.xValue(series.size() - 1));
+}
+
+void testUnsortedXY()
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution< double > xs(-50.0, 50.0);
+    QImChunkedXYDataSeries< double > series(4);
+    for (int i = 0; i < 100; ++i) {
+        series.append(xs(rng), std::sin(0.1 * i));
+    }
+    QIM_CHECK(sameBounds(series.bounds(), scanAll(series)));
+    auto appendOne = [ & ](QImChunkedXYDataSeries< double >& s, double y) { s.append(xs(rng), y); };
+    slideWindow(series, 20, 10, 10, appendOne);
+    slideWindow(series, 10, 7, 3, appendOne);
+    slideWindow(series, 10, 3, 7, appendOne);
+}
+
+void testYOnly()
+{
+    QImChunkedXYDataSeries< float > series(0.0, 0.5, 4);
+    for (int i = 0; i < 100; ++i) {
+        series.append(static_cast< float >(std::sin(0.1 * i)));
+    }
+    QIM_CHECK(sameBounds(series.bounds(), scanAll(series)));
+    auto appendOne = [](QImChunkedXYDataSeries< float >& s, double y) { s.append(static_cast< float >(y)); };
+    slideWindow(series, 20, 10, 10, appendOne);
+    slideWindow(series, 10, 3, 7, appendOne);
+}
+
+void testBatchAppendAndClear()
+{
+    QImChunkedXYDataSeries< double > series(4);
+    std::vector< double > x(40), y(40);
+    for (int i = 0; i < 40; ++i) {
+        x[ i ] = i;
+        y[ i ] = (i == 35) ? -80.0 : std::cos(0.2 * i);
+    }
+    series.appendBatch(x.data(), y.data(), 30);
+    QIM_CHECK(sameBounds(series.bounds(), scanAll(series)));
+    // 新数据中的尖峰在淘汰后仍必须被计入
+    series.appendBatch(x.data() + 30, y.data() + 30, 10);
+    series.removeFirst(10);
+    QIM_CHECK(sameBounds(series.bounds(), scanAll(series)));
+    QIM_CHECK(series.bounds().yMin == -80.0);
+    // 全部淘汰后再追加
+    series.removeFirst(series.size());
+    QIM_CHECK(!series.bounds().isValid());
+    series.append(1000.0, 5.0);
+    QIM_CHECK(sameBounds(series.bounds(), scanAll(series)));
+    // clear() 之后 X 可以重新从任意值开始
+    series.clear();
+    series.append(-3.0, 1.0);
+    series.append(-2.0, 2.0);
+    QIM_CHECK(sameBounds(series.bounds(), scanAll(series)));
+}
+
+void testColumnClear()
+{
+    auto x = QImDataColumn< double >::create();
+    auto y = QImDataColumn< float >::create();
+    for (int i = 0; i < 50; ++i) {
+        x->append(i);
+        y->append(static_cast< float >(std::sin(0.1 * i)) + (i == 20 ? 30.0f : 0.0f));
+    }
+    QImColumnXYDataSeries< double, float > xy(x, y);
+    QImColumnXYDataSeries< float > yOnly(y, 0.0, 1.0);
+    QIM_CHECK(sameBounds(xy.bounds(), scanAll(xy)));
+    QIM_CHECK(sameBounds(yOnly.bounds(), scanAll(yOnly)));
+    // 清空后重新填充到更长的长度，中间没有读取 bounds()：旧的尖峰不能留在缓存中
+    x->clear();
+    y->clear();
+    for (int i = 0; i < 60; ++i) {
+        x->append(-100.0 + i);
+        y->append(static_cast< float >(std::cos(0.1 * i)));
+    }
+    QIM_CHECK(sameBounds(xy.bounds(), scanAll(xy)));
+    QIM_CHECK(sameBounds(yOnly.bounds(), scanAll(yOnly)));
+    QIM_CHECK(xy.bounds().yMax <= 1.0);
+    // 之后的追加仍然增量扫描
+    y->append(-9.0f);
+    x->append(1000.0);
+    QIM_CHECK(sameBounds(xy.bounds(), scanAll(xy)));
+    QIM_CHECK(xy.bounds().yMin == -9.0);
+}
+
+}  // namespace
+
+int main()
+{
+    testSortedXY();
+    testUnsortedXY();
+    testYOnly();
+    testBatchAppendAndClear();
+    testColumnClear();
+    return QIM_TEST_RESULT();
+}
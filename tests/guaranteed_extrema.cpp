@@ -0,0 +1,139 @@
+// QImGuaranteedExtremaDownsampler 的保证：阈值带外的每个点，其像素列在输出中都有同侧、至少同样极端的点；
+// 每列最多加入 2 个点，全量结果不超过 targetPoints() + 2 * 列数，视图结果每列不超过 6 个点。
+// 覆盖全量结果、多个视图范围与像素宽度、非零参考值与恰好等于阈值的点
+#include "QImTestCheck.h"
+#include "plot/QImGuaranteedExtremaDownsampler.h"
+#include "plot/QImPlotDataSeries.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace QIM;
+
+namespace
+{
+
+using Series = QImVectorXYDataSeries< std::vector< double >, std::vector< double > >;
+
+constexpr int kTargetPoints = 500;
+
+// 与降采样器相同的列划分：第 c 列从第一个 X >= x0 + step * c 的点开始
+int columnOf(double x, double x0, double step, int columns)
+{
+    int c = 0;
+    while (c + 1 < columns && x >= x0 + step * (c + 1)) {
+        ++c;
+    }
+    return c;
+}
+
+// 确定性的测试信号：带噪声的正弦，加入单点尖峰与恰好位于阈值上的点
+std::vector< double > makeSignal(std::size_t n, double reference, double threshold)
+{
+    std::vector< double > y(n);
+    std::uint32_t state = 12345u;
+    for (std::size_t i = 0; i < n; ++i) {
+        state          = state * 1664525u + 1013904223u;
+        const double r = static_cast< double >(state >> 8) / static_cast< double >(1u << 24) - 0.5;
+        y[ i ]         = reference + 0.3 * std::sin(static_cast< double >(i) * 1e-3) + 0.2 * r;
+    }
+    for (std::size_t i = 137; i < n; i += 1777) {
+        y[ i ] = reference + ((i / 1777) % 2 ? 4.0 : -4.0);
+    }
+    for (std::size_t i = 911; i < n; i += 2903) {
+        y[ i ] = ((i / 2903) % 2) ? reference + threshold : reference - threshold;
+    }
+    return y;
+}
+
+// 检查 [x0, x1] 内的点在 columns 列上的保证与输出点数上限
+void checkGuarantee(const Series& source,
+                    const QImGuaranteedExtremaDownsampler& ds,
+                    double x0,
+                    double x1,
+                    int columns,
+                    qint64 maxOutput)
+{
+    const double step   = (x1 - x0) / columns;
+    const double high   = ds.reference() + ds.threshold();
+    const double low    = ds.reference() - ds.threshold();
+    const qint64 output = ds.size();
+    QIM_CHECK(output <= maxOutput);
+    QIM_CHECK(output <= ds.base()->size() + 2 * columns);
+
+    // 输出中每列的最大、最小值
+    std::vector< double > outMax(static_cast< std::size_t >(columns), -HUGE_VAL);
+    std::vector< double > outMin(static_cast< std::size_t >(columns), HUGE_VAL);
+    for (qint64 i = 0; i < output; ++i) {
+        const double x = ds.xValue(i);
+        if (x < x0 || x > x1) {
+            continue;
+        }
+        const std::size_t c = static_cast< std::size_t >(columnOf(x, x0, step, columns));
+        outMax[ c ]         = std::max(outMax[ c ], ds.yValue(i));
+        outMin[ c ]         = std::min(outMin[ c ], ds.yValue(i));
+    }
+    int missed  = 0;
+    int guarded = 0;
+    for (qint64 i = 0; i < source.size(); ++i) {
+        const double x = source.xValue(i);
+        const double y = source.yValue(i);
+        if (x < x0 || x > x1 || (y < high && y > low)) {
+            continue;
+        }
+        ++guarded;
+        const std::size_t c = static_cast< std::size_t >(columnOf(x, x0, step, columns));
+        if ((y >= high && outMax[ c ] < y) || (y <= low && outMin[ c ] > y)) {
+            ++missed;
+        }
+    }
+    QIM_CHECK(guarded > 0);
+    QIM_CHECK(missed == 0);
+}
+
+void testThresholds(double reference)
+{
+    const std::size_t n = 60000;
+    for (double threshold : { 0.0, 0.25, 1.0 }) {
+        std::vector< double > x(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            x[ i ] = 0.5 * static_cast< double >(i);
+        }
+        Series source(x, makeSignal(n, reference, threshold));
+        QImGuaranteedExtremaDownsampler ds(&source, kTargetPoints, threshold, reference);
+
+        // 全量结果：pixelWidth() 列覆盖整个 X 范围
+        ds.setPixelWidth(300);
+        checkGuarantee(source,
+                       ds,
+                       source.xValue(0),
+                       source.xValue(source.size() - 1),
+                       ds.pixelWidth(),
+                       ds.targetPoints() + 2 * ds.pixelWidth());
+
+        // 视图范围：整个范围、任意区间、边缘、可见点数少于像素数
+        const double xEnd         = source.xValue(source.size() - 1);
+        const double views[][ 2 ] = {
+            { 0.0, xEnd }, { 1000.25, 9000.75 }, { xEnd - 700.0, xEnd }, { 0.0, 333.3 }, { 5300.0, 5400.0 }
+        };
+        for (const auto& v : views) {
+            for (int width : { 800, 200, 97 }) {
+                QIM_CHECK(ds.setViewRange(v[ 0 ], v[ 1 ], width));
+                checkGuarantee(source, ds, v[ 0 ], v[ 1 ], width, 6 * static_cast< qint64 >(width));
+            }
+        }
+        ds.clearViewRange();
+        QIM_CHECK(!ds.isViewRangeActive());
+    }
+}
+
+}  // namespace
+
+int main()
+{
+    testThresholds(0.0);
+    testThresholds(1.5);
+    testThresholds(-7.25);
+    return QIM_TEST_RESULT();
+}